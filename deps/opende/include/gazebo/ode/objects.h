@@ -1140,6 +1140,29 @@ ODE_API void dBodySetAutoDisableFlag (dBodyID, int do_auto_disable);
  */
 ODE_API void  dBodySetAutoDisableDefaults (dBodyID);
 
+/**
+ * @brief Get the auto disable progress of a body: the idle time and
+ * steps left and the velocity history used for the averages.
+ * @ingroup bodies disable
+ * @param lvel, avel arrays of 4 * dBodyGetAutoDisableAverageSamplesCount
+ * values receiving the linear and angular velocity history. Unused when
+ * the samples count is 0.
+ */
+ODE_API void dBodyGetAutoDisableState (dBodyID, dReal *timeleft,
+                                       int *stepsleft, unsigned int *counter,
+                                       int *ready, dReal *lvel, dReal *avel);
+
+/**
+ * @brief Set the auto disable progress read by dBodyGetAutoDisableState,
+ * e.g. to restore a previously saved simulation state. The samples count
+ * must be the same as when the state was read.
+ * @ingroup bodies disable
+ */
+ODE_API void dBodySetAutoDisableState (dBodyID, dReal timeleft,
+                                       int stepsleft, unsigned int counter,
+                                       int ready, const dReal *lvel,
+                                       const dReal *avel);
+
 
 /**
  * @brief Retrieves the world attached to te given body.
@@ -1231,6 +1254,17 @@ ODE_API void dBodySetRotation   (dBodyID, const dMatrix3 R);
  */
 ODE_API void dBodySetQuaternion (dBodyID, const dQuaternion q);
 
+/**
+ * @brief Set the orientation of a body without renormalizing the
+ * quaternion.
+ * @ingroup bodies
+ * @remarks
+ * Meant to restore a quaternion previously read with dBodyGetQuaternion,
+ * which is already normalized, so that the simulation continues bit for
+ * bit from the saved state.
+ */
+ODE_API void dBodySetExactQuaternion (dBodyID, const dQuaternion q);
+
 /**
  * @brief Set the linear velocity of a body.
  * @ingroup bodies
@@ -2131,6 +2165,44 @@ ODE_API void dJointSetFeedback (dJointID, dJointFeedback *);
  */
 ODE_API dJointFeedback *dJointGetFeedback (dJointID);
 
+/**
+ * @brief Get the constraint impulses computed for a joint by the last
+ * step. QuickStep uses them to warm start the next step.
+ * @ingroup joints
+ * @param lambda array of 6 values receiving the impulses.
+ * @param lambda_erp array of 6 values receiving the error correcting
+ * impulses.
+ */
+ODE_API void dJointGetWarmStart (dJointID, dReal *lambda, dReal *lambda_erp);
+
+/**
+ * @brief Set the constraint impulses used to warm start the next step,
+ * e.g. to restore a previously saved simulation state.
+ * @ingroup joints
+ * @param lambda array of 6 impulses.
+ * @param lambda_erp array of 6 error correcting impulses.
+ */
+ODE_API void dJointSetWarmStart (dJointID, const dReal *lambda,
+                                 const dReal *lambda_erp);
+
+/**
+ * @brief Get the cumulative angles that hinge, screw, universal and
+ * gearbox joints track to apply limits beyond +/-pi.
+ * @ingroup joints
+ * @param angles array of 2 values receiving the angles.
+ * @return the number of angles written, 0 for other joint types.
+ */
+ODE_API int dJointGetCumulativeAngles (dJointID, dReal *angles);
+
+/**
+ * @brief Set the cumulative angles read by dJointGetCumulativeAngles,
+ * e.g. to restore a previously saved simulation state. Does nothing for
+ * joint types without cumulative angles.
+ * @ingroup joints
+ * @param angles array of 2 angles.
+ */
+ODE_API void dJointSetCumulativeAngles (dJointID, const dReal *angles);
+
 /**
  * @brief Set the joint anchor point.
  * @ingroup joints
@@ -427,6 +427,21 @@ void dBodySetQuaternion (dBodyID b, const dQuaternion q)
 }
 
 
+void dBodySetExactQuaternion (dBodyID b, const dQuaternion q)
+{
+  dAASSERT (b && q);
+  b->q[0] = q[0];
+  b->q[1] = q[1];
+  b->q[2] = q[2];
+  b->q[3] = q[3];
+  dQtoR (b->q,b->posr.R);
+
+  // notify all attached geoms that this body has moved
+  for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
+    dGeomMoved (geom);
+}
+
+
 void dBodySetLinearVel  (dBodyID b, dReal x, dReal y, dReal z)
 {
   dAASSERT (b);
@@ -993,6 +1008,46 @@ void dBodySetAutoDisableAverageSamplesCount (dBodyID b, unsigned int average_sam
 }
 
 
+void dBodyGetAutoDisableState (dBodyID b, dReal *timeleft, int *stepsleft,
+                               unsigned int *counter, int *ready,
+                               dReal *lvel, dReal *avel)
+{
+  dAASSERT(b && timeleft && stepsleft && counter && ready);
+  *timeleft = b->adis_timeleft;
+  *stepsleft = b->adis_stepsleft;
+  *counter = b->average_counter;
+  *ready = b->average_ready;
+  if (b->adis.average_samples > 0)
+  {
+    dAASSERT(lvel && avel);
+    memcpy (lvel, b->average_lvel_buffer,
+            b->adis.average_samples * sizeof(dVector3));
+    memcpy (avel, b->average_avel_buffer,
+            b->adis.average_samples * sizeof(dVector3));
+  }
+}
+
+
+void dBodySetAutoDisableState (dBodyID b, dReal timeleft, int stepsleft,
+                               unsigned int counter, int ready,
+                               const dReal *lvel, const dReal *avel)
+{
+  dAASSERT(b);
+  b->adis_timeleft = timeleft;
+  b->adis_stepsleft = stepsleft;
+  b->average_counter = counter;
+  b->average_ready = ready;
+  if (b->adis.average_samples > 0)
+  {
+    dAASSERT(lvel && avel);
+    memcpy (b->average_lvel_buffer, lvel,
+            b->adis.average_samples * sizeof(dVector3));
+    memcpy (b->average_avel_buffer, avel,
+            b->adis.average_samples * sizeof(dVector3));
+  }
+}
+
+
 int dBodyGetAutoDisableSteps (dBodyID b)
 {
   dAASSERT(b);
@@ -1542,6 +1597,69 @@ dJointFeedback *dJointGetFeedback (dxJoint *joint)
   return joint->feedback;
 }
 
+void dJointGetWarmStart (dxJoint *joint, dReal *lambda, dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (lambda, joint->lambda, 6 * sizeof(dReal));
+  memcpy (lambda_erp, joint->lambda_erp, 6 * sizeof(dReal));
+}
+
+void dJointSetWarmStart (dxJoint *joint, const dReal *lambda,
+                         const dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (joint->lambda, lambda, 6 * sizeof(dReal));
+  memcpy (joint->lambda_erp, lambda_erp, 6 * sizeof(dReal));
+}
+
+int dJointGetCumulativeAngles (dxJoint *joint, dReal *angles)
+{
+  dAASSERT (joint && angles);
+  switch (joint->type())
+  {
+    case dJointTypeHinge:
+      angles[0] = ((dxJointHinge*)joint)->cumulative_angle;
+      return 1;
+    case dJointTypeScrew:
+      angles[0] = ((dxJointScrew*)joint)->cumulative_angle;
+      return 1;
+    case dJointTypeUniversal:
+      angles[0] = ((dxJointUniversal*)joint)->cumulative_angle1;
+      angles[1] = ((dxJointUniversal*)joint)->cumulative_angle2;
+      return 2;
+    case dJointTypeGearbox:
+      angles[0] = ((dxJointGearbox*)joint)->cumulative_angle1;
+      angles[1] = ((dxJointGearbox*)joint)->cumulative_angle2;
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+void dJointSetCumulativeAngles (dxJoint *joint, const dReal *angles)
+{
+  dAASSERT (joint && angles);
+  switch (joint->type())
+  {
+    case dJointTypeHinge:
+      ((dxJointHinge*)joint)->cumulative_angle = angles[0];
+      break;
+    case dJointTypeScrew:
+      ((dxJointScrew*)joint)->cumulative_angle = angles[0];
+      break;
+    case dJointTypeUniversal:
+      ((dxJointUniversal*)joint)->cumulative_angle1 = angles[0];
+      ((dxJointUniversal*)joint)->cumulative_angle2 = angles[1];
+      break;
+    case dJointTypeGearbox:
+      ((dxJointGearbox*)joint)->cumulative_angle1 = angles[0];
+      ((dxJointGearbox*)joint)->cumulative_angle2 = angles[1];
+      break;
+    default:
+      break;
+  }
+}
+
 
 
 dJointID dConnectingJoint (dBodyID in_b1, dBodyID in_b2)
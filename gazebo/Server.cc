@@ -162,6 +162,12 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("record_filter", po::value<std::string>()->default_value(""),
      "Recording filter (supports wildcard and regular expression).")
     ("record_resources", "Recording with model meshes and materials.")
+    ("record_keyframe_period", po::value<double>()->default_value(-1),
+     "Period (seconds) at which full states are recorded. In between, only "
+     "models that moved are recorded. Disabled if <= 0.")
+    ("record_drift_threshold", po::value<double>()->default_value(0),
+     "Change (meters or radians) needed to record a model between "
+     "keyframes.")
     ("seed",  po::value<double>(), "Start with a given random number seed.")
     ("iters",  po::value<unsigned int>(), "Number of iterations to simulate.")
     ("minimal_comms", "Reduce the TCP/IP traffic output by gzserver")
@@ -620,6 +626,10 @@ void Server::ProcessParams()
       params.filter = this->dataPtr->vm["record_filter"].as<std::string>();
       params.recordResources =
           this->dataPtr->params.count("record_resources") > 0;
+      util::LogRecord::Instance()->SetKeyframePeriod(
+          this->dataPtr->vm["record_keyframe_period"].as<double>());
+      util::LogRecord::Instance()->SetDriftThreshold(
+          this->dataPtr->vm["record_drift_threshold"].as<double>());
       util::LogRecord::Instance()->Start(params);
     }
   }
@@ -17,6 +17,9 @@
 
 #include <tinyxml.h>
 #include <math.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <cstdlib>
 #include <sstream>
 #include <set>
 #include <memory>
@@ -80,6 +83,117 @@ struct Vector2dHash : unary_function<const ignition::math::Vector2d,
   }
 };
 
+/////////////////////////////////////////////////
+/// \brief Parse a whitespace separated list of floating point values in
+/// place, without splitting the string into tokens.
+/// \param[in] _str String to parse, may be null.
+/// \param[out] _values Parsed values are appended to this vector.
+static void parseFloats(const char *_str, std::vector<double> &_values)
+{
+  if (!_str)
+    return;
+
+  char *end = nullptr;
+  for (const char *p = _str; ; p = end)
+  {
+    const double value = std::strtod(p, &end);
+    if (end == p)
+      break;
+    _values.push_back(value);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a whitespace separated list of indices in place.
+/// \param[in] _str String to parse, may be null.
+/// \param[out] _values Parsed values are appended to this vector.
+static void parseIndices(const char *_str, std::vector<unsigned int> &_values)
+{
+  if (!_str)
+    return;
+
+  char *end = nullptr;
+  for (const char *p = _str; ; p = end)
+  {
+    const unsigned long value = std::strtoul(p, &end, 10);
+    if (end == p)
+      break;
+    _values.push_back(static_cast<unsigned int>(value));
+  }
+}
+
+/////////////////////////////////////////////////
+void ColladaLoaderPrivate::IndexElements(TiXmlElement *_elem)
+{
+  for (; _elem; _elem = _elem->NextSiblingElement())
+  {
+    // emplace keeps the first element with a given id
+    if (_elem->Attribute("id"))
+      this->elementIds.emplace(_elem->Attribute("id"), _elem);
+    if (_elem->Attribute("sid"))
+      this->elementIds.emplace(_elem->Attribute("sid"), _elem);
+
+    this->IndexElements(_elem->FirstChildElement());
+  }
+}
+
+/////////////////////////////////////////////////
+void ColladaLoaderPrivate::ParseFloatArrays()
+{
+  std::vector<TiXmlElement *> arrays;
+  for (TiXmlElement *libXml =
+       this->colladaXml->FirstChildElement("library_geometries");
+       libXml; libXml = libXml->NextSiblingElement("library_geometries"))
+  {
+    for (TiXmlElement *geomXml = libXml->FirstChildElement("geometry");
+         geomXml; geomXml = geomXml->NextSiblingElement("geometry"))
+    {
+      TiXmlElement *meshXml = geomXml->FirstChildElement("mesh");
+      if (!meshXml)
+        continue;
+
+      for (TiXmlElement *sourceXml = meshXml->FirstChildElement("source");
+           sourceXml; sourceXml = sourceXml->NextSiblingElement("source"))
+      {
+        TiXmlElement *floatArrayXml =
+            sourceXml->FirstChildElement("float_array");
+        if (floatArrayXml && floatArrayXml->GetText())
+          arrays.push_back(floatArrayXml);
+      }
+    }
+  }
+
+  // The arrays are independent, and hold most of the text of large files
+  std::vector<std::vector<double>> values(arrays.size());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, arrays.size(), 1),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          const char *count = arrays[i]->Attribute("count");
+          if (count)
+            values[i].reserve(std::strtoul(count, nullptr, 10));
+          parseFloats(arrays[i]->GetText(), values[i]);
+        }
+      });
+
+  for (size_t i = 0; i < arrays.size(); ++i)
+    this->floatArrays[arrays[i]] = std::move(values[i]);
+}
+
+/////////////////////////////////////////////////
+const std::vector<double> &ColladaLoaderPrivate::FloatArray(
+    TiXmlElement *_xml)
+{
+  auto iter = this->floatArrays.find(_xml);
+  if (iter == this->floatArrays.end())
+  {
+    iter = this->floatArrays.emplace(_xml, std::vector<double>()).first;
+    parseFloats(_xml->GetText(), iter->second);
+  }
+  return iter->second;
+}
+
 //////////////////////////////////////////////////
   ColladaLoader::ColladaLoader()
 : MeshLoader(), dataPtr(new ColladaLoaderPrivate)
@@ -104,6 +218,8 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
   this->dataPtr->positionDuplicateMap.clear();
   this->dataPtr->normalDuplicateMap.clear();
   this->dataPtr->texcoordDuplicateMap.clear();
+  this->dataPtr->elementIds.clear();
+  this->dataPtr->floatArrays.clear();
 
   // reset scale
   this->dataPtr->meter = 1.0;
@@ -135,11 +251,19 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
           unitXml->Attribute("meter"));
   }
 
+  // Lookups by id use an index instead of searching the document
+  this->dataPtr->IndexElements(this->dataPtr->colladaXml);
+  this->dataPtr->ParseFloatArrays();
+
   Mesh *mesh = new Mesh();
   mesh->SetPath(this->dataPtr->path);
 
   this->LoadScene(mesh);
 
+  // The elements are destroyed with the document
+  this->dataPtr->elementIds.clear();
+  this->dataPtr->floatArrays.clear();
+
   if (mesh->HasSkeleton())
     ApplyInvBindTransform(mesh->GetSkeleton());
 
@@ -915,6 +1039,13 @@ TiXmlElement *ColladaLoader::GetElementId(TiXmlElement *_parent,
   if (id.length() > 0 && id[0] == '#')
     id.erase(0, 1);
 
+  if (!id.empty() && _parent == this->dataPtr->colladaXml &&
+      !this->dataPtr->elementIds.empty())
+  {
+    auto iter = this->dataPtr->elementIds.find(id);
+    return iter != this->dataPtr->elementIds.end() ? iter->second : nullptr;
+  }
+
   if ((id.empty() && _parent->Value() == _name) ||
       (_parent->Attribute("id") && _parent->Attribute("id") == id) ||
       (_parent->Attribute("sid") && _parent->Attribute("sid") == id))
@@ -1032,21 +1163,15 @@ void ColladaLoader::LoadPositions(const std::string &_id,
 
     return;
   }
-  std::string valueStr = floatArrayXml->GetText();
+  const std::vector<double> &floats =
+      this->dataPtr->FloatArray(floatArrayXml);
 
   boost::unordered_map<ignition::math::Vector3d,
     unsigned int, Vector3Hash> unique;
 
-  std::vector<std::string> strs;
-  std::vector<std::string>::iterator iter, end;
-  boost::split(strs, valueStr, boost::is_any_of(" \t"));
-
-  end = strs.end();
-  for (iter = strs.begin(); iter != end; iter += 3)
+  for (size_t i = 0; i + 2 < floats.size(); i += 3)
   {
-    ignition::math::Vector3d vec(ignition::math::parseFloat(*iter),
-        ignition::math::parseFloat(*(iter+1)),
-        ignition::math::parseFloat(*(iter+2)));
+    ignition::math::Vector3d vec(floats[i], floats[i+1], floats[i+2]);
 
     vec = _transform * vec;
     _values.push_back(vec);
@@ -1118,25 +1243,21 @@ void ColladaLoader::LoadNormals(const std::string &_id,
   boost::unordered_map<ignition::math::Vector3d,
     unsigned int, Vector3Hash> unique;
 
-  std::string valueStr = floatArrayXml->GetText();
-  std::istringstream iss(valueStr);
-  do
+  const std::vector<double> &floats =
+      this->dataPtr->FloatArray(floatArrayXml);
+  for (size_t i = 0; i + 2 < floats.size(); i += 3)
   {
-    ignition::math::Vector3d vec;
-    iss >> vec.X() >> vec.Y() >> vec.Z();
-    if (iss)
-    {
-      vec = rotMat * vec;
-      vec.Normalize();
-      _values.push_back(vec);
+    ignition::math::Vector3d vec(floats[i], floats[i+1], floats[i+2]);
+    vec = rotMat * vec;
+    vec.Normalize();
+    _values.push_back(vec);
 
-      // create a map of duplicate indices
-      if (unique.find(vec) != unique.end())
-        _duplicates[_values.size()-1] = unique[vec];
-      else
-        unique[vec] = _values.size()-1;
-    }
-  } while (iss);
+    // create a map of duplicate indices
+    if (unique.find(vec) != unique.end())
+      _duplicates[_values.size()-1] = unique[vec];
+    else
+      unique[vec] = _values.size()-1;
+  }
 
   this->dataPtr->normalDuplicateMap[_id] = _duplicates;
   this->dataPtr->normalIds[_id] = _values;
@@ -1266,17 +1387,21 @@ void ColladaLoader::LoadTexCoords(const std::string &_id,
   boost::unordered_map<ignition::math::Vector2d,
     unsigned int, Vector2dHash> unique;
 
-  // Read the raw texture values, and split them on spaces.
-  std::string valueStr = floatArrayXml->GetText();
-  std::vector<std::string> values;
-  boost::split(values, valueStr, boost::is_any_of(" "));
+  // Read the raw texture values.
+  const std::vector<double> &values =
+      this->dataPtr->FloatArray(floatArrayXml);
+  if (values.size() < static_cast<size_t>(totCount) || stride < 2)
+  {
+    gzerr << "Error reading texture coordinates. Invalid values in element "
+             "with id[" << _id << "]\n";
+    return;
+  }
 
   // Read in all the texture coordinates.
   for (int i = 0; i < totCount; i += stride)
   {
     // We only handle 2D texture coordinates right now.
-    ignition::math::Vector2d vec(boost::lexical_cast<double>(values[i]),
-          1.0 - boost::lexical_cast<double>(values[i+1]));
+    ignition::math::Vector2d vec(values[i], 1.0 - values[i+1]);
     _values.push_back(vec);
 
     // create a map of duplicate indices
@@ -1602,17 +1727,14 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
   // break poly into triangles
   // if vcount >= 4, anchor around 0 (note this is bad for concave elements)
   //   e.g. if vcount = 4, break into triangle 1: [0,1,2], triangle 2: [0,2,3]
-  std::vector<std::string> vcountStrs;
   TiXmlElement *vcountXml = _polylistXml->FirstChildElement("vcount");
-  std::string vcountStr = vcountXml->GetText();
-  boost::split(vcountStrs, vcountStr, boost::is_any_of(" \t"));
-  std::vector<int> vcounts;
-  for (unsigned int j = 0; j < vcountStrs.size(); ++j)
-    vcounts.push_back(ignition::math::parseInt(vcountStrs[j]));
+  std::vector<unsigned int> vcounts;
+  parseIndices(vcountXml->GetText(), vcounts);
 
   // read p
   TiXmlElement *pXml = _polylistXml->FirstChildElement("p");
-  std::string pStr = pXml->GetText();
+  std::vector<unsigned int> pValues;
+  parseIndices(pXml->GetText(), pValues);
 
   // vertexIndexMap is a map of collada vertex index to Gazebo submesh vertex
   // indices, used for identifying vertices that can be shared.
@@ -1620,16 +1742,20 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
   unsigned int *values = new unsigned int[inputSize];
   memset(values, 0, inputSize);
 
-  std::vector<std::string> strs;
-  boost::split(strs, pStr, boost::is_any_of(" \t"));
-  std::vector<std::string>::iterator strsIter = strs.begin();
+  size_t polygonStart = 0;
   for (unsigned int l = 0; l < vcounts.size(); ++l)
   {
     // put us at the beginning of the polygon list
     if (l > 0)
-      strsIter += inputSize*vcounts[l-1];
+      polygonStart += inputSize*vcounts[l-1];
 
-    for (unsigned int k = 2; k < (unsigned int)vcounts[l]; ++k)
+    if (polygonStart + inputSize*vcounts[l] > pValues.size())
+    {
+      gzerr << "Polylist has fewer indices than its vcount requires\n";
+      break;
+    }
+
+    for (unsigned int k = 2; k < vcounts[l]; ++k)
     {
       // if vcounts[l] = 5, then read 0,1,2, then 0,2,3, 0,3,4,...
       // here k = the last number in the series
@@ -1648,7 +1774,7 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
 
         for (unsigned int i = 0; i < inputSize; ++i)
         {
-          values[i] = ignition::math::parseInt(strsIter[triangle_index+i]);
+          values[i] = pValues[polygonStart + triangle_index + i];
           /*gzerr << "debug parsing "
                 << " poly-i[" << l
                 << "] tri-end-index[" << k
@@ -1948,7 +2074,6 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
 
     return;
   }
-  std::string pStr = pXml->GetText();
 
   // Collada format allows normals and texcoords to have their own set of
   // indices for more efficient storage of data but opengl only supports one
@@ -1961,14 +2086,14 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
   std::map<unsigned int, std::vector<GeometryIndices> > vertexIndexMap;
 
   std::vector<unsigned int> values(offsetSize);
-  std::vector<std::string> strs;
-
-  boost::split(strs, pStr, boost::is_any_of(" \t"));
+  std::vector<unsigned int> pValues;
+  parseIndices(pXml->GetText(), pValues);
 
-  for (unsigned int j = 0; j < strs.size(); j += offsetSize)
+  for (unsigned int j = 0; offsetSize > 0 && j + offsetSize <= pValues.size();
+       j += offsetSize)
   {
     for (unsigned int i = 0; i < offsetSize; ++i)
-      values.at(i) = ignition::math::parseInt(strs[j+i]);
+      values.at(i) = pValues[j+i];
 
     unsigned int daeVertIndex = 0;
     bool addIndex = !hasVertices;
@@ -19,6 +19,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <ignition/math/Vector3.hh>
@@ -35,6 +36,19 @@ namespace gazebo
     /// \brief Private data for the ColladaLoader class
     class  ColladaLoaderPrivate
     {
+      /// \brief Index the elements of the document by id and sid.
+      public: void IndexElements(TiXmlElement *_elem);
+
+      /// \brief Parse the float arrays of all geometry sources in
+      /// parallel.
+      public: void ParseFloatArrays();
+
+      /// \brief Get the values of a float_array element, parsed on first
+      /// use if ParseFloatArrays did not parse it.
+      /// \param[in] _xml float_array element.
+      /// \return Values of the array.
+      public: const std::vector<double> &FloatArray(TiXmlElement *_xml);
+
       /// \brief scaling factor
       public: double meter;
 
@@ -85,6 +99,15 @@ namespace gazebo
       /// duplicate texture coordinates.
       public: std::map<std::string, std::map<unsigned int, unsigned int> >
           texcoordDuplicateMap;
+
+      /// \brief Elements indexed by their id and sid attributes. Holds the
+      /// first element in document order for each value, which is the
+      /// element a recursive search would find.
+      public: std::unordered_map<std::string, TiXmlElement *> elementIds;
+
+      /// \brief Parsed float_array elements.
+      public: std::unordered_map<const TiXmlElement *, std::vector<double>>
+          floatArrays;
     };
 
     /// \brief Helper data structure for loading collada geometries.
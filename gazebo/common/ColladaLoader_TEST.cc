@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "test_config.h"
@@ -179,6 +181,14 @@ TEST_F(ColladaLoader, LoadBoxWithAnimationOutsideSkeleton)
         0, 0, 1, 0,
         0, 0, 0, 1);
   EXPECT_EQ(expectedTrans, poseEnd.at("Armature"));
+
+  // The indexed poses match the dictionary
+  std::vector<ignition::math::Matrix4d> poses;
+  anim->PoseAt(1.666667, poses);
+  ASSERT_EQ(1u, poses.size());
+  ASSERT_EQ(1u, anim->NodeNames().size());
+  EXPECT_EQ("Armature", anim->NodeNames()[0]);
+  EXPECT_EQ(expectedTrans, poses[0]);
 }
 
 /////////////////////////////////////////////////
@@ -77,6 +77,7 @@ namespace gazebo
     class DiagnosticTimer;
     class Image;
     class Mesh;
+    class MeshJob;
     class SubMesh;
     class MouseEvent;
     class NumericAnimation;
@@ -123,6 +124,10 @@ namespace gazebo
     /// \def BatteryPtr
     /// \brief Standrd shared pointer to a Battery object
     typedef std::shared_ptr<Battery> BatteryPtr;
+
+    /// \def MeshJobPtr
+    /// \brief Standard shared pointer to a MeshJob object
+    typedef std::shared_ptr<MeshJob> MeshJobPtr;
   }
 
   namespace event
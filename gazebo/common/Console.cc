@@ -14,7 +14,19 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/regex.hpp>
@@ -26,6 +38,893 @@
 
 #include "gazebo/gazebo_config.h"
 
+namespace
+{
+  /// \brief Number of records the queue of the asynchronous mode holds.
+  const size_t kQueueSize = 8192;
+
+  /// \brief Number of call sites tracked by the rate limit. Call sites
+  /// that map to the same slot take it over from each other.
+  const size_t kRateSlots = 1024;
+
+  /// \brief Magic number at the start of a binary log file. The last byte
+  /// is the version of the format.
+  const char kBinaryMagic[8] = {'G', 'Z', 'L', 'O', 'G', 'B', '\0', '\2'};
+
+  /// \brief Kinds of records of a binary log file. The numbers are stored
+  /// in host byte order.
+  enum BinaryKind : uint8_t
+  {
+    /// \brief A string id: uint32 id, then the string.
+    BINARY_STRING = 0,
+
+    /// \brief A message: int64 seconds, int32 nanoseconds, uint32 prefix
+    /// string id, uint32 file string id (0 for none), int32 line, uint32
+    /// suppressed messages, the header text, then the text.
+    BINARY_MESSAGE = 1,
+
+    /// \brief Text without a header.
+    BINARY_TEXT = 2
+  };
+
+  /// \brief Rate limit state of a call site.
+  struct RateSlot
+  {
+    /// \brief Key of the call site using the slot.
+    std::atomic<uint64_t> key{0};
+
+    /// \brief Start of the current period, in nanoseconds.
+    std::atomic<int64_t> start{0};
+
+    /// \brief Messages output in the current period.
+    std::atomic<uint32_t> count{0};
+
+    /// \brief Messages suppressed since the last output.
+    std::atomic<uint32_t> suppressed{0};
+  };
+
+  /// \brief Get an unsigned number from an environment variable.
+  /// \param[in] _name Name of the variable.
+  /// \return The number, 0 if the variable is not set.
+  unsigned int EnvNumber(const char *_name)
+  {
+    const char *value = getenv(_name);
+    return value ? static_cast<unsigned int>(strtoul(value, nullptr, 10)) : 0;
+  }
+
+  /// \brief True in asynchronous mode.
+  std::atomic<bool> g_async(EnvNumber("GAZEBO_LOG_ASYNC") > 0);
+
+  /// \brief Number of messages dropped because the queue was full.
+  std::atomic<uint64_t> g_dropped(0);
+
+  /// \brief Messages per period allowed for each call site, 0 for no limit.
+  std::atomic<unsigned int> g_rateCount(EnvNumber("GAZEBO_LOG_RATE_LIMIT"));
+
+  /// \brief Rate limit period in nanoseconds.
+  std::atomic<int64_t> g_ratePeriod(1000000000);
+
+  /// \brief Rate limit state of the call sites.
+  RateSlot g_rateSlots[kRateSlots];
+
+  /// \brief Protects the log file and binary log file streams, and the
+  /// terminal output of complete messages.
+  std::mutex g_outputMutex;
+
+  /// \brief States of the background writer.
+  enum WriterState : int
+  {
+    /// \brief Not created yet.
+    WRITER_NONE,
+
+    /// \brief Running.
+    WRITER_RUNNING,
+
+    /// \brief Destroyed at exit, the loggers write synchronously.
+    WRITER_DESTROYED
+  };
+
+  /// \brief State of the background writer.
+  std::atomic<int> g_writerState(WRITER_NONE);
+
+  /// \brief Get the key of a call site.
+  /// \param[in] _file Hash of the file of the call site.
+  /// \param[in] _line Line of the call site.
+  /// \return The key, never 0.
+  uint64_t CallSite(const size_t _file, const int _line)
+  {
+    const uint64_t key = static_cast<uint64_t>(_file) * 1000003u +
+        static_cast<uint32_t>(_line);
+    return key ? key : 1;
+  }
+
+  /// \brief Check the rate limit of a call site.
+  /// \param[in] _key Key of the call site.
+  /// \param[out] _suppressed Number of messages suppressed since the last
+  /// output, set when the message is allowed.
+  /// \return True if the message is allowed.
+  bool RateAllowed(const uint64_t _key, uint32_t &_suppressed)
+  {
+    const unsigned int limit = g_rateCount.load(std::memory_order_relaxed);
+    if (limit == 0)
+      return true;
+
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // The slot is updated without locks, so concurrent messages of a call
+    // site may be counted approximately.
+    RateSlot &slot = g_rateSlots[_key % kRateSlots];
+    if (slot.key.load(std::memory_order_relaxed) != _key)
+    {
+      slot.key.store(_key, std::memory_order_relaxed);
+      slot.start.store(now, std::memory_order_relaxed);
+      slot.count.store(0, std::memory_order_relaxed);
+      slot.suppressed.store(0, std::memory_order_relaxed);
+    }
+    else if (now - slot.start.load(std::memory_order_relaxed) >=
+        g_ratePeriod.load(std::memory_order_relaxed))
+    {
+      slot.start.store(now, std::memory_order_relaxed);
+      slot.count.store(0, std::memory_order_relaxed);
+    }
+
+    if (slot.count.fetch_add(1, std::memory_order_relaxed) < limit)
+    {
+      _suppressed = slot.suppressed.exchange(0, std::memory_order_relaxed);
+      return true;
+    }
+
+    slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /// \brief Get the wall time of a message header. Unlike
+  /// Time::GetWallTime, it does not share a static time between threads.
+  /// \param[out] _sec Seconds.
+  /// \param[out] _nsec Nanoseconds.
+  void WallTime(int64_t &_sec, int32_t &_nsec)
+  {
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    _sec = now / 1000000000;
+    _nsec = static_cast<int32_t>(now % 1000000000);
+  }
+
+  /// \brief Get the file name of a path.
+  /// \param[in] _path The path.
+  /// \return The file name, part of _path.
+  const char *Basename(const char *_path)
+  {
+    const char *slash = strrchr(_path, '/');
+    return slash ? slash + 1 : _path;
+  }
+
+  /// \brief Format the header of a message, without the timestamp.
+  /// \param[in] _prefix Prefix of the logger.
+  /// \param[in] _file File name of the call site, or null.
+  /// \param[in] _line Line of the call site.
+  /// \param[in] _suppressed Number of messages suppressed by the rate limit.
+  /// \param[in] _text Text following the location.
+  /// \return The header.
+  std::string HeaderText(const std::string &_prefix, const char *_file,
+      const int _line, const uint32_t _suppressed, const std::string &_text)
+  {
+    std::stringstream out;
+    out << _prefix;
+    if (_file)
+      out << "[" << _file << ":" << _line << "] ";
+    out << _text;
+    if (_suppressed > 0)
+      out << "(" << _suppressed << " similar messages suppressed) ";
+    return out.str();
+  }
+
+  /// \brief Write a number to a binary log file.
+  /// \param[in] _out The binary log file.
+  /// \param[in] _value The number.
+  template<typename T>
+  void Put(std::ostream &_out, const T _value)
+  {
+    _out.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+  }
+
+  /// \brief Write a string to a binary log file.
+  /// \param[in] _out The binary log file.
+  /// \param[in] _value The string.
+  void PutString(std::ostream &_out, const std::string &_value)
+  {
+    Put<uint32_t>(_out, static_cast<uint32_t>(_value.size()));
+    _out.write(_value.data(), _value.size());
+  }
+
+  /// \brief Read a number from a binary log file.
+  /// \param[in] _in The binary log file.
+  /// \param[out] _value The number.
+  /// \return True if the number was read.
+  template<typename T>
+  bool Get(std::istream &_in, T &_value)
+  {
+    return static_cast<bool>(
+        _in.read(reinterpret_cast<char *>(&_value), sizeof(T)));
+  }
+
+  /// \brief Read a string from a binary log file.
+  /// \param[in] _in The binary log file.
+  /// \param[out] _value The string.
+  /// \return True if the string was read.
+  bool GetString(std::istream &_in, std::string &_value)
+  {
+    uint32_t size;
+    if (!Get(_in, size) || size > (1u << 30))
+      return false;
+    _value.resize(size);
+    return size == 0 || static_cast<bool>(_in.read(&_value[0], size));
+  }
+}
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief A message, or text without a header, output by a logger.
+    struct ConsoleRecord
+    {
+      /// \brief Kinds of records.
+      enum Kind : uint8_t
+      {
+        /// \brief A message with a timestamp, a prefix and a location.
+        MESSAGE,
+
+        /// \brief Text without a header.
+        TEXT
+      };
+
+      /// \brief Kind of the record.
+      Kind kind = TEXT;
+
+      /// \brief Terminal stream: 0 for none, 1 for stdout, 2 for stderr.
+      int terminal = 0;
+
+      /// \brief Color of the terminal output.
+      int color = 0;
+
+      /// \brief Prefix of a message, owned by its logger. Null for none.
+      const std::string *prefix = nullptr;
+
+      /// \brief Path of the call site of a message, with static storage
+      /// like __FILE__. Null if the location is already in the header.
+      const char *file = nullptr;
+
+      /// \brief Line of the call site of a message.
+      int line = 0;
+
+      /// \brief Wall time of a message, seconds.
+      int64_t sec = 0;
+
+      /// \brief Wall time of a message, nanoseconds.
+      int32_t nsec = 0;
+
+      /// \brief Messages of the call site suppressed before this one.
+      uint32_t suppressed = 0;
+
+      /// \brief Header text following the location, such as a location
+      /// formatted by the caller.
+      std::string header;
+
+      /// \brief Text of the record.
+      std::string text;
+    };
+
+    /// \internal
+    /// \brief Bounded queue of records, which any thread pushes into
+    /// without locks, and the background writer pops from. Each cell has a
+    /// sequence number, which tells whether the cell is free for the push
+    /// at a position, or holds the record for the pop at a position.
+    class ConsoleQueue
+    {
+      /// \brief Constructor.
+      /// \param[in] _size Number of cells, a power of two.
+      public: explicit ConsoleQueue(const size_t _size)
+        : cells(new Cell[_size]), mask(_size - 1)
+      {
+        for (size_t i = 0; i < _size; ++i)
+          this->cells[i].sequence.store(i, std::memory_order_relaxed);
+      }
+
+      /// \brief Push a record. Thread safe.
+      /// \param[in] _record The record, moved on success.
+      /// \return False if the queue is full.
+      public: bool Push(ConsoleRecord &&_record)
+      {
+        size_t pos = this->pushPos.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true)
+        {
+          cell = &this->cells[pos & this->mask];
+          const size_t sequence =
+              cell->sequence.load(std::memory_order_acquire);
+          const intptr_t diff =
+              static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+          if (diff == 0)
+          {
+            if (this->pushPos.compare_exchange_weak(pos, pos + 1,
+                  std::memory_order_relaxed))
+            {
+              break;
+            }
+          }
+          else if (diff < 0)
+          {
+            // The cell still holds the record of the previous lap
+            return false;
+          }
+          else
+          {
+            pos = this->pushPos.load(std::memory_order_relaxed);
+          }
+        }
+
+        cell->record = std::move(_record);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+
+      /// \brief Pop a record. Only called by the background writer.
+      /// \param[out] _record The record.
+      /// \return False if the queue is empty.
+      public: bool Pop(ConsoleRecord &_record)
+      {
+        Cell &cell = this->cells[this->popPos & this->mask];
+        if (cell.sequence.load(std::memory_order_acquire) != this->popPos + 1)
+          return false;
+
+        _record = std::move(cell.record);
+        cell.sequence.store(this->popPos + this->mask + 1,
+            std::memory_order_release);
+        ++this->popPos;
+        return true;
+      }
+
+      /// \brief A cell of the queue.
+      private: struct Cell
+               {
+                 /// \brief Sequence number of the cell.
+                 std::atomic<size_t> sequence;
+
+                 /// \brief Record held by the cell.
+                 ConsoleRecord record;
+               };
+
+      /// \brief Cells of the queue.
+      private: std::unique_ptr<Cell[]> cells;
+
+      /// \brief Number of cells minus one.
+      private: const size_t mask;
+
+      /// \brief Position of the next push.
+      private: alignas(64) std::atomic<size_t> pushPos{0};
+
+      /// \brief Position of the next pop.
+      private: alignas(64) size_t popPos = 0;
+    };
+
+    /// \internal
+    /// \brief Background thread of the asynchronous mode, which formats
+    /// and writes the queued records.
+    class ConsoleWriter
+    {
+      /// \brief Get the writer, starting its thread on first use. It is
+      /// destroyed before the loggers, and writes the remaining records.
+      /// \return The writer, null once it has been destroyed at exit.
+      public: static ConsoleWriter *Get()
+      {
+        if (g_writerState.load(std::memory_order_acquire) == WRITER_DESTROYED)
+          return nullptr;
+
+        static ConsoleWriter writer;
+        return &writer;
+      }
+
+      /// \brief Destructor.
+      public: ~ConsoleWriter()
+      {
+        // The loggers write synchronously from now on
+        g_writerState = WRITER_DESTROYED;
+        g_async = false;
+        {
+          std::lock_guard<std::mutex> lock(this->wakeMutex);
+          this->stop = true;
+        }
+        this->wake.notify_one();
+        this->thread.join();
+
+        std::lock_guard<std::mutex> lock(g_outputMutex);
+        if (this->binary.is_open())
+          this->binary.close();
+      }
+
+      /// \brief Queue a record. Never blocks.
+      /// \param[in] _record The record.
+      public: void Push(ConsoleRecord &&_record)
+      {
+        if (!this->queue.Push(std::move(_record)))
+        {
+          g_dropped.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+
+        this->pushed.fetch_add(1, std::memory_order_release);
+        if (this->sleeping.load(std::memory_order_relaxed))
+          this->wake.notify_one();
+      }
+
+      /// \brief Output a record: queue it in asynchronous mode, or write it
+      /// now.
+      /// \param[in] _record The record.
+      public: static void Output(ConsoleRecord &&_record)
+      {
+        ConsoleWriter *writer = Console::Async() ? Get() : nullptr;
+        if (writer)
+        {
+          writer->Push(std::move(_record));
+          return;
+        }
+
+        std::lock_guard<std::mutex> lock(g_outputMutex);
+        WriteText(_record);
+        auto buf = static_cast<FileLogger::Buffer *>(Console::log.rdbuf());
+        if (buf->stream)
+          buf->stream->flush();
+      }
+
+      /// \brief Write a record to the log file and the terminal. The caller
+      /// holds g_outputMutex.
+      /// \param[in] _record The record.
+      /// \return Header of the record, without the timestamp.
+      public: static std::string WriteText(const ConsoleRecord &_record)
+      {
+        auto buf = static_cast<FileLogger::Buffer *>(Console::log.rdbuf());
+
+        std::string header;
+        if (_record.kind == ConsoleRecord::MESSAGE)
+        {
+          header = HeaderText(_record.prefix ? *_record.prefix : "",
+              _record.file ? Basename(_record.file) : nullptr, _record.line,
+              _record.suppressed, _record.header);
+          if (buf->stream)
+          {
+            *buf->stream << "(" << _record.sec << " " << _record.nsec << ") "
+                         << header;
+          }
+        }
+        if (buf->stream)
+          *buf->stream << _record.text;
+
+        if (_record.terminal == 0 || Console::GetQuiet())
+          return header;
+
+        std::ostream &out = _record.terminal == 1 ? std::cout : std::cerr;
+#ifndef _WIN32
+        out << "\033[1;" << _record.color << "m" << header << _record.text
+            << "\033[0m";
+#else
+        out << header << _record.text;
+#endif
+        return header;
+      }
+
+      /// \brief Wake the writer up.
+      public: void Wake()
+      {
+        std::lock_guard<std::mutex> lock(this->wakeMutex);
+        this->wake.notify_one();
+      }
+
+      /// \brief Wait until the records queued so far are written.
+      public: void Flush()
+      {
+        const uint64_t target = this->pushed.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(this->wakeMutex);
+        this->wake.notify_one();
+        this->flushed.wait(lock, [&]
+            {
+              return this->written.load(std::memory_order_acquire) >= target;
+            });
+      }
+
+      /// \brief Open the binary log file, closing the current one.
+      /// \param[in] _filename Path of the file, empty to only close.
+      /// \return True if the file was opened.
+      public: bool OpenBinary(const std::string &_filename)
+      {
+        this->Flush();
+
+        std::lock_guard<std::mutex> lock(g_outputMutex);
+        if (this->binary.is_open())
+          this->binary.close();
+        this->stringIds.clear();
+
+        if (_filename.empty())
+          return false;
+
+        this->binary.clear();
+        this->binary.open(_filename.c_str(),
+            std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!this->binary.is_open())
+          return false;
+
+        this->binary.write(kBinaryMagic, sizeof(kBinaryMagic));
+        return true;
+      }
+
+      /// \brief Constructor, starts the thread.
+      private: ConsoleWriter()
+        : queue(kQueueSize)
+      {
+        g_writerState = WRITER_RUNNING;
+        this->thread = std::thread(&ConsoleWriter::Run, this);
+      }
+
+      /// \brief Thread function. Writes the queued records, then sleeps
+      /// until woken up, or for a short period in asynchronous mode, so
+      /// that the loggers rarely need to wake it up.
+      private: void Run()
+      {
+        while (true)
+        {
+          this->Drain();
+
+          std::unique_lock<std::mutex> lock(this->wakeMutex);
+          if (this->stop)
+            break;
+
+          // Records were pushed since the queue was drained
+          if (this->written.load(std::memory_order_acquire) <
+              this->pushed.load(std::memory_order_acquire))
+          {
+            continue;
+          }
+
+          this->sleeping = true;
+          if (g_async)
+            this->wake.wait_for(lock, std::chrono::milliseconds(10));
+          else
+            this->wake.wait(lock);
+          this->sleeping = false;
+        }
+
+        this->Drain();
+      }
+
+      /// \brief Write the queued records, and report the dropped messages.
+      private: void Drain()
+      {
+        uint64_t count = 0;
+        {
+          std::lock_guard<std::mutex> lock(g_outputMutex);
+
+          // Bound the batch, so that the log file is not held for long
+          ConsoleRecord record;
+          while (count < kQueueSize && this->queue.Pop(record))
+          {
+            this->Write(record);
+            ++count;
+          }
+
+          const uint64_t dropped = g_dropped.load(std::memory_order_relaxed);
+          if (dropped != this->reportedDrops)
+          {
+            std::stringstream text;
+            text << (dropped - this->reportedDrops)
+                 << " console messages dropped, the queue was full\n";
+            this->reportedDrops = dropped;
+
+            ConsoleRecord warning;
+            warning.kind = ConsoleRecord::MESSAGE;
+            warning.terminal = 2;
+            warning.color = Console::warn.color;
+            warning.prefix = &Console::warn.prefix;
+            WallTime(warning.sec, warning.nsec);
+            warning.text = text.str();
+            this->Write(warning);
+          }
+
+          if (count > 0)
+          {
+            auto buf = static_cast<FileLogger::Buffer *>(Console::log.rdbuf());
+            if (buf->stream)
+              buf->stream->flush();
+            if (this->binary.is_open())
+              this->binary.flush();
+            std::cout.flush();
+          }
+        }
+
+        if (count > 0)
+        {
+          this->written.fetch_add(count, std::memory_order_release);
+          {
+            std::lock_guard<std::mutex> lock(this->wakeMutex);
+          }
+          this->flushed.notify_all();
+        }
+      }
+
+      /// \brief Format and write a record.
+      /// \param[in] _record The record.
+      private: void Write(const ConsoleRecord &_record)
+      {
+        WriteText(_record);
+        if (this->binary.is_open())
+          this->WriteBinary(_record);
+      }
+
+      /// \brief Write a record to the binary log file.
+      /// \param[in] _record The record.
+      private: void WriteBinary(const ConsoleRecord &_record)
+      {
+        if (_record.kind == ConsoleRecord::TEXT)
+        {
+          Put<uint8_t>(this->binary, BINARY_TEXT);
+          PutString(this->binary, _record.text);
+          return;
+        }
+
+        const uint32_t prefixId =
+            this->StringId(_record.prefix ? *_record.prefix : "");
+        const uint32_t fileId =
+            _record.file ? this->StringId(Basename(_record.file)) : 0;
+
+        Put<uint8_t>(this->binary, BINARY_MESSAGE);
+        Put<int64_t>(this->binary, _record.sec);
+        Put<int32_t>(this->binary, _record.nsec);
+        Put<uint32_t>(this->binary, prefixId);
+        Put<uint32_t>(this->binary, fileId);
+        Put<int32_t>(this->binary, _record.line);
+        Put<uint32_t>(this->binary, _record.suppressed);
+        PutString(this->binary, _record.header);
+        PutString(this->binary, _record.text);
+      }
+
+      /// \brief Get the id of a string of the binary log file, writing
+      /// the string the first time.
+      /// \param[in] _value The string.
+      /// \return Id of the string, starting at 1.
+      private: uint32_t StringId(const std::string &_value)
+      {
+        auto iter = this->stringIds.find(_value);
+        if (iter != this->stringIds.end())
+          return iter->second;
+
+        const uint32_t id = static_cast<uint32_t>(this->stringIds.size()) + 1;
+        this->stringIds[_value] = id;
+        Put<uint8_t>(this->binary, BINARY_STRING);
+        Put<uint32_t>(this->binary, id);
+        PutString(this->binary, _value);
+        return id;
+      }
+
+      /// \brief Queue of records.
+      private: ConsoleQueue queue;
+
+      /// \brief Number of records pushed.
+      private: std::atomic<uint64_t> pushed{0};
+
+      /// \brief Number of records written.
+      private: std::atomic<uint64_t> written{0};
+
+      /// \brief Number of dropped messages already reported.
+      private: uint64_t reportedDrops = 0;
+
+      /// \brief True while the thread sleeps.
+      private: std::atomic<bool> sleeping{false};
+
+      /// \brief True to stop the thread.
+      private: bool stop = false;
+
+      /// \brief Protects the sleep of the thread.
+      private: std::mutex wakeMutex;
+
+      /// \brief Wakes the thread up.
+      private: std::condition_variable wake;
+
+      /// \brief Notified when records were written.
+      private: std::condition_variable flushed;
+
+      /// \brief Binary log file.
+      private: std::ofstream binary;
+
+      /// \brief Ids of the strings written to the binary log file.
+      private: std::unordered_map<std::string, uint32_t> stringIds;
+
+      /// \brief The thread.
+      private: std::thread thread;
+    };
+
+    /// \internal
+    /// \brief The message a thread is writing to a logger. The loggers are
+    /// shared by all the threads, so each thread collects its own messages
+    /// and outputs them whole.
+    struct PendingMessage
+    {
+      /// \brief Buffer of the logger.
+      const std::streambuf *buffer = nullptr;
+
+      /// \brief The message so far.
+      ConsoleRecord record;
+
+      /// \brief True if the message is over the rate limit. Its text is
+      /// dropped until the next message of the logger.
+      bool dropped = false;
+
+      /// \brief Take the message, and start an empty one.
+      /// \return The message.
+      ConsoleRecord Take()
+      {
+        ConsoleRecord result = std::move(this->record);
+        this->record = ConsoleRecord();
+        this->record.terminal = result.terminal;
+        this->record.color = result.color;
+        return result;
+      }
+
+      /// \brief Output the message if it has any content.
+      void Output()
+      {
+        if (!this->dropped && (this->record.kind == ConsoleRecord::MESSAGE ||
+              !this->record.text.empty()))
+        {
+          ConsoleWriter::Output(this->Take());
+        }
+        else
+        {
+          this->record.text.clear();
+        }
+      }
+    };
+
+    /// \internal
+    /// \brief The messages of a thread, one per logger.
+    class ThreadMessages
+    {
+      /// \brief Destructor, outputs the unfinished messages.
+      public: ~ThreadMessages()
+      {
+        for (auto &message : this->messages)
+          message.Output();
+      }
+
+      /// \brief Get the message of the calling thread for a logger.
+      /// \param[in] _buffer Buffer of the logger.
+      /// \param[in] _terminal Terminal stream of the logger, see
+      /// ConsoleRecord.
+      /// \param[in] _color Color of the logger.
+      /// \return The message, null once the messages of the thread have
+      /// been released at thread exit.
+      public: static PendingMessage *Find(const std::streambuf *_buffer,
+                  const int _terminal, const int _color);
+
+      /// \brief Output the unfinished messages of the calling thread.
+      public: static void OutputAll();
+
+      /// \brief Messages, one per logger the thread wrote to.
+      public: std::vector<PendingMessage> messages;
+    };
+
+    /// \internal
+    /// \brief Releases the messages of a thread at thread exit.
+    struct ThreadMessagesOwner
+    {
+      /// \brief Destructor.
+      ~ThreadMessagesOwner();
+
+      /// \brief Set on first use, which registers the destructor.
+      bool registered = false;
+    };
+  }
+}
+
+namespace
+{
+  /// \brief Messages of the calling thread, created on first use. A plain
+  /// pointer stays valid after the thread_local destructors ran, so the
+  /// loggers can check it while the thread exits.
+  thread_local gazebo::common::ThreadMessages *t_messages = nullptr;
+
+  /// \brief True once the messages of the calling thread were released.
+  thread_local bool t_messagesReleased = false;
+
+  /// \brief Releases t_messages at thread exit.
+  thread_local gazebo::common::ThreadMessagesOwner t_messagesOwner;
+}
+
+namespace gazebo
+{
+  namespace common
+  {
+    //////////////////////////////////////////////////
+    ThreadMessagesOwner::~ThreadMessagesOwner()
+    {
+      ThreadMessages *messages = t_messages;
+      t_messages = nullptr;
+      t_messagesReleased = true;
+      delete messages;
+    }
+
+    //////////////////////////////////////////////////
+    PendingMessage *ThreadMessages::Find(const std::streambuf *_buffer,
+        const int _terminal, const int _color)
+    {
+      if (!t_messages)
+      {
+        if (t_messagesReleased)
+          return nullptr;
+
+        // Register the owner, which deletes the messages at thread exit
+        t_messagesOwner.registered = true;
+        t_messages = new ThreadMessages;
+      }
+
+      for (auto &message : t_messages->messages)
+      {
+        if (message.buffer == _buffer)
+          return &message;
+      }
+
+      t_messages->messages.push_back(PendingMessage());
+      PendingMessage &message = t_messages->messages.back();
+      message.buffer = _buffer;
+      message.record.terminal = _terminal;
+      message.record.color = _color;
+      return &message;
+    }
+
+    //////////////////////////////////////////////////
+    void ThreadMessages::OutputAll()
+    {
+      if (!t_messages)
+        return;
+
+      for (auto &message : t_messages->messages)
+        message.Output();
+    }
+
+    /// \internal
+    /// \brief Start a message of a logger on the calling thread. The
+    /// unfinished message of the thread for the logger is output first.
+    /// \param[in] _buffer Buffer of the logger.
+    /// \param[in] _header Header of the message. Its kind and timestamp are
+    /// set here.
+    /// \param[in] _dropped True if the message is over the rate limit.
+    /// \return True if the header was handled, false if the caller writes
+    /// it synchronously.
+    bool StartMessage(const std::streambuf *_buffer, ConsoleRecord &&_header,
+        const bool _dropped)
+    {
+      PendingMessage *message =
+          ThreadMessages::Find(_buffer, _header.terminal, _header.color);
+      if (message)
+      {
+        message->Output();
+        message->dropped = _dropped;
+      }
+
+      if (_dropped)
+        return true;
+
+      if (!message || !Console::Async() || !ConsoleWriter::Get())
+        return false;
+
+      message->record = std::move(_header);
+      message->record.kind = ConsoleRecord::MESSAGE;
+      WallTime(message->record.sec, message->record.nsec);
+      return true;
+    }
+  }
+}
+
 using namespace gazebo;
 using namespace common;
 
@@ -49,6 +948,134 @@ bool Console::GetQuiet()
   return quiet;
 }
 
+//////////////////////////////////////////////////
+void Console::SetAsync(const bool _async)
+{
+  if (_async)
+  {
+    // The writer is gone at exit
+    ConsoleWriter *writer = ConsoleWriter::Get();
+    if (!writer)
+      return;
+
+    g_async = true;
+    writer->Wake();
+  }
+  else if (g_async)
+  {
+    // Queue the unfinished messages of this thread while still
+    // asynchronous
+    ThreadMessages::OutputAll();
+
+    ConsoleWriter *writer = ConsoleWriter::Get();
+    if (g_async.exchange(false) && writer)
+      writer->Flush();
+  }
+}
+
+//////////////////////////////////////////////////
+bool Console::Async()
+{
+  return g_async.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+void Console::Flush()
+{
+  ThreadMessages::OutputAll();
+
+  ConsoleWriter *writer = Console::Async() ? ConsoleWriter::Get() : nullptr;
+  if (writer)
+    writer->Flush();
+}
+
+//////////////////////////////////////////////////
+uint64_t Console::DroppedMessages()
+{
+  return g_dropped.load(std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+void Console::SetRateLimit(const unsigned int _count, const double _period)
+{
+  g_ratePeriod = static_cast<int64_t>(std::max(0.0, _period) * 1e9);
+  g_rateCount = _count;
+}
+
+//////////////////////////////////////////////////
+bool Console::SetBinaryLog(const std::string &_filename)
+{
+  if (!_filename.empty())
+    Console::SetAsync(true);
+  if (!Console::Async())
+    return false;
+
+  ConsoleWriter *writer = ConsoleWriter::Get();
+  return writer && writer->OpenBinary(_filename);
+}
+
+//////////////////////////////////////////////////
+bool Console::DecodeBinaryLog(const std::string &_filename,
+    std::ostream &_out)
+{
+  std::ifstream in(_filename.c_str(), std::ios::in | std::ios::binary);
+  char magic[sizeof(kBinaryMagic)];
+  if (!in.read(magic, sizeof(magic)) ||
+      memcmp(magic, kBinaryMagic, sizeof(magic)) != 0)
+  {
+    return false;
+  }
+
+  std::vector<std::string> strings(1);
+  uint8_t kind;
+  while (Get(in, kind))
+  {
+    if (kind == BINARY_STRING)
+    {
+      uint32_t id;
+      std::string value;
+      if (!Get(in, id) || id == 0 || id > (1u << 24) || !GetString(in, value))
+        return false;
+      if (id >= strings.size())
+        strings.resize(id + 1);
+      strings[id] = value;
+    }
+    else if (kind == BINARY_MESSAGE)
+    {
+      int64_t sec;
+      int32_t nsec, line;
+      uint32_t prefixId, fileId, suppressed;
+      std::string header, text;
+      if (!Get(in, sec) || !Get(in, nsec) || !Get(in, prefixId) ||
+          !Get(in, fileId) || !Get(in, line) || !Get(in, suppressed) ||
+          !GetString(in, header) || !GetString(in, text) ||
+          prefixId >= strings.size() || fileId >= strings.size())
+      {
+        return false;
+      }
+
+      _out << "(" << sec << " " << nsec << ") "
+           << HeaderText(strings[prefixId],
+               fileId ? strings[fileId].c_str() : nullptr, line, suppressed,
+               header)
+           << text;
+    }
+    else if (kind == BINARY_TEXT)
+    {
+      std::string text;
+      if (!GetString(in, text))
+        return false;
+      _out << text;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  return in.eof();
+}
+
 /////////////////////////////////////////////////
 Logger::Logger(const std::string &_prefix, int _color, LogType _type)
   : std::ostream(new Buffer(_type, _color)), color(_color), prefix(_prefix)
@@ -65,6 +1092,14 @@ Logger::~Logger()
 /////////////////////////////////////////////////
 Logger &Logger::operator()()
 {
+  auto buf = static_cast<const Buffer *>(this->rdbuf());
+  ConsoleRecord header;
+  header.terminal = buf->type == Logger::STDOUT ? 1 : 2;
+  header.color = buf->color;
+  header.prefix = &this->prefix;
+  if (StartMessage(buf, std::move(header), false))
+    return (*this);
+
   Console::log << "(" << Time::GetWallTime() << ") ";
   (*this) << this->prefix;
 
@@ -74,14 +1109,54 @@ Logger &Logger::operator()()
 /////////////////////////////////////////////////
 Logger &Logger::operator()(const std::string &_file, int _line)
 {
+  uint32_t suppressed = 0;
+  const bool allowed = RateAllowed(
+      CallSite(std::hash<std::string>()(_file), _line), suppressed);
+
   int index = _file.find_last_of("/") + 1;
+  const std::string file = _file.substr(index , _file.size() - index);
+
+  // The file name may not outlive the call, so it is formatted now
+  std::stringstream location;
+  location << "[" << file << ":" << _line << "] ";
+
+  auto buf = static_cast<const Buffer *>(this->rdbuf());
+  ConsoleRecord header;
+  header.terminal = buf->type == Logger::STDOUT ? 1 : 2;
+  header.color = buf->color;
+  header.prefix = &this->prefix;
+  header.line = _line;
+  header.suppressed = suppressed;
+  header.header = location.str();
+  if (StartMessage(buf, std::move(header), !allowed))
+    return (*this);
+
+  Console::log << "(" << Time::GetWallTime() << ") ";
+  (*this) << HeaderText(this->prefix, file.c_str(), _line, suppressed, "");
+
+  return (*this);
+}
+
+/////////////////////////////////////////////////
+Logger &Logger::operator()(const char *_file, int _line)
+{
+  uint32_t suppressed = 0;
+  const bool allowed = RateAllowed(
+      CallSite(std::hash<const void *>()(_file), _line), suppressed);
+
+  auto buf = static_cast<const Buffer *>(this->rdbuf());
+  ConsoleRecord header;
+  header.terminal = buf->type == Logger::STDOUT ? 1 : 2;
+  header.color = buf->color;
+  header.prefix = &this->prefix;
+  header.file = _file;
+  header.line = _line;
+  header.suppressed = suppressed;
+  if (StartMessage(buf, std::move(header), !allowed))
+    return (*this);
 
   Console::log << "(" << Time::GetWallTime() << ") ";
-  std::stringstream prefixString;
-  prefixString << this->prefix
-    << "[" << _file.substr(index , _file.size() - index) << ":"
-    << _line << "] ";
-  (*this) << prefixString.str();
+  (*this) << HeaderText(this->prefix, Basename(_file), _line, suppressed, "");
 
   return (*this);
 }
@@ -90,6 +1165,9 @@ Logger &Logger::operator()(const std::string &_file, int _line)
 Logger::Buffer::Buffer(LogType _type, int _color)
   :  type(_type), color(_color)
 {
+  // Every write goes through xsputn or overflow, into the message of the
+  // calling thread
+  this->setp(nullptr, nullptr);
 }
 
 /////////////////////////////////////////////////
@@ -106,11 +1184,76 @@ Logger::Buffer::~Buffer()
   }
 }
 
+/////////////////////////////////////////////////
+Logger::Buffer::int_type Logger::Buffer::overflow(int_type _c)
+{
+  if (traits_type::eq_int_type(_c, traits_type::eof()))
+    return traits_type::not_eof(_c);
+
+  const char c = traits_type::to_char_type(_c);
+  this->xsputn(&c, 1);
+  return _c;
+}
+
+/////////////////////////////////////////////////
+std::streamsize Logger::Buffer::xsputn(const char *_s, std::streamsize _n)
+{
+  const int terminal = this->type == Logger::STDOUT ? 1 : 2;
+  PendingMessage *message = ThreadMessages::Find(this, terminal, this->color);
+  if (message)
+  {
+    if (!message->dropped)
+      message->record.text.append(_s, static_cast<size_t>(_n));
+    return _n;
+  }
+
+  // The thread is exiting, output the text now
+  ConsoleRecord record;
+  record.terminal = terminal;
+  record.color = this->color;
+  record.text.assign(_s, static_cast<size_t>(_n));
+  ConsoleWriter::Output(std::move(record));
+  return _n;
+}
+
 /////////////////////////////////////////////////
 int Logger::Buffer::sync()
 {
+  const int terminal = this->type == Logger::STDOUT ? 1 : 2;
+  PendingMessage *message = ThreadMessages::Find(this, terminal, this->color);
+  if (!message)
+    return 0;
+
+  // Drop the text of a message over the rate limit
+  if (message->dropped)
+  {
+    message->record.text.clear();
+    return 0;
+  }
+
+  // A message is queued whole, once it ends with a new line
+  if (Console::Async() && ConsoleWriter::Get())
+  {
+    const std::string &text = message->record.text;
+    if (!text.empty() && text.back() == '\n')
+      ConsoleWriter::Output(message->Take());
+    return 0;
+  }
+
+  // Started in asynchronous mode
+  if (message->record.kind == ConsoleRecord::MESSAGE)
+  {
+    message->Output();
+    return 0;
+  }
+
+  std::string text;
+  text.swap(message->record.text);
+  if (text.empty())
+    return 0;
+
   // Log messages to disk
-  Console::log << this->str();
+  Console::log << text;
   Console::log.flush();
 
   // Output to terminal
@@ -119,22 +1262,21 @@ int Logger::Buffer::sync()
     if (this->type == Logger::STDOUT)
     {
       #ifndef _WIN32
-      std::cout << "\033[1;" << this->color << "m" << this->str() << "\033[0m";
+      std::cout << "\033[1;" << this->color << "m" << text << "\033[0m";
       #else
-      std::cout << this->str();
+      std::cout << text;
       #endif
     }
     else
     {
       #ifndef _WIN32
-      std::cerr << "\033[1;" << this->color << "m" << this->str() << "\033[0m";
+      std::cerr << "\033[1;" << this->color << "m" << text << "\033[0m";
       #else
-      std::cerr << this->str();
+      std::cerr << text;
       #endif
     }
   }
 
-  this->str("");
   return 0;
 }
 
@@ -180,6 +1322,11 @@ void FileLogger::Init(const std::string &_prefix, const std::string &_filename)
 
   logPath /= _filename;
 
+  // Write the queued messages to the current file, and keep the
+  // background writer out of the stream while it is opened.
+  Console::Flush();
+  std::lock_guard<std::mutex> lock(g_outputMutex);
+
   // Check if the Init method has been already called, and if so
   // remove current buffer.
   if (buf->stream && buf->stream->is_open())
@@ -226,6 +1373,9 @@ void FileLogger::Init(const std::string &_prefix, const std::string &_filename)
 /////////////////////////////////////////////////
 FileLogger &FileLogger::operator()()
 {
+  if (StartMessage(this->rdbuf(), ConsoleRecord(), false))
+    return (*this);
+
   (*this) << "(" << Time::GetWallTime() << ") ";
   return (*this);
 }
@@ -234,6 +1384,19 @@ FileLogger &FileLogger::operator()()
 FileLogger &FileLogger::operator()(const std::string &_file, int _line)
 {
   int index = _file.find_last_of("/") + 1;
+
+  if (Console::Async())
+  {
+    std::stringstream location;
+    location << "[" << _file.substr(index , _file.size() - index) << ":"
+      << _line << "]";
+
+    ConsoleRecord header;
+    header.header = location.str();
+    if (StartMessage(this->rdbuf(), std::move(header), false))
+      return (*this);
+  }
+
   (*this) << "(" << Time::GetWallTime() << ") ["
     << _file.substr(index , _file.size() - index) << ":" << _line << "]";
 
@@ -267,6 +1430,10 @@ std::string FileLogger::GetLogDirectory() const
 FileLogger::Buffer::Buffer(const std::string &_filename)
   : stream(nullptr)
 {
+  // Every write goes through xsputn or overflow, into the message of the
+  // calling thread
+  this->setp(nullptr, nullptr);
+
   if (!_filename.empty())
   {
     this->stream = new std::ofstream(_filename.c_str(), std::ios::out);
@@ -288,16 +1455,68 @@ FileLogger::Buffer::~Buffer()
   }
 }
 
+/////////////////////////////////////////////////
+FileLogger::Buffer::int_type FileLogger::Buffer::overflow(int_type _c)
+{
+  if (traits_type::eq_int_type(_c, traits_type::eof()))
+    return traits_type::not_eof(_c);
+
+  const char c = traits_type::to_char_type(_c);
+  this->xsputn(&c, 1);
+  return _c;
+}
+
+/////////////////////////////////////////////////
+std::streamsize FileLogger::Buffer::xsputn(const char *_s,
+    std::streamsize _n)
+{
+  PendingMessage *message = ThreadMessages::Find(this, 0, 0);
+  if (message)
+  {
+    message->record.text.append(_s, static_cast<size_t>(_n));
+    return _n;
+  }
+
+  // The thread is exiting, output the text now
+  ConsoleRecord record;
+  record.text.assign(_s, static_cast<size_t>(_n));
+  ConsoleWriter::Output(std::move(record));
+  return _n;
+}
+
 /////////////////////////////////////////////////
 int FileLogger::Buffer::sync()
 {
+  PendingMessage *message = ThreadMessages::Find(this, 0, 0);
+  if (!message)
+    return 0;
+
+  // A message is queued whole, once it ends with a new line
+  if (Console::Async() && ConsoleWriter::Get())
+  {
+    const std::string &text = message->record.text;
+    if (!text.empty() && text.back() == '\n')
+      ConsoleWriter::Output(message->Take());
+    return 0;
+  }
+
+  // Started in asynchronous mode
+  if (message->record.kind == ConsoleRecord::MESSAGE)
+  {
+    message->Output();
+    return 0;
+  }
+
+  std::string text;
+  text.swap(message->record.text);
+
+  std::lock_guard<std::mutex> lock(g_outputMutex);
   if (!this->stream)
     return -1;
 
-  *this->stream << this->str();
+  *this->stream << text;
 
   this->stream->flush();
 
-  this->str("");
   return !(*this->stream);
 }
@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_CONSOLE_HH_
 #define _GAZEBO_CONSOLE_HH_
 
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -34,6 +35,9 @@ namespace gazebo
 {
   namespace common
   {
+    // Forward declare the background writer of the asynchronous mode.
+    class ConsoleWriter;
+
     /// \addtogroup gazebo_common Common
     /// \{
 
@@ -122,6 +126,20 @@ namespace gazebo
                    /// \return Return 0 on success.
                    public: virtual int sync();
 
+                   /// \brief Append a character to the message of the
+                   /// calling thread.
+                   /// \param[in] _c The character.
+                   /// \return _c.
+                   protected: virtual int_type overflow(int_type _c);
+
+                   /// \brief Append characters to the message of the
+                   /// calling thread.
+                   /// \param[in] _s The characters.
+                   /// \param[in] _n Number of characters.
+                   /// \return _n.
+                   protected: virtual std::streamsize xsputn(const char *_s,
+                                  std::streamsize _n);
+
                    /// \brief Stream to output information into.
                    public: std::ofstream *stream;
                  };
@@ -129,6 +147,9 @@ namespace gazebo
       /// \brief Stores the full path of the directory where all the log files
       /// are stored.
       private: std::string logDirectory;
+
+      /// \brief The background writer outputs into the log file.
+      private: friend class ConsoleWriter;
     };
 
     /// \class Logger Logger.hh common/common.hh
@@ -166,6 +187,15 @@ namespace gazebo
       public: virtual Logger &operator()(
                   const std::string &_file, int _line);
 
+      /// \brief Output a filename and line number, then return a reference
+      /// to the logger. This is the overload used by gzdbg, gzwarn and
+      /// gzerr. In asynchronous mode, the file name is formatted by the
+      /// background writer, so it must stay valid, like __FILE__ does.
+      /// \param[in] _file Filename to output.
+      /// \param[in] _line Line number in the _file.
+      /// \return Reference to this logger.
+      public: Logger &operator()(const char *_file, int _line);
+
       /// \brief String buffer for the base logger.
       protected: class Buffer : public std::stringbuf
                  {
@@ -183,6 +213,20 @@ namespace gazebo
                    /// \return Return 0 on success.
                    public: virtual int sync();
 
+                   /// \brief Append a character to the message of the
+                   /// calling thread.
+                   /// \param[in] _c The character.
+                   /// \return _c.
+                   protected: virtual int_type overflow(int_type _c);
+
+                   /// \brief Append characters to the message of the
+                   /// calling thread.
+                   /// \param[in] _s The characters.
+                   /// \param[in] _n Number of characters.
+                   /// \return _n.
+                   protected: virtual std::streamsize xsputn(const char *_s,
+                                  std::streamsize _n);
+
                    /// \brief Destination type for the messages.
                    public: LogType type;
 
@@ -197,6 +241,9 @@ namespace gazebo
 
       /// \brief Prefix to use when logging to file.
       private: std::string prefix;
+
+      /// \brief The background writer formats the prefix.
+      private: friend class ConsoleWriter;
     };
 
     /// \class Console Console.hh common/common.hh
@@ -212,6 +259,56 @@ namespace gazebo
       /// \return True to if quiet output is set.
       public: static bool GetQuiet();
 
+      /// \brief Set asynchronous output. In asynchronous mode, each thread
+      /// collects its messages until they end with a new line, and queues
+      /// them whole. A background thread formats and writes them to the
+      /// terminal and the log file. Logging never blocks the caller: if the
+      /// queue is full, the message is dropped and counted. Asynchronous
+      /// mode is also enabled by setting the GAZEBO_LOG_ASYNC environment
+      /// variable to 1.
+      /// \param[in] _async True to enable asynchronous output.
+      public: static void SetAsync(const bool _async);
+
+      /// \brief Get whether asynchronous output is set.
+      /// \return True if asynchronous output is set.
+      public: static bool Async();
+
+      /// \brief Output the unfinished messages of the calling thread, and
+      /// wait until the background thread has written all the messages
+      /// queued so far.
+      public: static void Flush();
+
+      /// \brief Get the number of messages dropped because the queue of
+      /// the asynchronous mode was full.
+      /// \return Number of dropped messages.
+      public: static uint64_t DroppedMessages();
+
+      /// \brief Limit the number of messages output by each gzdbg, gzwarn
+      /// and gzerr call site. Messages over the limit are dropped, and the
+      /// next message of the call site tells how many were suppressed. The
+      /// limit can also be set in messages per second with the
+      /// GAZEBO_LOG_RATE_LIMIT environment variable.
+      /// \param[in] _count Number of messages per period, 0 to disable
+      /// the limit.
+      /// \param[in] _period Period in seconds.
+      public: static void SetRateLimit(const unsigned int _count,
+                  const double _period = 1.0);
+
+      /// \brief Write the log file messages to a compact binary file as
+      /// well, which stores the timestamps and file names as numbers. The
+      /// binary file is written by the background thread, so this enables
+      /// asynchronous output.
+      /// \param[in] _filename Path of the binary file, empty to close it.
+      /// \return True if the file was opened.
+      public: static bool SetBinaryLog(const std::string &_filename);
+
+      /// \brief Convert a binary log file into the text of the log file.
+      /// \param[in] _filename Path of the binary file.
+      /// \param[out] _out Stream to output the text into.
+      /// \return True if the whole file was converted.
+      public: static bool DecodeBinaryLog(const std::string &_filename,
+                  std::ostream &_out);
+
       /// \brief Global instance of the message logger.
       public: static Logger msg;
 
@@ -18,6 +18,10 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 #include <stdlib.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Console.hh"
@@ -274,6 +278,170 @@ TEST_F(Console_TEST, ColorErr)
   EXPECT_TRUE(logContent.find(logString) != std::string::npos);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test Console::SetAsync
+TEST_F(Console_TEST, Async)
+{
+  common::Console::SetAsync(true);
+  EXPECT_TRUE(common::Console::Async());
+
+  for (int i = 0; i < 10; ++i)
+  {
+    gzerr << "async error " << i << std::endl;
+    gzlog << "async log " << i << std::endl;
+  }
+  common::Console::Flush();
+
+  std::string logContent = this->GetLogContent();
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_NE(logContent.find("async error " + std::to_string(i)),
+        std::string::npos);
+    EXPECT_NE(logContent.find("async log " + std::to_string(i)),
+        std::string::npos);
+  }
+  EXPECT_NE(logContent.find("[Err] [Console_TEST.cc:"), std::string::npos);
+
+  common::Console::SetAsync(false);
+  EXPECT_FALSE(common::Console::Async());
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that the messages of concurrent threads are output whole in
+/// asynchronous mode.
+TEST_F(Console_TEST, AsyncThreads)
+{
+  common::Console::SetAsync(true);
+
+  const int threadCount = 4;
+  const int messageCount = 50;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.push_back(std::thread([t]()
+        {
+          for (int i = 0; i < messageCount; ++i)
+          {
+            gzwarn << "thread " << t << " message " << i << " part "
+                   << "two\n";
+          }
+        }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // An unfinished message is output by Flush
+  gzerr << "unfinished";
+  common::Console::Flush();
+
+  std::string logContent = this->GetLogContent();
+  const uint64_t dropped = common::Console::DroppedMessages();
+  int found = 0;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    for (int i = 0; i < messageCount; ++i)
+    {
+      std::ostringstream stream;
+      stream << "] thread " << t << " message " << i << " part two(";
+      if (logContent.find(stream.str()) != std::string::npos)
+        ++found;
+    }
+  }
+  EXPECT_EQ(threadCount * messageCount, found + static_cast<int>(dropped));
+  EXPECT_NE(logContent.find("unfinished"), std::string::npos);
+
+  common::Console::SetAsync(false);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that Console::DroppedMessages counts messages, not the
+/// pieces of text they are made of.
+TEST_F(Console_TEST, AsyncDropped)
+{
+  common::Console::SetAsync(true);
+  common::Console::Flush();
+  const uint64_t droppedBefore = common::Console::DroppedMessages();
+
+  // More messages than the queue holds
+  const int messageCount = 20000;
+  for (int i = 0; i < messageCount; ++i)
+    gzlog << "flood " << i << " " << "of " << messageCount << std::endl;
+  common::Console::Flush();
+
+  const uint64_t dropped =
+      common::Console::DroppedMessages() - droppedBefore;
+  std::string logContent = this->GetLogContent();
+  int written = 0;
+  for (size_t pos = logContent.find("flood "); pos != std::string::npos;
+       pos = logContent.find("flood ", pos + 1))
+  {
+    ++written;
+  }
+  EXPECT_EQ(messageCount, written + static_cast<int>(dropped));
+
+  common::Console::SetAsync(false);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test Console::SetRateLimit
+TEST_F(Console_TEST, RateLimit)
+{
+  common::Console::SetRateLimit(1, 0.5);
+
+  for (int i = 0; i < 6; ++i)
+  {
+    if (i == 3)
+      common::Time::MSleep(600);
+    gzwarn << "rate limited " << i << std::endl;
+  }
+
+  common::Console::SetRateLimit(0);
+
+  std::string logContent = this->GetLogContent();
+  EXPECT_NE(logContent.find("rate limited 0"), std::string::npos);
+  EXPECT_EQ(logContent.find("rate limited 1"), std::string::npos);
+  EXPECT_EQ(logContent.find("rate limited 2"), std::string::npos);
+  EXPECT_NE(logContent.find("(2 similar messages suppressed) rate limited 3"),
+      std::string::npos);
+  EXPECT_EQ(logContent.find("rate limited 4"), std::string::npos);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test Console::SetBinaryLog
+TEST_F(Console_TEST, BinaryLog)
+{
+  boost::filesystem::path binaryPath(gzLogDirectory());
+  binaryPath /= "binary.log";
+
+  EXPECT_TRUE(common::Console::SetBinaryLog(binaryPath.string()));
+  EXPECT_TRUE(common::Console::Async());
+
+  gzmsg << "binary message" << std::endl;
+  gzerr << "binary error" << std::endl;
+  gzlog << "binary log" << std::endl;
+
+  EXPECT_FALSE(common::Console::SetBinaryLog(""));
+  common::Console::SetAsync(false);
+
+  std::stringstream decoded;
+  EXPECT_TRUE(common::Console::DecodeBinaryLog(binaryPath.string(), decoded));
+
+  std::string text = decoded.str();
+  EXPECT_NE(text.find("[Msg] binary message\n"), std::string::npos);
+  EXPECT_NE(text.find("[Err] [Console_TEST.cc:"), std::string::npos);
+  EXPECT_NE(text.find("binary error\n"), std::string::npos);
+  EXPECT_NE(text.find(") binary log\n"), std::string::npos);
+
+  // The text log holds the same messages
+  std::string logContent = this->GetLogContent();
+  EXPECT_NE(logContent.find("[Msg] binary message"), std::string::npos);
+
+  // Not a binary log
+  std::stringstream invalid;
+  EXPECT_FALSE(common::Console::DecodeBinaryLog(this->GetFullLogPath(),
+      invalid));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
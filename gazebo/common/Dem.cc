@@ -16,6 +16,7 @@
 */
 
 #include <algorithm>
+#include <cmath>
 #include <boost/filesystem.hpp>
 #include <gazebo/gazebo_config.h>
 
@@ -38,6 +39,77 @@ using namespace common;
 
 #ifdef HAVE_GDAL
 
+namespace
+{
+  /// \brief Read a window of the DEM's samples, padded to the terrain's
+  /// side. The samples are copied from the DEM data if it is loaded, and
+  /// read from the file otherwise, so only the window is in memory.
+  /// \param[in] _dem The DEM.
+  /// \param[in] _x First column of the window.
+  /// \param[in] _y First row of the window.
+  /// \param[in] _width Number of columns of the window.
+  /// \param[in] _height Number of rows of the window.
+  /// \param[out] _samples Samples of the window, row by row.
+  /// \return 0 when the operation succeeds.
+  int ReadSamples(const DemPrivate &_dem, const unsigned int _x,
+      const unsigned int _y, const unsigned int _width,
+      const unsigned int _height, std::vector<float> &_samples)
+  {
+    // Points outside the scaled raster are padding
+    _samples.assign(static_cast<size_t>(_width) * _height, 0.0f);
+
+    if (!_dem.demData.empty())
+    {
+      for (unsigned int y = 0; y < _height; ++y)
+      {
+        auto row = _dem.demData.begin() +
+            static_cast<size_t>(_y + y) * _dem.side + _x;
+        std::copy(row, row + _width,
+            _samples.begin() + static_cast<size_t>(y) * _width);
+      }
+      return 0;
+    }
+
+    const unsigned int endX = std::min(_x + _width, _dem.destWidth);
+    const unsigned int endY = std::min(_y + _height, _dem.destHeight);
+    if (_x >= endX || _y >= endY)
+      return 0;
+
+    // Read the part of the raster that is scaled to the window. The window
+    // is given in raster pixels with a fractional part, so the samples are
+    // picked as if the whole raster was read.
+    const int nXSize = _dem.dataSet->GetRasterXSize();
+    const int nYSize = _dem.dataSet->GetRasterYSize();
+    const double ratioX = nXSize / static_cast<double>(_dem.destWidth);
+    const double ratioY = nYSize / static_cast<double>(_dem.destHeight);
+
+    GDALRasterIOExtraArg extraArg;
+    INIT_RASTERIO_EXTRA_ARG(extraArg);
+    extraArg.bFloatingPointWindowValidity = TRUE;
+    extraArg.dfXOff = _x * ratioX;
+    extraArg.dfYOff = _y * ratioY;
+    extraArg.dfXSize = (endX - _x) * ratioX;
+    extraArg.dfYSize = (endY - _y) * ratioY;
+
+    const int xOff = static_cast<int>(std::floor(extraArg.dfXOff));
+    const int yOff = static_cast<int>(std::floor(extraArg.dfYOff));
+    const int xEnd = std::min(nXSize, static_cast<int>(
+        std::ceil(extraArg.dfXOff + extraArg.dfXSize)));
+    const int yEnd = std::min(nYSize, static_cast<int>(
+        std::ceil(extraArg.dfYOff + extraArg.dfYSize)));
+
+    if (_dem.band->RasterIO(GF_Read, xOff, yOff, xEnd - xOff, yEnd - yOff,
+        &_samples[0], endX - _x, endY - _y, GDT_Float32, sizeof(float),
+        sizeof(float) * static_cast<GSpacing>(_width), &extraArg) != CE_None)
+    {
+      gzerr << "Failure calling RasterIO while reading a DEM file\n";
+      return -1;
+    }
+
+    return 0;
+  }
+}
+
 //////////////////////////////////////////////////
 Dem::Dem()
   : dataPtr(new DemPrivate)
@@ -139,9 +211,31 @@ int Dem::Load(const std::string &_filename)
 
   this->dataPtr->side = std::max(width, height);
 
-  // Preload the DEM's data
-  if (this->LoadData() != 0)
+  if (xSize <= 0 || ySize <= 0)
+  {
+    gzerr << "Illegal size loading a DEM file (" << xSize << ","
+          << ySize << ")\n";
     return -1;
+  }
+
+  // Scale the terrain keeping the same ratio between width and height
+  float ratio;
+  if (xSize > ySize)
+  {
+    ratio = static_cast<float>(xSize) / static_cast<float>(ySize);
+    this->dataPtr->destWidth = this->dataPtr->side;
+    // The decimal part is discarted for interpret the result as pixels
+    this->dataPtr->destHeight = static_cast<float>(this->dataPtr->destWidth) /
+        static_cast<float>(ratio);
+  }
+  else
+  {
+    ratio = static_cast<float>(ySize) / static_cast<float>(xSize);
+    this->dataPtr->destHeight = this->dataPtr->side;
+    // The decimal part is discarted for interpret the result as pixels
+    this->dataPtr->destWidth = static_cast<float>(this->dataPtr->destHeight) /
+        static_cast<float>(ratio);
+  }
 
   // Check for nodata value in dem data. This is used when computing the
   // min elevation. If nodata value is not defined, we assume it will be one
@@ -154,14 +248,28 @@ int Dem::Load(const std::string &_filename)
   if (validNoData <= 0)
     noDataValue = defaultNoDataValue;
 
+  // The DEM's data is not preloaded, read it in strips of rows to find
+  // the extremes
+  const unsigned int side = this->dataPtr->side;
+  const unsigned int stripRows = std::max(1u, (1u << 22) / side);
+  std::vector<float> strip;
   double min = ignition::math::MAX_D;
   double max = -ignition::math::MAX_D;
-  for (auto d : this->dataPtr->demData)
+  for (unsigned int y = 0; y < side; y += stripRows)
   {
-    if (d < min && d > noDataValue)
-      min = d;
-    if (d > max && d > noDataValue)
-      max = d;
+    if (ReadSamples(*this->dataPtr, 0, y, side, std::min(stripRows, side - y),
+        strip) != 0)
+    {
+      return -1;
+    }
+
+    for (auto d : strip)
+    {
+      if (d < min && d > noDataValue)
+        min = d;
+      if (d > max && d > noDataValue)
+        max = d;
+    }
   }
   if (ignition::math::equal(min, ignition::math::MAX_D) ||
       ignition::math::equal(max, -ignition::math::MAX_D))
@@ -183,6 +291,9 @@ double Dem::GetElevation(double _x, double _y)
            " x " << this->GetHeight() << "]\n");
   }
 
+  if (this->dataPtr->demData.empty() && this->LoadData() != 0)
+    return 0.0;
+
   return this->dataPtr->demData.at(_y * this->GetWidth() + _x);
 }
 
@@ -265,6 +376,21 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     const ignition::math::Vector3d &_size,
     const ignition::math::Vector3d &_scale,
     bool _flipY, std::vector<float> &_heights)
+{
+  // The whole terrain is read, keep it for the following fills
+  if (this->dataPtr->demData.empty() && this->LoadData() != 0)
+    return;
+
+  this->FillHeightMapWindow(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, _heights);
+}
+
+//////////////////////////////////////////////////
+void Dem::FillHeightMapWindow(int _subSampling, unsigned int _vertSize,
+    const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, std::vector<float> &_heights)
 {
   if (_subSampling <= 0)
   {
@@ -272,34 +398,71 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
     return;
   }
 
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  // Resize the vector to match the size of the window.
+  _heights.resize(static_cast<size_t>(_width) * _height);
+  if (_width == 0 || _height == 0)
+    return;
+
+  const unsigned int side = this->dataPtr->side;
+
+  // Vertex rows and columns the window is sampled from
+  unsigned int firstY = _y;
+  unsigned int lastY = _y + _height - 1;
+  if (_flipY)
+  {
+    firstY = _vertSize - lastY - 1;
+    lastY = _vertSize - _y - 1;
+  }
+  const unsigned int firstX = _x;
+  const unsigned int lastX = _x + _width - 1;
+
+  // Read the samples around the window only
+  const unsigned int sampleX = std::min(firstX / _subSampling, side - 1);
+  const unsigned int sampleY = std::min(firstY / _subSampling, side - 1);
+  const unsigned int sampleWidth = std::min<unsigned int>(
+      std::ceil(lastX / static_cast<double>(_subSampling)), side - 1) -
+      sampleX + 1;
+  const unsigned int sampleHeight = std::min<unsigned int>(
+      std::ceil(lastY / static_cast<double>(_subSampling)), side - 1) -
+      sampleY + 1;
+  std::vector<float> samples;
+  if (ReadSamples(*this->dataPtr, sampleX, sampleY, sampleWidth,
+      sampleHeight, samples) != 0)
+  {
+    return;
+  }
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // Iterate over the rows of the window
+  for (unsigned int row = 0; row < _height; ++row)
   {
+    // Vertex row the window row is sampled from
+    unsigned int y = _y + row;
+    if (_flipY)
+      y = _vertSize - y - 1;
+
     double yf = y / static_cast<double>(_subSampling);
     unsigned int y1 = floor(yf);
     unsigned int y2 = ceil(yf);
-    if (y2 >= this->dataPtr->side)
-      y2 = this->dataPtr->side - 1;
+    if (y2 >= side)
+      y2 = side - 1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int col = 0; col < _width; ++col)
     {
+      unsigned int x = _x + col;
       double xf = x / static_cast<double>(_subSampling);
       unsigned int x1 = floor(xf);
       unsigned int x2 = ceil(xf);
-      if (x2 >= this->dataPtr->side)
-        x2 = this->dataPtr->side - 1;
+      if (x2 >= side)
+        x2 = side - 1;
       double dx = xf - x1;
 
-      double px1 = this->dataPtr->demData[y1 * this->dataPtr->side + x1];
-      double px2 = this->dataPtr->demData[y1 * this->dataPtr->side + x2];
+      double px1 = samples[(y1 - sampleY) * sampleWidth + x1 - sampleX];
+      double px2 = samples[(y1 - sampleY) * sampleWidth + x2 - sampleX];
       float h1 = (px1 - ((px1 - px2) * dx));
 
-      double px3 = this->dataPtr->demData[y2 * this->dataPtr->side + x1];
-      double px4 = this->dataPtr->demData[y2 * this->dataPtr->side + x2];
+      double px3 = samples[(y2 - sampleY) * sampleWidth + x1 - sampleX];
+      double px4 = samples[(y2 - sampleY) * sampleWidth + x2 - sampleX];
       float h2 = (px3 - ((px3 - px4) * dx));
 
       float h = this->dataPtr->minElevation +
@@ -316,10 +479,7 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
         h = this->dataPtr->minElevation;
 
       // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      _heights[static_cast<size_t>(row) * _width + col] = h;
     }
   }
 }
@@ -327,58 +487,18 @@ void Dem::FillHeightMap(int _subSampling, unsigned int _vertSize,
 //////////////////////////////////////////////////
 int Dem::LoadData()
 {
-    unsigned int destWidth;
-    unsigned int destHeight;
-    unsigned int nXSize = this->dataPtr->dataSet->GetRasterXSize();
-    unsigned int nYSize = this->dataPtr->dataSet->GetRasterYSize();
-    float ratio;
-    std::vector<float> buffer;
-
-    if (nXSize == 0 || nYSize == 0)
-    {
-      gzerr << "Illegal size loading a DEM file (" << nXSize << ","
-            << nYSize << ")\n";
-      return -1;
-    }
-
-    // Scale the terrain keeping the same ratio between width and height
-    if (nXSize > nYSize)
-    {
-      ratio = static_cast<float>(nXSize) / static_cast<float>(nYSize);
-      destWidth = this->dataPtr->side;
-      // The decimal part is discarted for interpret the result as pixels
-      destHeight = static_cast<float>(destWidth) / static_cast<float>(ratio);
-    }
-    else
-    {
-      ratio = static_cast<float>(nYSize) / static_cast<float>(nXSize);
-      destHeight = this->dataPtr->side;
-      // The decimal part is discarted for interpret the result as pixels
-      destWidth = static_cast<float>(destHeight) / static_cast<float>(ratio);
-    }
-
-    // Read the whole raster data and convert it to a GDT_Float32 array.
-    // In this step the DEM is scaled to destWidth x destHeight
-    buffer.resize(destWidth * destHeight);
-    if (this->dataPtr->band->RasterIO(GF_Read, 0, 0, nXSize, nYSize, &buffer[0],
-                         destWidth, destHeight, GDT_Float32, 0, 0) != CE_None)
-    {
-      gzerr << "Failure calling RasterIO while loading a DEM file\n";
-      return -1;
-    }
-
-    // Copy and align 'buffer' into the target vector. The destination vector is
-    // initialized to 0, so all the points not contained in 'buffer' will be
-    // extra padding
-    this->dataPtr->demData.resize(this->GetWidth() * this->GetHeight());
-    for (unsigned int y = 0; y < destHeight; ++y)
-    {
-        std::copy(&buffer[destWidth * y], &buffer[destWidth * y] + destWidth,
-                  this->dataPtr->demData.begin() + this->GetWidth() * y);
-    }
-    buffer.clear();
+  // Read the whole raster data and convert it to a GDT_Float32 array.
+  // In this step the DEM is scaled to destWidth x destHeight, and all the
+  // points not contained in the raster are extra padding.
+  std::vector<float> data;
+  if (ReadSamples(*this->dataPtr, 0, 0, this->GetWidth(), this->GetHeight(),
+      data) != 0)
+  {
+    return -1;
+  }
+  this->dataPtr->demData.swap(data);
 
-    return 0;
+  return 0;
 }
 
 #endif
@@ -118,6 +118,17 @@ namespace gazebo
                   const bool _flipY,
                   std::vector<float> &_heights);
 
+      /// \brief Fill a window of the lookup table of the terrain's height.
+      /// Only the DEM samples around the window are read from the file, so
+      /// the whole raster is not loaded.
+      /// \sa HeightmapData::FillHeightMapWindow
+      public: void FillHeightMapWindow(int _subSampling,
+                  unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale, bool _flipY,
+                  unsigned int _x, unsigned int _y, unsigned int _width,
+                  unsigned int _height, std::vector<float> &_heights);
+
       /// \brief Get the georeferenced coordinates (lat, long) of a terrain's
       /// pixel in WGS84.
       /// \param[in] _x X coordinate of the terrain.
@@ -51,13 +51,21 @@ namespace gazebo
       /// \brief Terrain's side (after the padding).
       public: unsigned int side;
 
+      /// \brief Width of the raster after scaling it to the terrain's side.
+      public: unsigned int destWidth;
+
+      /// \brief Height of the raster after scaling it to the terrain's side.
+      public: unsigned int destHeight;
+
       /// \brief Minimum elevation in meters.
       public: double minElevation;
 
       /// \brief Maximum elevation in meters.
       public: double maxElevation;
 
-      /// \brief DEM data converted to be OGRE-compatible.
+      /// \brief DEM data converted to be OGRE-compatible. Loaded by the
+      /// first call that needs the whole terrain, windows are read from the
+      /// file until then.
       public: std::vector<float> demData;
     };
     /// \}
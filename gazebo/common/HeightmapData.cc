@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <gazebo/gazebo_config.h>
 
 #ifdef HAVE_GDAL
@@ -34,6 +35,42 @@
 using namespace gazebo;
 using namespace common;
 
+//////////////////////////////////////////////////
+void HeightmapData::FillHeightMapWindow(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, std::vector<float> &_heights)
+{
+  // Data that can sample a window directly
+  if (auto image = dynamic_cast<ImageHeightmap *>(this))
+  {
+    image->FillHeightMapWindow(_subSampling, _vertSize, _size, _scale, _flipY,
+        _x, _y, _width, _height, _heights);
+    return;
+  }
+#ifdef HAVE_GDAL
+  if (auto dem = dynamic_cast<Dem *>(this))
+  {
+    dem->FillHeightMapWindow(_subSampling, _vertSize, _size, _scale, _flipY,
+        _x, _y, _width, _height, _heights);
+    return;
+  }
+#endif
+
+  // Fall back to filling the whole table
+  std::vector<float> all;
+  this->FillHeightMap(_subSampling, _vertSize, _size, _scale, _flipY, all);
+
+  _heights.resize(static_cast<size_t>(_width) * _height);
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    auto row = all.begin() + static_cast<size_t>(_y + y) * _vertSize + _x;
+    std::copy(row, row + _width,
+        _heights.begin() + static_cast<size_t>(y) * _width);
+  }
+}
+
 //////////////////////////////////////////////////
 HeightmapData *HeightmapDataLoader::LoadImageAsTerrain(
     const std::string &_filename)
@@ -56,6 +56,30 @@ namespace gazebo
           const ignition::math::Vector3d &_scale, bool _flipY,
           std::vector<float> &_heights) = 0;
 
+      /// \brief Fill a window of the lookup table of the terrain's height.
+      /// The window holds the values that FillHeightMap stores at columns
+      /// [_x, _x + _width) and rows [_y, _y + _height), row by row. Dem and
+      /// ImageHeightmap compute the window directly, so large terrains can
+      /// be filled piece by piece. Other data fill the whole table and copy
+      /// the window out of it.
+      /// \param[in] _subsampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the whole table.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY If true, it inverts the order in which the vector
+      /// is filled.
+      /// \param[in] _x First column of the window.
+      /// \param[in] _y First row of the window.
+      /// \param[in] _width Number of columns of the window.
+      /// \param[in] _height Number of rows of the window.
+      /// \param[out] _heights Vector containing the window's heights.
+      /// \sa FillHeightMap
+      public: void FillHeightMapWindow(int _subSampling,
+          unsigned int _vertSize, const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y, unsigned int _width,
+          unsigned int _height, std::vector<float> &_heights);
+
       /// \brief Get the terrain's height.
       /// \return The terrain's height.
       public: virtual unsigned int GetHeight() const = 0;
@@ -20,8 +20,19 @@
  */
 
 #include <FreeImage.h>
-#include <boost/filesystem.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <ignition/math/Helpers.hh>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/CommonIface.hh"
@@ -31,6 +42,348 @@
 using namespace gazebo;
 using namespace common;
 
+namespace
+{
+  /// \brief Channel offsets of an 8 bit per channel pixel format. Luminance
+  /// uses the same offset for the three colors, and -1 is a missing alpha.
+  template<int N, int R, int G, int B, int A>
+  struct Channels
+  {
+    static const int n = N;
+    static const int r = R;
+    static const int g = G;
+    static const int b = B;
+    static const int a = A;
+  };
+
+  typedef Channels<1, 0, 0, 0, -1> ChannelsL;
+  typedef Channels<3, 0, 1, 2, -1> ChannelsRGB;
+  typedef Channels<4, 0, 1, 2, 3> ChannelsRGBA;
+  typedef Channels<3, 2, 1, 0, -1> ChannelsBGR;
+  typedef Channels<4, 2, 1, 0, 3> ChannelsBGRA;
+
+  /// \brief Get the alpha of a pixel.
+  /// \param[in] _pixel The pixel.
+  /// \return The alpha byte, at offset A.
+  template<int A>
+  unsigned char AlphaOf(const unsigned char *_pixel)
+  {
+    return _pixel[A];
+  }
+
+  /// \brief Get the alpha of a pixel without an alpha channel.
+  /// \return Opaque alpha.
+  template<>
+  unsigned char AlphaOf<-1>(const unsigned char *)
+  {
+    return 255;
+  }
+
+  /// \brief Pixel conversion kernel.
+  typedef void (*ConvertFn)(const unsigned char *, unsigned char *, size_t);
+
+  /// \brief Convert pixels from one channel layout to another. The layouts
+  /// are compile time constants, so the loop has a fixed stride and no
+  /// branches, which lets the compiler vectorize it.
+  /// \param[in] _src Source pixels.
+  /// \param[out] _dst Destination pixels.
+  /// \param[in] _count Number of pixels.
+  template<typename Src, typename Dst>
+  void ConvertKernel(const unsigned char *_src, unsigned char *_dst,
+      const size_t _count)
+  {
+    for (size_t i = 0; i < _count; ++i)
+    {
+      const unsigned char *s = _src + i * Src::n;
+      unsigned char *d = _dst + i * Dst::n;
+      if (Dst::n == 1)
+      {
+        // Rec. 601 luma, with weights summing to 256
+        d[0] = static_cast<unsigned char>(
+            (77u * s[Src::r] + 150u * s[Src::g] + 29u * s[Src::b] + 128u) >>
+            8);
+      }
+      else
+      {
+        d[Dst::r] = s[Src::r];
+        d[Dst::g] = s[Src::g];
+        d[Dst::b] = s[Src::b];
+        if (Dst::a >= 0)
+          d[Dst::a] = AlphaOf<Src::a>(s);
+      }
+    }
+  }
+
+  /// \brief Get the kernel converting from a layout to a pixel format.
+  /// \param[in] _dst Destination pixel format.
+  /// \return The kernel, or nullptr if the format is not supported.
+  template<typename Src>
+  ConvertFn ConvertTo(const Image::PixelFormat _dst)
+  {
+    switch (_dst)
+    {
+      case Image::L_INT8:
+        return &ConvertKernel<Src, ChannelsL>;
+      case Image::RGB_INT8:
+        return &ConvertKernel<Src, ChannelsRGB>;
+      case Image::RGBA_INT8:
+        return &ConvertKernel<Src, ChannelsRGBA>;
+      case Image::BGR_INT8:
+        return &ConvertKernel<Src, ChannelsBGR>;
+      case Image::BGRA_INT8:
+        return &ConvertKernel<Src, ChannelsBGRA>;
+      default:
+        return nullptr;
+    }
+  }
+
+  /// \brief Get the kernel converting between two pixel formats.
+  /// \param[in] _src Source pixel format.
+  /// \param[in] _dst Destination pixel format.
+  /// \return The kernel, or nullptr if a format is not supported.
+  ConvertFn ConvertFor(const Image::PixelFormat _src,
+      const Image::PixelFormat _dst)
+  {
+    switch (_src)
+    {
+      case Image::L_INT8:
+        return ConvertTo<ChannelsL>(_dst);
+      case Image::RGB_INT8:
+        return ConvertTo<ChannelsRGB>(_dst);
+      case Image::RGBA_INT8:
+        return ConvertTo<ChannelsRGBA>(_dst);
+      case Image::BGR_INT8:
+        return ConvertTo<ChannelsBGR>(_dst);
+      case Image::BGRA_INT8:
+        return ConvertTo<ChannelsBGRA>(_dst);
+      default:
+        return nullptr;
+    }
+  }
+
+  /// \brief Get the number of bytes per pixel of a bitmap whose pixels are
+  /// read directly from its scanlines, as FreeImage_GetPixelColor and
+  /// FreeImage_GetPixelIndex would read them.
+  /// \param[in] _bitmap The bitmap.
+  /// \return 1 for 8 bit indices, 3 or 4 for colors, 0 otherwise.
+  unsigned int PixelBytes(FIBITMAP *_bitmap)
+  {
+    if (FreeImage_GetImageType(_bitmap) != FIT_BITMAP)
+      return 0;
+
+    const unsigned int bpp = FreeImage_GetBPP(_bitmap);
+    const FREE_IMAGE_COLOR_TYPE type = FreeImage_GetColorType(_bitmap);
+    if (bpp == 8)
+      return 1;
+    if ((bpp == 24 || bpp == 32) && (type == FIC_RGB || type == FIC_RGBALPHA))
+      return bpp / 8;
+    return 0;
+  }
+
+  /// \brief Get the number of channels of a bitmap with 8 bits per channel
+  /// that is resampled or copied channel by channel.
+  /// \param[in] _bitmap The bitmap.
+  /// \return 1 for grayscale, 3 or 4 for colors, 0 otherwise.
+  unsigned int ChannelCount(FIBITMAP *_bitmap)
+  {
+    const unsigned int bytes = PixelBytes(_bitmap);
+    if (bytes == 1 && FreeImage_GetColorType(_bitmap) != FIC_MINISBLACK)
+      return 0;
+    return bytes;
+  }
+
+  /// \brief Get the color channel values of the bytes 0 to 255, as
+  /// ignition::math::Color::Set normalizes them.
+  /// \return The channel values.
+  const std::array<float, 256> &ChannelValues()
+  {
+    static const std::array<float, 256> values = []()
+    {
+      std::array<float, 256> result;
+      for (unsigned int i = 0; i < result.size(); ++i)
+      {
+        ignition::math::Color clr;
+        clr.Set(i, i, i);
+        result[i] = clr.R();
+      }
+      return result;
+    }();
+    return values;
+  }
+
+  /// \brief Weights of the source samples that make up each destination
+  /// sample, along one axis.
+  struct ResampleWeights
+  {
+    /// \brief First source sample of each destination sample.
+    std::vector<unsigned int> first;
+
+    /// \brief Weights of each destination sample, taps apart.
+    std::vector<float> weights;
+
+    /// \brief Maximum number of source samples of a destination sample.
+    unsigned int taps = 0;
+  };
+
+  /// \brief Lanczos filter with 3 lobes.
+  /// \param[in] _x Distance from the filter center.
+  /// \return Filter value.
+  double Lanczos3(const double _x)
+  {
+    if (std::fabs(_x) < 1e-9)
+      return 1.0;
+    if (std::fabs(_x) >= 3.0)
+      return 0.0;
+    const double px = IGN_PI * _x;
+    return 3.0 * std::sin(px) * std::sin(px / 3.0) / (px * px);
+  }
+
+  /// \brief Compute the resampling weights along one axis. The filter is
+  /// widened when downsampling, so every source sample contributes.
+  /// \param[in] _src Number of source samples.
+  /// \param[in] _dst Number of destination samples.
+  /// \return The weights.
+  ResampleWeights Weights(const unsigned int _src, const unsigned int _dst)
+  {
+    const double scale = static_cast<double>(_dst) / _src;
+    const double filterScale = std::min(1.0, scale);
+    const double radius = 3.0 / filterScale;
+
+    ResampleWeights result;
+    result.taps = static_cast<unsigned int>(std::ceil(radius * 2.0)) + 1;
+    result.first.resize(_dst);
+    result.weights.assign(static_cast<size_t>(_dst) * result.taps, 0.0f);
+
+    std::vector<double> weights(result.taps);
+    for (unsigned int i = 0; i < _dst; ++i)
+    {
+      const double center = (i + 0.5) / scale;
+      const int first = std::max(0,
+          static_cast<int>(std::floor(center - radius + 0.5)));
+      const int last = std::min(static_cast<int>(_src),
+          static_cast<int>(first + result.taps));
+
+      double total = 0.0;
+      for (int j = first; j < last; ++j)
+      {
+        weights[j - first] = Lanczos3((j + 0.5 - center) * filterScale);
+        total += weights[j - first];
+      }
+
+      result.first[i] = first;
+      float *dst = &result.weights[static_cast<size_t>(i) * result.taps];
+      for (int j = first; j < last; ++j)
+        dst[j - first] = static_cast<float>(weights[j - first] / total);
+    }
+    return result;
+  }
+
+  /// \brief Filter a row of pixels horizontally.
+  /// \param[in] _src Source row.
+  /// \param[in] _srcWidth Number of source pixels.
+  /// \param[in] _weights Horizontal weights.
+  /// \param[out] _dst Destination row, N channels per pixel.
+  /// \param[in] _width Number of destination pixels.
+  template<unsigned int N>
+  void FilterRow(const BYTE *_src, const unsigned int _srcWidth,
+      const ResampleWeights &_weights, float *_dst, const unsigned int _width)
+  {
+    for (unsigned int x = 0; x < _width; ++x)
+    {
+      const float *w = &_weights.weights[
+          static_cast<size_t>(x) * _weights.taps];
+      const BYTE *s = _src + _weights.first[x] * N;
+      const unsigned int taps = std::min(_weights.taps,
+          _srcWidth - _weights.first[x]);
+
+      float sums[N] = {};
+      for (unsigned int k = 0; k < taps; ++k, s += N)
+      {
+        for (unsigned int c = 0; c < N; ++c)
+          sums[c] += w[k] * s[c];
+      }
+      for (unsigned int c = 0; c < N; ++c)
+        _dst[x * N + c] = sums[c];
+    }
+  }
+
+  /// \brief Resample a bitmap with 8 bits per channel, in parallel. The
+  /// rows are filtered horizontally, and then the columns vertically.
+  /// \param[in] _src Source bitmap.
+  /// \param[in] _channels Number of channels of the source bitmap.
+  /// \param[in] _width Destination width.
+  /// \param[in] _height Destination height.
+  /// \return The destination bitmap, or nullptr if it can't be allocated.
+  FIBITMAP *Resample(FIBITMAP *_src, const unsigned int _channels,
+      const unsigned int _width, const unsigned int _height)
+  {
+    const unsigned int srcWidth = FreeImage_GetWidth(_src);
+    const unsigned int srcHeight = FreeImage_GetHeight(_src);
+
+    FIBITMAP *dst = FreeImage_Allocate(_width, _height,
+        FreeImage_GetBPP(_src), FreeImage_GetRedMask(_src),
+        FreeImage_GetGreenMask(_src), FreeImage_GetBlueMask(_src));
+    if (!dst)
+      return nullptr;
+
+    if (_channels == 1)
+    {
+      std::memcpy(FreeImage_GetPalette(dst), FreeImage_GetPalette(_src),
+          256 * sizeof(RGBQUAD));
+    }
+
+    const ResampleWeights horizontal = Weights(srcWidth, _width);
+    const ResampleWeights vertical = Weights(srcHeight, _height);
+    const size_t rowSize = static_cast<size_t>(_width) * _channels;
+    std::vector<float> rows(rowSize * srcHeight);
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, srcHeight),
+        [&](const tbb::blocked_range<unsigned int> &_r)
+    {
+      for (unsigned int y = _r.begin(); y != _r.end(); ++y)
+      {
+        const BYTE *src = FreeImage_GetScanLine(_src, y);
+        float *row = &rows[y * rowSize];
+        if (_channels == 1)
+          FilterRow<1>(src, srcWidth, horizontal, row, _width);
+        else if (_channels == 3)
+          FilterRow<3>(src, srcWidth, horizontal, row, _width);
+        else
+          FilterRow<4>(src, srcWidth, horizontal, row, _width);
+      }
+    });
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, _height),
+        [&](const tbb::blocked_range<unsigned int> &_r)
+    {
+      std::vector<float> sums(rowSize);
+      for (unsigned int y = _r.begin(); y != _r.end(); ++y)
+      {
+        std::fill(sums.begin(), sums.end(), 0.0f);
+        const float *w = &vertical.weights[
+            static_cast<size_t>(y) * vertical.taps];
+        const unsigned int taps = std::min(vertical.taps,
+            srcHeight - vertical.first[y]);
+        for (unsigned int k = 0; k < taps; ++k)
+        {
+          const float *row = &rows[(vertical.first[y] + k) * rowSize];
+          for (size_t i = 0; i < rowSize; ++i)
+            sums[i] += w[k] * row[i];
+        }
+
+        BYTE *out = FreeImage_GetScanLine(dst, y);
+        for (size_t i = 0; i < rowSize; ++i)
+        {
+          out[i] = static_cast<BYTE>(
+              std::min(255.0f, std::max(0.0f, sums[i] + 0.5f)));
+        }
+      }
+    });
+
+    return dst;
+  }
+}
+
 int Image::count = 0;
 
 //////////////////////////////////////////////////
@@ -176,9 +529,20 @@ int Image::GetPitch() const
 //////////////////////////////////////////////////
 void Image::GetRGBData(unsigned char **_data, unsigned int &_count) const
 {
-  FIBITMAP *tmp = FreeImage_ConvertTo24Bits(this->bitmap);
-  this->GetDataImpl(_data, _count, tmp);
-  FreeImage_Unload(tmp);
+  if (ChannelCount(this->bitmap) == 0)
+  {
+    FIBITMAP *tmp = FreeImage_ConvertTo24Bits(this->bitmap);
+    this->GetDataImpl(_data, _count, tmp);
+    FreeImage_Unload(tmp);
+    return;
+  }
+
+  if (*_data)
+    delete [] *_data;
+
+  _count = this->GetWidth() * this->GetHeight() * 3;
+  *_data = new unsigned char[_count];
+  this->CopyRGBData(*_data, _count);
 }
 
 //////////////////////////////////////////////////
@@ -187,6 +551,58 @@ void Image::GetData(unsigned char **_data, unsigned int &_count) const
   this->GetDataImpl(_data, _count, this->bitmap);
 }
 
+//////////////////////////////////////////////////
+unsigned int Image::DataSize() const
+{
+  if (!this->Valid())
+    return 0;
+
+  return FreeImage_GetLine(this->bitmap) * FreeImage_GetHeight(this->bitmap);
+}
+
+//////////////////////////////////////////////////
+bool Image::CopyData(unsigned char *_data, const unsigned int _size) const
+{
+  if (!this->Valid() || _size < this->DataSize())
+    return false;
+
+  FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(_data), this->bitmap,
+      FreeImage_GetLine(this->bitmap), FreeImage_GetBPP(this->bitmap),
+      FI_RGBA_RED_MASK, FI_RGBA_GREEN_MASK, FI_RGBA_BLUE_MASK, true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Image::CopyRGBData(unsigned char *_data, const unsigned int _size) const
+{
+  const unsigned int width = this->GetWidth();
+  const unsigned int height = this->GetHeight();
+  if (!this->Valid() || _size < width * height * 3)
+    return false;
+
+  // Copy the rows top down, dropping alpha or expanding grayscale in place
+  // of a 24 bit copy of the bitmap
+  const unsigned int channels = ChannelCount(this->bitmap);
+  if (channels == 0)
+  {
+    FIBITMAP *tmp = FreeImage_ConvertTo24Bits(this->bitmap);
+    FreeImage_ConvertToRawBits(reinterpret_cast<BYTE*>(_data), tmp,
+        width * 3, 24, FI_RGBA_RED_MASK, FI_RGBA_GREEN_MASK,
+        FI_RGBA_BLUE_MASK, true);
+    FreeImage_Unload(tmp);
+    return true;
+  }
+
+  const PixelFormat format = channels == 1 ? L_INT8 :
+      (channels == 3 ? RGB_INT8 : RGBA_INT8);
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    ConvertPixels(FreeImage_GetScanLine(this->bitmap, height - 1 - y),
+        format, _data + static_cast<size_t>(y) * width * 3, RGB_INT8, width);
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Image::GetDataImpl(unsigned char **_data, unsigned int &_count,
                         FIBITMAP *_img) const
@@ -273,6 +689,27 @@ ignition::math::Color Image::Pixel(const unsigned int _x,
   if (!this->Valid())
     return clr;
 
+  // Read 8 bit pixels straight from the scanline. The color bytes are in
+  // red, green, blue order, whatever the FreeImage color order is.
+  const unsigned int bytes = PixelBytes(this->bitmap);
+  if (bytes > 0)
+  {
+    if (_x >= FreeImage_GetWidth(this->bitmap) ||
+        _y >= FreeImage_GetHeight(this->bitmap))
+    {
+      gzerr << "Image: Coordinates out of range["
+        << _x << " " << _y << "] \n";
+      return clr;
+    }
+
+    const BYTE *pixel = FreeImage_GetScanLine(this->bitmap, _y) + _x * bytes;
+    if (bytes == 1)
+      clr.Set(pixel[0], pixel[0], pixel[0]);
+    else
+      clr.Set(pixel[0], pixel[1], pixel[2]);
+    return clr;
+  }
+
   FREE_IMAGE_COLOR_TYPE type = FreeImage_GetColorType(this->bitmap);
 
   if (type == FIC_RGB || type == FIC_RGBALPHA)
@@ -323,14 +760,43 @@ ignition::math::Color Image::AvgColor()
   ignition::math::Color pixel;
 
   rsum = gsum = bsum = 0.0;
-  for (y = 0; y < this->GetHeight(); ++y)
+  const unsigned int bytes = this->Valid() ? PixelBytes(this->bitmap) : 0;
+  if (bytes > 0)
   {
-    for (x = 0; x < this->GetWidth(); ++x)
+    // Count the channel bytes, and sum their values once per byte value
+    std::vector<uint64_t> counts(3 * 256, 0);
+    const unsigned int width = this->GetWidth();
+    const unsigned int offset = bytes == 1 ? 0 : 1;
+    for (y = 0; y < this->GetHeight(); ++y)
     {
-      pixel = this->Pixel(x, y);
-      rsum += pixel.R();
-      gsum += pixel.G();
-      bsum += pixel.B();
+      const BYTE *row = FreeImage_GetScanLine(this->bitmap, y);
+      for (x = 0; x < width; ++x, row += bytes)
+      {
+        ++counts[row[0]];
+        ++counts[256 + row[offset]];
+        ++counts[512 + row[2 * offset]];
+      }
+    }
+
+    const std::array<float, 256> &values = ChannelValues();
+    for (unsigned int i = 0; i < 256; ++i)
+    {
+      rsum += static_cast<double>(values[i]) * counts[i];
+      gsum += static_cast<double>(values[i]) * counts[256 + i];
+      bsum += static_cast<double>(values[i]) * counts[512 + i];
+    }
+  }
+  else
+  {
+    for (y = 0; y < this->GetHeight(); ++y)
+    {
+      for (x = 0; x < this->GetWidth(); ++x)
+      {
+        pixel = this->Pixel(x, y);
+        rsum += pixel.R();
+        gsum += pixel.G();
+        bsum += pixel.B();
+      }
     }
   }
 
@@ -350,6 +816,35 @@ ignition::math::Color Image::MaxColor() const
 
   maxClr.Set(0, 0, 0, 0);
 
+  const unsigned int bytes = this->Valid() ? PixelBytes(this->bitmap) : 0;
+  if (bytes > 0)
+  {
+    // Compare the channel sums without building a color per pixel
+    const std::array<float, 256> &values = ChannelValues();
+    const unsigned int width = this->GetWidth();
+    const unsigned int offset = bytes == 1 ? 0 : 1;
+    float maxSum = 0.0f;
+    unsigned int maxX = 0;
+    unsigned int maxY = 0;
+    for (y = 0; y < this->GetHeight(); y++)
+    {
+      const BYTE *row = FreeImage_GetScanLine(this->bitmap, y);
+      for (x = 0; x < width; x++, row += bytes)
+      {
+        const float sum = values[row[0]] + values[row[offset]] +
+            values[row[2 * offset]];
+        if (sum > maxSum)
+        {
+          maxSum = sum;
+          maxX = x;
+          maxY = y;
+        }
+      }
+    }
+
+    return maxSum > 0.0f ? this->Pixel(maxX, maxY) : maxClr;
+  }
+
   for (y = 0; y < this->GetHeight(); y++)
   {
     for (x = 0; x < this->GetWidth(); x++)
@@ -369,12 +864,40 @@ ignition::math::Color Image::MaxColor() const
 //////////////////////////////////////////////////
 void Image::Rescale(int _width, int _height)
 {
+  if (!this->Valid() || _width <= 0 || _height <= 0)
+  {
+    gzerr << "Unable to rescale image to [" << _width << " x " << _height
+          << "]\n";
+    return;
+  }
+
+  FIBITMAP *scaled = nullptr;
+  const unsigned int channels = ChannelCount(this->bitmap);
+  if (channels > 0)
+  {
+    scaled = Resample(this->bitmap, channels, _width, _height);
+  }
+  else
+  {
 #ifndef _WIN32
-  this->bitmap = FreeImage_Rescale(this->bitmap, _width, _height,
-      FILTER_LANCZOS3);
+    scaled = FreeImage_Rescale(this->bitmap, _width, _height,
+        FILTER_LANCZOS3);
 #else
-  gzerr << "Image::Rescale is not implemented on Windows.\n";
+    gzerr << "Image::Rescale is not implemented on Windows for pixel "
+          << "format[" << this->GetPixelFormat() << "]\n";
+    return;
 #endif
+  }
+
+  if (!scaled)
+  {
+    gzerr << "Unable to rescale image to [" << _width << " x " << _height
+          << "]\n";
+    return;
+  }
+
+  FreeImage_Unload(this->bitmap);
+  this->bitmap = scaled;
 }
 
 //////////////////////////////////////////////////
@@ -450,3 +973,45 @@ Image::PixelFormat Image::ConvertPixelFormat(const std::string &_format)
 
   return UNKNOWN_PIXEL_FORMAT;
 }
+
+/////////////////////////////////////////////////
+bool Image::ConvertPixels(const unsigned char *_src,
+    const PixelFormat _srcFormat, unsigned char *_dst,
+    const PixelFormat _dstFormat, const size_t _count)
+{
+  ConvertFn convert = ConvertFor(_srcFormat, _dstFormat);
+  if (!convert)
+  {
+    gzerr << "Unable to convert pixel format[" << _srcFormat << "] to ["
+          << _dstFormat << "]\n";
+    return false;
+  }
+
+  convert(_src, _dst, _count);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void Image::ConvertDepth(const float *_src, uint16_t *_dst,
+    const size_t _count, const double _scale)
+{
+  const float scale = static_cast<float>(_scale);
+  const float maxDepth = std::numeric_limits<uint16_t>::max() + 0.5f;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    // NaN fails both comparisons
+    const float depth = _src[i] * scale;
+    _dst[i] = depth > 0.0f && depth < maxDepth ?
+        static_cast<uint16_t>(depth + 0.5f) : 0;
+  }
+}
+
+/////////////////////////////////////////////////
+void Image::ConvertDepth(const uint16_t *_src, float *_dst,
+    const size_t _count, const double _scale)
+{
+  const float scale = static_cast<float>(1.0 / _scale);
+  const float noReading = std::numeric_limits<float>::quiet_NaN();
+  for (size_t i = 0; i < _count; ++i)
+    _dst[i] = _src[i] == 0 ? noReading : _src[i] * scale;
+}
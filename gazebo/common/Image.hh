@@ -22,6 +22,8 @@
 #ifndef _IMAGE_HH_
 #define _IMAGE_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <ignition/math/Color.hh>
 
@@ -96,6 +98,41 @@ namespace gazebo
       public: static Image::PixelFormat ConvertPixelFormat(
                   const std::string &_format);
 
+      /// \brief Convert pixels between 8 bit per channel formats. The
+      /// supported formats are L_INT8, RGB_INT8, RGBA_INT8, BGR_INT8 and
+      /// BGRA_INT8. A missing alpha channel is filled with 255, and color
+      /// is converted to luminance with the Rec. 601 weights.
+      /// \param[in] _src Source pixels, tightly packed.
+      /// \param[in] _srcFormat Pixel format of the source.
+      /// \param[out] _dst Destination pixels. It must hold _count pixels
+      /// of _dstFormat, and must not overlap the source.
+      /// \param[in] _dstFormat Pixel format of the destination.
+      /// \param[in] _count Number of pixels.
+      /// \return False if a pixel format is not supported.
+      public: static bool ConvertPixels(const unsigned char *_src,
+                  const Image::PixelFormat _srcFormat, unsigned char *_dst,
+                  const Image::PixelFormat _dstFormat, const size_t _count);
+
+      /// \brief Convert depths to 16 bit integers, such as meters to
+      /// millimeters. Depths that are not finite, not positive, or too far
+      /// for 16 bits are converted to 0, which means no reading.
+      /// \param[in] _src Source depths.
+      /// \param[out] _dst Destination depths. It must hold _count values.
+      /// \param[in] _count Number of depths.
+      /// \param[in] _scale Number of integer units per depth unit.
+      public: static void ConvertDepth(const float *_src, uint16_t *_dst,
+                  const size_t _count, const double _scale = 1000.0);
+
+      /// \brief Convert 16 bit integer depths to floating point depths,
+      /// such as millimeters to meters. A depth of 0 means no reading, and
+      /// is converted to NaN.
+      /// \param[in] _src Source depths.
+      /// \param[out] _dst Destination depths. It must hold _count values.
+      /// \param[in] _count Number of depths.
+      /// \param[in] _scale Number of integer units per depth unit.
+      public: static void ConvertDepth(const uint16_t *_src, float *_dst,
+                  const size_t _count, const double _scale = 1000.0);
+
       /// \brief Constructor
       /// \param[in] _filename the path to the image
       public: explicit Image(const std::string &_filename="");
@@ -135,6 +172,29 @@ namespace gazebo
       public: void GetRGBData(unsigned char **_data,
                               unsigned int &_count) const;
 
+      /// \brief Get the size of the data array returned by GetData.
+      /// \return Size in bytes, or 0 if the image is not valid.
+      public: unsigned int DataSize() const;
+
+      /// \brief Copy the image data to a caller provided buffer, in the
+      /// same layout as GetData. Use this instead of GetData to reuse a
+      /// buffer across frames.
+      /// \param[out] _data Buffer of at least DataSize() bytes.
+      /// \param[in] _size Size of the buffer in bytes.
+      /// \return False if the image is not valid or the buffer is too
+      /// small.
+      public: bool CopyData(unsigned char *_data,
+                            const unsigned int _size) const;
+
+      /// \brief Copy only the RGB data to a caller provided buffer, in the
+      /// same layout as GetRGBData.
+      /// \param[out] _data Buffer of at least width * height * 3 bytes.
+      /// \param[in] _size Size of the buffer in bytes.
+      /// \return False if the image is not valid or the buffer is too
+      /// small.
+      public: bool CopyRGBData(unsigned char *_data,
+                               const unsigned int _size) const;
+
       /// \brief Get the width
       /// \return The image width
       public: unsigned int GetWidth() const;
@@ -174,7 +234,8 @@ namespace gazebo
       /// \return The max color
       public: ignition::math::Color MaxColor() const;
 
-      /// \brief Rescale the image
+      /// \brief Rescale the image with a Lanczos filter. Images with 8 bits
+      /// per channel are resampled in parallel, row by row.
       /// \param[in] _width New image width
       /// \param[in] _height New image height
       public: void Rescale(int _width, int _height);
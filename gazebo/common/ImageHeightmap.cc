@@ -15,6 +15,10 @@
  *
  */
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/ImageHeightmap.hh"
@@ -22,11 +26,36 @@
 using namespace gazebo;
 using namespace common;
 
+namespace
+{
+  /// \brief Copies of the pixels of the heightmaps filling windows, by
+  /// heightmap.
+  std::unordered_map<const ImageHeightmap *, std::vector<unsigned char>>
+      g_pixels;
+
+  /// \brief Protects g_pixels.
+  std::mutex g_pixelsMutex;
+
+  /// \brief Drop the copy of a heightmap's pixels.
+  /// \param[in] _heightmap The heightmap.
+  void ReleasePixels(const ImageHeightmap *_heightmap)
+  {
+    std::lock_guard<std::mutex> lock(g_pixelsMutex);
+    g_pixels.erase(_heightmap);
+  }
+}
+
 //////////////////////////////////////////////////
 ImageHeightmap::ImageHeightmap()
 {
 }
 
+//////////////////////////////////////////////////
+ImageHeightmap::~ImageHeightmap()
+{
+  ReleasePixels(this);
+}
+
 //////////////////////////////////////////////////
 int ImageHeightmap::Load(const std::string &_filename)
 {
@@ -35,6 +64,7 @@ int ImageHeightmap::Load(const std::string &_filename)
     gzerr << "Unable to load image file as a terrain [" << _filename << "]\n";
     return -1;
   }
+  ReleasePixels(this);
 
   return 0;
 }
@@ -45,8 +75,29 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
     const ignition::math::Vector3d &_scale, bool _flipY,
     std::vector<float> &_heights)
 {
-  // Resize the vector to match the size of the vertices.
-  _heights.resize(_vertSize * _vertSize);
+  bool cached;
+  {
+    std::lock_guard<std::mutex> lock(g_pixelsMutex);
+    cached = g_pixels.count(this) > 0;
+  }
+
+  this->FillHeightMapWindow(_subSampling, _vertSize, _size, _scale, _flipY,
+      0, 0, _vertSize, _vertSize, _heights);
+
+  // The pixels are only kept for filling windows
+  if (!cached)
+    ReleasePixels(this);
+}
+
+//////////////////////////////////////////////////
+void ImageHeightmap::FillHeightMapWindow(int _subSampling,
+    unsigned int _vertSize, const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, bool _flipY,
+    unsigned int _x, unsigned int _y, unsigned int _width,
+    unsigned int _height, std::vector<float> &_heights)
+{
+  // Resize the vector to match the size of the window.
+  _heights.resize(static_cast<size_t>(_width) * _height);
 
   int imgHeight = this->GetHeight();
   int imgWidth = this->GetWidth();
@@ -59,13 +110,31 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
   // Bytes per pixel
   unsigned int bpp = pitch / imgWidth;
 
-  unsigned char *data = nullptr;
-  unsigned int count;
-  this->img.GetData(&data, count);
+  // Keep a copy of the pixels, so a window does not copy the whole image.
+  // Map values are not moved by other insertions.
+  const unsigned char *data = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(g_pixelsMutex);
+    std::vector<unsigned char> &pixels = g_pixels[this];
+    if (pixels.empty())
+    {
+      unsigned char *copy = nullptr;
+      unsigned int count;
+      this->img.GetData(&copy, count);
+      pixels.assign(copy, copy + count);
+      delete [] copy;
+    }
+    data = pixels.data();
+  }
 
-  // Iterate over all the vertices
-  for (unsigned int y = 0; y < _vertSize; ++y)
+  // Iterate over the rows of the window
+  for (unsigned int row = 0; row < _height; ++row)
   {
+    // Vertex row the window row is sampled from
+    unsigned int y = _y + row;
+    if (_flipY)
+      y = _vertSize - y - 1;
+
     // yf ranges between 0 and 4
     double yf = y / static_cast<double>(_subSampling);
     int y1 = floor(yf);
@@ -74,9 +143,9 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
       y2 = imgHeight-1;
     double dy = yf - y1;
 
-    for (unsigned int x = 0; x < _vertSize; ++x)
+    for (unsigned int col = 0; col < _width; ++col)
     {
-      double xf = x / static_cast<double>(_subSampling);
+      double xf = (_x + col) / static_cast<double>(_subSampling);
       int x1 = floor(xf);
       int x2 = ceil(xf);
       if (x2 >= imgWidth)
@@ -100,14 +169,9 @@ void ImageHeightmap::FillHeightMap(int _subSampling,
         h = 1.0 - h;
 
       // Store the height for future use
-      if (!_flipY)
-        _heights[y * _vertSize + x] = h;
-      else
-        _heights[(_vertSize - y - 1) * _vertSize + x] = h;
+      _heights[static_cast<size_t>(row) * _width + col] = h;
     }
   }
-
-  delete [] data;
 }
 
 //////////////////////////////////////////////////
@@ -42,6 +42,9 @@ namespace gazebo
       /// \param[in] _filename the path to the image
       public: ImageHeightmap();
 
+      /// \brief Destructor
+      public: virtual ~ImageHeightmap();
+
       /// \brief Load an image file as a heightmap.
       /// \param[in] _filename the path to the image file.
       /// \return True when the operation succeeds to open a file.
@@ -53,6 +56,16 @@ namespace gazebo
           const ignition::math::Vector3d &_scale, bool _flipY,
           std::vector<float> &_heights);
 
+      /// \brief Fill a window of the lookup table of the terrain's height.
+      /// The image's pixels are copied by the first call, and kept until
+      /// the next Load, so the following windows do not copy the image.
+      /// \sa HeightmapData::FillHeightMapWindow
+      public: void FillHeightMapWindow(int _subSampling,
+          unsigned int _vertSize, const ignition::math::Vector3d &_size,
+          const ignition::math::Vector3d &_scale, bool _flipY,
+          unsigned int _x, unsigned int _y, unsigned int _width,
+          unsigned int _height, std::vector<float> &_heights);
+
       /// \brief Get the full filename of the image
       /// \return The filename used to load the image
       public: std::string GetFilename() const;
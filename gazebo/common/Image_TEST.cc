@@ -15,6 +15,10 @@
  *
 */
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <ignition/math/Color.hh>
 
@@ -100,6 +104,201 @@ TEST_F(ImageTest, ConvertPixelFormat)
      Image::ConvertPixelFormat("BAYER_BGGR8"));
 }
 
+/////////////////////////////////////////////////
+TEST_F(ImageTest, ConvertPixels)
+{
+  using Image = gazebo::common::Image;
+  const std::vector<unsigned char> rgb = {10, 20, 30, 255, 128, 0};
+
+  std::vector<unsigned char> bgr(6);
+  EXPECT_TRUE(Image::ConvertPixels(rgb.data(), Image::RGB_INT8, bgr.data(),
+      Image::BGR_INT8, 2));
+  EXPECT_EQ(std::vector<unsigned char>({30, 20, 10, 0, 128, 255}), bgr);
+
+  std::vector<unsigned char> rgba(8);
+  EXPECT_TRUE(Image::ConvertPixels(bgr.data(), Image::BGR_INT8, rgba.data(),
+      Image::RGBA_INT8, 2));
+  EXPECT_EQ(std::vector<unsigned char>({10, 20, 30, 255, 255, 128, 0, 255}),
+      rgba);
+
+  std::vector<unsigned char> bgra(8);
+  rgba[3] = 7;
+  EXPECT_TRUE(Image::ConvertPixels(rgba.data(), Image::RGBA_INT8,
+      bgra.data(), Image::BGRA_INT8, 2));
+  EXPECT_EQ(std::vector<unsigned char>({30, 20, 10, 7, 0, 128, 255, 255}),
+      bgra);
+
+  std::vector<unsigned char> back(6);
+  EXPECT_TRUE(Image::ConvertPixels(bgra.data(), Image::BGRA_INT8,
+      back.data(), Image::RGB_INT8, 2));
+  EXPECT_EQ(rgb, back);
+
+  // Luminance keeps gray levels, and expands to every color channel
+  const std::vector<unsigned char> gray = {0, 0, 0, 200, 200, 200, 255, 255,
+      255};
+  std::vector<unsigned char> mono(3);
+  EXPECT_TRUE(Image::ConvertPixels(gray.data(), Image::RGB_INT8, mono.data(),
+      Image::L_INT8, 3));
+  EXPECT_EQ(std::vector<unsigned char>({0, 200, 255}), mono);
+
+  std::vector<unsigned char> expanded(9);
+  EXPECT_TRUE(Image::ConvertPixels(mono.data(), Image::L_INT8,
+      expanded.data(), Image::RGB_INT8, 3));
+  EXPECT_EQ(gray, expanded);
+
+  EXPECT_TRUE(Image::ConvertPixels(rgb.data(), Image::RGB_INT8, mono.data(),
+      Image::L_INT8, 1));
+  EXPECT_EQ(18u, mono[0]);
+
+  EXPECT_FALSE(Image::ConvertPixels(rgb.data(), Image::RGB_INT16,
+      bgr.data(), Image::BGR_INT8, 1));
+  EXPECT_FALSE(Image::ConvertPixels(rgb.data(), Image::RGB_INT8,
+      bgr.data(), Image::R_FLOAT32, 1));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, ConvertDepth)
+{
+  using Image = gazebo::common::Image;
+  const std::vector<float> depths = {0.0f, 1.2345f, 65.535f, 70.0f, -1.0f,
+      std::numeric_limits<float>::quiet_NaN(),
+      std::numeric_limits<float>::infinity()};
+
+  std::vector<uint16_t> millimeters(depths.size());
+  Image::ConvertDepth(depths.data(), millimeters.data(), depths.size());
+  EXPECT_EQ(std::vector<uint16_t>({0, 1235, 65535, 0, 0, 0, 0}),
+      millimeters);
+
+  std::vector<float> meters(depths.size());
+  Image::ConvertDepth(millimeters.data(), meters.data(), millimeters.size());
+  EXPECT_TRUE(std::isnan(meters[0]));
+  EXPECT_FLOAT_EQ(1.235f, meters[1]);
+  EXPECT_FLOAT_EQ(65.535f, meters[2]);
+  EXPECT_TRUE(std::isnan(meters[3]));
+
+  // Tenths of millimeters
+  Image::ConvertDepth(depths.data(), millimeters.data(), 2, 10000.0);
+  EXPECT_EQ(12345u, millimeters[1]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, CopyData)
+{
+  common::Image img;
+  EXPECT_EQ(0u, img.DataSize());
+  EXPECT_FALSE(img.CopyData(nullptr, 0));
+
+  // 3x2 RGBA image
+  const std::vector<unsigned char> rgba = {
+      1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+      13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24};
+  img.SetFromData(rgba.data(), 3, 2, common::Image::RGBA_INT8);
+  ASSERT_EQ(24u, img.DataSize());
+
+  std::vector<unsigned char> data(img.DataSize());
+  EXPECT_FALSE(img.CopyData(data.data(), 10));
+  EXPECT_TRUE(img.CopyData(data.data(), data.size()));
+  EXPECT_EQ(rgba, data);
+
+  std::vector<unsigned char> rgb(3 * 2 * 3);
+  EXPECT_FALSE(img.CopyRGBData(rgb.data(), 10));
+  EXPECT_TRUE(img.CopyRGBData(rgb.data(), rgb.size()));
+  EXPECT_EQ(std::vector<unsigned char>({1, 2, 3, 5, 6, 7, 9, 10, 11,
+      13, 14, 15, 17, 18, 19, 21, 22, 23}), rgb);
+
+  // The allocating version returns the same data
+  unsigned char *rgbData = nullptr;
+  unsigned int size = 0;
+  img.GetRGBData(&rgbData, size);
+  ASSERT_EQ(rgb.size(), size);
+  EXPECT_EQ(rgb, std::vector<unsigned char>(rgbData, rgbData + size));
+  delete [] rgbData;
+
+  // Grayscale expands to the three channels
+  const std::vector<unsigned char> mono = {0, 100, 200, 255};
+  img.SetFromData(mono.data(), 2, 2, common::Image::L_INT8);
+  rgb.resize(12);
+  EXPECT_TRUE(img.CopyRGBData(rgb.data(), rgb.size()));
+  EXPECT_EQ(std::vector<unsigned char>({0, 0, 0, 100, 100, 100,
+      200, 200, 200, 255, 255, 255}), rgb);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, Colors)
+{
+  // 2x2 RGB image, the rows are stored bottom up
+  const std::vector<unsigned char> rgb = {
+      255, 0, 0, 0, 255, 0,
+      0, 0, 255, 51, 102, 153};
+  common::Image img;
+  img.SetFromData(rgb.data(), 2, 2, common::Image::RGB_INT8);
+
+  EXPECT_EQ(ignition::math::Color(0, 0, 1), img.Pixel(0, 0));
+  EXPECT_EQ(ignition::math::Color(0.2, 0.4, 0.6), img.Pixel(1, 0));
+  EXPECT_EQ(ignition::math::Color(1, 0, 0), img.Pixel(0, 1));
+  EXPECT_EQ(ignition::math::Color(), img.Pixel(2, 0));
+
+  EXPECT_EQ(ignition::math::Color(0.3, 0.35, 0.4), img.AvgColor());
+  EXPECT_EQ(ignition::math::Color(0.2, 0.4, 0.6), img.MaxColor());
+
+  // Black images have no max color
+  const std::vector<unsigned char> black(12, 0);
+  img.SetFromData(black.data(), 2, 2, common::Image::RGB_INT8);
+  EXPECT_EQ(ignition::math::Color(0, 0, 0, 0), img.MaxColor());
+
+  const std::vector<unsigned char> mono = {0, 51, 102, 255};
+  img.SetFromData(mono.data(), 2, 2, common::Image::L_INT8);
+  EXPECT_EQ(ignition::math::Color(0.4, 0.4, 0.4), img.Pixel(0, 0));
+  EXPECT_EQ(ignition::math::Color(1, 1, 1), img.MaxColor());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ImageTest, Rescale)
+{
+  // Uniform images stay uniform
+  const unsigned int width = 64;
+  const unsigned int height = 48;
+  std::vector<unsigned char> rgb(width * height * 3);
+  for (size_t i = 0; i < rgb.size(); i += 3)
+  {
+    rgb[i] = 40;
+    rgb[i + 1] = 120;
+    rgb[i + 2] = 200;
+  }
+
+  common::Image img;
+  img.SetFromData(rgb.data(), width, height, common::Image::RGB_INT8);
+  img.Rescale(20, 100);
+  EXPECT_EQ(20u, img.GetWidth());
+  EXPECT_EQ(100u, img.GetHeight());
+  EXPECT_EQ(24u, img.GetBPP());
+
+  std::vector<unsigned char> data(img.DataSize());
+  ASSERT_TRUE(img.CopyData(data.data(), data.size()));
+  unsigned int mismatches = 0;
+  for (size_t i = 0; i < data.size(); i += 3)
+  {
+    if (data[i] != 40 || data[i + 1] != 120 || data[i + 2] != 200)
+      ++mismatches;
+  }
+  EXPECT_EQ(0u, mismatches);
+
+  // A gradient keeps its ends when downsampled
+  std::vector<unsigned char> mono(width * height);
+  for (unsigned int y = 0; y < height; ++y)
+    for (unsigned int x = 0; x < width; ++x)
+      mono[y * width + x] = x < width / 2 ? 0 : 255;
+
+  img.SetFromData(mono.data(), width, height, common::Image::L_INT8);
+  img.Rescale(16, 12);
+  EXPECT_EQ(8u, img.GetBPP());
+  EXPECT_EQ(ignition::math::Color(0, 0, 0), img.Pixel(0, 5));
+  EXPECT_EQ(ignition::math::Color(1, 1, 1), img.Pixel(15, 5));
+
+  // Invalid sizes leave the image alone
+  img.Rescale(0, 10);
+  EXPECT_EQ(16u, img.GetWidth());
+}
 
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_COMMON_MATERIAL_HH_
 #define GAZEBO_COMMON_MATERIAL_HH_
 
+#include <atomic>
 #include <string>
 #include <iostream>
 #include <ignition/math/Color.hh>
@@ -223,8 +224,9 @@ namespace gazebo
       /// \brief the shade mode
       protected: ShadeMode shadeMode;
 
-      /// \brief the total number of instanciated Material instances
-      private: static unsigned int counter;
+      /// \brief the total number of instanciated Material instances.
+      /// Materials are created by meshes decoded on several threads.
+      private: static std::atomic<unsigned int> counter;
 
       /// \brief flag to perform depth buffer write
       private: bool depthWrite = true;
@@ -17,6 +17,9 @@
 #include <float.h>
 #include <string.h>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 #include "gazebo/common/Material.hh"
 #include "gazebo/common/Exception.hh"
@@ -28,6 +31,68 @@
 using namespace gazebo;
 using namespace common;
 
+namespace
+{
+  /// \brief Compact buffers of a sub-mesh, see SubMesh::Compact.
+  struct SubMeshBuffers
+  {
+    /// \brief Packed x, y, z coordinates of each vertex.
+    std::shared_ptr<const std::vector<float>> vertices;
+
+    /// \brief Packed x, y, z coordinates of each normal.
+    std::shared_ptr<const std::vector<float>> normals;
+
+    /// \brief Indices.
+    std::shared_ptr<const std::vector<int>> indices;
+  };
+
+  /// \brief Buffers of the compact sub-meshes. Kept out of SubMesh to
+  /// preserve its layout. Only compact sub-meshes have an entry.
+  std::unordered_map<const SubMesh *, SubMeshBuffers> g_buffers;
+
+  /// \brief Number of entries in g_buffers, lets the accessors skip the
+  /// lookup while no sub-mesh is compact.
+  std::atomic<size_t> g_bufferCount(0);
+
+  /// \brief Protects g_buffers.
+  std::mutex g_buffersMutex;
+
+  /// \brief Get the compact buffers of a sub-mesh.
+  /// \param[in] _subMesh The sub-mesh.
+  /// \return The buffers, or nullptr if the sub-mesh is not compact. The
+  /// entry lives until the sub-mesh is expanded or destroyed.
+  const SubMeshBuffers *BuffersOf(const SubMesh *_subMesh)
+  {
+    if (g_bufferCount == 0)
+      return nullptr;
+
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    auto iter = g_buffers.find(_subMesh);
+    return iter != g_buffers.end() ? &iter->second : nullptr;
+  }
+
+  /// \brief Set the compact buffers of a sub-mesh.
+  /// \param[in] _subMesh The sub-mesh.
+  /// \param[in] _buffers The buffers.
+  void SetBuffers(const SubMesh *_subMesh, const SubMeshBuffers &_buffers)
+  {
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    g_buffers[_subMesh] = _buffers;
+    g_bufferCount = g_buffers.size();
+  }
+
+  /// \brief Remove the compact buffers of a sub-mesh, if any.
+  /// \param[in] _subMesh The sub-mesh.
+  void EraseBuffers(const SubMesh *_subMesh)
+  {
+    if (g_bufferCount == 0)
+      return;
+
+    std::lock_guard<std::mutex> lock(g_buffersMutex);
+    g_buffers.erase(_subMesh);
+    g_bufferCount = g_buffers.size();
+  }
+}
 
 //////////////////////////////////////////////////
 Mesh::Mesh()
@@ -331,6 +396,13 @@ void Mesh::RecalculateNormals()
     (*iter)->RecalculateNormals();
 }
 
+//////////////////////////////////////////////////
+void Mesh::Compact()
+{
+  for (auto &submesh : this->submeshes)
+    submesh->Compact();
+}
+
 //////////////////////////////////////////////////
 void Mesh::SetSkeleton(Skeleton* _skel)
 {
@@ -435,11 +507,16 @@ SubMesh::SubMesh(const SubMesh *_mesh)
       std::back_inserter(this->texCoords));
   std::copy(_mesh->vertices.begin(), _mesh->vertices.end(),
       std::back_inserter(this->vertices));
+
+  // Compact buffers are immutable, the copy shares them
+  if (auto buffers = BuffersOf(_mesh))
+    SetBuffers(this, *buffers);
 }
 
 //////////////////////////////////////////////////
 SubMesh::~SubMesh()
 {
+  EraseBuffers(this);
   this->vertices.clear();
   this->indices.clear();
   this->nodeAssignments.clear();
@@ -460,6 +537,7 @@ SubMesh::PrimitiveType SubMesh::GetPrimitiveType() const
 //////////////////////////////////////////////////
 void SubMesh::CopyVertices(const std::vector<ignition::math::Vector3d> &_verts)
 {
+  this->Expand();
   this->vertices.clear();
   this->vertices.resize(_verts.size());
   std::copy(_verts.begin(), _verts.end(), this->vertices.begin());
@@ -468,6 +546,7 @@ void SubMesh::CopyVertices(const std::vector<ignition::math::Vector3d> &_verts)
 //////////////////////////////////////////////////
 void SubMesh::CopyNormals(const std::vector<ignition::math::Vector3d> &_norms)
 {
+  this->Expand();
   this->normals.clear();
   this->normals.resize(_norms.size());
   for (unsigned int i = 0; i < _norms.size(); ++i)
@@ -484,18 +563,21 @@ void SubMesh::CopyNormals(const std::vector<ignition::math::Vector3d> &_norms)
 //////////////////////////////////////////////////
 void SubMesh::SetVertexCount(unsigned int _count)
 {
+  this->Expand();
   this->vertices.resize(_count);
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetIndexCount(unsigned int _count)
 {
+  this->Expand();
   this->indices.resize(_count);
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetNormalCount(unsigned int _count)
 {
+  this->Expand();
   this->normals.resize(_count);
 }
 
@@ -508,12 +590,14 @@ void SubMesh::SetTexCoordCount(unsigned int _count)
 //////////////////////////////////////////////////
 void SubMesh::AddIndex(unsigned int _i)
 {
+  this->Expand();
   this->indices.push_back(_i);
 }
 
 //////////////////////////////////////////////////
 void SubMesh::AddVertex(const ignition::math::Vector3d &_v)
 {
+  this->Expand();
   this->vertices.push_back(_v);
 }
 
@@ -526,6 +610,7 @@ void SubMesh::AddVertex(double _x, double _y, double _z)
 //////////////////////////////////////////////////
 void SubMesh::AddNormal(const ignition::math::Vector3d &_n)
 {
+  this->Expand();
   this->normals.push_back(_n);
 }
 
@@ -556,15 +641,22 @@ void SubMesh::AddNodeAssignment(unsigned int _vertex, unsigned int _node,
 //////////////////////////////////////////////////
 ignition::math::Vector3d SubMesh::Vertex(unsigned int _i) const
 {
-  if (_i >= this->vertices.size())
+  if (_i >= this->GetVertexCount())
     gzthrow("Index too large");
 
+  if (auto buffers = BuffersOf(this))
+  {
+    const float *v = buffers->vertices->data() + _i * 3;
+    return ignition::math::Vector3d(v[0], v[1], v[2]);
+  }
+
   return this->vertices[_i];
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetVertex(unsigned int _i, const ignition::math::Vector3d &_v)
 {
+  this->Expand();
   if (_i >= this->vertices.size())
     gzthrow("Index too large");
 
@@ -574,15 +666,22 @@ void SubMesh::SetVertex(unsigned int _i, const ignition::math::Vector3d &_v)
 //////////////////////////////////////////////////
 ignition::math::Vector3d SubMesh::Normal(unsigned int _i) const
 {
-  if (_i >= this->normals.size())
+  if (_i >= this->GetNormalCount())
     gzthrow("Index too large");
 
+  if (auto buffers = BuffersOf(this))
+  {
+    const float *n = buffers->normals->data() + _i * 3;
+    return ignition::math::Vector3d(n[0], n[1], n[2]);
+  }
+
   return this->normals[_i];
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetNormal(unsigned int _i, const ignition::math::Vector3d &_n)
 {
+  this->Expand();
   if (_i >= this->normals.size())
     gzthrow("Index too large");
 
@@ -619,9 +718,12 @@ void SubMesh::SetTexCoord(unsigned int _i, const ignition::math::Vector2d &_t)
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetIndex(unsigned int _i) const
 {
-  if (_i > this->indices.size())
+  if (_i > this->GetIndexCount())
     gzthrow("Index too large");
 
+  if (auto buffers = BuffersOf(this))
+    return (*buffers->indices)[_i];
+
   return this->indices[_i];
 }
 
@@ -629,17 +731,17 @@ unsigned int SubMesh::GetIndex(unsigned int _i) const
 ignition::math::Vector3d SubMesh::Max() const
 {
   ignition::math::Vector3d max;
-  std::vector<ignition::math::Vector3d>::const_iterator iter;
 
   max.X(-FLT_MAX);
   max.Y(-FLT_MAX);
   max.Z(-FLT_MAX);
 
-  for (iter = this->vertices.begin(); iter != this->vertices.end(); ++iter)
+  for (unsigned int i = 0; i < this->GetVertexCount(); ++i)
   {
-    max.X(std::max(max.X(), (*iter).X()));
-    max.Y(std::max(max.Y(), (*iter).Y()));
-    max.Z(std::max(max.Z(), (*iter).Z()));
+    ignition::math::Vector3d v = this->Vertex(i);
+    max.X(std::max(max.X(), v.X()));
+    max.Y(std::max(max.Y(), v.Y()));
+    max.Z(std::max(max.Z(), v.Z()));
   }
 
   return max;
@@ -649,17 +751,17 @@ ignition::math::Vector3d SubMesh::Max() const
 ignition::math::Vector3d SubMesh::Min() const
 {
   ignition::math::Vector3d min;
-  std::vector<ignition::math::Vector3d>::const_iterator iter;
 
   min.X(FLT_MAX);
   min.Y(FLT_MAX);
   min.Z(FLT_MAX);
 
-  for (iter = this->vertices.begin(); iter != this->vertices.end(); ++iter)
+  for (unsigned int i = 0; i < this->GetVertexCount(); ++i)
   {
-    min.X(std::min(min.X(), (*iter).X()));
-    min.Y(std::min(min.Y(), (*iter).Y()));
-    min.Z(std::min(min.Z(), (*iter).Z()));
+    ignition::math::Vector3d v = this->Vertex(i);
+    min.X(std::min(min.X(), v.X()));
+    min.Y(std::min(min.Y(), v.Y()));
+    min.Z(std::min(min.Z(), v.Z()));
   }
 
   return min;
@@ -668,18 +770,27 @@ ignition::math::Vector3d SubMesh::Min() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetVertexCount() const
 {
+  if (auto buffers = BuffersOf(this))
+    return buffers->vertices->size() / 3;
+
   return this->vertices.size();
 }
 
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetNormalCount() const
 {
+  if (auto buffers = BuffersOf(this))
+    return buffers->normals->size() / 3;
+
   return this->normals.size();
 }
 
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetIndexCount() const
 {
+  if (auto buffers = BuffersOf(this))
+    return buffers->indices->size();
+
   return this->indices.size();
 }
 
@@ -698,6 +809,13 @@ unsigned int SubMesh::GetNodeAssignmentsCount() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetMaxIndex() const
 {
+  if (auto buffers = BuffersOf(this))
+  {
+    auto maxIter = std::max_element(buffers->indices->begin(),
+        buffers->indices->end());
+    return maxIter != buffers->indices->end() ? *maxIter : 0;
+  }
+
   std::vector<unsigned int>::const_iterator maxIter;
   maxIter = std::max_element(this->indices.begin(), this->indices.end());
 
@@ -722,10 +840,8 @@ unsigned int SubMesh::GetMaterialIndex() const
 //////////////////////////////////////////////////
 bool SubMesh::HasVertex(const ignition::math::Vector3d &_v) const
 {
-  std::vector< ignition::math::Vector3d >::const_iterator iter;
-
-  for (iter = this->vertices.begin(); iter != this->vertices.end(); ++iter)
-    if (_v.Equal(*iter))
+  for (unsigned int i = 0; i < this->GetVertexCount(); ++i)
+    if (_v.Equal(this->Vertex(i)))
       return true;
 
   return false;
@@ -734,11 +850,9 @@ bool SubMesh::HasVertex(const ignition::math::Vector3d &_v) const
 //////////////////////////////////////////////////
 unsigned int SubMesh::GetVertexIndex(const ignition::math::Vector3d &_v) const
 {
-  std::vector< ignition::math::Vector3d >::const_iterator iter;
-
-  for (iter = this->vertices.begin(); iter != this->vertices.end(); ++iter)
-    if (_v.Equal(*iter))
-      return iter - this->vertices.begin();
+  for (unsigned int i = 0; i < this->GetVertexCount(); ++i)
+    if (_v.Equal(this->Vertex(i)))
+      return i;
 
   return 0;
 }
@@ -746,7 +860,7 @@ unsigned int SubMesh::GetVertexIndex(const ignition::math::Vector3d &_v) const
 //////////////////////////////////////////////////
 void SubMesh::FillArrays(float **_vertArr, int **_indArr) const
 {
-  if (this->vertices.empty() || this->indices.empty())
+  if (this->GetVertexCount() == 0 || this->GetIndexCount() == 0)
     gzerr << "No vertices or indices\n";
 
   std::vector<ignition::math::Vector3d>::const_iterator viter;
@@ -759,6 +873,17 @@ void SubMesh::FillArrays(float **_vertArr, int **_indArr) const
   if (*_indArr)
     delete [] *_indArr;
 
+  if (auto buffers = BuffersOf(this))
+  {
+    *_vertArr = new float[buffers->vertices->size()];
+    *_indArr = new int[buffers->indices->size()];
+    std::copy(buffers->vertices->begin(), buffers->vertices->end(),
+        *_vertArr);
+    std::copy(buffers->indices->begin(), buffers->indices->end(),
+        *_indArr);
+    return;
+  }
+
   *_vertArr = new float[this->vertices.size() * 3];
   *_indArr = new int[this->indices.size()];
 
@@ -780,6 +905,7 @@ void SubMesh::FillArrays(float **_vertArr, int **_indArr) const
 //////////////////////////////////////////////////
 void SubMesh::RecalculateNormals()
 {
+  this->Expand();
   unsigned int i;
   if (normals.size() < 3)
     return;
@@ -854,14 +980,15 @@ void Mesh::GetAABB(ignition::math::Vector3d &_center,
 //////////////////////////////////////////////////
 void SubMesh::GenSphericalTexCoord(const ignition::math::Vector3d &_center)
 {
-  std::vector<ignition::math::Vector3d>::const_iterator viter;
-  for (viter = this->vertices.begin(); viter != this->vertices.end(); ++viter)
+  for (unsigned int i = 0; i < this->GetVertexCount(); ++i)
   {
+    ignition::math::Vector3d vert = this->Vertex(i);
+
     // generate projected texture coordinates, projected from center
     // get x, y, z for computing texture coordinate projections
-    double x = (*viter).X() - _center.X();
-    double y = (*viter).Y() - _center.Y();
-    double z = (*viter).Z() - _center.Z();
+    double x = vert.X() - _center.X();
+    double y = vert.Y() - _center.Y();
+    double z = vert.Z() - _center.Z();
 
     double r = std::max(0.000001, sqrt(x*x+y*y+z*z));
     double s = std::min(1.0, std::max(-1.0, z/r));
@@ -875,6 +1002,7 @@ void SubMesh::GenSphericalTexCoord(const ignition::math::Vector3d &_center)
 //////////////////////////////////////////////////
 void SubMesh::Scale(double _factor)
 {
+  this->Expand();
   for (auto &vert : this->vertices)
     vert *= _factor;
 }
@@ -882,6 +1010,7 @@ void SubMesh::Scale(double _factor)
 //////////////////////////////////////////////////
 void SubMesh::SetScale(const ignition::math::Vector3d &_factor)
 {
+  this->Expand();
   for (auto &vert : this->vertices)
     vert *= _factor;
 }
@@ -900,10 +1029,97 @@ void SubMesh::Center(const ignition::math::Vector3d &_center)
 //////////////////////////////////////////////////
 void SubMesh::Translate(const ignition::math::Vector3d &_vec)
 {
+  this->Expand();
   for (auto &vert : this->vertices)
     vert += _vec;
 }
 
+//////////////////////////////////////////////////
+void SubMesh::Compact()
+{
+  if (this->IsCompact())
+    return;
+
+  auto verts = std::make_shared<std::vector<float>>();
+  verts->reserve(this->vertices.size() * 3);
+  for (auto const &v : this->vertices)
+  {
+    verts->push_back(static_cast<float>(v.X()));
+    verts->push_back(static_cast<float>(v.Y()));
+    verts->push_back(static_cast<float>(v.Z()));
+  }
+
+  auto norms = std::make_shared<std::vector<float>>();
+  norms->reserve(this->normals.size() * 3);
+  for (auto const &n : this->normals)
+  {
+    norms->push_back(static_cast<float>(n.X()));
+    norms->push_back(static_cast<float>(n.Y()));
+    norms->push_back(static_cast<float>(n.Z()));
+  }
+
+  SubMeshBuffers buffers;
+  buffers.vertices = verts;
+  buffers.normals = norms;
+  buffers.indices = std::make_shared<std::vector<int>>(
+      this->indices.begin(), this->indices.end());
+  SetBuffers(this, buffers);
+
+  // Release the double precision arrays
+  std::vector<ignition::math::Vector3d>().swap(this->vertices);
+  std::vector<ignition::math::Vector3d>().swap(this->normals);
+  std::vector<unsigned int>().swap(this->indices);
+}
+
+//////////////////////////////////////////////////
+bool SubMesh::IsCompact() const
+{
+  return BuffersOf(this) != nullptr;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const std::vector<float>> SubMesh::VertexBuffer() const
+{
+  auto buffers = BuffersOf(this);
+  return buffers ? buffers->vertices : nullptr;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const std::vector<float>> SubMesh::NormalBuffer() const
+{
+  auto buffers = BuffersOf(this);
+  return buffers ? buffers->normals : nullptr;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const std::vector<int>> SubMesh::IndexBuffer() const
+{
+  auto buffers = BuffersOf(this);
+  return buffers ? buffers->indices : nullptr;
+}
+
+//////////////////////////////////////////////////
+void SubMesh::Expand()
+{
+  auto buffers = BuffersOf(this);
+  if (!buffers)
+    return;
+
+  const std::vector<float> &verts = *buffers->vertices;
+  this->vertices.resize(verts.size() / 3);
+  for (size_t i = 0; i < this->vertices.size(); ++i)
+    this->vertices[i].Set(verts[i * 3], verts[i * 3 + 1], verts[i * 3 + 2]);
+
+  const std::vector<float> &norms = *buffers->normals;
+  this->normals.resize(norms.size() / 3);
+  for (size_t i = 0; i < this->normals.size(); ++i)
+    this->normals[i].Set(norms[i * 3], norms[i * 3 + 1], norms[i * 3 + 2]);
+
+  this->indices.assign(buffers->indices->begin(), buffers->indices->end());
+
+  EraseBuffers(this);
+}
+
 //////////////////////////////////////////////////
 void SubMesh::SetName(const std::string &_n)
 {
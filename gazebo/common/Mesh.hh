@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_MESH_HH_
 #define _GAZEBO_MESH_HH_
 
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -135,6 +136,10 @@ namespace gazebo
       /// indices.
       public: void RecalculateNormals();
 
+      /// \brief Store the vertices, normals and indices of all sub-meshes
+      /// in compact single precision buffers, see SubMesh::Compact.
+      public: void Compact();
+
       /// \brief Get AABB coordinate
       /// \param[out] _center of the bounding box
       /// \param[out] _minXYZ bounding box minimum values
@@ -423,6 +428,39 @@ namespace gazebo
       /// \param[in] _factor Scaling vector
       public: void SetScale(const ignition::math::Vector3d &_factor);
 
+      /// \brief Store the vertices, normals and indices in compact single
+      /// precision buffers, and release the double precision arrays.
+      ///
+      /// The buffers are immutable and shared: copies of the sub-mesh and
+      /// the collision engines reference them instead of copying. A
+      /// function that modifies the vertices, normals or indices converts
+      /// the sub-mesh back to double precision first, buffers handed out
+      /// before keep their content.
+      public: void Compact();
+
+      /// \brief Get whether the sub-mesh uses compact buffers.
+      /// \return True if Compact was called and the sub-mesh was not
+      /// modified since.
+      public: bool IsCompact() const;
+
+      /// \brief Get the compact vertex buffer.
+      /// \return Packed x, y, z coordinates of each vertex, or nullptr if
+      /// the sub-mesh is not compact.
+      public: std::shared_ptr<const std::vector<float>> VertexBuffer() const;
+
+      /// \brief Get the compact normal buffer.
+      /// \return Packed x, y, z coordinates of each normal, or nullptr if
+      /// the sub-mesh is not compact.
+      public: std::shared_ptr<const std::vector<float>> NormalBuffer() const;
+
+      /// \brief Get the compact index buffer.
+      /// \return Indices, or nullptr if the sub-mesh is not compact.
+      public: std::shared_ptr<const std::vector<int>> IndexBuffer() const;
+
+      /// \brief Convert compact buffers back to the double precision
+      /// arrays, before the arrays are modified.
+      private: void Expand();
+
       /// \brief the vertex array
       private: std::vector<ignition::math::Vector3d> vertices;
 
@@ -0,0 +1,746 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/gazebo_config.h"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Magic bytes at the start of a cache file, including the version
+/// of the cache file format.
+static const char kMagic[8] = {'G', 'Z', 'M', 'E', 'S', 'H', 0, 3};
+
+/// \brief Gazebo version that wrote a cache file. Entries written by
+/// another version are ignored, since the loaders may decode differently.
+static const char *kLoaderVersion = GAZEBO_VERSION_FULL;
+
+/// \brief Extension of the cache files.
+static const char *kExtension = ".gzmesh";
+
+/// \brief Offset of the mesh file modification time in a cache file.
+static const std::streamoff kMtimeOffset = 16;
+
+/// \brief Appends values to a cache file buffer.
+class CacheWriter
+{
+  /// \brief Append a plain value.
+  /// \param[in] _value Value to append.
+  public: template<typename T> void Value(const T &_value)
+          {
+            this->data.append(reinterpret_cast<const char *>(&_value),
+                sizeof(T));
+          }
+
+  /// \brief Append an array, starting at an aligned offset.
+  /// \param[in] _values First value.
+  /// \param[in] _count Number of values.
+  public: template<typename T> void Array(const T *_values,
+              const size_t _count)
+          {
+            this->Pad();
+            this->data.append(reinterpret_cast<const char *>(_values),
+                _count * sizeof(T));
+          }
+
+  /// \brief Append a string.
+  /// \param[in] _str String to append.
+  public: void String(const std::string &_str)
+          {
+            this->Value(static_cast<uint32_t>(_str.size()));
+            this->data.append(_str);
+          }
+
+  /// \brief Pad the buffer to the next 8 byte boundary.
+  public: void Pad()
+          {
+            this->data.append((8 - this->data.size() % 8) % 8, '\0');
+          }
+
+  /// \brief Content of the cache file.
+  public: std::string data;
+};
+
+/// \brief Reads values from a cache file buffer, with bounds checks.
+class CacheReader
+{
+  /// \brief Constructor.
+  /// \param[in] _data Content of the cache file.
+  public: explicit CacheReader(const std::string &_data)
+          : data(_data)
+          {
+          }
+
+  /// \brief Read a plain value.
+  /// \param[out] _value Value read.
+  /// \return False if the buffer is too short.
+  public: template<typename T> bool Value(T &_value)
+          {
+            if (this->pos + sizeof(T) > this->data.size())
+              return false;
+            std::memcpy(&_value, this->data.data() + this->pos, sizeof(T));
+            this->pos += sizeof(T);
+            return true;
+          }
+
+  /// \brief Read an array that starts at an aligned offset.
+  /// \param[out] _values Values read.
+  /// \param[in] _count Number of values.
+  /// \return False if the buffer is too short.
+  public: template<typename T> bool Array(std::vector<T> &_values,
+              const size_t _count)
+          {
+            this->pos += (8 - this->pos % 8) % 8;
+            if (this->pos + _count * sizeof(T) > this->data.size())
+              return false;
+            _values.resize(_count);
+            if (_count > 0)
+            {
+              std::memcpy(_values.data(), this->data.data() + this->pos,
+                  _count * sizeof(T));
+            }
+            this->pos += _count * sizeof(T);
+            return true;
+          }
+
+  /// \brief Read a string.
+  /// \param[out] _str String read.
+  /// \return False if the buffer is too short.
+  public: bool String(std::string &_str)
+          {
+            uint32_t size = 0;
+            if (!this->Value(size) || this->pos + size > this->data.size())
+              return false;
+            _str.assign(this->data.data() + this->pos, size);
+            this->pos += size;
+            return true;
+          }
+
+  /// \brief Content of the cache file.
+  private: const std::string &data;
+
+  /// \brief Read offset.
+  private: size_t pos = 0;
+};
+
+/// \brief Private data for the MeshCache class.
+class gazebo::common::MeshCachePrivate
+{
+  /// \brief Account for a cache file written by Save, and trim the cache
+  /// if it grew larger than maxSize.
+  /// \param[in] _added Size of the new cache file.
+  /// \param[in] _replaced Size of the cache file it replaced, zero if
+  /// there was none.
+  public: void Saved(const uint64_t _added, const uint64_t _replaced);
+
+  /// \brief Remove the least recently used cache files until the cache
+  /// fits in three quarters of maxSize, so that the directory is not
+  /// scanned again on the next save.
+  /// \param[in] _trim False to only compute the size of the cache.
+  /// \return Size of the cache files left.
+  public: uint64_t Trim(const bool _trim);
+
+  /// \brief Directory of the cache files.
+  public: std::string path;
+
+  /// \brief Maximum size of the cache files in bytes.
+  public: uint64_t maxSize = 512 * 1024 * 1024;
+
+  /// \brief Running size of the cache files. Saves by other processes
+  /// are only counted when the directory is scanned by Trim.
+  public: uint64_t cacheSize = 0;
+
+  /// \brief True once the directory has been scanned for cacheSize.
+  public: bool cacheSizeKnown = false;
+
+  /// \brief Protects cacheSize and cacheSizeKnown.
+  public: std::mutex mutex;
+};
+
+/////////////////////////////////////////////////
+/// \brief Hash the content of a file.
+/// \param[in] _filename File to hash.
+/// \param[out] _hash Hash of the file.
+/// \return False if the file could not be read.
+static bool hashFile(const std::string &_filename, uint64_t &_hash)
+{
+  std::ifstream in(_filename, std::ios::binary);
+  if (!in.is_open())
+    return false;
+
+  _hash = MeshCache::Hash(nullptr, 0);
+  std::vector<char> buffer(1 << 20);
+  while (in)
+  {
+    in.read(buffer.data(), buffer.size());
+    _hash = MeshCache::Hash(buffer.data(), in.gcount(), _hash);
+  }
+  return in.eof();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the files that a mesh was decoded from, besides the mesh
+/// file: the material libraries of an OBJ file and the texture images.
+/// \param[in] _filename Full path of the mesh file.
+/// \param[in] _mesh Mesh decoded from the file.
+/// \return Full paths of the existing dependencies.
+static std::vector<std::string> dependencies(const std::string &_filename,
+    const Mesh *_mesh)
+{
+  namespace fs = boost::filesystem;
+  std::vector<std::string> deps;
+
+  if (fs::path(_filename).extension() == ".obj")
+  {
+    const fs::path dir = fs::path(_filename).parent_path();
+    std::ifstream in(_filename);
+    std::string line;
+    while (std::getline(in, line))
+    {
+      std::istringstream tokens(line);
+      std::string keyword, library;
+      if (!(tokens >> keyword) || keyword != "mtllib")
+        continue;
+      while (tokens >> library)
+        deps.push_back((dir / library).string());
+    }
+  }
+
+  for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+  {
+    const std::string texture = _mesh->GetMaterial(i)->GetTextureImage();
+    if (!texture.empty())
+      deps.push_back(texture);
+  }
+
+  boost::system::error_code ec;
+  deps.erase(std::remove_if(deps.begin(), deps.end(),
+      [&ec](const std::string &_dep)
+      {
+        return !fs::is_regular_file(_dep, ec);
+      }), deps.end());
+  std::sort(deps.begin(), deps.end());
+  deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+  return deps;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a color to a cache file.
+/// \param[in] _clr Color.
+/// \param[in,out] _out Cache file writer.
+static void writeColor(const ignition::math::Color &_clr, CacheWriter &_out)
+{
+  _out.Value(_clr.R());
+  _out.Value(_clr.G());
+  _out.Value(_clr.B());
+  _out.Value(_clr.A());
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a color from a cache file.
+/// \param[in,out] _in Cache file reader.
+/// \param[out] _clr Color read.
+/// \return False if the cache file is too short.
+static bool readColor(CacheReader &_in, ignition::math::Color &_clr)
+{
+  float rgba[4];
+  for (auto &v : rgba)
+  {
+    if (!_in.Value(v))
+      return false;
+  }
+  _clr.Set(rgba[0], rgba[1], rgba[2], rgba[3]);
+  return true;
+}
+
+/////////////////////////////////////////////////
+MeshCache::MeshCache(const std::string &_path)
+  : dataPtr(new MeshCachePrivate)
+{
+  this->dataPtr->path = _path;
+}
+
+/////////////////////////////////////////////////
+MeshCache::~MeshCache()
+{
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::Path() const
+{
+  return this->dataPtr->path;
+}
+
+/////////////////////////////////////////////////
+void MeshCache::SetMaxSize(const uint64_t _size)
+{
+  this->dataPtr->maxSize = _size;
+}
+
+/////////////////////////////////////////////////
+uint64_t MeshCache::MaxSize() const
+{
+  return this->dataPtr->maxSize;
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::CacheFilename(const std::string &_filename) const
+{
+  std::ostringstream name;
+  name << std::hex << std::setfill('0') << std::setw(16)
+       << Hash(_filename.data(), _filename.size()) << kExtension;
+  return (boost::filesystem::path(this->dataPtr->path) / name.str()).string();
+}
+
+/////////////////////////////////////////////////
+uint64_t MeshCache::Hash(const void *_data, const size_t _size,
+    const uint64_t _hash)
+{
+  uint64_t hash = _hash;
+  const unsigned char *bytes = static_cast<const unsigned char *>(_data);
+  for (size_t i = 0; i < _size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_filename) const
+{
+  const std::string cacheFilename = this->CacheFilename(_filename);
+  std::ifstream in(cacheFilename, std::ios::binary);
+  if (!in.is_open())
+    return nullptr;
+
+  std::string data((std::istreambuf_iterator<char>(in)),
+      std::istreambuf_iterator<char>());
+  in.close();
+
+  CacheReader reader(data);
+  char magic[sizeof(kMagic)] = {0};
+  uint64_t size = 0;
+  int64_t mtime = 0;
+  uint64_t hash = 0;
+  std::string version;
+  for (auto &c : magic)
+    reader.Value(c);
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !reader.Value(size) || !reader.Value(mtime) || !reader.Value(hash) ||
+      !reader.String(version) || version != kLoaderVersion)
+  {
+    return nullptr;
+  }
+
+  boost::system::error_code ec;
+
+  // A dependency that changed size or modification time invalidates the
+  // entry. Unlike the mesh file, dependencies are not hashed.
+  uint32_t depCount = 0;
+  if (!reader.Value(depCount))
+    return nullptr;
+  for (uint32_t i = 0; i < depCount; ++i)
+  {
+    std::string dep;
+    uint64_t depSize = 0;
+    int64_t depMtime = 0;
+    if (!reader.String(dep) || !reader.Value(depSize) ||
+        !reader.Value(depMtime))
+    {
+      return nullptr;
+    }
+    if (boost::filesystem::file_size(dep, ec) != depSize || ec ||
+        boost::filesystem::last_write_time(dep, ec) != depMtime || ec)
+    {
+      return nullptr;
+    }
+  }
+
+  const uint64_t fileSize = boost::filesystem::file_size(_filename, ec);
+  if (ec || fileSize != size)
+    return nullptr;
+  const int64_t fileMtime = boost::filesystem::last_write_time(_filename, ec);
+  if (ec)
+    return nullptr;
+
+  if (fileMtime != mtime)
+  {
+    uint64_t fileHash = 0;
+    if (!hashFile(_filename, fileHash) || fileHash != hash)
+      return nullptr;
+
+    // The file was touched but not changed. Store the new time so the next
+    // load does not hash the file again.
+    std::fstream patch(cacheFilename,
+        std::ios::in | std::ios::out | std::ios::binary);
+    if (patch.is_open())
+    {
+      patch.seekp(kMtimeOffset);
+      patch.write(reinterpret_cast<const char *>(&fileMtime),
+          sizeof(fileMtime));
+    }
+  }
+
+  // Mark the entry as recently used, see MeshCachePrivate::Trim.
+  boost::filesystem::last_write_time(cacheFilename, std::time(nullptr), ec);
+
+  std::unique_ptr<Mesh> mesh(new Mesh());
+
+  std::string path;
+  uint32_t materialCount = 0;
+  bool ok = reader.String(path) && reader.Value(materialCount);
+  mesh->SetPath(path);
+
+  for (uint32_t i = 0; ok && i < materialCount; ++i)
+  {
+    std::string texture;
+    ignition::math::Color ambient, diffuse, specular, emissive;
+    double transparency, shininess, pointSize, srcBlend, dstBlend;
+    uint32_t blendMode, shadeMode, depthWrite, lighting;
+    ok = reader.String(texture) &&
+        readColor(reader, ambient) && readColor(reader, diffuse) &&
+        readColor(reader, specular) && readColor(reader, emissive) &&
+        reader.Value(transparency) && reader.Value(shininess) &&
+        reader.Value(pointSize) && reader.Value(srcBlend) &&
+        reader.Value(dstBlend) && reader.Value(blendMode) &&
+        reader.Value(shadeMode) && reader.Value(depthWrite) &&
+        reader.Value(lighting) &&
+        blendMode < Material::BLEND_COUNT &&
+        shadeMode < Material::SHADE_COUNT;
+    if (!ok)
+      break;
+
+    Material *material = new Material();
+    material->SetTextureImage(texture);
+    material->SetAmbient(ambient);
+    material->SetDiffuse(diffuse);
+    material->SetSpecular(specular);
+    material->SetEmissive(emissive);
+    material->SetTransparency(transparency);
+    material->SetShininess(shininess);
+    material->SetPointSize(pointSize);
+    material->SetBlendFactors(srcBlend, dstBlend);
+    material->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+    material->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+    material->SetDepthWrite(depthWrite != 0);
+    material->SetLighting(lighting != 0);
+    mesh->AddMaterial(material);
+  }
+
+  uint32_t subMeshCount = 0;
+  ok = ok && reader.Value(subMeshCount);
+
+  std::vector<double> vertices, normals, texCoords;
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; ok && i < subMeshCount; ++i)
+  {
+    std::string name;
+    uint32_t primitiveType;
+    int32_t materialIndex;
+    uint32_t vertexCount, normalCount, texCoordCount, indexCount;
+    ok = reader.String(name) && reader.Value(primitiveType) &&
+        reader.Value(materialIndex) && reader.Value(vertexCount) &&
+        reader.Value(normalCount) && reader.Value(texCoordCount) &&
+        reader.Value(indexCount) &&
+        primitiveType <= SubMesh::TRISTRIPS &&
+        reader.Array(vertices, vertexCount * 3) &&
+        reader.Array(normals, normalCount * 3) &&
+        reader.Array(texCoords, texCoordCount * 2) &&
+        reader.Array(indices, indexCount);
+    if (!ok)
+      break;
+
+    SubMesh *subMesh = new SubMesh();
+    subMesh->SetName(name);
+    subMesh->SetPrimitiveType(
+        static_cast<SubMesh::PrimitiveType>(primitiveType));
+    subMesh->SetMaterialIndex(materialIndex);
+
+    subMesh->SetVertexCount(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+      subMesh->SetVertex(v, ignition::math::Vector3d(
+          vertices[v * 3], vertices[v * 3 + 1], vertices[v * 3 + 2]));
+    }
+    subMesh->SetNormalCount(normalCount);
+    for (uint32_t n = 0; n < normalCount; ++n)
+    {
+      subMesh->SetNormal(n, ignition::math::Vector3d(
+          normals[n * 3], normals[n * 3 + 1], normals[n * 3 + 2]));
+    }
+    subMesh->SetTexCoordCount(texCoordCount);
+    for (uint32_t t = 0; t < texCoordCount; ++t)
+    {
+      subMesh->SetTexCoord(t, ignition::math::Vector2d(
+          texCoords[t * 2], texCoords[t * 2 + 1]));
+    }
+    for (auto const index : indices)
+      subMesh->AddIndex(index);
+
+    mesh->AddSubMesh(subMesh);
+  }
+
+  if (!ok)
+  {
+    gzwarn << "Ignoring corrupt mesh cache file[" << cacheFilename << "]\n";
+    return nullptr;
+  }
+
+  return mesh.release();
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::Save(const std::string &_filename, const Mesh *_mesh) const
+{
+  // Skeletons and their animations are not cached
+  if (!_mesh || _mesh->HasSkeleton())
+    return false;
+
+  boost::system::error_code ec;
+  const uint64_t fileSize = boost::filesystem::file_size(_filename, ec);
+  if (ec)
+    return false;
+  const int64_t fileMtime = boost::filesystem::last_write_time(_filename, ec);
+  if (ec)
+    return false;
+  uint64_t fileHash = 0;
+  if (!hashFile(_filename, fileHash))
+    return false;
+
+  CacheWriter writer;
+  for (auto const c : kMagic)
+    writer.Value(c);
+  writer.Value(fileSize);
+  writer.Value(fileMtime);
+  writer.Value(fileHash);
+  writer.String(kLoaderVersion);
+
+  const std::vector<std::string> deps = dependencies(_filename, _mesh);
+  writer.Value(static_cast<uint32_t>(deps.size()));
+  for (auto const &dep : deps)
+  {
+    const uint64_t depSize = boost::filesystem::file_size(dep, ec);
+    if (ec)
+      return false;
+    const int64_t depMtime = boost::filesystem::last_write_time(dep, ec);
+    if (ec)
+      return false;
+    writer.String(dep);
+    writer.Value(depSize);
+    writer.Value(depMtime);
+  }
+
+  writer.String(_mesh->GetPath());
+
+  writer.Value(static_cast<uint32_t>(_mesh->GetMaterialCount()));
+  for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+  {
+    const Material *material = _mesh->GetMaterial(i);
+    double srcBlend, dstBlend;
+    material->GetBlendFactors(srcBlend, dstBlend);
+
+    writer.String(material->GetTextureImage());
+    writeColor(material->Ambient(), writer);
+    writeColor(material->Diffuse(), writer);
+    writeColor(material->Specular(), writer);
+    writeColor(material->Emissive(), writer);
+    writer.Value(material->GetTransparency());
+    writer.Value(material->GetShininess());
+    writer.Value(material->GetPointSize());
+    writer.Value(srcBlend);
+    writer.Value(dstBlend);
+    writer.Value(static_cast<uint32_t>(material->GetBlendMode()));
+    writer.Value(static_cast<uint32_t>(material->GetShadeMode()));
+    writer.Value(static_cast<uint32_t>(material->GetDepthWrite()));
+    writer.Value(static_cast<uint32_t>(material->GetLighting()));
+  }
+
+  writer.Value(static_cast<uint32_t>(_mesh->GetSubMeshCount()));
+  std::vector<double> values;
+  std::vector<uint32_t> indices;
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    writer.String(subMesh->GetName());
+    writer.Value(static_cast<uint32_t>(subMesh->GetPrimitiveType()));
+    writer.Value(static_cast<int32_t>(subMesh->GetMaterialIndex()));
+    writer.Value(static_cast<uint32_t>(subMesh->GetVertexCount()));
+    writer.Value(static_cast<uint32_t>(subMesh->GetNormalCount()));
+    writer.Value(static_cast<uint32_t>(subMesh->GetTexCoordCount()));
+    writer.Value(static_cast<uint32_t>(subMesh->GetIndexCount()));
+
+    values.clear();
+    for (unsigned int v = 0; v < subMesh->GetVertexCount(); ++v)
+    {
+      const ignition::math::Vector3d vertex = subMesh->Vertex(v);
+      values.insert(values.end(), {vertex.X(), vertex.Y(), vertex.Z()});
+    }
+    writer.Array(values.data(), values.size());
+
+    values.clear();
+    for (unsigned int n = 0; n < subMesh->GetNormalCount(); ++n)
+    {
+      const ignition::math::Vector3d normal = subMesh->Normal(n);
+      values.insert(values.end(), {normal.X(), normal.Y(), normal.Z()});
+    }
+    writer.Array(values.data(), values.size());
+
+    values.clear();
+    for (unsigned int t = 0; t < subMesh->GetTexCoordCount(); ++t)
+    {
+      const ignition::math::Vector2d texCoord = subMesh->TexCoord(t);
+      values.insert(values.end(), {texCoord.X(), texCoord.Y()});
+    }
+    writer.Array(values.data(), values.size());
+
+    indices.clear();
+    for (unsigned int n = 0; n < subMesh->GetIndexCount(); ++n)
+      indices.push_back(subMesh->GetIndex(n));
+    writer.Array(indices.data(), indices.size());
+  }
+  writer.Pad();
+
+  boost::filesystem::create_directories(this->dataPtr->path, ec);
+  if (ec)
+  {
+    gzwarn << "Unable to create mesh cache directory[" << this->dataPtr->path
+           << "]: " << ec.message() << "\n";
+    return false;
+  }
+
+  // Write to a temporary file first, so concurrent readers never see a
+  // partial cache file.
+  const std::string cacheFilename = this->CacheFilename(_filename);
+  const boost::filesystem::path tmpFilename =
+      boost::filesystem::unique_path(cacheFilename + ".%%%%-%%%%");
+  {
+    std::ofstream out(tmpFilename.string(), std::ios::binary);
+    out.write(writer.data.data(), writer.data.size());
+    if (!out.good())
+    {
+      out.close();
+      boost::filesystem::remove(tmpFilename, ec);
+      return false;
+    }
+  }
+
+  uint64_t replaced = boost::filesystem::file_size(cacheFilename, ec);
+  if (ec)
+    replaced = 0;
+
+  boost::filesystem::rename(tmpFilename, cacheFilename, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmpFilename, ec);
+    return false;
+  }
+
+  this->dataPtr->Saved(writer.data.size(), replaced);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void MeshCachePrivate::Saved(const uint64_t _added, const uint64_t _replaced)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // The first save scans the directory, which counts the new file too
+  if (!this->cacheSizeKnown)
+  {
+    this->cacheSize = this->Trim(false);
+    this->cacheSizeKnown = true;
+  }
+  else
+  {
+    this->cacheSize += _added;
+    this->cacheSize -= std::min(this->cacheSize, _replaced);
+  }
+
+  if (this->cacheSize > this->maxSize)
+    this->cacheSize = this->Trim(true);
+}
+
+/////////////////////////////////////////////////
+uint64_t MeshCachePrivate::Trim(const bool _trim)
+{
+  namespace fs = boost::filesystem;
+
+  struct Entry
+  {
+    std::time_t time;
+    uint64_t size;
+    fs::path path;
+  };
+  std::vector<Entry> entries;
+  uint64_t totalSize = 0;
+
+  boost::system::error_code ec;
+  for (fs::directory_iterator file(this->path, ec);
+       !ec && file != fs::directory_iterator(); file.increment(ec))
+  {
+    // Temporary files of concurrent saves are not counted
+    if (file->path().extension() != kExtension)
+      continue;
+
+    boost::system::error_code statError;
+    Entry entry;
+    entry.size = fs::file_size(file->path(), statError);
+    if (statError)
+      continue;
+    entry.time = fs::last_write_time(file->path(), statError);
+    if (statError)
+      continue;
+    entry.path = file->path();
+    totalSize += entry.size;
+    entries.push_back(entry);
+  }
+
+  const uint64_t targetSize = this->maxSize - this->maxSize / 4;
+  if (!_trim || totalSize <= targetSize)
+    return totalSize;
+
+  // Oldest first
+  std::sort(entries.begin(), entries.end(),
+      [](const Entry &_a, const Entry &_b)
+      {
+        return _a.time < _b.time;
+      });
+
+  for (const auto &entry : entries)
+  {
+    if (totalSize <= targetSize)
+      break;
+    if (fs::remove(entry.path, ec))
+      totalSize -= entry.size;
+  }
+  return totalSize;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHCACHE_HH_
+#define GAZEBO_COMMON_MESHCACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+
+    // Forward declare private data class.
+    class MeshCachePrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshCache MeshCache.hh common/common.hh
+    /// \brief On disk cache of decoded meshes.
+    ///
+    /// Each mesh file gets one cache file, named after a hash of the mesh
+    /// file's path. The cache file holds the size, modification time and
+    /// content hash of the mesh file and the Gazebo version that decoded
+    /// it, followed by the decoded materials and sub-meshes. A cache entry
+    /// is used directly while the mesh file's size and modification time
+    /// match. If only the modification time changed, the mesh file is
+    /// hashed, and the entry is used if the content did not change. Entries
+    /// written by another Gazebo version are ignored.
+    ///
+    /// The cache file also lists the files the mesh depends on, the
+    /// material libraries of an OBJ file and the texture images, with their
+    /// size and modification time. The entry is ignored when one of them
+    /// changed.
+    ///
+    /// The cache keeps a running size of its files. When it grows larger
+    /// than MaxSize, the least recently used cache files are removed until
+    /// the cache fits in three quarters of MaxSize.
+    ///
+    /// Arrays are stored in native byte order at 8 byte aligned offsets,
+    /// so a cache file can be read in one block without parsing. Meshes with
+    /// a skeleton are not cached.
+    class GZ_COMMON_VISIBLE MeshCache
+    {
+      /// \brief Constructor.
+      /// \param[in] _path Directory of the cache files. It is created on
+      /// the first save.
+      public: explicit MeshCache(const std::string &_path);
+
+      /// \brief Destructor.
+      public: virtual ~MeshCache();
+
+      /// \brief Get the directory of the cache files.
+      /// \return Cache directory.
+      public: std::string Path() const;
+
+      /// \brief Set the maximum size of the cache files. Not thread safe,
+      /// call it before the cache is used.
+      /// \param[in] _size Maximum size in bytes.
+      public: void SetMaxSize(const uint64_t _size);
+
+      /// \brief Get the maximum size of the cache files.
+      /// \return Maximum size in bytes. The default is 512 MiB.
+      public: uint64_t MaxSize() const;
+
+      /// \brief Load the cached mesh of a file.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \return A new mesh owned by the caller, or nullptr if the file is
+      /// not cached or the cache entry is out of date.
+      public: Mesh *Load(const std::string &_filename) const;
+
+      /// \brief Save a mesh decoded from a file.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \param[in] _mesh Mesh decoded from the file.
+      /// \return True if the mesh was saved.
+      public: bool Save(const std::string &_filename, const Mesh *_mesh) const;
+
+      /// \brief Get the name of the cache file of a mesh file.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \return Full path of the cache file.
+      public: std::string CacheFilename(const std::string &_filename) const;
+
+      /// \brief Compute the FNV-1a hash of a buffer.
+      /// \param[in] _data Buffer.
+      /// \param[in] _size Size of the buffer in bytes.
+      /// \param[in] _hash Hash to continue from.
+      /// \return Hash of the buffer.
+      public: static uint64_t Hash(const void *_data, const size_t _size,
+                  const uint64_t _hash = 14695981039346656037ULL);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MeshCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
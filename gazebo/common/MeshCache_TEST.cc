@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "test_config.h"
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/OBJLoader.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCache : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, SaveLoad)
+{
+  namespace fs = boost::filesystem;
+  const fs::path tmpPath = fs::temp_directory_path() /
+      fs::unique_path("gz_mesh_cache-%%%%-%%%%");
+  fs::create_directories(tmpPath);
+
+  // Work on a copy, so the mesh file can be modified
+  const std::string filename = (tmpPath / "box.dae").string();
+  fs::copy_file(std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae",
+      filename);
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+
+  common::MeshCache cache((tmpPath / "cache").string());
+  EXPECT_EQ(nullptr, cache.Load(filename));
+  EXPECT_TRUE(cache.Save(filename, mesh.get()));
+  EXPECT_TRUE(fs::exists(cache.CacheFilename(filename)));
+
+  // The cached mesh matches the decoded mesh
+  std::unique_ptr<common::Mesh> cached(cache.Load(filename));
+  ASSERT_TRUE(cached != nullptr);
+  EXPECT_EQ(mesh->GetPath(), cached->GetPath());
+  EXPECT_EQ(mesh->GetVertexCount(), cached->GetVertexCount());
+  EXPECT_EQ(mesh->GetNormalCount(), cached->GetNormalCount());
+  EXPECT_EQ(mesh->GetIndexCount(), cached->GetIndexCount());
+  EXPECT_EQ(mesh->GetTexCoordCount(), cached->GetTexCoordCount());
+  EXPECT_EQ(mesh->Max(), cached->Max());
+  EXPECT_EQ(mesh->Min(), cached->Min());
+  ASSERT_EQ(mesh->GetSubMeshCount(), cached->GetSubMeshCount());
+  ASSERT_EQ(mesh->GetMaterialCount(), cached->GetMaterialCount());
+
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *expected = mesh->GetSubMesh(i);
+    const common::SubMesh *actual = cached->GetSubMesh(i);
+    EXPECT_EQ(expected->GetName(), actual->GetName());
+    EXPECT_EQ(expected->GetPrimitiveType(), actual->GetPrimitiveType());
+    EXPECT_EQ(expected->GetMaterialIndex(), actual->GetMaterialIndex());
+    for (unsigned int v = 0; v < expected->GetVertexCount(); ++v)
+    {
+      EXPECT_EQ(expected->Vertex(v), actual->Vertex(v));
+      EXPECT_EQ(expected->Normal(v), actual->Normal(v));
+    }
+    for (unsigned int n = 0; n < expected->GetIndexCount(); ++n)
+      EXPECT_EQ(expected->GetIndex(n), actual->GetIndex(n));
+  }
+
+  const common::Material *material = mesh->GetMaterial(0);
+  const common::Material *cachedMaterial = cached->GetMaterial(0);
+  EXPECT_EQ(material->Diffuse(), cachedMaterial->Diffuse());
+  EXPECT_EQ(material->Specular(), cachedMaterial->Specular());
+  EXPECT_DOUBLE_EQ(material->GetShininess(), cachedMaterial->GetShininess());
+  EXPECT_EQ(material->GetTextureImage(), cachedMaterial->GetTextureImage());
+
+  // Touching the file keeps the entry valid, since the content is the same
+  fs::last_write_time(filename, fs::last_write_time(filename) + 10);
+  cached.reset(cache.Load(filename));
+  EXPECT_TRUE(cached != nullptr);
+
+  // Changing the content invalidates the entry
+  {
+    std::ofstream out(filename, std::ios::app);
+    out << "\n";
+  }
+  cached.reset(cache.Load(filename));
+  EXPECT_TRUE(cached == nullptr);
+
+  // A truncated cache file is ignored
+  EXPECT_TRUE(cache.Save(filename, mesh.get()));
+  fs::resize_file(cache.CacheFilename(filename), 64);
+  cached.reset(cache.Load(filename));
+  EXPECT_TRUE(cached == nullptr);
+
+  fs::remove_all(tmpPath);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, MaxSize)
+{
+  namespace fs = boost::filesystem;
+  const fs::path tmpPath = fs::temp_directory_path() /
+      fs::unique_path("gz_mesh_cache-%%%%-%%%%");
+  fs::create_directories(tmpPath);
+
+  // Two mesh files get two cache entries
+  const std::string first = (tmpPath / "first.dae").string();
+  const std::string second = (tmpPath / "second.dae").string();
+  fs::copy_file(std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae",
+      first);
+  fs::copy_file(std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae",
+      second);
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(first));
+  ASSERT_TRUE(mesh != nullptr);
+
+  common::MeshCache cache((tmpPath / "cache").string());
+  EXPECT_GT(cache.MaxSize(), 0u);
+  EXPECT_TRUE(cache.Save(first, mesh.get()));
+  const uint64_t entrySize = fs::file_size(cache.CacheFilename(first));
+
+  // Room for one entry only, the least recently used one is removed
+  cache.SetMaxSize(entrySize + entrySize / 2);
+  EXPECT_EQ(entrySize + entrySize / 2, cache.MaxSize());
+  fs::last_write_time(cache.CacheFilename(first),
+      fs::last_write_time(cache.CacheFilename(first)) - 10);
+  EXPECT_TRUE(cache.Save(second, mesh.get()));
+  EXPECT_FALSE(fs::exists(cache.CacheFilename(first)));
+  EXPECT_TRUE(fs::exists(cache.CacheFilename(second)));
+
+  std::unique_ptr<common::Mesh> cached(cache.Load(second));
+  EXPECT_TRUE(cached != nullptr);
+  cached.reset(cache.Load(first));
+  EXPECT_TRUE(cached == nullptr);
+
+  fs::remove_all(tmpPath);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Dependencies)
+{
+  namespace fs = boost::filesystem;
+  const fs::path tmpPath = fs::temp_directory_path() /
+      fs::unique_path("gz_mesh_cache-%%%%-%%%%");
+  fs::create_directories(tmpPath);
+
+  // The OBJ file references its material library
+  const std::string filename = (tmpPath / "box.obj").string();
+  const std::string mtlFilename = (tmpPath / "box.mtl").string();
+  fs::copy_file(std::string(PROJECT_SOURCE_PATH) + "/test/data/box.obj",
+      filename);
+  fs::copy_file(std::string(PROJECT_SOURCE_PATH) + "/test/data/box.mtl",
+      mtlFilename);
+
+  common::OBJLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(filename));
+  ASSERT_TRUE(mesh != nullptr);
+
+  common::MeshCache cache((tmpPath / "cache").string());
+  EXPECT_TRUE(cache.Save(filename, mesh.get()));
+  std::unique_ptr<common::Mesh> cached(cache.Load(filename));
+  EXPECT_TRUE(cached != nullptr);
+
+  // Changing the material library invalidates the entry
+  {
+    std::ofstream out(mtlFilename, std::ios::app);
+    out << "\n";
+  }
+  cached.reset(cache.Load(filename));
+  EXPECT_TRUE(cached == nullptr);
+
+  fs::remove_all(tmpPath);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
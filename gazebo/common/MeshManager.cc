@@ -16,13 +16,28 @@
  */
 
 #include <sys/stat.h>
-#include <string>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
 #include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <boost/thread/condition_variable.hpp>
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
 #include "gazebo/common/STLLoader.hh"
@@ -40,18 +55,486 @@ namespace gazebo
 {
 namespace common
 {
+namespace
+{
+/// \brief Maximum number of generated meshes memoized by MeshManager.
+const size_t kMaxGeneratedMeshes = 64;
+
+/// \brief Hash of the inputs of a generated mesh. Meshes are keyed by the
+/// digest rather than by their inputs, which may hold whole meshes.
+using KeyHash = boost::uuids::detail::sha1;
+
+/// \brief Add bytes to a key.
+/// \param[in,out] _key The key.
+/// \param[in] _data The bytes.
+/// \param[in] _size Number of bytes.
+void KeyBytes(KeyHash &_key, const void *_data, const size_t _size)
+{
+  _key.process_bytes(_data, _size);
+}
+
+/// \brief Get the digest of a key.
+/// \param[in,out] _key The key.
+/// \return The SHA1 digest, 20 bytes.
+std::string KeyDigest(KeyHash &_key)
+{
+  unsigned int hash[5];
+  _key.get_digest(hash);
+  return std::string(reinterpret_cast<const char *>(hash), sizeof(hash));
+}
+
+/// \brief Add a value to a key.
+/// \param[in,out] _key The key.
+/// \param[in] _value The value.
+template<typename T>
+void KeyValue(KeyHash &_key, const T _value)
+{
+  KeyBytes(_key, &_value, sizeof(T));
+}
+
+/// \brief Add a vector to a key.
+/// \param[in,out] _key The key.
+/// \param[in] _vec The vector.
+void KeyVector(KeyHash &_key, const ignition::math::Vector3d &_vec)
+{
+  KeyValue(_key, _vec.X());
+  KeyValue(_key, _vec.Y());
+  KeyValue(_key, _vec.Z());
+}
+
+/// \brief Add a color to a key.
+/// \param[in,out] _key The key.
+/// \param[in] _clr The color.
+void KeyColor(KeyHash &_key, const ignition::math::Color &_clr)
+{
+  KeyValue(_key, _clr.R());
+  KeyValue(_key, _clr.G());
+  KeyValue(_key, _clr.B());
+  KeyValue(_key, _clr.A());
+}
+
+/// \brief Add a material to a key.
+/// \param[in,out] _key The key.
+/// \param[in] _material The material.
+void KeyMaterial(KeyHash &_key, const Material *_material)
+{
+  const std::string texture = _material->GetTextureImage();
+  KeyValue(_key, texture.size());
+  KeyBytes(_key, texture.data(), texture.size());
+  KeyColor(_key, _material->Ambient());
+  KeyColor(_key, _material->Diffuse());
+  KeyColor(_key, _material->Specular());
+  KeyColor(_key, _material->Emissive());
+  double srcBlend, dstBlend;
+  _material->GetBlendFactors(srcBlend, dstBlend);
+  KeyValue(_key, _material->GetTransparency());
+  KeyValue(_key, _material->GetShininess());
+  KeyValue(_key, _material->GetPointSize());
+  KeyValue(_key, srcBlend);
+  KeyValue(_key, dstBlend);
+  KeyValue(_key, static_cast<int>(_material->GetBlendMode()));
+  KeyValue(_key, static_cast<int>(_material->GetShadeMode()));
+  KeyValue(_key, _material->GetDepthWrite());
+  KeyValue(_key, _material->GetLighting());
+}
+
+/// \brief Add the geometry and the materials of a mesh to a key.
+/// \param[in,out] _key The key.
+/// \param[in] _mesh The mesh.
+void KeyMesh(KeyHash &_key, const Mesh *_mesh)
+{
+  KeyValue(_key, _mesh->GetMaterialCount());
+  for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+    KeyMaterial(_key, _mesh->GetMaterial(i));
+
+  KeyValue(_key, _mesh->GetSubMeshCount());
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    KeyValue(_key, static_cast<int>(subMesh->GetPrimitiveType()));
+    KeyValue(_key, subMesh->GetMaterialIndex());
+    KeyValue(_key, subMesh->GetVertexCount());
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+      KeyVector(_key, subMesh->Vertex(j));
+    KeyValue(_key, subMesh->GetIndexCount());
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+      KeyValue(_key, subMesh->GetIndex(j));
+  }
+}
+
+/// \brief Kinds of generated meshes, hashed first in the keys.
+enum GeneratedKind : uint8_t
+{
+  /// \brief Extruded polylines.
+  GENERATED_EXTRUDED_POLYLINE,
+
+  /// \brief Boolean of two meshes.
+  GENERATED_BOOLEAN,
+
+  /// \brief Simplified mesh.
+  GENERATED_SIMPLIFIED
+};
+
+/// \brief Get the key of an extruded polyline.
+/// \param[in] _polys The polylines.
+/// \param[in] _height The height of extrusion.
+/// \return The digest of all the inputs.
+std::string ExtrudedPolylineKey(
+    const std::vector<std::vector<ignition::math::Vector2d> > &_polys,
+    const double _height)
+{
+  KeyHash key;
+  KeyValue(key, GENERATED_EXTRUDED_POLYLINE);
+  KeyValue(key, _height);
+  KeyValue(key, _polys.size());
+  for (auto const &poly : _polys)
+  {
+    KeyValue(key, poly.size());
+    for (auto const &point : poly)
+    {
+      KeyValue(key, point.X());
+      KeyValue(key, point.Y());
+    }
+  }
+  return KeyDigest(key);
+}
+
+#ifdef HAVE_GTS
+/// \brief Get the key of a boolean mesh.
+/// \param[in] _m1 The parent mesh.
+/// \param[in] _m2 The child mesh.
+/// \param[in] _operation The boolean operation.
+/// \param[in] _offset _m2's pose offset from _m1.
+/// \return The digest of all the inputs.
+std::string BooleanKey(const Mesh *_m1, const Mesh *_m2,
+    const int _operation, const ignition::math::Pose3d &_offset)
+{
+  KeyHash key;
+  KeyValue(key, GENERATED_BOOLEAN);
+  KeyValue(key, _operation);
+  KeyVector(key, _offset.Pos());
+  KeyValue(key, _offset.Rot().W());
+  KeyValue(key, _offset.Rot().X());
+  KeyValue(key, _offset.Rot().Y());
+  KeyValue(key, _offset.Rot().Z());
+  KeyMesh(key, _m1);
+  KeyMesh(key, _m2);
+  return KeyDigest(key);
+}
+#endif
+
+/// \brief Get the key of a simplified mesh.
+/// \param[in] _mesh The mesh to simplify.
+/// \param[in] _maxTriangles The maximum number of triangles.
+/// \return The digest of all the inputs.
+std::string SimplifiedKey(const Mesh *_mesh,
+    const unsigned int _maxTriangles)
+{
+  KeyHash key;
+  KeyValue(key, GENERATED_SIMPLIFIED);
+  KeyValue(key, _maxTriangles);
+  KeyMesh(key, _mesh);
+  return KeyDigest(key);
+}
+
+/// \brief Copy a material.
+/// \param[in] _material The material.
+/// \return The copy.
+Material *CopyMaterial(const Material *_material)
+{
+  Material *copy = new Material();
+  double srcBlend, dstBlend;
+  _material->GetBlendFactors(srcBlend, dstBlend);
+  copy->SetTextureImage(_material->GetTextureImage());
+  copy->SetAmbient(_material->Ambient());
+  copy->SetDiffuse(_material->Diffuse());
+  copy->SetSpecular(_material->Specular());
+  copy->SetEmissive(_material->Emissive());
+  copy->SetTransparency(_material->GetTransparency());
+  copy->SetShininess(_material->GetShininess());
+  copy->SetPointSize(_material->GetPointSize());
+  copy->SetBlendFactors(srcBlend, dstBlend);
+  copy->SetBlendMode(_material->GetBlendMode());
+  copy->SetShadeMode(_material->GetShadeMode());
+  copy->SetDepthWrite(_material->GetDepthWrite());
+  copy->SetLighting(_material->GetLighting());
+  return copy;
+}
+
+/// \brief Copy the materials of a mesh.
+/// \param[in] _from The mesh to copy from.
+/// \param[in,out] _to The mesh to copy to.
+void CopyMaterials(const Mesh *_from, Mesh *_to)
+{
+  for (unsigned int i = 0; i < _from->GetMaterialCount(); ++i)
+    _to->AddMaterial(CopyMaterial(_from->GetMaterial(i)));
+}
+
+/// \brief Copy a mesh, with its materials.
+/// \param[in] _mesh The mesh.
+/// \return The copy.
+Mesh *CopyMesh(const Mesh *_mesh)
+{
+  Mesh *copy = new Mesh();
+  copy->SetPath(_mesh->GetPath());
+  CopyMaterials(_mesh, copy);
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+    copy->AddSubMesh(new SubMesh(_mesh->GetSubMesh(i)));
+  return copy;
+}
+
+/// \brief Get the number of triangles of a mesh.
+/// \param[in] _mesh The mesh.
+/// \return Number of triangles.
+unsigned int TriangleCount(const Mesh *_mesh)
+{
+  unsigned int count = 0;
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    if (subMesh->GetPrimitiveType() == SubMesh::TRIANGLES)
+      count += subMesh->GetIndexCount() / 3;
+  }
+  return count;
+}
+
+/// \brief Merge the vertices of a mesh that are in the same grid cell.
+/// Triangles that collapse, or duplicate another one, are removed.
+/// \param[in] _mesh The mesh.
+/// \param[in] _min Corner of the grid.
+/// \param[in] _cellSize Size of the grid cells.
+/// \return The new mesh.
+Mesh *ClusterVertices(const Mesh *_mesh, const ignition::math::Vector3d &_min,
+    const double _cellSize)
+{
+  // Cell coordinates are packed in 21 bits each
+  const uint64_t maxCell = (1u << 21) - 1;
+  auto cellCoord = [&](const double _value)
+  {
+    return std::min(maxCell, static_cast<uint64_t>(
+        std::max(0.0, std::floor(_value / _cellSize))));
+  };
+
+  Mesh *result = new Mesh();
+  CopyMaterials(_mesh, result);
+  for (unsigned int s = 0; s < _mesh->GetSubMeshCount(); ++s)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(s);
+    if (subMesh->GetPrimitiveType() != SubMesh::TRIANGLES)
+    {
+      result->AddSubMesh(new SubMesh(subMesh));
+      continue;
+    }
+
+    SubMesh *simplified = new SubMesh();
+    simplified->SetName(subMesh->GetName());
+    simplified->SetPrimitiveType(SubMesh::TRIANGLES);
+    simplified->SetMaterialIndex(subMesh->GetMaterialIndex());
+    result->AddSubMesh(simplified);
+
+    // Assign each vertex to the cluster of its cell
+    std::unordered_map<uint64_t, unsigned int> cells;
+    std::vector<unsigned int> clusterOf(subMesh->GetVertexCount());
+    std::vector<ignition::math::Vector3d> sums;
+    std::vector<unsigned int> counts;
+    for (unsigned int i = 0; i < subMesh->GetVertexCount(); ++i)
+    {
+      const ignition::math::Vector3d vertex = subMesh->Vertex(i);
+      const ignition::math::Vector3d local = vertex - _min;
+      const uint64_t cell = (cellCoord(local.X()) << 42) |
+          (cellCoord(local.Y()) << 21) | cellCoord(local.Z());
+
+      auto inserted = cells.insert(
+          std::make_pair(cell, static_cast<unsigned int>(sums.size())));
+      if (inserted.second)
+      {
+        sums.push_back(ignition::math::Vector3d::Zero);
+        counts.push_back(0);
+      }
+      clusterOf[i] = inserted.first->second;
+      sums[clusterOf[i]] += vertex;
+      ++counts[clusterOf[i]];
+    }
+
+    // Keep the triangles across three clusters, once each
+    std::set<std::array<unsigned int, 3>> triangles;
+    std::vector<int> newIndex(sums.size(), -1);
+    std::vector<ignition::math::Vector3d> normals;
+    for (unsigned int i = 0; i + 2 < subMesh->GetIndexCount(); i += 3)
+    {
+      std::array<unsigned int, 3> triangle = {{
+          clusterOf[subMesh->GetIndex(i)],
+          clusterOf[subMesh->GetIndex(i + 1)],
+          clusterOf[subMesh->GetIndex(i + 2)]}};
+      if (triangle[0] == triangle[1] || triangle[1] == triangle[2] ||
+          triangle[0] == triangle[2])
+      {
+        continue;
+      }
+
+      std::array<unsigned int, 3> sorted = triangle;
+      std::sort(sorted.begin(), sorted.end());
+      if (!triangles.insert(sorted).second)
+        continue;
+
+      ignition::math::Vector3d corners[3];
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        const unsigned int cluster = triangle[k];
+        corners[k] = sums[cluster] / counts[cluster];
+        if (newIndex[cluster] < 0)
+        {
+          newIndex[cluster] = static_cast<int>(simplified->GetVertexCount());
+          simplified->AddVertex(corners[k]);
+          normals.push_back(ignition::math::Vector3d::Zero);
+        }
+        simplified->AddIndex(newIndex[cluster]);
+      }
+
+      // Vertex normals are the average of the face normals
+      const ignition::math::Vector3d normal =
+          ignition::math::Vector3d::Normal(corners[0], corners[1], corners[2]);
+      for (unsigned int k = 0; k < 3; ++k)
+        normals[newIndex[triangle[k]]] += normal;
+    }
+
+    for (auto &normal : normals)
+      simplified->AddNormal(normal.Normalize());
+  }
+
+  return result;
+}
+
+/// \brief Simplify a mesh, see MeshManager::CreateSimplified.
+/// \param[in] _mesh The mesh.
+/// \param[in] _maxTriangles The maximum number of triangles.
+/// \return The new mesh.
+Mesh *SimplifyMesh(const Mesh *_mesh, const unsigned int _maxTriangles)
+{
+  const ignition::math::Vector3d min = _mesh->Min();
+  const double extent = (_mesh->Max() - min).Max();
+  if (TriangleCount(_mesh) <= _maxTriangles || !(extent > 0))
+    return CopyMesh(_mesh);
+
+  // A closed surface clustered in a grid of n cells per side has about
+  // 4 n^2 triangles. Enlarge the cells until the mesh fits.
+  double cells = std::max(1.0, std::sqrt(_maxTriangles / 4.0));
+  while (true)
+  {
+    Mesh *simplified = ClusterVertices(_mesh, min, extent / cells);
+    if (cells <= 1.0 || TriangleCount(simplified) <= _maxTriangles)
+      return simplified;
+
+    delete simplified;
+    cells = std::max(1.0, cells * 0.75);
+  }
+}
+}
+
+//////////////////////////////////////////////////
+class MeshJobPrivate
+{
+  /// \brief Name of the mesh.
+  public: std::string name;
+
+  /// \brief Generates the mesh, cleared when the job runs.
+  public: std::function<Mesh *()> generate;
+
+  /// \brief Status of the job.
+  public: MeshJob::Status status = MeshJob::QUEUED;
+
+  /// \brief True if the job was canceled while running.
+  public: bool cancelRequested = false;
+
+  /// \brief The mesh of a completed job.
+  public: const Mesh *result = nullptr;
+
+  /// \brief Protects the status and the result.
+  public: mutable boost::mutex mutex;
+
+  /// \brief Notified when the job is over.
+  public: mutable boost::condition_variable condition;
+};
+
 //////////////////////////////////////////////////
 class MeshManagerPrivate
 {
-  /// \brief 3D mesh loader for COLLADA files
-  public: ColladaLoader *colladaLoader = nullptr;
+  /// \brief Get a copy of a generated mesh, generating it unless a mesh
+  /// with the same inputs was memoized.
+  /// \param[in] _key Digest of the inputs, see ExtrudedPolylineKey.
+  /// \param[in] _generate Generates the mesh, returns null on failure.
+  /// \param[in] _gts True if _generate uses GTS, which is not thread safe.
+  /// \return A new mesh owned by the caller, or null.
+  public: Mesh *Generate(const std::string &_key,
+              const std::function<Mesh *()> &_generate, const bool _gts)
+  {
+    {
+      boost::mutex::scoped_lock lock(this->generatedMutex);
+      auto iter = this->generated.find(_key);
+      if (iter != this->generated.end())
+        return CopyMesh(iter->second.get());
+    }
+
+    Mesh *mesh;
+    if (_gts)
+    {
+      boost::mutex::scoped_lock lock(this->gtsMutex);
+      mesh = _generate();
+    }
+    else
+    {
+      mesh = _generate();
+    }
+
+    if (!mesh)
+      return nullptr;
+
+    boost::mutex::scoped_lock lock(this->generatedMutex);
+    if (this->generated.find(_key) == this->generated.end())
+    {
+      this->generated[_key].reset(CopyMesh(mesh));
+      this->generatedOrder.push_back(_key);
+      if (this->generatedOrder.size() > kMaxGeneratedMeshes)
+      {
+        this->generated.erase(this->generatedOrder.front());
+        this->generatedOrder.pop_front();
+      }
+    }
+
+    return mesh;
+  }
+
+  /// \brief Add a generated mesh, unless a mesh with the same name exists.
+  /// \param[in] _name Name of the mesh.
+  /// \param[in] _mesh The mesh, deleted if not added.
+  /// \return The mesh with the name.
+  public: const Mesh *Insert(const std::string &_name, Mesh *_mesh)
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    auto iter = this->meshes.find(_name);
+    if (iter != this->meshes.end())
+    {
+      delete _mesh;
+      return iter->second;
+    }
+
+    _mesh->SetName(_name);
+    this->meshes[_name] = _mesh;
+    return _mesh;
+  }
+
+  /// \brief Get whether a mesh exists. Thread safe.
+  /// \param[in] _name Name of the mesh.
+  /// \return True if the mesh exists.
+  public: bool Exists(const std::string &_name)
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    return this->meshes.find(_name) != this->meshes.end();
+  }
 
   /// \brief 3D mesh exporter for COLLADA files
   public: ColladaExporter *colladaExporter = nullptr;
 
-  /// \brief 3D mesh loader for STL files
-  public: STLLoader *stlLoader = nullptr;
-
   // \brief 3D mesh loader for FBX files
   // \todo The FBX loader needs to be implemented.
   // public: FBXLoader *fbxLoader = nullptr;
@@ -62,22 +545,131 @@ class MeshManagerPrivate
   /// \brief supported file extensions for meshes
   public: std::vector<std::string> fileExtensions;
 
-  /// \brief Mutex to protect from loading the same mesh in different threads
-  /// at the same time.
+  /// \brief Mutex to protect the meshes, the meshes being loaded and the
+  /// cache.
   public: boost::mutex mutex;
+
+  /// \brief Names of the meshes being loaded by Load. A thread that
+  /// requests a mesh in this set waits for the loading thread instead of
+  /// decoding the file a second time.
+  public: std::set<std::string> loading;
+
+  /// \brief Notified when a mesh is removed from the loading set.
+  public: boost::condition_variable loadingCondition;
+
+  /// \brief On disk cache of decoded meshes, null if disabled.
+  public: std::shared_ptr<MeshCache> cache;
+
+  /// \brief True to store loaded meshes in compact buffers.
+  public: bool compact = false;
+
+  /// \brief Maximum number of triangles of collision meshes, 0 for no
+  /// limit.
+  public: unsigned int collisionTriangleLimit = 0;
+
+  /// \brief Generated meshes, by their inputs.
+  public: std::map<std::string, std::unique_ptr<Mesh>> generated;
+
+  /// \brief Keys of the generated meshes, oldest first.
+  public: std::deque<std::string> generatedOrder;
+
+  /// \brief Protects the generated meshes.
+  public: boost::mutex generatedMutex;
+
+  /// \brief Serializes the GTS operations.
+  public: boost::mutex gtsMutex;
+
+  /// \brief Jobs waiting for the background thread.
+  public: std::deque<MeshJobPtr> jobs;
+
+  /// \brief Background thread running the jobs, started by the first job.
+  public: std::thread jobThread;
+
+  /// \brief True to stop the background thread.
+  public: bool stopJobs = false;
+
+  /// \brief Protects the jobs.
+  public: boost::mutex jobMutex;
+
+  /// \brief Notified when a job is queued.
+  public: boost::condition_variable jobCondition;
 };
 
-// added here for ABI compatibility
-// TODO move to header / private class when merging forward.
-static OBJLoader objLoader;
+//////////////////////////////////////////////////
+MeshJob::MeshJob(const std::string &_name)
+  : dataPtr(new MeshJobPrivate)
+{
+  this->dataPtr->name = _name;
+}
+
+//////////////////////////////////////////////////
+MeshJob::~MeshJob()
+{
+}
+
+//////////////////////////////////////////////////
+std::string MeshJob::Name() const
+{
+  return this->dataPtr->name;
+}
+
+//////////////////////////////////////////////////
+MeshJob::Status MeshJob::JobStatus() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->status;
+}
+
+//////////////////////////////////////////////////
+bool MeshJob::Done() const
+{
+  const Status status = this->JobStatus();
+  return status != QUEUED && status != RUNNING;
+}
+
+//////////////////////////////////////////////////
+void MeshJob::Wait() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  while (this->dataPtr->status == QUEUED ||
+         this->dataPtr->status == RUNNING)
+  {
+    this->dataPtr->condition.wait(lock);
+  }
+}
+
+//////////////////////////////////////////////////
+void MeshJob::Cancel()
+{
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    if (this->dataPtr->status == RUNNING)
+    {
+      this->dataPtr->cancelRequested = true;
+      return;
+    }
+
+    if (this->dataPtr->status != QUEUED)
+      return;
+
+    this->dataPtr->status = CANCELED;
+    this->dataPtr->generate = nullptr;
+  }
+  this->dataPtr->condition.notify_all();
+}
+
+//////////////////////////////////////////////////
+const Mesh *MeshJob::Result() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->result;
+}
 
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
   : dataPtr(new MeshManagerPrivate)
 {
-  this->dataPtr->colladaLoader = new ColladaLoader();
   this->dataPtr->colladaExporter = new ColladaExporter();
-  this->dataPtr->stlLoader = new STLLoader();
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -111,14 +703,40 @@ MeshManager::MeshManager()
   this->dataPtr->fileExtensions.push_back("stlb");
   this->dataPtr->fileExtensions.push_back("dae");
   this->dataPtr->fileExtensions.push_back("obj");
+
+  // The on disk cache is opt in
+  const char *cachePath = getenv("GAZEBO_MESH_CACHE_PATH");
+  if (cachePath)
+    this->SetCachePath(cachePath);
+
+  const char *compact = getenv("GAZEBO_MESH_COMPACT");
+  this->dataPtr->compact = compact && std::string(compact) == "1";
+
+  const char *collisionLimit = getenv("GAZEBO_COLLISION_MESH_MAX_TRIANGLES");
+  if (collisionLimit)
+  {
+    this->dataPtr->collisionTriangleLimit =
+        static_cast<unsigned int>(strtoul(collisionLimit, nullptr, 10));
+  }
 }
 
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
-  delete this->dataPtr->colladaLoader;
+  // Stop the background thread after the running job, and cancel the
+  // queued ones
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->jobMutex);
+    this->dataPtr->stopJobs = true;
+  }
+  this->dataPtr->jobCondition.notify_all();
+  if (this->dataPtr->jobThread.joinable())
+    this->dataPtr->jobThread.join();
+  for (auto &job : this->dataPtr->jobs)
+    job->Cancel();
+  this->dataPtr->jobs.clear();
+
   delete this->dataPtr->colladaExporter;
-  delete this->dataPtr->stlLoader;
   for (auto &pairNameMesh : this->dataPtr->meshes)
   {
     delete pairNameMesh.second;
@@ -142,21 +760,27 @@ const Mesh *MeshManager::Load(const std::string &_filename)
 
   std::string extension;
 
-  if (this->HasMesh(_filename))
-  {
-    return this->dataPtr->meshes[_filename];
-
-    // This breaks trimesh geom. Each new trimesh should have a unique name.
-    /*
-    // erase mesh from this->dataPtr->meshes.
-    // This allows a mesh to be modified and
-    // inserted into gazebo again without closing gazebo.
-    std::map<std::string, Mesh*>::iterator iter;
-    iter = this->dataPtr->meshes.find(_filename);
-    delete iter->second;
-    iter->second = nullptr;
-    this->dataPtr->meshes.erase(iter);
-    */
+  {
+    // The map is also filled by other threads loading meshes.
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->meshes.find(_filename);
+    if (iter != this->dataPtr->meshes.end())
+    {
+      return iter->second;
+
+      // This breaks trimesh geom. Each new trimesh should have a unique
+      // name.
+      /*
+      // erase mesh from this->dataPtr->meshes.
+      // This allows a mesh to be modified and
+      // inserted into gazebo again without closing gazebo.
+      std::map<std::string, Mesh*>::iterator iter;
+      iter = this->dataPtr->meshes.find(_filename);
+      delete iter->second;
+      iter->second = nullptr;
+      this->dataPtr->meshes.erase(iter);
+      */
+    }
   }
 
   std::string fullname = common::find_file(_filename);
@@ -166,46 +790,78 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
     std::transform(extension.begin(), extension.end(),
         extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
+    // Each load uses its own loader, the loaders keep per file state.
+    std::unique_ptr<MeshLoader> loader;
 
     if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->dataPtr->stlLoader;
+      loader.reset(new STLLoader());
     else if (extension == "dae")
-      loader = this->dataPtr->colladaLoader;
+      loader.reset(new ColladaLoader());
     else if (extension == "obj")
-      loader = &objLoader;
+      loader.reset(new OBJLoader());
     else
     {
       gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
       return nullptr;
     }
 
-    try
+    // Only one thread loads a given mesh. Different meshes are decoded
+    // concurrently, the mutex is not held while decoding.
+    std::shared_ptr<MeshCache> cache;
+    bool compact;
     {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
       boost::mutex::scoped_lock lock(this->dataPtr->mutex);
-      if (!this->HasMesh(_filename))
-      {
-        if ((mesh = loader->Load(fullname)) != nullptr)
-        {
-          mesh->SetName(_filename);
-          this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
-        }
-        else
-          gzerr << "Unable to load mesh[" << fullname << "]\n";
-      }
-      else
-      {
-        mesh = this->dataPtr->meshes[_filename];
-      }
+      while (this->dataPtr->loading.count(_filename) > 0)
+        this->dataPtr->loadingCondition.wait(lock);
+
+      auto iter = this->dataPtr->meshes.find(_filename);
+      if (iter != this->dataPtr->meshes.end())
+        return iter->second;
+
+      this->dataPtr->loading.insert(_filename);
+      cache = this->dataPtr->cache;
+      compact = this->dataPtr->compact;
+    }
+
+    try
+    {
+      // Decoded meshes are cached on disk to skip parsing on the next
+      // start.
+      if (cache)
+        mesh = cache->Load(fullname);
+
+      if (!mesh && (mesh = loader->Load(fullname)) != nullptr && cache)
+        cache->Save(fullname, mesh);
+
+      if (mesh && compact && !mesh->HasSkeleton())
+        mesh->Compact();
     }
     catch(gazebo::common::Exception &e)
     {
+      {
+        boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+        this->dataPtr->loading.erase(_filename);
+      }
+      this->dataPtr->loadingCondition.notify_all();
+
       gzerr << "Error loading mesh[" << fullname << "]\n";
       gzerr << e << "\n";
       gzthrow(e);
     }
+
+    {
+      boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+      if (mesh)
+      {
+        mesh->SetName(_filename);
+        this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
+      }
+      this->dataPtr->loading.erase(_filename);
+    }
+    this->dataPtr->loadingCondition.notify_all();
+
+    if (!mesh)
+      gzerr << "Unable to load mesh[" << fullname << "]\n";
   }
   else
     gzerr << "Unable to find file[" << _filename << "]\n";
@@ -213,6 +869,51 @@ const Mesh *MeshManager::Load(const std::string &_filename)
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void MeshManager::SetCachePath(const std::string &_path)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  if (_path.empty())
+    this->dataPtr->cache.reset();
+  else
+    this->dataPtr->cache.reset(new MeshCache(_path));
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::CachePath() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->cache ? this->dataPtr->cache->Path() : "";
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetCompactMeshes(const bool _compact)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  this->dataPtr->compact = _compact;
+}
+
+//////////////////////////////////////////////////
+bool MeshManager::CompactMeshes() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->compact;
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetCollisionTriangleLimit(const unsigned int _maxTriangles)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  this->dataPtr->collisionTriangleLimit = _maxTriangles;
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshManager::CollisionTriangleLimit() const
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  return this->dataPtr->collisionTriangleLimit;
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -249,28 +950,33 @@ void MeshManager::GetMeshAABB(const Mesh *_mesh,
     ignition::math::Vector3d &_center,
     ignition::math::Vector3d &_minXYZ, ignition::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GetAABB(_center, _minXYZ, _maxXYZ);
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GetAABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const ignition::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()]->GenSphericalTexCoord(_center);
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->GetName());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->GetName()))
-    this->dataPtr->meshes[_mesh->GetName()] = _mesh;
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  this->dataPtr->meshes.insert(std::make_pair(_mesh->GetName(), _mesh));
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::GetMesh(const std::string &_name) const
 {
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
 
   iter = this->dataPtr->meshes.find(_name);
@@ -287,10 +993,7 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
-  std::map<std::string, Mesh*>::const_iterator iter;
-  iter = this->dataPtr->meshes.find(_name);
-
-  return iter != this->dataPtr->meshes.end();
+  return this->dataPtr->Exists(_name);
 }
 
 //////////////////////////////////////////////////
@@ -310,7 +1013,6 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -351,6 +1053,8 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
       }
     }
   }
+
+  this->dataPtr->Insert(name, mesh);
 }
 
 //////////////////////////////////////////////////
@@ -378,7 +1082,6 @@ void MeshManager::CreatePlane(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -402,6 +1105,7 @@ void MeshManager::CreatePlane(const std::string &_name,
   if (!xform.IsAffine())
   {
     gzerr << "Matrix is not affine, plane creation failed\n";
+    delete mesh;
     return;
   }
 
@@ -442,6 +1146,8 @@ void MeshManager::CreatePlane(const std::string &_name,
   }
 
   this->Tesselate2DMesh(subMesh, _segments.X() + 1, _segments.Y() + 1, false);
+
+  this->dataPtr->Insert(_name, mesh);
 }
 
 //////////////////////////////////////////////////
@@ -458,7 +1164,6 @@ void MeshManager::CreateBox(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -544,19 +1249,183 @@ void MeshManager::CreateBox(const std::string &_name,
   // Set the indices
   for (i = 0; i < 36; ++i)
     subMesh->AddIndex(ind[i]);
+
+  this->dataPtr->Insert(_name, mesh);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     const std::vector<std::vector<ignition::math::Vector2d> > &_polys,
     double _height)
+{
+  if (this->dataPtr->Exists(_name))
+    return;
+
+  // Editors extrude the same polylines again on every change
+  Mesh *mesh = this->dataPtr->Generate(ExtrudedPolylineKey(_polys, _height),
+      [&]()
+      {
+        return MeshManager::ExtrudePolyline(_polys, _height);
+      }, true);
+
+  if (mesh)
+    this->dataPtr->Insert(_name, mesh);
+}
+
+//////////////////////////////////////////////////
+MeshJobPtr MeshManager::CreateExtrudedPolylineAsync(const std::string &_name,
+    const std::vector<std::vector<ignition::math::Vector2d> > &_polys,
+    double _height)
+{
+  return this->Enqueue(_name, [this, _polys, _height]()
+      {
+        return this->dataPtr->Generate(ExtrudedPolylineKey(_polys, _height),
+            [&]()
+            {
+              return MeshManager::ExtrudePolyline(_polys, _height);
+            }, true);
+      });
+}
+
+//////////////////////////////////////////////////
+void MeshManager::CreateSimplified(const std::string &_name,
+    const Mesh *_mesh, const unsigned int _maxTriangles)
+{
+  if (!_mesh || this->dataPtr->Exists(_name))
+    return;
+
+  Mesh *mesh = this->dataPtr->Generate(SimplifiedKey(_mesh, _maxTriangles),
+      [&]()
+      {
+        return SimplifyMesh(_mesh, _maxTriangles);
+      }, false);
+
+  if (mesh)
+    this->dataPtr->Insert(_name, mesh);
+}
+
+//////////////////////////////////////////////////
+MeshJobPtr MeshManager::CreateSimplifiedAsync(const std::string &_name,
+    const Mesh *_mesh, const unsigned int _maxTriangles)
+{
+  if (!_mesh)
+    return this->Enqueue(_name, []() -> Mesh * { return nullptr; });
+
+  std::shared_ptr<Mesh> mesh(CopyMesh(_mesh));
+  return this->Enqueue(_name, [this, mesh, _maxTriangles]()
+      {
+        return this->dataPtr->Generate(SimplifiedKey(mesh.get(), _maxTriangles),
+            [&]()
+            {
+              return SimplifyMesh(mesh.get(), _maxTriangles);
+            }, false);
+      });
+}
+
+//////////////////////////////////////////////////
+MeshJobPtr MeshManager::Enqueue(const std::string &_name,
+    std::function<Mesh *()> _generate)
+{
+  MeshJobPtr job(new MeshJob(_name));
+
+  // Like the synchronous functions, an existing mesh is kept
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->meshes.find(_name);
+    if (iter != this->dataPtr->meshes.end())
+    {
+      job->dataPtr->status = MeshJob::COMPLETED;
+      job->dataPtr->result = iter->second;
+      return job;
+    }
+  }
+
+  job->dataPtr->generate = std::move(_generate);
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->jobMutex);
+    if (!this->dataPtr->jobThread.joinable())
+      this->dataPtr->jobThread = std::thread(&MeshManager::RunJobs, this);
+    this->dataPtr->jobs.push_back(job);
+  }
+  this->dataPtr->jobCondition.notify_one();
+
+  return job;
+}
+
+//////////////////////////////////////////////////
+void MeshManager::RunJobs()
+{
+  while (true)
+  {
+    MeshJobPtr job;
+    {
+      boost::mutex::scoped_lock lock(this->dataPtr->jobMutex);
+      while (this->dataPtr->jobs.empty() && !this->dataPtr->stopJobs)
+        this->dataPtr->jobCondition.wait(lock);
+
+      if (this->dataPtr->stopJobs)
+        return;
+
+      job = this->dataPtr->jobs.front();
+      this->dataPtr->jobs.pop_front();
+    }
+
+    MeshJobPrivate &jobData = *job->dataPtr;
+    std::function<Mesh *()> generate;
+    {
+      boost::mutex::scoped_lock lock(jobData.mutex);
+      if (jobData.status != MeshJob::QUEUED)
+        continue;
+      jobData.status = MeshJob::RUNNING;
+      generate = std::move(jobData.generate);
+    }
+
+    Mesh *mesh = nullptr;
+    try
+    {
+      mesh = generate();
+    }
+    catch(gazebo::common::Exception &_e)
+    {
+      gzerr << "Unable to create mesh[" << jobData.name << "]: " << _e
+            << std::endl;
+    }
+
+    bool canceled;
+    {
+      boost::mutex::scoped_lock lock(jobData.mutex);
+      canceled = jobData.cancelRequested;
+    }
+
+    const Mesh *result = nullptr;
+    if (canceled)
+      delete mesh;
+    else if (mesh)
+      result = this->dataPtr->Insert(jobData.name, mesh);
+
+    {
+      boost::mutex::scoped_lock lock(jobData.mutex);
+      jobData.result = result;
+      if (canceled)
+        jobData.status = MeshJob::CANCELED;
+      else
+        jobData.status = result ? MeshJob::COMPLETED : MeshJob::FAILED;
+    }
+    jobData.condition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshManager::ExtrudePolyline(
+    const std::vector<std::vector<ignition::math::Vector2d> > &_polys,
+    double _height)
 {
   // distance tolerence between 2 points. This is used when creating a list
   // of distinct points in the polylines.
   double tol = 1e-4;
   #if !HAVE_GTS
     gzerr << "GTS library not found. Can not extrude polyline" << std::endl;
-    return;
+    return nullptr;
   #endif
   auto polys = _polys;
   // close all the loops
@@ -576,13 +1445,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  if (this->HasMesh(_name))
-  {
-    return;
-  }
-
   Mesh *mesh = new Mesh();
-  mesh->SetName(_name);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -598,7 +1461,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   {
     gzerr << "Unable to triangulate polyline." << std::endl;
     delete mesh;
-    return;
+    return nullptr;
   }
   #endif
 
@@ -688,7 +1551,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   {
     gzerr << "Unable to extrude mesh. Triangulation failed" << std::endl;
     delete mesh;
-    return;
+    return nullptr;
   }
 
   unsigned int numVertices = subMesh->GetVertexCount();
@@ -759,8 +1622,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
-  return;
+  return mesh;
 }
 
 //////////////////////////////////////////////////
@@ -775,7 +1637,6 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -858,6 +1719,8 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
     subMesh->AddIndex(ind[i]);
 
   mesh->RecalculateNormals();
+
+  this->dataPtr->Insert(_name, mesh);
 }
 
 //////////////////////////////////////////////////
@@ -876,7 +1739,6 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -975,6 +1837,8 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
       subMesh->AddIndex(verticeIndex - segments + seg);
     }
   }
+
+  this->dataPtr->Insert(name, mesh);
 }
 
 //////////////////////////////////////////////////
@@ -993,7 +1857,6 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1085,6 +1948,8 @@ void MeshManager::CreateCone(const std::string &name, float radius,
   }
 
   mesh->RecalculateNormals();
+
+  this->dataPtr->Insert(name, mesh);
 }
 
 //////////////////////////////////////////////////
@@ -1110,7 +1975,6 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
@@ -1252,6 +2116,8 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
   }
 
   mesh->RecalculateNormals();
+
+  this->dataPtr->Insert(_name, mesh);
 }
 
 //////////////////////////////////////////////////
@@ -1325,13 +2191,38 @@ void MeshManager::Tesselate2DMesh(SubMesh *sm, int meshWidth, int meshHeight,
 void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
     const Mesh *_m2, int _operation, const ignition::math::Pose3d &_offset)
 {
-  if (this->HasMesh(_name))
+  if (this->dataPtr->Exists(_name))
     return;
 
-  MeshCSG csg;
-  Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
-  mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  Mesh *mesh = this->dataPtr->Generate(
+      BooleanKey(_m1, _m2, _operation, _offset), [&]()
+      {
+        MeshCSG csg;
+        return csg.CreateBoolean(_m1, _m2, _operation, _offset);
+      }, true);
+
+  if (mesh)
+    this->dataPtr->Insert(_name, mesh);
+}
+
+//////////////////////////////////////////////////
+MeshJobPtr MeshManager::CreateBooleanAsync(const std::string &_name,
+    const Mesh *_m1, const Mesh *_m2, const int _operation,
+    const ignition::math::Pose3d &_offset)
+{
+  // The meshes may change or be deleted before the job runs
+  std::shared_ptr<Mesh> m1(CopyMesh(_m1));
+  std::shared_ptr<Mesh> m2(CopyMesh(_m2));
+  return this->Enqueue(_name, [this, m1, m2, _operation, _offset]()
+      {
+        return this->dataPtr->Generate(
+            BooleanKey(m1.get(), m2.get(), _operation, _offset), [&]()
+            {
+              MeshCSG csg;
+              return csg.CreateBoolean(m1.get(), m2.get(), _operation,
+                  _offset);
+            }, true);
+      });
 }
 #endif
 
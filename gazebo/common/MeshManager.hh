@@ -17,6 +17,8 @@
 #ifndef GAZEBO_COMMON_MESHMANAGER_HH_
 #define GAZEBO_COMMON_MESHMANAGER_HH_
 
+#include <functional>
+#include <memory>
 #include <utility>
 #include <string>
 #include <vector>
@@ -38,6 +40,7 @@ namespace gazebo
   namespace common
   {
     // Forward declarations.
+    class MeshJobPrivate;
     class MeshManagerPrivate;
     class Mesh;
     class SubMesh;
@@ -45,6 +48,70 @@ namespace gazebo
     /// \addtogroup gazebo_common Common
     /// \{
 
+    /// \class MeshJob MeshManager.hh common/common.hh
+    /// \brief A mesh generation job, run by the MeshManager in a background
+    /// thread. When the job completes, the mesh is added to the manager
+    /// with the name of the job.
+    class GZ_COMMON_VISIBLE MeshJob
+    {
+      /// \enum Status
+      /// \brief Status of a job.
+      public: enum Status
+              {
+                /// \brief Waiting for the background thread.
+                QUEUED,
+                /// \brief The mesh is being generated.
+                RUNNING,
+                /// \brief The mesh was added to the manager.
+                COMPLETED,
+                /// \brief The mesh could not be generated.
+                FAILED,
+                /// \brief The job was canceled.
+                CANCELED
+              };
+
+      /// \brief Constructor.
+      /// \param[in] _name Name of the mesh.
+      public: explicit MeshJob(const std::string &_name);
+
+      /// \brief Destructor.
+      public: virtual ~MeshJob();
+
+      /// \brief Get the name of the mesh.
+      /// \return Name of the mesh.
+      public: std::string Name() const;
+
+      /// \brief Get the status of the job.
+      /// \return Status of the job.
+      public: Status JobStatus() const;
+
+      /// \brief Get whether the job is over.
+      /// \return True if the job completed, failed or was canceled.
+      public: bool Done() const;
+
+      /// \brief Wait until the job is over.
+      public: void Wait() const;
+
+      /// \brief Cancel the job. A queued job is skipped and is over right
+      /// away. Mesh generation can't be interrupted: a running job still
+      /// runs to the end in the background, then its mesh is discarded
+      /// instead of being added to the manager. Until then its status
+      /// stays RUNNING, see Wait.
+      public: void Cancel();
+
+      /// \brief Get the mesh of a completed job.
+      /// \return The mesh, owned by the manager, or null if the job did not
+      /// complete.
+      public: const Mesh *Result() const;
+
+      /// \brief The manager runs the job.
+      private: friend class MeshManager;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<MeshJobPrivate> dataPtr;
+    };
+
     /// \class MeshManager MeshManager.hh common/common.hh
     /// \brief Maintains and manages all meshes
     class GZ_COMMON_VISIBLE MeshManager : public SingletonT<MeshManager>
@@ -62,6 +129,30 @@ namespace gazebo
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Set the directory of the on disk cache of decoded meshes,
+      /// see MeshCache. The cache is disabled by default, or uses the
+      /// GAZEBO_MESH_CACHE_PATH environment variable when it is set.
+      /// \param[in] _path Cache directory, or an empty string to disable
+      /// the cache.
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory of the on disk cache of decoded meshes.
+      /// \return Cache directory, or an empty string if the cache is
+      /// disabled.
+      public: std::string CachePath() const;
+
+      /// \brief Set whether meshes loaded from now on are stored in compact
+      /// single precision buffers, see SubMesh::Compact. The collision
+      /// engines then reference the buffers instead of copying them.
+      /// Meshes with a skeleton are not compacted. The default is false,
+      /// or true when the GAZEBO_MESH_COMPACT environment variable is 1.
+      /// \param[in] _compact True to compact loaded meshes.
+      public: void SetCompactMeshes(const bool _compact);
+
+      /// \brief Get whether loaded meshes are stored in compact buffers.
+      /// \return True if loaded meshes are compacted.
+      public: bool CompactMeshes() const;
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
@@ -139,6 +230,48 @@ namespace gazebo
                   const std::vector<std::vector<ignition::math::Vector2d> >
                   &_vertices, double _height);
 
+      /// \brief Create an extruded mesh from polylines in a background
+      /// thread. See CreateExtrudedPolyline.
+      /// \param[in] _name the name of the new mesh
+      /// \param[in] _vertices A multidimensional vector of polylines and
+      /// their vertices.
+      /// \param[in] _height the height of extrusion
+      /// \return The job creating the mesh.
+      public: MeshJobPtr CreateExtrudedPolylineAsync(const std::string &_name,
+                  const std::vector<std::vector<ignition::math::Vector2d> >
+                  &_vertices, double _height);
+
+      /// \brief Create a simplified copy of a mesh, with at most a number of
+      /// triangles. The vertices in the same cell of a grid are merged, and
+      /// the cells are enlarged until the mesh fits. Texture coordinates are
+      /// not kept, the result is meant for collisions.
+      /// \param[in] _name the name of the new mesh
+      /// \param[in] _mesh the mesh to simplify
+      /// \param[in] _maxTriangles the maximum number of triangles
+      public: void CreateSimplified(const std::string &_name,
+                  const Mesh *_mesh, const unsigned int _maxTriangles);
+
+      /// \brief Create a simplified copy of a mesh in a background thread.
+      /// See CreateSimplified.
+      /// \param[in] _name the name of the new mesh
+      /// \param[in] _mesh the mesh to simplify, copied before returning
+      /// \param[in] _maxTriangles the maximum number of triangles
+      /// \return The job creating the mesh.
+      public: MeshJobPtr CreateSimplifiedAsync(const std::string &_name,
+                  const Mesh *_mesh, const unsigned int _maxTriangles);
+
+      /// \brief Set the maximum number of triangles of collision meshes.
+      /// Physics mesh shapes use a simplified copy of larger meshes. The
+      /// limit can also be set with the GAZEBO_COLLISION_MESH_MAX_TRIANGLES
+      /// environment variable.
+      /// \param[in] _maxTriangles Maximum number of triangles, 0 for no
+      /// limit.
+      public: void SetCollisionTriangleLimit(const unsigned int _maxTriangles);
+
+      /// \brief Get the maximum number of triangles of collision meshes.
+      /// \return Maximum number of triangles, 0 for no limit.
+      public: unsigned int CollisionTriangleLimit() const;
+
       /// \brief Create a cylinder mesh
       /// \param[in] _name the name of the new mesh
       /// \param[in] _radius the radius of the cylinder in the x y plane
@@ -233,8 +366,38 @@ namespace gazebo
       public: void CreateBoolean(const std::string &_name, const Mesh *_m1,
           const Mesh *_m2, const int _operation,
           const ignition::math::Pose3d &_offset = ignition::math::Pose3d::Zero);
+
+      /// \brief Create a boolean mesh from two meshes in a background
+      /// thread. See CreateBoolean.
+      /// \param[in] _name the name of the new mesh
+      /// \param[in] _m1 the parent mesh, copied before returning
+      /// \param[in] _m2 the child mesh, copied before returning
+      /// \param[in] _operation the boolean operation applied to the two meshes
+      /// \param[in] _offset _m2's pose offset from _m1
+      /// \return The job creating the mesh.
+      public: MeshJobPtr CreateBooleanAsync(const std::string &_name,
+          const Mesh *_m1, const Mesh *_m2, const int _operation,
+          const ignition::math::Pose3d &_offset = ignition::math::Pose3d::Zero);
 #endif
 
+      /// \brief Extrude polylines, see CreateExtrudedPolyline.
+      /// \param[in] _polys the polylines
+      /// \param[in] _height the height of extrusion
+      /// \return The new mesh, or null on failure.
+      private: static Mesh *ExtrudePolyline(
+                   const std::vector<std::vector<ignition::math::Vector2d> >
+                   &_polys, double _height);
+
+      /// \brief Queue a mesh generation job.
+      /// \param[in] _name the name of the new mesh
+      /// \param[in] _generate Generates the mesh in the background thread.
+      /// \return The job.
+      private: MeshJobPtr Enqueue(const std::string &_name,
+                   std::function<Mesh *()> _generate);
+
+      /// \brief Background thread function, which runs the queued jobs.
+      private: void RunJobs();
+
       /// \brief Converts a vector of polylines into a table of vertices and
       /// a list of edges (each made of 2 points from the table of vertices.
       /// \param[in] _polys the polylines
@@ -15,9 +15,14 @@
  *
 */
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "test_config.h"
+#include "gazebo/common/Material.hh"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/MeshManager.hh"
 #include "gazebo/gazebo_config.h"
@@ -266,6 +271,250 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CachePath)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+
+  // The on disk cache is opt in
+  if (!getenv("GAZEBO_MESH_CACHE_PATH"))
+    EXPECT_TRUE(meshManager->CachePath().empty());
+
+  const std::string path = meshManager->CachePath();
+  meshManager->SetCachePath("/tmp/gz_mesh_cache_test");
+  EXPECT_EQ("/tmp/gz_mesh_cache_test", meshManager->CachePath());
+  meshManager->SetCachePath(path);
+  EXPECT_EQ(path, meshManager->CachePath());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, LoadConcurrent)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  meshManager->SetCachePath("");
+
+  const std::string dataPath = std::string(PROJECT_SOURCE_PATH) + "/test/data/";
+  const std::vector<std::string> filenames = {
+      dataPath + "box.dae", dataPath + "box.obj", dataPath + "twoFaces.stl",
+      dataPath + "box_offset.dae"};
+
+  // Several threads load each mesh, all of them get the same mesh
+  const unsigned int threadCount = 8;
+  std::vector<std::vector<const common::Mesh *>> loaded(threadCount);
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < threadCount; ++t)
+  {
+    threads.push_back(std::thread([&, t]()
+        {
+          for (size_t i = 0; i < filenames.size(); ++i)
+          {
+            const std::string &filename =
+                filenames[(i + t) % filenames.size()];
+            loaded[t].push_back(meshManager->Load(filename));
+          }
+        }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (auto const &filename : filenames)
+  {
+    EXPECT_TRUE(meshManager->HasMesh(filename));
+    const common::Mesh *mesh = meshManager->GetMesh(filename);
+    ASSERT_TRUE(mesh != nullptr);
+    EXPECT_GT(mesh->GetVertexCount(), 0u);
+  }
+
+  for (unsigned int t = 0; t < threadCount; ++t)
+  {
+    ASSERT_EQ(filenames.size(), loaded[t].size());
+    for (size_t i = 0; i < filenames.size(); ++i)
+    {
+      EXPECT_EQ(meshManager->GetMesh(filenames[(i + t) % filenames.size()]),
+          loaded[t][i]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateConcurrent)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+
+  // Threads create the same shapes while others look them up. Each shape
+  // is only visible once it is complete.
+  const unsigned int threadCount = 8;
+  const unsigned int shapeCount = 16;
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < threadCount; ++t)
+  {
+    threads.push_back(std::thread([&, t]()
+        {
+          for (unsigned int i = 0; i < shapeCount; ++i)
+          {
+            const std::string name =
+                "concurrent_box_" + std::to_string((i + t) % shapeCount);
+            if (t % 2 == 0)
+            {
+              meshManager->CreateBox(name, ignition::math::Vector3d::One,
+                  ignition::math::Vector2d::One);
+            }
+            else if (meshManager->HasMesh(name))
+            {
+              const common::Mesh *mesh = meshManager->GetMesh(name);
+              ASSERT_TRUE(mesh != nullptr);
+              EXPECT_EQ(24u, mesh->GetVertexCount());
+            }
+          }
+        }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (unsigned int i = 0; i < shapeCount; ++i)
+  {
+    const std::string name = "concurrent_box_" + std::to_string(i);
+    const common::Mesh *mesh = meshManager->GetMesh(name);
+    ASSERT_TRUE(mesh != nullptr);
+    EXPECT_EQ(name, mesh->GetName());
+    EXPECT_EQ(24u, mesh->GetVertexCount());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateSimplified)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  meshManager->CreateSphere("simplify_sphere", 1.0, 64, 64);
+  const common::Mesh *sphere = meshManager->GetMesh("simplify_sphere");
+  ASSERT_TRUE(sphere != nullptr);
+  ASSERT_GT(sphere->GetIndexCount() / 3, 1000u);
+
+  meshManager->CreateSimplified("simplify_sphere_1000", sphere, 1000);
+  const common::Mesh *simplified =
+      meshManager->GetMesh("simplify_sphere_1000");
+  ASSERT_TRUE(simplified != nullptr);
+  EXPECT_EQ(sphere->GetSubMeshCount(), simplified->GetSubMeshCount());
+  EXPECT_LE(simplified->GetIndexCount() / 3, 1000u);
+  EXPECT_GT(simplified->GetIndexCount() / 3, 100u);
+  EXPECT_EQ(simplified->GetVertexCount(), simplified->GetNormalCount());
+
+  // The shape is kept
+  EXPECT_LT((sphere->Max() - simplified->Max()).Length(), 0.2);
+  EXPECT_LT((sphere->Min() - simplified->Min()).Length(), 0.2);
+
+  // Meshes under the limit are copied
+  meshManager->CreateSimplified("simplify_sphere_copy", sphere, 1000000);
+  const common::Mesh *copy = meshManager->GetMesh("simplify_sphere_copy");
+  ASSERT_TRUE(copy != nullptr);
+  EXPECT_EQ(sphere->GetIndexCount(), copy->GetIndexCount());
+  EXPECT_EQ(sphere->GetVertexCount(), copy->GetVertexCount());
+
+  // The same inputs give the same mesh
+  meshManager->CreateSimplified("simplify_sphere_1000_again", sphere, 1000);
+  const common::Mesh *again =
+      meshManager->GetMesh("simplify_sphere_1000_again");
+  ASSERT_TRUE(again != nullptr);
+  EXPECT_NE(simplified, again);
+  EXPECT_EQ(simplified->GetIndexCount(), again->GetIndexCount());
+  EXPECT_EQ(simplified->GetVertexCount(), again->GetVertexCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateSimplifiedMaterials)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  meshManager->CreateSphere("simplify_material_sphere", 1.0, 64, 64);
+  common::Mesh *sphere = const_cast<common::Mesh *>(
+      meshManager->GetMesh("simplify_material_sphere"));
+  ASSERT_TRUE(sphere != nullptr);
+
+  common::Material *material = new common::Material();
+  material->SetDiffuse(ignition::math::Color(1, 0, 0, 1));
+  material->SetTextureImage("texture.png");
+  sphere->GetSubMesh(0)->SetMaterialIndex(sphere->AddMaterial(material));
+
+  // Copies and simplified meshes keep the materials
+  for (auto const maxTriangles : {1000u, 1000000u})
+  {
+    const std::string name = "simplify_material_sphere_" +
+        std::to_string(maxTriangles);
+    meshManager->CreateSimplified(name, sphere, maxTriangles);
+    const common::Mesh *simplified = meshManager->GetMesh(name);
+    ASSERT_TRUE(simplified != nullptr);
+    ASSERT_EQ(1u, simplified->GetMaterialCount());
+    EXPECT_NE(material, simplified->GetMaterial(0));
+    EXPECT_EQ(material->Diffuse(), simplified->GetMaterial(0)->Diffuse());
+    EXPECT_EQ(material->GetTextureImage(),
+        simplified->GetMaterial(0)->GetTextureImage());
+    EXPECT_EQ(sphere->GetSubMesh(0)->GetMaterialIndex(),
+        simplified->GetSubMesh(0)->GetMaterialIndex());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateSimplifiedAsync)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  meshManager->CreateSphere("async_sphere", 1.0, 128, 128);
+  const common::Mesh *sphere = meshManager->GetMesh("async_sphere");
+  ASSERT_TRUE(sphere != nullptr);
+
+  common::MeshJobPtr job =
+      meshManager->CreateSimplifiedAsync("async_sphere_500", sphere, 500);
+  ASSERT_TRUE(job != nullptr);
+  EXPECT_EQ("async_sphere_500", job->Name());
+
+  // A job queued behind the first one is canceled before it runs
+  common::MeshJobPtr canceled =
+      meshManager->CreateSimplifiedAsync("async_sphere_200", sphere, 200);
+  canceled->Cancel();
+
+  job->Wait();
+  EXPECT_TRUE(job->Done());
+  EXPECT_EQ(common::MeshJob::COMPLETED, job->JobStatus());
+  ASSERT_TRUE(job->Result() != nullptr);
+  EXPECT_EQ(meshManager->GetMesh("async_sphere_500"), job->Result());
+  EXPECT_LE(job->Result()->GetIndexCount() / 3, 500u);
+
+  canceled->Wait();
+  EXPECT_EQ(common::MeshJob::CANCELED, canceled->JobStatus());
+  EXPECT_TRUE(canceled->Result() == nullptr);
+  EXPECT_FALSE(meshManager->HasMesh("async_sphere_200"));
+
+  // A job for an existing mesh completes right away
+  common::MeshJobPtr existing =
+      meshManager->CreateSimplifiedAsync("async_sphere_500", sphere, 100);
+  EXPECT_EQ(common::MeshJob::COMPLETED, existing->JobStatus());
+  EXPECT_EQ(job->Result(), existing->Result());
+}
+
+#ifdef HAVE_GTS
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateExtrudedPolylineAsync)
+{
+  std::vector<std::vector<ignition::math::Vector2d> > path;
+  path.push_back({ignition::math::Vector2d(0, 0),
+      ignition::math::Vector2d(1, 0), ignition::math::Vector2d(1, 1),
+      ignition::math::Vector2d(0, 1), ignition::math::Vector2d(0, 0)});
+
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  common::MeshJobPtr job =
+      meshManager->CreateExtrudedPolylineAsync("extruded_async", path, 2.0);
+  job->Wait();
+  EXPECT_EQ(common::MeshJob::COMPLETED, job->JobStatus());
+  ASSERT_TRUE(job->Result() != nullptr);
+
+  // The synchronous version gives the same mesh
+  meshManager->CreateExtrudedPolyline("extruded_sync", path, 2.0);
+  const common::Mesh *mesh = meshManager->GetMesh("extruded_sync");
+  ASSERT_TRUE(mesh != nullptr);
+  EXPECT_EQ(mesh->GetVertexCount(), job->Result()->GetVertexCount());
+  EXPECT_EQ(mesh->GetIndexCount(), job->Result()->GetIndexCount());
+  EXPECT_EQ(mesh->Max(), job->Result()->Max());
+}
+#endif
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
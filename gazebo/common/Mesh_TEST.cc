@@ -15,6 +15,9 @@
  *
 */
 
+#include <memory>
+#include <string>
+
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 
@@ -297,6 +300,71 @@ TEST_F(MeshTest, SubMeshCenter)
   EXPECT_EQ(ignition::math::Vector3d(3.46555, 0.180391, 2.8431), mesh->Min());
 }
 
+/////////////////////////////////////////////////
+// Test compact sub-mesh buffers.
+TEST_F(MeshTest, SubMeshCompact)
+{
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box_offset.dae"));
+  ASSERT_TRUE(mesh != nullptr);
+
+  common::SubMesh expected(mesh->GetSubMesh("Cube"));
+  EXPECT_FALSE(expected.IsCompact());
+  EXPECT_TRUE(expected.VertexBuffer() == nullptr);
+
+  mesh->Compact();
+  const common::SubMesh *compact = mesh->GetSubMesh("Cube");
+  ASSERT_TRUE(compact->IsCompact());
+
+  // Same content, in single precision
+  EXPECT_EQ(expected.GetVertexCount(), compact->GetVertexCount());
+  EXPECT_EQ(expected.GetNormalCount(), compact->GetNormalCount());
+  EXPECT_EQ(expected.GetIndexCount(), compact->GetIndexCount());
+  EXPECT_EQ(expected.GetMaxIndex(), compact->GetMaxIndex());
+  for (unsigned int i = 0; i < expected.GetVertexCount(); ++i)
+  {
+    EXPECT_TRUE(expected.Vertex(i).Equal(compact->Vertex(i), 1e-6));
+    EXPECT_TRUE(expected.Normal(i).Equal(compact->Normal(i), 1e-6));
+  }
+  for (unsigned int i = 0; i < expected.GetIndexCount(); ++i)
+    EXPECT_EQ(expected.GetIndex(i), compact->GetIndex(i));
+  EXPECT_TRUE(expected.Max().Equal(compact->Max(), 1e-5));
+
+  auto vertexBuffer = compact->VertexBuffer();
+  auto indexBuffer = compact->IndexBuffer();
+  ASSERT_TRUE(vertexBuffer != nullptr);
+  ASSERT_TRUE(indexBuffer != nullptr);
+  EXPECT_EQ(compact->GetVertexCount() * 3, vertexBuffer->size());
+  EXPECT_EQ(compact->GetIndexCount(), indexBuffer->size());
+
+  // FillArrays copies the buffers
+  float *vertArr = nullptr;
+  int *indArr = nullptr;
+  compact->FillArrays(&vertArr, &indArr);
+  for (size_t i = 0; i < vertexBuffer->size(); ++i)
+    EXPECT_FLOAT_EQ((*vertexBuffer)[i], vertArr[i]);
+  for (size_t i = 0; i < indexBuffer->size(); ++i)
+    EXPECT_EQ((*indexBuffer)[i], indArr[i]);
+  delete [] vertArr;
+  delete [] indArr;
+
+  // A copy shares the buffers
+  common::SubMesh copy(compact);
+  EXPECT_TRUE(copy.IsCompact());
+  EXPECT_EQ(vertexBuffer, copy.VertexBuffer());
+
+  // Modifying the copy expands it, the shared buffers keep their content
+  const float x = (*vertexBuffer)[0];
+  copy.Translate(ignition::math::Vector3d(1, 0, 0));
+  EXPECT_FALSE(copy.IsCompact());
+  EXPECT_TRUE(copy.VertexBuffer() == nullptr);
+  EXPECT_FLOAT_EQ(x, (*vertexBuffer)[0]);
+  EXPECT_NEAR(x + 1.0, copy.Vertex(0).X(), 1e-6);
+  EXPECT_EQ(compact->GetIndexCount(), copy.GetIndexCount());
+  EXPECT_EQ(vertexBuffer, compact->VertexBuffer());
+}
+
 /////////////////////////////////////////////////
 // Test STL import
 TEST_F(MeshTest, STLRead)
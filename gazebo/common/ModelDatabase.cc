@@ -514,6 +514,9 @@ std::string ModelDatabase::GetModelPath(const std::string &_uri,
       tar_extract_all(tar, const_cast<char*>(outputPath.c_str()));
       path = outputPath + "/" + modelName;
 
+      // The model directory is new, don't let the file lookups miss it
+      SystemPaths::Instance()->ClearFindFileCache();
+
       ModelDatabase::DownloadDependencies(path);
 #endif
     }
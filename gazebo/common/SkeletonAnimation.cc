@@ -298,6 +298,34 @@ std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAt(
 //////////////////////////////////////////////////
 std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAtX(
     const double _x, const std::string &_node, const bool _loop) const
+{
+  return this->PoseAt(this->TimeAtX(_x, _node, _loop), _loop);
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> SkeletonAnimation::NodeNames() const
+{
+  std::vector<std::string> names;
+  names.reserve(this->animations.size());
+  for (auto const &anim : this->animations)
+    names.push_back(anim.first);
+
+  return names;
+}
+
+//////////////////////////////////////////////////
+void SkeletonAnimation::PoseAt(const double _time,
+    std::vector<ignition::math::Matrix4d> &_poses, const bool _loop) const
+{
+  _poses.resize(this->animations.size());
+  size_t i = 0;
+  for (auto const &anim : this->animations)
+    _poses[i++] = anim.second->FrameAt(_time, _loop);
+}
+
+//////////////////////////////////////////////////
+double SkeletonAnimation::TimeAtX(const double _x, const std::string &_node,
+    const bool _loop) const
 {
   std::map<std::string, NodeAnimation*>::const_iterator nodeAnim =
       this->animations.find(_node);
@@ -317,9 +345,7 @@ std::map<std::string, ignition::math::Matrix4d> SkeletonAnimation::PoseAtX(
   while (x > lastX)
     x -= lastX;
 
-  double time = nodeAnim->second->GetTimeAtX(x);
-
-  return this->PoseAt(time, _loop);
+  return nodeAnim->second->GetTimeAtX(x);
 }
 
 //////////////////////////////////////////////////
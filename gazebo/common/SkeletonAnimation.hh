@@ -20,6 +20,7 @@
 #include <map>
 #include <utility>
 #include <string>
+#include <vector>
 
 #include <ignition/math/Matrix4.hh>
 #include <ignition/math/Pose3.hh>
@@ -200,6 +201,35 @@ namespace gazebo
                   const double _x, const std::string &_node,
                   const bool _loop = true) const;
 
+      /// \brief Get the names of the animation nodes, in the order in which
+      /// the indexed version of PoseAt fills the transformations.
+      /// \return Node names.
+      public: std::vector<std::string> NodeNames() const;
+
+      /// \brief Get the transformations of all nodes at a specific time,
+      /// without building a dictionary. The transformations are the same as
+      /// the dictionary version of PoseAt.
+      /// \param[in] _time the time
+      /// \param[out] _poses the transformation of every node, in the order
+      /// of NodeNames
+      /// \param[in] _loop when true, the time is divided by the duration
+      /// (see GetLength)
+      public: void PoseAt(const double _time,
+                  std::vector<ignition::math::Matrix4d> &_poses,
+                  const bool _loop = true) const;
+
+      /// \brief Get the time at which a named node transformation's
+      /// translational value along the X axis is equal to _x.
+      /// \param[in] _x the value along x. You must ensure that _x is within a
+      /// valid range.
+      /// \param[in] _node the name of the animation node
+      /// \param[in] _loop when true, the time is divided by the duration
+      /// (see GetLength)
+      /// \return the time
+      /// \sa PoseAtX
+      public: double TimeAtX(const double _x, const std::string &_node,
+                  const bool _loop = true) const;
+
 
       /// \brief Scales every animation in the animations list
       /// \param[in] _scale the scaling factor
@@ -17,7 +17,11 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <unordered_map>
 
 #include <boost/filesystem.hpp>
 #include <ignition/common/StringUtils.hh>
@@ -34,6 +38,12 @@
   #include "win_dirent.h"
 #endif
 
+#ifdef __linux__
+  #include <sys/inotify.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/ModelDatabase.hh"
@@ -56,8 +66,161 @@ char pathDelimiter()
 /// TODO(chapulina): Move to member variable when porting forward
 std::vector<std::function<std::string (const std::string &)>> g_findFileCbs;
 
+/// \brief Cached FindFile results and directory indexes.
+class gazebo::common::FindFileCache
+{
+  /// \brief Destructor.
+  public: ~FindFileCache()
+  {
+#ifdef __linux__
+    if (this->inotifyFd >= 0)
+      close(this->inotifyFd);
+#endif
+  }
+
+  /// \brief Drop the results, and the indexes of directories that changed.
+  /// Call with the mutex locked.
+  public: void ProcessEvents()
+  {
+#ifdef __linux__
+    if (this->inotifyFd < 0)
+      return;
+
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t len;
+    while ((len = read(this->inotifyFd, buffer, sizeof(buffer))) > 0)
+    {
+      for (char *ptr = buffer; ptr < buffer + len;
+           ptr += sizeof(struct inotify_event) +
+           reinterpret_cast<struct inotify_event *>(ptr)->len)
+      {
+        auto event = reinterpret_cast<struct inotify_event *>(ptr);
+        auto iter = this->watches.find(event->wd);
+        if (iter == this->watches.end())
+          continue;
+
+        this->listings.erase(iter->second);
+        if (event->mask & IN_IGNORED)
+          this->watches.erase(iter);
+        else if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+          inotify_rm_watch(this->inotifyFd, event->wd);
+      }
+
+      // A new file may resolve a name differently
+      this->results.clear();
+    }
+#endif
+  }
+
+  /// \brief Check whether a path relative to a directory may exist, using
+  /// the indexes of the directory and of its sub-directory. Call with the
+  /// mutex locked.
+  /// \param[in] _dir Directory.
+  /// \param[in] _rel Relative path.
+  /// \return False if the path does not exist, true if it may exist.
+  public: bool MayExist(const boost::filesystem::path &_dir,
+              const boost::filesystem::path &_rel)
+  {
+#ifdef __linux__
+    boost::filesystem::path dir = _dir;
+    unsigned int depth = 0;
+    for (auto const &part : _rel)
+    {
+      if (part == "." || part == ".." || part == "/" || depth++ == 2)
+        break;
+
+      const std::set<std::string> *listing = this->Listing(dir.string());
+      if (!listing)
+        return true;
+      if (listing->find(part.string()) == listing->end())
+        return false;
+      dir /= part;
+    }
+#endif
+    return true;
+  }
+
+  /// \brief Get the index of a directory, listed on first use. Call with
+  /// the mutex locked.
+  /// \param[in] _dir Directory.
+  /// \return Names in the directory, or null if it can't be indexed.
+  private: const std::set<std::string> *Listing(const std::string &_dir)
+  {
+#ifdef __linux__
+    auto iter = this->listings.find(_dir);
+    if (iter != this->listings.end())
+      return iter->second.get();
+
+    if (this->inotifyFd < 0)
+    {
+      this->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (this->inotifyFd < 0)
+        return nullptr;
+    }
+
+    // Watch before listing, so a change made while listing is not missed
+    const int wd = inotify_add_watch(this->inotifyFd, _dir.c_str(),
+        IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+        IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+
+    // Directories that can't be watched, such as missing ones, are not
+    // indexed
+    if (wd < 0)
+      return nullptr;
+    this->watches[wd] = _dir;
+
+    std::unique_ptr<std::set<std::string>> listing(
+        new std::set<std::string>());
+    boost::system::error_code ec;
+    for (boost::filesystem::directory_iterator dirIter(_dir, ec), end;
+         !ec && dirIter != end; dirIter.increment(ec))
+    {
+      listing->insert(dirIter->path().filename().string());
+    }
+    if (ec)
+      return nullptr;
+
+    return (this->listings[_dir] = std::move(listing)).get();
+#else
+    return nullptr;
+#endif
+  }
+
+  /// \brief Clear the results and the indexes. Call with the mutex locked.
+  public: void Clear()
+  {
+    this->results.clear();
+    this->listings.clear();
+  }
+
+  /// \brief Protects the cache.
+  public: std::mutex mutex;
+
+  /// \brief Found files, indexed by search key.
+  public: std::unordered_map<std::string, std::string> results;
+
+  /// \brief Directory indexes, by directory.
+  public: std::unordered_map<std::string,
+          std::unique_ptr<std::set<std::string>>> listings;
+
+  /// \brief Number of cache hits.
+  public: uint64_t hits = 0;
+
+  /// \brief Number of cache misses.
+  public: uint64_t misses = 0;
+
+#ifdef __linux__
+  /// \brief inotify instance watching the indexed directories.
+  public: int inotifyFd = -1;
+
+  /// \brief Watched directories, by watch descriptor.
+  public: std::unordered_map<int, std::string> watches;
+#endif
+};
+
 //////////////////////////////////////////////////
 SystemPaths::SystemPaths()
+  : findFileCache(new FindFileCache())
 {
   this->gazeboPaths.clear();
   this->ogrePaths.clear();
@@ -135,6 +298,24 @@ SystemPaths::SystemPaths()
   this->ogrePathsFromEnv = true;
 }
 
+/////////////////////////////////////////////////
+SystemPaths::~SystemPaths()
+{
+}
+
+/////////////////////////////////////////////////
+bool SystemPaths::PathExists(const boost::filesystem::path &_dir,
+    const boost::filesystem::path &_rel)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->findFileCache->mutex);
+    this->findFileCache->ProcessEvents();
+    if (!this->findFileCache->MayExist(_dir, _rel))
+      return false;
+  }
+  return boost::filesystem::exists(_dir / _rel);
+}
+
 /////////////////////////////////////////////////
 std::string SystemPaths::GetLogPath() const
 {
@@ -319,6 +500,8 @@ std::string SystemPaths::FindFileURI(const std::string &_uri)
     for (std::list<std::string>::iterator iter = this->modelPaths.begin();
          iter != this->modelPaths.end(); ++iter)
     {
+      // Not through the directory indexes, ModelDatabase downloads models
+      // into the model paths and then looks them up here.
       path = boost::filesystem::path(*iter) / suffix;
       if (boost::filesystem::exists(path))
       {
@@ -349,6 +532,81 @@ static bool isAbsolute(const std::string &_filename)
 //////////////////////////////////////////////////
 std::string SystemPaths::FindFile(const std::string &_filename,
                                   bool _searchLocalPath)
+{
+  if (_filename.empty())
+    return std::string();
+
+  // Relative names also depend on the working directory
+  std::string key = _searchLocalPath ? "1" : "0";
+  if (_filename.find("://") == std::string::npos && !isAbsolute(_filename))
+  {
+    boost::system::error_code ec;
+    key += boost::filesystem::current_path(ec).string();
+  }
+  key += '\n' + _filename;
+
+  // And on the search paths, which may change through the environment
+  for (auto const &path : this->GetGazeboPaths())
+    key += '\n' + path;
+  key += '\n';
+  for (auto const &path : this->modelPaths)
+    key += '\n' + path;
+  key += '\n';
+  for (auto const &path : this->suffixPaths)
+    key += '\n' + path;
+
+  {
+    std::lock_guard<std::mutex> lock(this->findFileCache->mutex);
+    this->findFileCache->ProcessEvents();
+    auto iter = this->findFileCache->results.find(key);
+    if (iter != this->findFileCache->results.end())
+    {
+      if (boost::filesystem::exists(iter->second))
+      {
+        ++this->findFileCache->hits;
+        return iter->second;
+      }
+      this->findFileCache->results.erase(iter);
+    }
+    ++this->findFileCache->misses;
+  }
+
+  // Resolve without holding the lock, resolving a model URI may download
+  // the model
+  std::string result = this->FindFileUncached(_filename, _searchLocalPath);
+  if (!result.empty())
+  {
+    std::lock_guard<std::mutex> lock(this->findFileCache->mutex);
+    this->findFileCache->results[key] = result;
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+uint64_t SystemPaths::FindFileCacheHits() const
+{
+  std::lock_guard<std::mutex> lock(this->findFileCache->mutex);
+  return this->findFileCache->hits;
+}
+
+//////////////////////////////////////////////////
+uint64_t SystemPaths::FindFileCacheMisses() const
+{
+  std::lock_guard<std::mutex> lock(this->findFileCache->mutex);
+  return this->findFileCache->misses;
+}
+
+//////////////////////////////////////////////////
+void SystemPaths::ClearFindFileCache()
+{
+  std::lock_guard<std::mutex> lock(this->findFileCache->mutex);
+  this->findFileCache->Clear();
+}
+
+//////////////////////////////////////////////////
+std::string SystemPaths::FindFileUncached(const std::string &_filename,
+                                          bool _searchLocalPath)
 {
   boost::filesystem::path path;
 
@@ -376,7 +634,7 @@ std::string SystemPaths::FindFile(const std::string &_filename,
            iter != this->modelPaths.end(); ++iter)
       {
         auto modelPath = boost::filesystem::path(*iter) / path;
-        if (boost::filesystem::exists(modelPath))
+        if (this->PathExists(*iter, path.relative_path()))
         {
           path = modelPath;
           break;
@@ -417,7 +675,7 @@ std::string SystemPaths::FindFile(const std::string &_filename,
       {
         path = boost::filesystem::path((*iter));
         path = boost::filesystem::operator/(path, _filename);
-        if (boost::filesystem::exists(path))
+        if (this->PathExists(*iter, _filename))
         {
           found = true;
           break;
@@ -430,7 +688,9 @@ std::string SystemPaths::FindFile(const std::string &_filename,
           path = boost::filesystem::path(*iter);
           path = boost::filesystem::operator/(path, *suffixIter);
           path = boost::filesystem::operator/(path, _filename);
-          if (boost::filesystem::exists(path))
+          if (this->PathExists(*iter,
+                boost::filesystem::path(*suffixIter).relative_path() /
+                _filename))
           {
             found = true;
             break;
@@ -474,24 +734,28 @@ void SystemPaths::AddFindFileCallback(
 /////////////////////////////////////////////////
 void SystemPaths::ClearGazeboPaths()
 {
+  this->ClearFindFileCache();
   this->gazeboPaths.clear();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearOgrePaths()
 {
+  this->ClearFindFileCache();
   this->ogrePaths.clear();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearPluginPaths()
 {
+  this->ClearFindFileCache();
   this->pluginPaths.clear();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearModelPaths()
 {
+  this->ClearFindFileCache();
   this->modelPaths.clear();
 }
 
@@ -559,7 +823,13 @@ void SystemPaths::InsertUnique(const std::string &_path,
                                std::list<std::string> &_list)
 {
   if (std::find(_list.begin(), _list.end(), _path) == _list.end())
+  {
     _list.push_back(_path);
+
+    // The new path may resolve a name differently
+    std::lock_guard<std::mutex> lock(this->findFileCache->mutex);
+    this->findFileCache->results.clear();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -576,4 +846,5 @@ void SystemPaths::AddSearchPathSuffix(const std::string &_suffix)
     s += "/";
 
   this->suffixPaths.push_back(s);
+  this->ClearFindFileCache();
 }
@@ -29,7 +29,9 @@
 #endif
 
 #include <boost/filesystem.hpp>
+#include <cstdint>
 #include <list>
+#include <memory>
 #include <string>
 
 #include "gazebo/common/CommonTypes.hh"
@@ -44,6 +46,9 @@ namespace gazebo
 {
   namespace common
   {
+    // Forward declare private data class.
+    class FindFileCache;
+
     /// \addtogroup gazebo_common Common
     /// \{
 
@@ -61,6 +66,9 @@ namespace gazebo
       /// Constructor for SystemPaths
       private: SystemPaths();
 
+      /// \brief Destructor
+      private: virtual ~SystemPaths();
+
       /// \brief Get the log path
       /// \return the path
       public: std::string GetLogPath() const;
@@ -109,6 +117,12 @@ namespace gazebo
       /// \brief Find a file in the gazebo paths. If not found locally, all
       /// callbacks added with AddFindFileCallback will be called in order
       /// until found.
+      ///
+      /// Found files are cached. A cached result is used while the file
+      /// exists and the search paths did not change. On Linux, the top two
+      /// levels of each search path are also indexed, so most candidate
+      /// paths are rejected without a file system access. The indexes are
+      /// refreshed through inotify when the directories change.
       /// \param[in] _filename Name of the file to find.
       /// \param[in] _searchLocalPath True to search in the current working
       /// directory.
@@ -116,6 +130,19 @@ namespace gazebo
       public: std::string FindFile(const std::string &_filename,
                                    bool _searchLocalPath = true);
 
+      /// \brief Get the number of FindFile calls answered by the cache.
+      /// \return Number of cache hits.
+      public: uint64_t FindFileCacheHits() const;
+
+      /// \brief Get the number of FindFile calls that searched the paths.
+      /// \return Number of cache misses.
+      public: uint64_t FindFileCacheMisses() const;
+
+      /// \brief Clear the cached FindFile results and directory indexes.
+      /// Call it after writing files into the search paths from another
+      /// host, or before inotify reports the change.
+      public: void ClearFindFileCache();
+
       /// \brief Add a callback to use when Gazebo can't find a file.
       /// The callback should return a full local path to the requested file, or
       /// and empty string if the file was not found in the callback.
@@ -175,6 +202,23 @@ namespace gazebo
       /// \brief re-read SystemPaths#ogrePaths from environment variable
       private: void UpdateOgrePaths();
 
+      /// \brief Find a file in the gazebo paths without using the cached
+      /// results, see FindFile.
+      /// \param[in] _filename Name of the file to find.
+      /// \param[in] _searchLocalPath True to search in the current working
+      /// directory.
+      /// \return Full path name to file, or an empty string.
+      private: std::string FindFileUncached(const std::string &_filename,
+                                            bool _searchLocalPath);
+
+      /// \brief Check whether a path exists, using the directory indexes
+      /// first.
+      /// \param[in] _dir Search directory.
+      /// \param[in] _rel Path relative to the search directory.
+      /// \return True if _dir/_rel exists.
+      private: bool PathExists(const boost::filesystem::path &_dir,
+                               const boost::filesystem::path &_rel);
+
       /// \brief adds a path to the list if not already present
       /// \param[in]_path the path
       /// \param[in]_list the list
@@ -219,6 +263,9 @@ namespace gazebo
 
       /// \brief Path to the instance temporary directory
       private: boost::filesystem::path tmpInstancePath;
+
+      /// \brief Cached FindFile results and directory indexes.
+      private: std::unique_ptr<FindFileCache> findFileCache;
     };
     /// \}
   }
@@ -15,6 +15,9 @@
  *
 */
 #include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
 
 #include <string>
 #include <vector>
@@ -90,6 +93,85 @@ TEST_F(SystemPathsTest, FindFile)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(SystemPathsTest, FindFileCache)
+{
+  namespace fs = boost::filesystem;
+  auto sysPaths = common::SystemPaths::Instance();
+
+  const fs::path tmpPath = fs::temp_directory_path() /
+      fs::unique_path("gz_find_file-%%%%-%%%%");
+  fs::create_directories(tmpPath / "media" / "models");
+  std::ofstream((tmpPath / "media" / "models" / "cached.dae").string());
+
+  sysPaths->AddGazeboPaths(tmpPath.string());
+  const std::string expected =
+      (tmpPath / "media" / "models" / "cached.dae").string();
+
+  // The first lookup searches the paths, the next ones use the cache
+  const uint64_t hits = sysPaths->FindFileCacheHits();
+  const uint64_t misses = sysPaths->FindFileCacheMisses();
+  EXPECT_EQ(expected, sysPaths->FindFile("cached.dae", false));
+  EXPECT_EQ(misses + 1, sysPaths->FindFileCacheMisses());
+  EXPECT_EQ(expected, sysPaths->FindFile("cached.dae", false));
+  EXPECT_EQ(expected, sysPaths->FindFile("cached.dae", false));
+  EXPECT_EQ(hits + 2, sysPaths->FindFileCacheHits());
+  EXPECT_EQ(misses + 1, sysPaths->FindFileCacheMisses());
+
+  // A missing file is searched for on every lookup
+  EXPECT_EQ("", sysPaths->FindFile("uncached.dae", false));
+  EXPECT_EQ("", sysPaths->FindFile("uncached.dae", false));
+  EXPECT_EQ(misses + 3, sysPaths->FindFileCacheMisses());
+
+  // New files are found, also with the directory indexes
+  std::ofstream((tmpPath / "uncached.dae").string());
+  EXPECT_EQ((tmpPath / "uncached.dae").string(),
+      sysPaths->FindFile("uncached.dae", false));
+  fs::create_directories(tmpPath / "meshes");
+  std::ofstream((tmpPath / "meshes" / "new.dae").string());
+  EXPECT_EQ((tmpPath / "meshes" / "new.dae").string(),
+      sysPaths->FindFile("meshes/new.dae", false));
+
+  // A cached file that was removed is not returned
+  fs::remove(expected);
+  EXPECT_EQ("", sysPaths->FindFile("cached.dae", false));
+
+  // The file is found again where it now exists
+  std::ofstream((tmpPath / "cached.dae").string());
+  EXPECT_EQ((tmpPath / "cached.dae").string(),
+      sysPaths->FindFile("cached.dae", false));
+
+  sysPaths->ClearFindFileCache();
+  EXPECT_EQ((tmpPath / "cached.dae").string(),
+      sysPaths->FindFile("cached.dae", false));
+
+  fs::remove_all(tmpPath);
+}
+
+//////////////////////////////////////////////////
+TEST_F(SystemPathsTest, FindFileURICache)
+{
+  namespace fs = boost::filesystem;
+  auto sysPaths = common::SystemPaths::Instance();
+
+  const fs::path tmpPath = fs::temp_directory_path() /
+      fs::unique_path("gz_find_file_uri-%%%%-%%%%");
+  fs::create_directories(tmpPath);
+  sysPaths->AddModelPaths(tmpPath.string());
+
+  // Index the model path through an absolute path lookup
+  EXPECT_EQ("", sysPaths->FindFile("/gz_missing_dir/missing.dae", false));
+
+  // A model added afterwards, e.g. by ModelDatabase, is found
+  fs::create_directories(tmpPath / "new_model");
+  EXPECT_EQ((tmpPath / "new_model").string(),
+      sysPaths->FindFileURI("model://new_model"));
+  EXPECT_EQ((tmpPath / "new_model").string(),
+      sysPaths->FindFile("model://new_model", false));
+
+  fs::remove_all(tmpPath);
+}
+
 //////////////////////////////////////////////////
 TEST_F(SystemPathsTest, SystemPaths)
 {
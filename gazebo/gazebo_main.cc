@@ -62,6 +62,16 @@ void help()
   << "regular expression).\n"
   << "  --record_resources           Recording with model meshes and "
   << "materials.\n"
+  << "  --record_keyframe_period arg (=-1)\n"
+  << "                                Period (seconds) at which full states "
+  << "are\n"
+  << "                                recorded. In between, only models that "
+  << "moved\n"
+  << "                                are recorded. Disabled if <= 0.\n"
+  << "  --record_drift_threshold arg (=0)\n"
+  << "                                Change (meters or radians) needed to "
+  << "record\n"
+  << "                                a model between keyframes.\n"
   << "  --seed arg                    Start with a given random number seed.\n"
   << "  --iters arg                   Number of iterations to simulate.\n"
   << "  --minimal_comms               Reduce the TCP/IP traffic output by "
@@ -244,13 +244,13 @@ namespace gazebo
       _msg->set_pixel_format(_i.GetPixelFormat());
       _msg->set_step(_i.GetPitch());
 
-      unsigned char *data = NULL;
-      unsigned int size;
-      _i.GetData(&data, size);
-      _msg->set_data(data, size);
-      if (data)
+      // Copy straight into the message, without a temporary buffer
+      std::string *data = _msg->mutable_data();
+      data->resize(_i.DataSize());
+      if (!data->empty())
       {
-        delete[] data;
+        _i.CopyData(reinterpret_cast<unsigned char *>(&(*data)[0]),
+            data->size());
       }
     }
 
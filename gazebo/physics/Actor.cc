@@ -17,6 +17,7 @@
 #include <sstream>
 #include <limits>
 #include <algorithm>
+#include <vector>
 
 #include "gazebo/common/BVHLoader.hh"
 #include "gazebo/common/Console.hh"
@@ -35,9 +36,42 @@
 
 #include "gazebo/transport/Node.hh"
 
+/// \brief Tables to evaluate a skeleton animation by bone index.
+struct gazebo::physics::ActorAnimationTable
+{
+  /// \brief Number of animation nodes the table was built for.
+  unsigned int nodeCount = 0;
+
+  /// \brief Index of each bone's node in the animation's poses, or -1 if
+  /// the bone is not animated. Indexed by bone handle.
+  std::vector<int> boneNodes;
+
+  /// \brief Translations to align a BVH skeleton, by bone handle.
+  std::vector<ignition::math::Matrix4d> translationAligners;
+
+  /// \brief Rotations to align a BVH skeleton, by bone handle.
+  std::vector<ignition::math::Matrix4d> rotationAligners;
+
+  /// \brief Name of the animation node of the root bone.
+  std::string rootNode;
+};
+
 /// \brief Private data for Actor class
 class gazebo::physics::ActorPrivate
 {
+  /// \brief What the evaluated frame sets when it is applied.
+  public: enum class Pending
+  {
+    /// \brief Nothing to apply.
+    NONE,
+
+    /// \brief Only the actor's pose.
+    MODEL_POSE,
+
+    /// \brief The actor's pose and the pose of each bone.
+    SKELETON
+  };
+
   /// \brief True if the animation is loaded from BVH file
   public: bool bvhFile = false;
 
@@ -48,6 +82,39 @@ class gazebo::physics::ActorPrivate
   /// \brief Rotations to align BVH skeleton to DAE skin
   public: std::map<std::string, ignition::math::Matrix4d>
       rotationAligner;
+
+  /// \brief Bone tables of each skeleton animation, by animation name.
+  public: std::map<std::string, ActorAnimationTable> animationTables;
+
+  /// \brief Parent handle of each bone, or -1 for the root.
+  public: std::vector<int> boneParents;
+
+  /// \brief Link of each bone, by bone handle.
+  public: std::vector<LinkPtr> boneLinks;
+
+  /// \brief Poses of the animation nodes at the evaluated time.
+  public: std::vector<ignition::math::Matrix4d> nodePoses;
+
+  /// \brief Evaluated pose of each bone relative to its parent.
+  public: std::vector<ignition::math::Pose3d> boneLocalPoses;
+
+  /// \brief Evaluated world pose of each bone's link.
+  public: std::vector<ignition::math::Pose3d> boneWorldPoses;
+
+  /// \brief Evaluated pose of the actor.
+  public: ignition::math::Pose3d modelPose;
+
+  /// \brief True to set the actor's pose when the frame is applied.
+  public: bool setModelPose = false;
+
+  /// \brief Simulation time of the evaluated frame.
+  public: double frameTime = 0.0;
+
+  /// \brief What the evaluated frame sets.
+  public: Pending pending = Pending::NONE;
+
+  /// \brief True if the frame of this update was already evaluated.
+  public: bool evaluated = false;
 };
 
 using namespace gazebo;
@@ -667,6 +734,20 @@ bool Actor::IsActive() const
 ///////////////////////////////////////////////////
 void Actor::Update()
 {
+  // The world may have evaluated the frame already, in parallel with the
+  // other actors
+  if (!this->dataPtr->evaluated)
+    this->EvaluateFrame();
+  this->dataPtr->evaluated = false;
+
+  this->ApplyFrame();
+}
+
+///////////////////////////////////////////////////
+void Actor::EvaluateFrame()
+{
+  this->dataPtr->evaluated = true;
+
   if (!this->active)
     return;
 
@@ -766,39 +847,40 @@ void Actor::Update()
   // If there's no skeleton animation, we just update the global pose
   if (!skelAnim)
   {
-    this->SetWorldPose(modelPose);
+    this->dataPtr->modelPose = modelPose;
+    this->dataPtr->pending = ActorPrivate::Pending::MODEL_POSE;
     return;
   }
 
-  auto skelMap = this->skelNodesMap[tinfo->type];
+  // Build the bone tables the first time an animation is played
+  auto &table = this->dataPtr->animationTables[tinfo->type];
+  if (table.nodeCount != skelAnim->GetNodeCount() ||
+      this->dataPtr->boneLinks.size() != this->skeleton->GetNumNodes())
+  {
+    this->BuildBoneTables(tinfo->type, skelAnim, table);
+  }
 
-  std::map<std::string, ignition::math::Matrix4d> frame;
-  if (!this->customTrajectoryInfo)
+  auto &nodePoses = this->dataPtr->nodePoses;
+  if (!this->customTrajectoryInfo &&
+      this->interpolateX[tinfo->type] &&
+      this->trajectories.find(tinfo->id) != this->trajectories.end())
   {
-    if (this->interpolateX[tinfo->type] &&
-          this->trajectories.find(tinfo->id) != this->trajectories.end())
-    {
-      frame = skelAnim->PoseAtX(this->pathLength,
-                skelMap[this->skeleton->GetRootNode()->GetName()]);
-    }
-    else
-    {
-      frame = skelAnim->PoseAt(this->scriptTime);
-    }
+    skelAnim->PoseAt(skelAnim->TimeAtX(this->pathLength, table.rootNode),
+        nodePoses);
   }
   else
   {
-    frame = skelAnim->PoseAt(this->scriptTime);
+    skelAnim->PoseAt(this->scriptTime, nodePoses);
   }
 
   this->lastTraj = tinfo->id;
 
+  SkeletonNode *rootBone = this->skeleton->GetRootNode();
+  const int rootIndex = table.boneNodes[rootBone->GetHandle()];
+
   ignition::math::Matrix4d rootTrans = ignition::math::Matrix4d::Identity;
-  auto iter = frame.find(skelMap[this->skeleton->GetRootNode()->GetName()]);
-  if (iter != frame.end())
-  {
-    rootTrans = frame[skelMap[this->skeleton->GetRootNode()->GetName()]];
-  }
+  if (rootIndex >= 0)
+    rootTrans = nodePoses[rootIndex];
 
   ignition::math::Vector3d rootPos = rootTrans.Translation();
   ignition::math::Quaterniond rootRot = rootTrans.Rotation();
@@ -839,22 +921,9 @@ void Actor::Update()
   // workaround for rotation bug
   rootM.SetTranslation(rootM.Translation() * this->skinScale);
 
-  frame[skelMap[this->skeleton->GetRootNode()->GetName()]] = rootM;
-
-  this->SetPose(frame, skelMap, currentTime.Double());
-}
-
-//////////////////////////////////////////////////
-void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
-    std::map<std::string, std::string> _skelMap, const double _time)
-{
-  msgs::PoseAnimation msg;
-  msg.set_model_name(this->visualName);
-  msg.set_model_id(this->visualId);
-
-  ignition::math::Matrix4d modelTrans(ignition::math::Matrix4d::Identity);
+  // Compute the bone poses, parents before children
+  const double time = currentTime.Double();
   ignition::math::Pose3d mainLinkPose;
-
   if (this->customTrajectoryInfo)
   {
     mainLinkPose.Pos() = this->worldPose.Pos();
@@ -864,17 +933,15 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
   for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
   {
     SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
-    SkeletonNode *parentBone = bone->GetParent();
+    const int node = table.boneNodes[i];
     ignition::math::Matrix4d transform(ignition::math::Matrix4d::Identity);
 
-    if (_frame.find(_skelMap[bone->GetName()]) != _frame.end())
+    if (bone == rootBone || node >= 0)
     {
+      transform = bone == rootBone ? rootM : nodePoses[node];
       if (this->dataPtr->bvhFile)
       {
-        std::string tempStr(_skelMap[bone->GetName()]);
-        transform = _frame[tempStr];
-
-        if (bone->GetName() != this->skeleton->GetRootNode()->GetName())
+        if (bone != rootBone)
         {
           ignition::math::Vector3d bvhOffset = transform.Translation();
           ignition::math::Vector3d daeOffset = bone->Transform().Translation();
@@ -882,12 +949,8 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
           transform.SetTranslation(daeOffset.Length() * bvhOffset.Normalize());
         }
 
-        transform = this->dataPtr->translationAligner[tempStr] * transform *
-            this->dataPtr->rotationAligner[tempStr];
-      }
-      else
-      {
-        transform = _frame[_skelMap[bone->GetName()]];
+        transform = table.translationAligners[i] * transform *
+            table.rotationAligners[i];
       }
     }
     else
@@ -895,69 +958,157 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
       transform = bone->Transform();
     }
 
-    LinkPtr currentLink = this->GetChildLink(bone->GetName());
     ignition::math::Pose3d bonePose = transform.Pose();
     if (!bonePose.IsFinite())
     {
-      gzerr << "ACTOR: " << _time << " " << bone->GetName()
+      gzerr << "ACTOR: " << time << " " << bone->GetName()
                 << " " << bonePose << "\n";
       bonePose.Correct();
     }
+    this->dataPtr->boneLocalPoses[i] = bonePose;
 
-    msgs::Pose *bone_pose = msg.add_pose();
-    bone_pose->set_name(bone->GetName());
-
-    if (!parentBone)
+    const int parent = this->dataPtr->boneParents[i];
+    if (parent < 0)
     {
-      bone_pose->mutable_position()->CopyFrom(
-          msgs::Convert(ignition::math::Vector3d()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
-          ignition::math::Quaterniond()));
       if (!this->customTrajectoryInfo)
         mainLinkPose = bonePose;
     }
     else
     {
-      bone_pose->mutable_position()->CopyFrom(msgs::Convert(bonePose.Pos()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(bonePose.Rot()));
-      LinkPtr parentLink = this->GetChildLink(parentBone->GetName());
-      auto parentPose = parentLink->WorldPose();
-      ignition::math::Matrix4d parentTrans(parentPose);
+      ignition::math::Matrix4d parentTrans(
+          this->dataPtr->boneWorldPoses[parent]);
       transform = parentTrans * transform;
     }
 
-    msgs::Pose *link_pose = msg.add_pose();
-    link_pose->set_name(currentLink->GetScopedName());
-    link_pose->set_id(currentLink->GetId());
-    ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
-    link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
-    link_pose->mutable_orientation()->CopyFrom(msgs::Convert(linkPose.Rot()));
-    currentLink->SetWorldPose(transform.Pose(), true, false);
+    this->dataPtr->boneWorldPoses[i] = transform.Pose();
   }
 
-  msgs::Time *stamp = msg.add_time();
-  stamp->CopyFrom(msgs::Convert(_time));
+  this->dataPtr->modelPose = mainLinkPose;
+  this->dataPtr->setModelPose = !this->customTrajectoryInfo;
+  this->dataPtr->frameTime = time;
+  this->dataPtr->pending = ActorPrivate::Pending::SKELETON;
+}
 
-  msgs::Pose *model_pose = msg.add_pose();
-  model_pose->set_name(this->GetScopedName());
-  model_pose->set_id(this->GetId());
-  if (!this->customTrajectoryInfo)
+//////////////////////////////////////////////////
+void Actor::BuildBoneTables(const std::string &_animName,
+    const common::SkeletonAnimation *_skelAnim, ActorAnimationTable &_table)
+{
+  const unsigned int boneCount = this->skeleton->GetNumNodes();
+
+  // Links and parents are shared by all animations
+  if (this->dataPtr->boneLinks.size() != boneCount)
   {
-    model_pose->mutable_position()->CopyFrom(msgs::Convert(mainLinkPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(mainLinkPose.Rot()));
+    this->dataPtr->boneLinks.resize(boneCount);
+    this->dataPtr->boneParents.resize(boneCount);
+    this->dataPtr->boneLocalPoses.resize(boneCount);
+    this->dataPtr->boneWorldPoses.resize(boneCount);
+    for (unsigned int i = 0; i < boneCount; ++i)
+    {
+      SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
+      SkeletonNode *parentBone = bone->GetParent();
+      this->dataPtr->boneLinks[i] = this->GetChildLink(bone->GetName());
+      this->dataPtr->boneParents[i] =
+          parentBone ? static_cast<int>(parentBone->GetHandle()) : -1;
+      this->dataPtr->boneWorldPoses[i] =
+          this->dataPtr->boneLinks[i]->WorldPose();
+    }
   }
-  else
+
+  // Index of each animation node in the poses
+  std::map<std::string, int> nodeIndices;
+  const std::vector<std::string> nodeNames = _skelAnim->NodeNames();
+  for (size_t n = 0; n < nodeNames.size(); ++n)
+    nodeIndices[nodeNames[n]] = static_cast<int>(n);
+
+  auto &skelMap = this->skelNodesMap[_animName];
+  _table.nodeCount = _skelAnim->GetNodeCount();
+  _table.boneNodes.assign(boneCount, -1);
+  _table.translationAligners.resize(boneCount);
+  _table.rotationAligners.resize(boneCount);
+  for (unsigned int i = 0; i < boneCount; ++i)
+  {
+    const std::string &nodeName =
+        skelMap[this->skeleton->GetNodeByHandle(i)->GetName()];
+    auto iter = nodeIndices.find(nodeName);
+    if (iter != nodeIndices.end())
+      _table.boneNodes[i] = iter->second;
+
+    if (this->dataPtr->bvhFile)
+    {
+      _table.translationAligners[i] =
+          this->dataPtr->translationAligner[nodeName];
+      _table.rotationAligners[i] = this->dataPtr->rotationAligner[nodeName];
+    }
+  }
+  _table.rootNode = skelMap[this->skeleton->GetRootNode()->GetName()];
+}
+
+//////////////////////////////////////////////////
+void Actor::ApplyFrame()
+{
+  const ActorPrivate::Pending pending = this->dataPtr->pending;
+  this->dataPtr->pending = ActorPrivate::Pending::NONE;
+
+  if (pending == ActorPrivate::Pending::NONE)
+    return;
+
+  if (pending == ActorPrivate::Pending::MODEL_POSE)
+  {
+    this->SetWorldPose(this->dataPtr->modelPose);
+    return;
+  }
+
+  for (size_t i = 0; i < this->dataPtr->boneLinks.size(); ++i)
   {
-    model_pose->mutable_position()->CopyFrom(
-        msgs::Convert(this->worldPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(this->worldPose.Rot()));
+    this->dataPtr->boneLinks[i]->SetWorldPose(
+        this->dataPtr->boneWorldPoses[i], true, false);
   }
 
+  const ignition::math::Pose3d &mainLinkPose = this->dataPtr->modelPose;
+
+  // Only build the message if someone listens
   if (this->bonePosePub && this->bonePosePub->HasConnections())
+  {
+    msgs::PoseAnimation msg;
+    msg.set_model_name(this->visualName);
+    msg.set_model_id(this->visualId);
+
+    for (size_t i = 0; i < this->dataPtr->boneLinks.size(); ++i)
+    {
+      const LinkPtr &currentLink = this->dataPtr->boneLinks[i];
+
+      msgs::Pose *bone_pose = msg.add_pose();
+      bone_pose->set_name(this->skeleton->GetNodeByHandle(i)->GetName());
+      if (this->dataPtr->boneParents[i] < 0)
+      {
+        msgs::Set(bone_pose, ignition::math::Pose3d::Zero);
+      }
+      else
+      {
+        msgs::Set(bone_pose, this->dataPtr->boneLocalPoses[i]);
+      }
+
+      msgs::Pose *link_pose = msg.add_pose();
+      link_pose->set_name(currentLink->GetScopedName());
+      link_pose->set_id(currentLink->GetId());
+      msgs::Set(link_pose, this->dataPtr->boneWorldPoses[i] - mainLinkPose);
+    }
+
+    msgs::Time *stamp = msg.add_time();
+    stamp->CopyFrom(msgs::Convert(this->dataPtr->frameTime));
+
+    msgs::Pose *model_pose = msg.add_pose();
+    model_pose->set_name(this->GetScopedName());
+    model_pose->set_id(this->GetId());
+    if (this->dataPtr->setModelPose)
+      msgs::Set(model_pose, mainLinkPose);
+    else
+      msgs::Set(model_pose, this->worldPose);
+
     this->bonePosePub->Publish(msg);
-  if (!this->customTrajectoryInfo)
+  }
+
+  if (this->dataPtr->setModelPose)
     this->SetWorldPose(mainLinkPose, true, false);
 }
 
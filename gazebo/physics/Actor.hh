@@ -40,6 +40,7 @@ namespace gazebo
   namespace physics
   {
     class ActorPrivate;
+    struct ActorAnimationTable;
 
     /// \brief Information about a trajectory for an Actor.
     /// This doesn't contain the keyframes information, just duration.
@@ -114,6 +115,12 @@ namespace gazebo
       /// \brief Update the actor
       public: void Update();
 
+      /// \brief Compute the actor's pose and the pose of each bone at the
+      /// current simulation time, without moving any link. The next Update
+      /// applies the computed poses. This only changes the actor's own
+      /// data, so the world evaluates all actors in parallel.
+      public: void EvaluateFrame();
+
       /// \brief Finalize the actor
       public: virtual void Fini();
 
@@ -277,15 +284,20 @@ namespace gazebo
       /// \param[in] _sdf SDF element containing the trajectory script.
       private: void LoadScript(sdf::ElementPtr _sdf);
 
-      /// \brief Set the actor's pose. This sets the pose for each bone in the
-      /// skeleton and also the actor's pose in the world.
-      /// \param[in] _frame Each frame name and transform.
-      /// \param[in] _skelMap Map of bone relationships.
-      /// \param[in] _time Time over which to animate the set pose.
-      private: void SetPose(
-                   std::map<std::string, ignition::math::Matrix4d> _frame,
-                   std::map<std::string, std::string> _skelMap,
-                   const double _time);
+      /// \brief Apply the frame computed by EvaluateFrame. This sets the
+      /// pose of each bone's link and the actor's pose in the world, and
+      /// publishes the bone poses if there are subscribers.
+      private: void ApplyFrame();
+
+      /// \brief Build the tables to evaluate a skeleton animation by bone
+      /// index: the link and parent of each bone, and the animation node
+      /// and BVH aligners of each bone.
+      /// \param[in] _animName Name of the skeleton animation.
+      /// \param[in] _skelAnim The skeleton animation.
+      /// \param[out] _table Tables of the animation.
+      private: void BuildBoneTables(const std::string &_animName,
+                   const common::SkeletonAnimation *_skelAnim,
+                   ActorAnimationTable &_table);
 
       /// \brief Pointer to the actor's mesh.
       protected: const common::Mesh *mesh = nullptr;
@@ -102,6 +102,36 @@ TEST_F(ActorTest, TrajectoryFromSDF)
   EXPECT_LT(fabs(actor->ScriptTime() - world->SimTime().Double()), 1.0 / 30);
 }
 
+//////////////////////////////////////////////////
+TEST_F(ActorTest, EvaluateFrame)
+{
+  // Load a world with an actor
+  this->Load("worlds/actor.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  auto actor = boost::dynamic_pointer_cast<physics::Actor>(
+      world->ModelByName("actor"));
+  ASSERT_TRUE(actor != nullptr);
+
+  world->Step(100);
+  auto pose = actor->WorldPose();
+
+  // Evaluating a frame does not move the actor
+  world->SetSimTime(world->SimTime() + common::Time(0.5));
+  actor->EvaluateFrame();
+  EXPECT_EQ(pose, actor->WorldPose());
+
+  // The update applies the evaluated frame
+  actor->Update();
+  EXPECT_NE(pose, actor->WorldPose());
+  pose = actor->WorldPose();
+
+  // Without a new frame, the update does not move the actor
+  actor->Update();
+  EXPECT_EQ(pose, actor->WorldPose());
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_CHECKPOINTHELPERS_HH_
+#define GAZEBO_PHYSICS_CHECKPOINTHELPERS_HH_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Append the raw bytes of a value to a checkpoint buffer.
+    /// Checkpoints only live in memory, so no byte order conversion is done.
+    /// \param[in,out] _data Checkpoint buffer.
+    /// \param[in] _value Value to append.
+    template<typename T>
+    void WriteCheckpoint(std::vector<uint8_t> &_data, const T &_value)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+          "Checkpoint values must be trivially copyable");
+      const size_t offset = _data.size();
+      _data.resize(offset + sizeof(T));
+      std::memcpy(_data.data() + offset, &_value, sizeof(T));
+    }
+
+    /// \internal
+    /// \brief Read a value written by WriteCheckpoint.
+    /// \param[in] _data Checkpoint buffer.
+    /// \param[in,out] _offset Read position, advanced past the value.
+    /// \param[out] _value Value read.
+    /// \return False if the buffer is too short.
+    template<typename T>
+    bool ReadCheckpoint(const std::vector<uint8_t> &_data, size_t &_offset,
+        T &_value)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+          "Checkpoint values must be trivially copyable");
+      if (_offset + sizeof(T) > _data.size())
+        return false;
+      std::memcpy(&_value, _data.data() + _offset, sizeof(T));
+      _offset += sizeof(T);
+      return true;
+    }
+  }
+}
+#endif
@@ -14,6 +14,13 @@
  * limitations under the License.
  *
 */
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -30,12 +37,47 @@
 using namespace gazebo;
 using namespace physics;
 
+namespace
+{
+  /// \brief In-process subscribers of the filters of a contact manager.
+  /// Guarded by the manager's custom mutex.
+  struct ContactCallbacks
+  {
+    /// \brief Callback of each filter with an in-process subscriber, by
+    /// filter name.
+    std::map<std::string,
+        std::function<void (const std::vector<Contact *> &)>> callbacks;
+
+    /// \brief Contacts of a filter passed to its callback, reused across
+    /// updates.
+    std::vector<Contact *> contacts;
+  };
+
+  /// \brief In-process subscribers by contact manager. Entries are added by
+  /// the constructor and erased by the destructor, and other insertions do
+  /// not move them.
+  std::unordered_map<const ContactManager *, ContactCallbacks> g_callbacks;
+
+  /// \brief Protects g_callbacks.
+  std::mutex g_callbacksMutex;
+
+  /// \brief Get the in-process subscribers of a contact manager.
+  /// \param[in] _manager The contact manager.
+  /// \return The in-process subscribers.
+  ContactCallbacks &CallbacksOf(const ContactManager *_manager)
+  {
+    std::lock_guard<std::mutex> lock(g_callbacksMutex);
+    return g_callbacks[_manager];
+  }
+}
+
 /////////////////////////////////////////////////
 ContactManager::ContactManager()
 {
   this->contactIndex = 0;
   this->customMutex = new boost::recursive_mutex();
   this->neverDropContacts = false;
+  CallbacksOf(this);
 }
 
 /////////////////////////////////////////////////
@@ -65,6 +107,11 @@ ContactManager::~ContactManager()
   delete this->customMutex;
   this->customMutex = NULL;
 
+  {
+    std::lock_guard<std::mutex> lock(g_callbacksMutex);
+    g_callbacks.erase(this);
+  }
+
   this->world.reset();
 }
 
@@ -296,7 +343,7 @@ void ContactManager::PublishContacts()
   }
 
   // publish to default topic, ~/physics/contacts
-  if (!transport::getMinimalComms())
+  if (!transport::getMinimalComms() && this->contactPub->HasConnections())
   {
     msgs::Contacts msg;
     for (unsigned int i = 0; i < this->contactIndex; ++i)
@@ -314,23 +361,46 @@ void ContactManager::PublishContacts()
 
   // publish to other custom topics
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  ContactCallbacks &callbacks = CallbacksOf(this);
   boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
-    for (unsigned int j = 0;
-        j < contactPublisher->contacts.size(); ++j)
+
+    // hand the contacts to in-process subscribers directly
+    auto callback = callbacks.callbacks.end();
+    if (!callbacks.callbacks.empty())
+      callback = callbacks.callbacks.find(iter->first);
+    if (callback != callbacks.callbacks.end())
     {
-      if (contactPublisher->contacts[j]->count == 0)
-        continue;
+      callbacks.contacts.clear();
+      for (auto const contact : contactPublisher->contacts)
+      {
+        if (contact->count > 0)
+          callbacks.contacts.push_back(contact);
+      }
+      callback->second(callbacks.contacts);
+    }
+
+    // only serialize the contacts when someone subscribed to the topic, or
+    // when there is no in-process subscriber, to keep the previous behavior
+    if (callback == callbacks.callbacks.end() ||
+        contactPublisher->publisher->HasConnections())
+    {
+      msgs::Contacts msg2;
+      for (unsigned int j = 0;
+          j < contactPublisher->contacts.size(); ++j)
+      {
+        if (contactPublisher->contacts[j]->count == 0)
+          continue;
 
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
+        msgs::Contact *contactMsg = msg2.add_contact();
+        contactPublisher->contacts[j]->FillMsg(*contactMsg);
+      }
+      msgs::Set(msg2.mutable_time(), this->world->SimTime());
+      contactPublisher->publisher->Publish(msg2);
     }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
-    contactPublisher->publisher->Publish(msg2);
     contactPublisher->contacts.clear();
   }
 }
@@ -424,6 +494,25 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   return topic;
 }
 
+/////////////////////////////////////////////////
+std::string ContactManager::CreateFilter(const std::string &_name,
+    const std::vector<std::string> &_collisions,
+    const std::function<void (const std::vector<Contact *> &)> &_callback)
+{
+  std::string topic = this->CreateFilter(_name, _collisions);
+  if (topic.empty())
+    return topic;
+
+  std::string name = _name;
+  boost::replace_all(name, "::", "/");
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  if (this->customContactPublishers.count(name) > 0 && _callback)
+    CallbacksOf(this).callbacks[name] = _callback;
+
+  return topic;
+}
+
 /////////////////////////////////////////////////
 void ContactManager::RemoveFilter(const std::string &_name)
 {
@@ -439,6 +528,7 @@ void ContactManager::RemoveFilter(const std::string &_name)
     contactPublisher->contacts.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
+    CallbacksOf(this).callbacks.erase(name);
     contactPublisher->publisher->Fini();
     contactPublisher->publisher.reset();
     this->customContactPublishers.erase(iter);
@@ -18,6 +18,7 @@
 #ifndef GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 #define GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <map>
@@ -191,6 +192,22 @@ namespace gazebo
                   const std::map<std::string, physics::CollisionPtr>
                   &_collisions);
 
+      /// \brief Create a filter for contacts with an in-process subscriber.
+      /// The callback is called from the physics thread by PublishContacts,
+      /// after each physics update, with the contacts associated to the
+      /// collisions. The contacts are only valid during the callback.
+      /// Contacts are still published to the returned topic, but only when
+      /// it has subscribers, so transport serialization is skipped when the
+      /// callback is the only consumer.
+      /// param[in] _name Filter name.
+      /// param[in] _collisions A list of collision names used for filtering.
+      /// param[in] _callback Function called with the filtered contacts.
+      /// \return Topic where filtered messages will be published to.
+      public: std::string CreateFilter(const std::string &_name,
+                  const std::vector<std::string> &_collisions,
+                  const std::function<void (const std::vector<Contact *> &)>
+                  &_callback);
+
       /// \brief Remove a contacts filter and the associated custom publisher
       /// param[in] _name Filter name.
       public: void RemoveFilter(const std::string &_name);
@@ -15,6 +15,8 @@
  *
 */
 
+#include <atomic>
+
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -194,6 +196,55 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterCallback)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  // In-process subscriber for the contacts of the box
+  std::atomic<unsigned int> calls(0);
+  std::atomic<unsigned int> boxContacts(0);
+  std::vector<std::string> collisions = {"box::link::collision"};
+  std::string topic = manager->CreateFilter("box_filter", collisions,
+      [&](const std::vector<physics::Contact *> &_contacts)
+      {
+        ++calls;
+        for (auto const contact : _contacts)
+        {
+          EXPECT_GT(contact->count, 0);
+          if (contact->collision1->GetScopedName() == collisions[0] ||
+              contact->collision2->GetScopedName() == collisions[0])
+          {
+            ++boxContacts;
+          }
+        }
+      });
+  EXPECT_FALSE(topic.empty());
+  EXPECT_TRUE(manager->HasFilter("box_filter"));
+
+  // The filter makes the physics engine compute the box contacts, and the
+  // callback gets them after every step.
+  world->Step(5);
+  EXPECT_GE(calls, 5u);
+  EXPECT_GT(boxContacts, 0u);
+
+  // No callbacks once the filter is removed
+  manager->RemoveFilter("box_filter");
+  const unsigned int callsBeforeStep = calls;
+  world->Step(1);
+  EXPECT_EQ(callsBeforeStep, calls);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
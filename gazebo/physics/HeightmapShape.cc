@@ -16,7 +16,11 @@
 */
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <ignition/math/Helpers.hh>
 #include <gazebo/gazebo_config.h>
 
@@ -32,6 +36,42 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Number of points per row of a height tile.
+static const unsigned int kTileSize = 256;
+
+namespace
+{
+  /// \brief Tiling state of a heightmap shape.
+  struct HeightmapTiling
+  {
+    /// \brief True if the physics engine only reads the heights through
+    /// GetHeight, so they can be kept in tiles.
+    bool tileable = false;
+
+    /// \brief Memory budget of the height lookup table in bytes.
+    size_t budget = 0;
+
+    /// \brief Tiles holding the heights, if the lookup table is larger
+    /// than the budget.
+    std::unique_ptr<HeightmapTiles> tiles;
+  };
+
+  /// \brief Tiling state by shape. Entries are added by the constructor
+  /// and erased by the destructor, and other insertions do not move them.
+  std::unordered_map<const HeightmapShape *, HeightmapTiling> g_tiling;
+
+  /// \brief Protects g_tiling.
+  std::mutex g_tilingMutex;
+
+  /// \brief Get the tiling state of a shape.
+  /// \param[in] _shape The shape.
+  /// \return The tiling state.
+  HeightmapTiling &TilingOf(const HeightmapShape *_shape)
+  {
+    std::lock_guard<std::mutex> lock(g_tilingMutex);
+    return g_tiling[_shape];
+  }
+}
 
 //////////////////////////////////////////////////
 HeightmapShape::HeightmapShape(CollisionPtr _parent)
@@ -43,11 +83,23 @@ HeightmapShape::HeightmapShape(CollisionPtr _parent)
       "Height field needs to be double or float");
   this->vertSize = 0;
   this->AddType(Base::HEIGHTMAP_SHAPE);
+
+  HeightmapTiling &tiling = TilingOf(this);
+  tiling.budget = 256u << 20;
+  const char *budget = getenv("GAZEBO_HEIGHTMAP_TILE_BUDGET");
+  if (budget)
+    tiling.budget = static_cast<size_t>(std::strtoull(budget, nullptr, 10))
+        << 20;
 }
 
 //////////////////////////////////////////////////
 HeightmapShape::~HeightmapShape()
 {
+  {
+    std::lock_guard<std::mutex> lock(g_tilingMutex);
+    g_tiling.erase(this);
+  }
+
   this->requestSub.reset();
   this->responsePub.reset();
   if (this->node)
@@ -93,17 +145,16 @@ int HeightmapShape::LoadTerrainFile(const std::string &_filename)
   auto demData = dynamic_cast<common::Dem *>(this->heightmapData);
   if (demData)
   {
-    this->dem = *demData;
     if (this->sdf->HasElement("size"))
     {
       this->heightmapSize = this->sdf->Get<ignition::math::Vector3d>("size");
     }
     else
     {
-      this->heightmapSize.X() = this->dem.GetWorldWidth();
-      this->heightmapSize.Y() = this->dem.GetWorldHeight();
-      this->heightmapSize.Z() = this->dem.GetMaxElevation() -
-          this->dem.GetMinElevation();
+      this->heightmapSize.X() = demData->GetWorldWidth();
+      this->heightmapSize.Y() = demData->GetWorldHeight();
+      this->heightmapSize.Z() = demData->GetMaxElevation() -
+          demData->GetMinElevation();
     }
 
     // Modify the reference geotedic latitude/longitude.
@@ -116,8 +167,8 @@ int HeightmapShape::LoadTerrainFile(const std::string &_filename)
       ignition::math::Angle latitude, longitude;
       double elevation;
 
-      this->dem.GetGeoReferenceOrigin(latitude, longitude);
-      elevation = this->dem.GetElevation(0.0, 0.0);
+      demData->GetGeoReferenceOrigin(latitude, longitude);
+      elevation = demData->GetElevation(0.0, 0.0);
 
       sphericalCoordinates->SetLatitudeReference(latitude);
       sphericalCoordinates->SetLongitudeReference(longitude);
@@ -245,10 +296,49 @@ void HeightmapShape::Init()
   else
     this->scale.Z() = fabs(terrainSize.Z()) / heightmapSizeZ;
 
+  // Keep the heights in tiles if the lookup table does not fit the budget
+  HeightmapTiling &tiling = TilingOf(this);
+  const size_t tableBytes = sizeof(HeightType) *
+      static_cast<size_t>(this->vertSize) * this->vertSize;
+  if (tiling.tileable && tableBytes > tiling.budget)
+  {
+    gzmsg << "Heightmap [" << this->GetURI() << "] of " << this->vertSize
+          << "x" << this->vertSize << " points exceeds the budget of "
+          << (tiling.budget >> 20) << " MB, using tiles\n";
+    tiling.tiles.reset(new HeightmapTiles(this->heightmapData,
+        this->subSampling, this->vertSize, this->Size(), this->scale,
+        this->flipY, kTileSize, tiling.budget));
+    return;
+  }
+
   // Construct the heightmap lookup table
   this->FillHeightfield(this->heights);
 }
 
+//////////////////////////////////////////////////
+void HeightmapShape::SetTileBudget(const size_t _bytes)
+{
+  TilingOf(this).budget = _bytes;
+}
+
+//////////////////////////////////////////////////
+size_t HeightmapShape::TileBudget() const
+{
+  return TilingOf(this).budget;
+}
+
+//////////////////////////////////////////////////
+HeightmapTiles *HeightmapShape::Tiles() const
+{
+  return TilingOf(this).tiles.get();
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::SetTileable(const bool _tileable)
+{
+  TilingOf(this).tileable = _tileable;
+}
+
 //////////////////////////////////////////////////
 void HeightmapShape::SetScale(const ignition::math::Vector3d &_scale)
 {
@@ -294,12 +384,39 @@ void HeightmapShape::FillMsg(msgs::Geometry &_msg)
 //////////////////////////////////////////////////
 void HeightmapShape::FillHeights(msgs::Geometry &_msg) const
 {
-  for (unsigned int y = 0; y < this->vertSize; ++y)
+  auto heightmap = _msg.mutable_heightmap();
+  heightmap->mutable_heights()->Reserve(heightmap->heights_size() +
+      this->vertSize * this->vertSize);
+
+  HeightmapTiles *tiles = this->Tiles();
+  if (!tiles)
+  {
+    for (unsigned int y = 0; y < this->vertSize; ++y)
+    {
+      for (unsigned int x = 0; x < this->vertSize; ++x)
+      {
+        int index = (this->vertSize - y - 1) * this->vertSize + x;
+        heightmap->add_heights(this->heights[index]);
+      }
+    }
+    return;
+  }
+
+  // The rows are sent last first. Read the rows of a tile at once, so each
+  // tile is filled once.
+  const unsigned int tileSize = tiles->TileSize();
+  std::vector<float> rows;
+  for (unsigned int ty = (this->vertSize + tileSize - 1) / tileSize;
+      ty-- > 0;)
   {
-    for (unsigned int x = 0; x < this->vertSize; ++x)
+    const unsigned int first = ty * tileSize;
+    const unsigned int count = std::min(tileSize, this->vertSize - first);
+    tiles->Heights(0, first, this->vertSize, count, rows);
+    for (unsigned int y = count; y-- > 0;)
     {
-      int index = (this->vertSize - y - 1) * this->vertSize + x;
-      _msg.mutable_heightmap()->add_heights(this->heights[index]);
+      auto row = rows.begin() + static_cast<size_t>(y) * this->vertSize;
+      for (unsigned int x = 0; x < this->vertSize; ++x)
+        heightmap->add_heights(row[x]);
     }
   }
 }
@@ -319,6 +436,18 @@ ignition::math::Vector2i HeightmapShape::VertexCount() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 {
+  // The lookup table is empty if the heights are in tiles
+  HeightmapTiles *tiles = this->heights.empty() ? this->Tiles() : nullptr;
+  if (tiles)
+  {
+    if (_x < 0 || _y < 0 || _x >= static_cast<int>(this->vertSize) ||
+        _y >= static_cast<int>(this->vertSize))
+    {
+      return 0.0;
+    }
+    return tiles->Height(_x, _y);
+  }
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
     return 0.0;
@@ -329,6 +458,10 @@ HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 {
+  HeightmapTiles *tiles = this->heights.empty() ? this->Tiles() : nullptr;
+  if (tiles)
+    return tiles->MaxHeight();
+
   HeightType max = -std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -342,6 +475,10 @@ HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMinHeight() const
 {
+  HeightmapTiles *tiles = this->heights.empty() ? this->Tiles() : nullptr;
+  if (tiles)
+    return tiles->MinHeight();
+
   HeightType min = std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
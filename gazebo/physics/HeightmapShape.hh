@@ -27,6 +27,7 @@
 #include "gazebo/common/HeightmapData.hh"
 #include "gazebo/common/Dem.hh"
 #include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/physics/HeightmapTiles.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Shape.hh"
 #include "gazebo/util/system.hh"
@@ -42,6 +43,13 @@ namespace gazebo
     /// \brief HeightmapShape collision shape builds a heightmap from
     /// an image.  The supplied image must be square with
     /// N*N+1 pixels per side, where N is an integer.
+    ///
+    /// If the physics engine reads the heights through GetHeight, and the
+    /// height lookup table is larger than the tile budget, the table is not
+    /// built. The heights are kept in tiles that are filled on demand
+    /// instead, see HeightmapTiles. The default budget is 256 MB, and can
+    /// be set in MB with the GAZEBO_HEIGHTMAP_TILE_BUDGET environment
+    /// variable.
     class GZ_PHYSICS_VISIBLE HeightmapShape : public Shape
     {
       /// \brief height field type, float or double
@@ -114,6 +122,26 @@ namespace gazebo
       /// \return The minimum height.
       public: HeightType GetMinHeight() const;
 
+      /// \brief Set the memory budget of the height lookup table. Larger
+      /// tables are split in tiles. Must be called before Init.
+      /// \param[in] _bytes Budget in bytes.
+      public: void SetTileBudget(const size_t _bytes);
+
+      /// \brief Get the memory budget of the height lookup table.
+      /// \return Budget in bytes.
+      public: size_t TileBudget() const;
+
+      /// \brief Get the tiles holding the heights.
+      /// \return The tiles, or nullptr if the heights are in one lookup
+      /// table.
+      public: HeightmapTiles *Tiles() const;
+
+      /// \brief Allow the heights to be kept in tiles. Physics engines that
+      /// only read the heights through GetHeight call it from their
+      /// constructor.
+      /// \param[in] _tileable True if the heights can be kept in tiles.
+      protected: void SetTileable(const bool _tileable);
+
       /// \brief Get the amount of subsampling.
       /// \return Amount of subsampling.
       public: int GetSubSampling() const;
@@ -177,7 +205,8 @@ namespace gazebo
       private: ignition::math::Vector3d heightmapSize;
 
       #ifdef HAVE_GDAL
-      /// \brief DEM used to generate the heights.
+      /// \brief DEM used to generate the heights. Unused, the heights are
+      /// sampled from heightmapData.
       private: common::Dem dem;
       #endif
 
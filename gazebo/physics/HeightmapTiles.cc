@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/HeightmapData.hh"
+#include "gazebo/physics/HeightmapTiles.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief A tile of the height lookup table.
+    struct HeightmapTile
+    {
+      /// \brief Index of the tile, row * tiles per row + column.
+      uint64_t key;
+
+      /// \brief Heights of the tile, row by row.
+      std::vector<float> heights;
+    };
+
+    /// \internal
+    /// \brief Private data for the HeightmapTiles class
+    class HeightmapTilesPrivate
+    {
+      /// \brief Fill a tile from the heightmap data.
+      /// \param[in] _tx Column of the tile.
+      /// \param[in] _ty Row of the tile.
+      /// \param[out] _heights Heights of the tile.
+      public: void Fill(const unsigned int _tx, const unsigned int _ty,
+                  std::vector<float> &_heights)
+      {
+        const unsigned int x = _tx * this->tileSize;
+        const unsigned int y = _ty * this->tileSize;
+        this->data->FillHeightMapWindow(this->subSampling, this->vertSize,
+            this->size, this->scale, this->flipY, x, y,
+            std::min(this->tileSize, this->vertSize - x),
+            std::min(this->tileSize, this->vertSize - y), _heights);
+        ++this->fills;
+      }
+
+      /// \brief Get a tile, filling it if it is not in memory. The mutex
+      /// must be locked.
+      /// \param[in] _tx Column of the tile.
+      /// \param[in] _ty Row of the tile.
+      /// \return Heights of the tile, valid until the next call.
+      public: const std::vector<float> &Tile(const unsigned int _tx,
+                  const unsigned int _ty)
+      {
+        const uint64_t key =
+            static_cast<uint64_t>(_ty) * this->tilesPerRow + _tx;
+
+        // Consecutive reads usually hit the same tile
+        if (!this->tiles.empty() && this->tiles.front().key == key)
+          return this->tiles.front().heights;
+
+        auto iter = this->tileIndex.find(key);
+        if (iter != this->tileIndex.end())
+        {
+          this->tiles.splice(this->tiles.begin(), this->tiles, iter->second);
+          return this->tiles.front().heights;
+        }
+
+        // Reuse the least recently used tile when the budget is full
+        if (this->tiles.size() >= this->maxTiles)
+        {
+          this->tileIndex.erase(this->tiles.back().key);
+          this->tiles.splice(this->tiles.begin(), this->tiles,
+              std::prev(this->tiles.end()));
+        }
+        else
+        {
+          this->tiles.emplace_front();
+        }
+
+        this->tiles.front().key = key;
+        this->Fill(_tx, _ty, this->tiles.front().heights);
+        this->tileIndex[key] = this->tiles.begin();
+        return this->tiles.front().heights;
+      }
+
+      /// \brief Get the number of points per row of a tile of the last
+      /// column, which may be narrower.
+      /// \param[in] _tx Column of the tile.
+      /// \return Number of points per row of the tile.
+      public: unsigned int TileWidth(const unsigned int _tx) const
+      {
+        return std::min(this->tileSize,
+            this->vertSize - _tx * this->tileSize);
+      }
+
+      /// \brief Heightmap data the heights are sampled from.
+      public: common::HeightmapData *data;
+
+      /// \brief Multiplier used to increase the resolution.
+      public: int subSampling;
+
+      /// \brief Number of points per row of the lookup table.
+      public: unsigned int vertSize;
+
+      /// \brief Real dimmensions of the terrain.
+      public: ignition::math::Vector3d size;
+
+      /// \brief Scale of the heights.
+      public: ignition::math::Vector3d scale;
+
+      /// \brief True to flip the heights along the y direction.
+      public: bool flipY;
+
+      /// \brief Number of points per row of a tile.
+      public: unsigned int tileSize;
+
+      /// \brief Number of tiles per row of the lookup table.
+      public: unsigned int tilesPerRow;
+
+      /// \brief Maximum number of tiles in memory.
+      public: size_t maxTiles;
+
+      /// \brief Minimum height.
+      public: float minHeight;
+
+      /// \brief Maximum height.
+      public: float maxHeight;
+
+      /// \brief Tiles in memory, most recently used first.
+      public: std::list<HeightmapTile> tiles;
+
+      /// \brief Tiles in memory by index.
+      public: std::unordered_map<uint64_t,
+              std::list<HeightmapTile>::iterator> tileIndex;
+
+      /// \brief Number of tile fills.
+      public: uint64_t fills = 0;
+
+      /// \brief Protects the tiles.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+HeightmapTiles::HeightmapTiles(common::HeightmapData *_data,
+    const int _subSampling, const unsigned int _vertSize,
+    const ignition::math::Vector3d &_size,
+    const ignition::math::Vector3d &_scale, const bool _flipY,
+    const unsigned int _tileSize, const size_t _budget)
+  : dataPtr(new HeightmapTilesPrivate)
+{
+  GZ_ASSERT(_data, "Heightmap data is null");
+  GZ_ASSERT(_tileSize > 0, "Tile size must be positive");
+
+  this->dataPtr->data = _data;
+  this->dataPtr->subSampling = _subSampling;
+  this->dataPtr->vertSize = _vertSize;
+  this->dataPtr->size = _size;
+  this->dataPtr->scale = _scale;
+  this->dataPtr->flipY = _flipY;
+  this->dataPtr->tileSize = std::min(_tileSize, _vertSize);
+  this->dataPtr->tilesPerRow =
+      (_vertSize + this->dataPtr->tileSize - 1) / this->dataPtr->tileSize;
+
+  const size_t tileBytes = sizeof(float) *
+      this->dataPtr->tileSize * this->dataPtr->tileSize;
+  this->dataPtr->maxTiles = std::max<size_t>(4, _budget / tileBytes);
+
+  // The heights are interpolated between the data's samples, so the
+  // extremes are found at the samples. Read the samples in strips.
+  const unsigned int width = _data->GetWidth();
+  const unsigned int stripRows = std::max(1u, (1u << 22) / width);
+  this->dataPtr->minHeight = std::numeric_limits<float>::max();
+  this->dataPtr->maxHeight = -std::numeric_limits<float>::max();
+  std::vector<float> strip;
+  for (unsigned int y = 0; y < width; y += stripRows)
+  {
+    _data->FillHeightMapWindow(1, width, _size, _scale, false, 0, y, width,
+        std::min(stripRows, width - y), strip);
+    auto minMax = std::minmax_element(strip.begin(), strip.end());
+    this->dataPtr->minHeight = std::min(this->dataPtr->minHeight,
+        *minMax.first);
+    this->dataPtr->maxHeight = std::max(this->dataPtr->maxHeight,
+        *minMax.second);
+  }
+}
+
+//////////////////////////////////////////////////
+HeightmapTiles::~HeightmapTiles()
+{
+}
+
+//////////////////////////////////////////////////
+float HeightmapTiles::Height(const unsigned int _x, const unsigned int _y)
+{
+  const unsigned int tileSize = this->dataPtr->tileSize;
+  const unsigned int tx = _x / tileSize;
+  const unsigned int ty = _y / tileSize;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const std::vector<float> &tile = this->dataPtr->Tile(tx, ty);
+  return tile[static_cast<size_t>(_y - ty * tileSize) *
+      this->dataPtr->TileWidth(tx) + (_x - tx * tileSize)];
+}
+
+//////////////////////////////////////////////////
+void HeightmapTiles::Heights(const unsigned int _x, const unsigned int _y,
+    const unsigned int _width, const unsigned int _height,
+    std::vector<float> &_heights)
+{
+  _heights.resize(static_cast<size_t>(_width) * _height);
+  if (_width == 0 || _height == 0)
+    return;
+
+  const unsigned int tileSize = this->dataPtr->tileSize;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (unsigned int ty = _y / tileSize; ty <= (_y + _height - 1) / tileSize;
+      ++ty)
+  {
+    // Rows of the window in the tile
+    const unsigned int firstY = std::max(_y, ty * tileSize);
+    const unsigned int endY = std::min(_y + _height, (ty + 1) * tileSize);
+
+    for (unsigned int tx = _x / tileSize;
+        tx <= (_x + _width - 1) / tileSize; ++tx)
+    {
+      // Columns of the window in the tile
+      const unsigned int firstX = std::max(_x, tx * tileSize);
+      const unsigned int endX = std::min(_x + _width, (tx + 1) * tileSize);
+
+      const std::vector<float> &tile = this->dataPtr->Tile(tx, ty);
+      const unsigned int tileWidth = this->dataPtr->TileWidth(tx);
+      for (unsigned int y = firstY; y < endY; ++y)
+      {
+        auto row = tile.begin() +
+            static_cast<size_t>(y - ty * tileSize) * tileWidth +
+            (firstX - tx * tileSize);
+        std::copy(row, row + (endX - firstX), _heights.begin() +
+            static_cast<size_t>(y - _y) * _width + (firstX - _x));
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+float HeightmapTiles::MinHeight() const
+{
+  return this->dataPtr->minHeight;
+}
+
+//////////////////////////////////////////////////
+float HeightmapTiles::MaxHeight() const
+{
+  return this->dataPtr->maxHeight;
+}
+
+//////////////////////////////////////////////////
+unsigned int HeightmapTiles::TileSize() const
+{
+  return this->dataPtr->tileSize;
+}
+
+//////////////////////////////////////////////////
+size_t HeightmapTiles::MaxTileCount() const
+{
+  return this->dataPtr->maxTiles;
+}
+
+//////////////////////////////////////////////////
+size_t HeightmapTiles::TileCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->tiles.size();
+}
+
+//////////////////////////////////////////////////
+uint64_t HeightmapTiles::TileFills() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->fills;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_HEIGHTMAPTILES_HH_
+#define GAZEBO_PHYSICS_HEIGHTMAPTILES_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class HeightmapData;
+  }
+
+  namespace physics
+  {
+    // Forward declare private data class.
+    class HeightmapTilesPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class HeightmapTiles HeightmapTiles.hh physics/physics.hh
+    /// \brief Height lookup table of a heightmap, split in square tiles
+    /// that are filled on demand.
+    ///
+    /// The lookup table holds the same heights as
+    /// common::HeightmapData::FillHeightMap, but only the tiles that were
+    /// read recently are kept in memory. When the memory budget is full, the
+    /// least recently used tile is dropped, and it is filled again from the
+    /// heightmap data if it is read later. Physics engines read the heights
+    /// around the colliding models, so the kept tiles follow the models.
+    class GZ_PHYSICS_VISIBLE HeightmapTiles
+    {
+      /// \brief Constructor.
+      /// \param[in] _data Heightmap data the heights are sampled from. It
+      /// must outlive this object.
+      /// \param[in] _subSampling Multiplier used to increase the resolution.
+      /// \param[in] _vertSize Number of points per row of the lookup table.
+      /// \param[in] _size Real dimmensions of the terrain.
+      /// \param[in] _scale Vector3 used to scale the height.
+      /// \param[in] _flipY True to flip the heights along the y direction.
+      /// \param[in] _tileSize Number of points per row of a tile.
+      /// \param[in] _budget Memory budget of the tiles in bytes. At least
+      /// four tiles are kept, so a region across tile corners fits.
+      public: HeightmapTiles(common::HeightmapData *_data,
+                  const int _subSampling, const unsigned int _vertSize,
+                  const ignition::math::Vector3d &_size,
+                  const ignition::math::Vector3d &_scale, const bool _flipY,
+                  const unsigned int _tileSize, const size_t _budget);
+
+      /// \brief Destructor.
+      public: virtual ~HeightmapTiles();
+
+      /// \brief Get a height of the lookup table. The tile holding the
+      /// height is filled if it is not in memory. Thread safe.
+      /// \param[in] _x Column, less than the number of points per row.
+      /// \param[in] _y Row, less than the number of points per row.
+      /// \return The height.
+      public: float Height(const unsigned int _x, const unsigned int _y);
+
+      /// \brief Get a window of the lookup table. Each tile in the window
+      /// is looked up once, and filled if it is not in memory. Thread safe.
+      /// \param[in] _x First column of the window.
+      /// \param[in] _y First row of the window.
+      /// \param[in] _width Number of columns of the window.
+      /// \param[in] _height Number of rows of the window.
+      /// \param[out] _heights Heights of the window, row by row.
+      public: void Heights(const unsigned int _x, const unsigned int _y,
+                  const unsigned int _width, const unsigned int _height,
+                  std::vector<float> &_heights);
+
+      /// \brief Get the minimum height of the lookup table.
+      /// \return The minimum height.
+      public: float MinHeight() const;
+
+      /// \brief Get the maximum height of the lookup table.
+      /// \return The maximum height.
+      public: float MaxHeight() const;
+
+      /// \brief Get the number of points per row of a tile.
+      /// \return Tile size.
+      public: unsigned int TileSize() const;
+
+      /// \brief Get the maximum number of tiles kept in memory.
+      /// \return Maximum number of tiles.
+      public: size_t MaxTileCount() const;
+
+      /// \brief Get the number of tiles in memory.
+      /// \return Number of tiles.
+      public: size_t TileCount() const;
+
+      /// \brief Get the number of times a tile was filled.
+      /// \return Number of tile fills.
+      public: uint64_t TileFills() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<HeightmapTilesPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/HeightmapData.hh"
+#include "gazebo/physics/HeightmapTiles.hh"
+#include "test_config.h"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class HeightmapTiles : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Read all the heights through a small tile budget, and compare
+/// them with the whole lookup table.
+TEST_F(HeightmapTiles, MatchesLookupTable)
+{
+  std::unique_ptr<common::HeightmapData> data(
+      common::HeightmapDataLoader::LoadTerrainFile(
+      std::string(PROJECT_SOURCE_PATH) +
+      "/media/materials/textures/heightmap_bowl.png"));
+  ASSERT_TRUE(data != nullptr);
+
+  const int subSampling = 2;
+  const unsigned int vertSize = data->GetWidth() * subSampling -
+      subSampling + 1;
+  const ignition::math::Vector3d size(10, 10, 2);
+  const ignition::math::Vector3d scale(10.0 / vertSize, 10.0 / vertSize, 2);
+
+  std::vector<float> heights;
+  data->FillHeightMap(subSampling, vertSize, size, scale, true, heights);
+  ASSERT_EQ(static_cast<size_t>(vertSize) * vertSize, heights.size());
+
+  // 257 points per row, in 9x9 tiles, of which 4 fit the budget
+  const unsigned int tileSize = 32;
+  physics::HeightmapTiles tiles(data.get(), subSampling, vertSize, size,
+      scale, true, tileSize, 4 * tileSize * tileSize * sizeof(float));
+  EXPECT_EQ(tileSize, tiles.TileSize());
+  EXPECT_EQ(4u, tiles.MaxTileCount());
+  EXPECT_EQ(0u, tiles.TileCount());
+
+  auto minMax = std::minmax_element(heights.begin(), heights.end());
+  EXPECT_FLOAT_EQ(*minMax.first, tiles.MinHeight());
+  EXPECT_FLOAT_EQ(*minMax.second, tiles.MaxHeight());
+
+  // Read column by column, so the tiles are dropped and filled again
+  unsigned int mismatches = 0;
+  for (unsigned int x = 0; x < vertSize; ++x)
+  {
+    for (unsigned int y = 0; y < vertSize; ++y)
+    {
+      if (!ignition::math::equal(tiles.Height(x, y),
+          heights[y * vertSize + x]))
+        ++mismatches;
+    }
+    EXPECT_LE(tiles.TileCount(), tiles.MaxTileCount());
+  }
+  EXPECT_EQ(0u, mismatches);
+  EXPECT_GT(tiles.TileFills(), 81u);
+
+  // Reading a tile in memory does not fill it again
+  const uint64_t fills = tiles.TileFills();
+  EXPECT_FLOAT_EQ(heights[vertSize * vertSize - 1],
+      tiles.Height(vertSize - 1, vertSize - 1));
+  EXPECT_FLOAT_EQ(heights[(vertSize - 2) * vertSize + vertSize - 2],
+      tiles.Height(vertSize - 2, vertSize - 2));
+  EXPECT_EQ(fills, tiles.TileFills());
+}
+
+/////////////////////////////////////////////////
+/// \brief Read windows across tile borders, and check that each tile of a
+/// window is filled once.
+TEST_F(HeightmapTiles, Windows)
+{
+  std::unique_ptr<common::HeightmapData> data(
+      common::HeightmapDataLoader::LoadTerrainFile(
+      std::string(PROJECT_SOURCE_PATH) +
+      "/media/materials/textures/heightmap_bowl.png"));
+  ASSERT_TRUE(data != nullptr);
+
+  const int subSampling = 2;
+  const unsigned int vertSize = data->GetWidth() * subSampling -
+      subSampling + 1;
+  const ignition::math::Vector3d size(10, 10, 2);
+  const ignition::math::Vector3d scale(10.0 / vertSize, 10.0 / vertSize, 2);
+
+  std::vector<float> heights;
+  data->FillHeightMap(subSampling, vertSize, size, scale, false, heights);
+  ASSERT_EQ(static_cast<size_t>(vertSize) * vertSize, heights.size());
+
+  const unsigned int tileSize = 32;
+  physics::HeightmapTiles tiles(data.get(), subSampling, vertSize, size,
+      scale, false, tileSize, 4 * tileSize * tileSize * sizeof(float));
+
+  // A window over 3x2 tiles
+  std::vector<float> window;
+  tiles.Heights(20, 40, 70, 30, window);
+  ASSERT_EQ(70u * 30u, window.size());
+  EXPECT_EQ(6u, tiles.TileFills());
+  for (unsigned int y = 0; y < 30; ++y)
+  {
+    for (unsigned int x = 0; x < 70; ++x)
+    {
+      EXPECT_FLOAT_EQ(heights[(40 + y) * vertSize + 20 + x],
+          window[y * 70 + x]);
+    }
+  }
+
+  // Strips of the rows of a tile, including the narrower last column
+  uint64_t fills = tiles.TileFills();
+  const unsigned int tilesPerRow = (vertSize + tileSize - 1) / tileSize;
+  tiles.Heights(0, vertSize - 1, vertSize, 1, window);
+  ASSERT_EQ(vertSize, window.size());
+  EXPECT_EQ(fills + tilesPerRow, tiles.TileFills());
+  for (unsigned int x = 0; x < vertSize; ++x)
+  {
+    EXPECT_FLOAT_EQ(heights[(vertSize - 1) * vertSize + x], window[x]);
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <string>
 #include <boost/thread/recursive_mutex.hpp>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
@@ -65,6 +66,20 @@ void MeshShape::Init()
       gzerr << "Unable to load mesh from file[" << meshStr << "]\n";
   }
 
+  // Collide with a simplified copy of large meshes, if a limit is set
+  const unsigned int maxTriangles = meshManager->CollisionTriangleLimit();
+  if (this->mesh && maxTriangles > 0 &&
+      this->mesh->GetIndexCount() / 3 > maxTriangles)
+  {
+    const std::string simplifiedName = this->mesh->GetName() +
+        "::simplified_" + std::to_string(maxTriangles);
+    meshManager->CreateSimplified(simplifiedName, this->mesh, maxTriangles);
+
+    const common::Mesh *simplified = meshManager->GetMesh(simplifiedName);
+    if (simplified)
+      this->mesh = simplified;
+  }
+
   if (this->submesh)
     delete this->submesh;
   this->submesh = NULL;
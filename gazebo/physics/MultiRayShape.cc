@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <mutex>
+#include <unordered_map>
+
 #include "gazebo/common/Exception.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/MultiRayShape.hh"
@@ -21,12 +24,46 @@
 using namespace gazebo;
 using namespace physics;
 
+namespace
+{
+  /// \brief Results of the last scan of a multiray shape.
+  struct MultiRayScan
+  {
+    /// \brief Detected range of each ray.
+    std::vector<double> ranges;
+
+    /// \brief Detected retro value of each ray.
+    std::vector<double> retros;
+
+    /// \brief Id of the collision hit by each ray, set by UpdateRays when
+    /// supported by the physics engine.
+    std::vector<uint32_t> hitIds;
+  };
+
+  /// \brief Scan results by shape. Entries are added by the constructor
+  /// and erased by the destructor, and other insertions do not move them.
+  std::unordered_map<const MultiRayShape *, MultiRayScan> g_scans;
+
+  /// \brief Protects g_scans.
+  std::mutex g_scansMutex;
+
+  /// \brief Get the scan results of a shape.
+  /// \param[in] _shape The shape.
+  /// \return The scan results.
+  MultiRayScan &ScanOf(const MultiRayShape *_shape)
+  {
+    std::lock_guard<std::mutex> lock(g_scansMutex);
+    return g_scans[_shape];
+  }
+}
+
 //////////////////////////////////////////////////
 MultiRayShape::MultiRayShape(CollisionPtr _parent)
 : Shape(_parent)
 {
   this->AddType(MULTIRAY_SHAPE);
   this->SetName("multiray");
+  ScanOf(this);
 }
 
 //////////////////////////////////////////////////
@@ -39,6 +76,9 @@ MultiRayShape::MultiRayShape(PhysicsEnginePtr /*_physicsEngine*/)
 MultiRayShape::~MultiRayShape()
 {
   this->rays.clear();
+
+  std::lock_guard<std::mutex> lock(g_scansMutex);
+  g_scans.erase(this);
 }
 
 //////////////////////////////////////////////////
@@ -181,10 +221,22 @@ void MultiRayShape::Update()
     // Get the global points of the line
     this->rays[i]->Update();
   }
+  MultiRayScan &scan = ScanOf(this);
+  scan.hitIds.assign(raySize, 0);
 
   // do actual collision checks
   this->UpdateRays();
 
+  // Gather the results in contiguous arrays for the sensors
+  scan.ranges.resize(raySize);
+  scan.retros.resize(raySize);
+  for (unsigned int i = 0; i < raySize; ++i)
+  {
+    // Add min range, because we measured from min range.
+    scan.ranges[i] = this->GetMinRange() + this->rays[i]->GetLength();
+    scan.retros[i] = this->rays[i]->GetRetro();
+  }
+
   // for plugin
   this->newLaserScans();
 }
@@ -215,6 +267,30 @@ void MultiRayShape::AddRay(const ignition::math::Vector3d &/*_start*/,
 }
 
 
+//////////////////////////////////////////////////
+const std::vector<double> &MultiRayShape::Ranges() const
+{
+  return ScanOf(this).ranges;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &MultiRayShape::Retros() const
+{
+  return ScanOf(this).retros;
+}
+
+//////////////////////////////////////////////////
+const std::vector<uint32_t> &MultiRayShape::HitIds() const
+{
+  return ScanOf(this).hitIds;
+}
+
+//////////////////////////////////////////////////
+void MultiRayShape::SetHitIds(const std::vector<uint32_t> &_ids)
+{
+  ScanOf(this).hitIds = _ids;
+}
+
 //////////////////////////////////////////////////
 double MultiRayShape::GetMinRange() const
 {
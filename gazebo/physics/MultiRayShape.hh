@@ -80,6 +80,28 @@ namespace gazebo
       /// \return Fiducial value for the ray.
       public: int GetFiducial(unsigned int _index);
 
+      /// \brief Get the detected ranges of all the rays, indexed like the
+      /// rays. Updated by Update().
+      /// \return Ranges, the maximum range for rays without detection.
+      public: const std::vector<double> &Ranges() const;
+
+      /// \brief Get the detected retro (intensity) values of all the rays,
+      /// indexed like the rays. Updated by Update().
+      /// \return Retro values.
+      public: const std::vector<double> &Retros() const;
+
+      /// \brief Get the ids of the collisions hit by the rays, indexed like
+      /// the rays. Updated by Update().
+      /// \return Collision ids, 0 where nothing was hit or if the physics
+      /// engine does not report hit collisions.
+      public: const std::vector<uint32_t> &HitIds() const;
+
+      /// \brief Set the ids of the collisions hit by the rays. Called by
+      /// UpdateRays of the physics engines that report hit collisions.
+      /// \param[in] _ids Collision ids indexed like the rays, 0 where
+      /// nothing was hit.
+      protected: void SetHitIds(const std::vector<uint32_t> &_ids);
+
       /// \brief Get the minimum range.
       /// \return Minimum range of all the rays.
       public: double GetMinRange() const;
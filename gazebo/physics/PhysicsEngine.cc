@@ -33,6 +33,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/ode/ODEPhysics.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -136,6 +137,21 @@ CollisionPtr PhysicsEngine::CreateCollision(const std::string &_shapeType,
   return result;
 }
 
+//////////////////////////////////////////////////
+bool PhysicsEngine::SaveCheckpoint(std::vector<uint8_t> &_data) const
+{
+  // Not virtual, to keep the ABI of the engine classes
+  auto ode = dynamic_cast<const ODEPhysics *>(this);
+  return ode && ode->SaveCheckpoint(_data);
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::RestoreCheckpoint(const std::vector<uint8_t> &_data)
+{
+  auto ode = dynamic_cast<ODEPhysics *>(this);
+  return ode && ode->RestoreCheckpoint(_data);
+}
+
 //////////////////////////////////////////////////
 double PhysicsEngine::GetUpdatePeriod()
 {
@@ -19,7 +19,9 @@
 
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/any.hpp>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <ignition/transport/Node.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -255,6 +257,21 @@ namespace gazebo
       /// \return Pointer to the physics SDF element.
       public: sdf::ElementPtr GetSDF() const;
 
+      /// \brief Save the engine specific dynamic state of the world, such
+      /// as body velocities and solver warm start data, to a buffer in
+      /// memory. Used by World::SaveCheckpoint. Only the ODE engine
+      /// supports checkpoints.
+      /// \param[out] _data Buffer receiving the state.
+      /// \return False if the engine does not support checkpoints.
+      public: bool SaveCheckpoint(std::vector<uint8_t> &_data) const;
+
+      /// \brief Restore a state written by SaveCheckpoint. The world must
+      /// contain the same links and joints as when the state was saved.
+      /// \param[in] _data Buffer written by SaveCheckpoint.
+      /// \return False if the engine does not support checkpoints or the
+      /// buffer does not match the world.
+      public: bool RestoreCheckpoint(const std::vector<uint8_t> &_data);
+
       /// \brief Helper function for performing any_cast operations in
       /// SetParam. This is useful because the PresetManager stores the
       /// output of sdf::Element::GetAny as boost::any values in its
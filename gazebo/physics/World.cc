@@ -51,6 +51,7 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/URI.hh"
@@ -80,6 +81,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
 
+#include "gazebo/physics/CheckpointHelpers.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/Population.hh"
@@ -105,6 +107,88 @@ class ModelUpdate_TBB
   private: Model_V *models;
 };
 
+//////////////////////////////////////////////////
+/// \brief Collect the mesh files of collisions and actors in an SDF tree.
+/// \param[in] _sdf SDF element to search, including nested models.
+/// \param[in] _inCollision True if _sdf is inside a collision.
+/// \param[out] _filenames Mesh files, keyed as MeshShape and Actor load
+/// them: collision URIs resolved to a full path, actor files as written.
+static void collectMeshFiles(sdf::ElementPtr _sdf, const bool _inCollision,
+    std::set<std::string> &_filenames)
+{
+  const std::string &name = _sdf->GetName();
+  if (_inCollision && name == "mesh" && _sdf->HasElement("uri"))
+  {
+    std::string filename =
+        common::find_file(_sdf->Get<std::string>("uri"));
+    if (!filename.empty())
+      _filenames.insert(filename);
+    return;
+  }
+
+  if ((name == "skin" || name == "animation") &&
+      _sdf->HasElement("filename"))
+  {
+    std::string filename = _sdf->Get<std::string>("filename");
+    if (!common::find_file(filename).empty())
+      _filenames.insert(filename);
+    return;
+  }
+
+  // Visual meshes are left to rendering, which may run in another process.
+  if (name == "visual" || name == "plugin")
+    return;
+
+  for (sdf::ElementPtr child = _sdf->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    collectMeshFiles(child, _inCollision || name == "collision", _filenames);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Decode the meshes used by a world on a thread pool, so that the
+/// sequential entity loading finds them in the MeshManager.
+/// \param[in] _sdf World SDF element.
+static void prefetchMeshes(sdf::ElementPtr _sdf)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+
+  // Files are resolved on this thread, resolving a model URI may download
+  // the model.
+  std::set<std::string> found;
+  collectMeshFiles(_sdf, false, found);
+
+  std::vector<std::string> filenames;
+  for (auto const &filename : found)
+  {
+    if (meshManager->IsValidFilename(filename) &&
+        !meshManager->HasMesh(filename))
+    {
+      filenames.push_back(filename);
+    }
+  }
+
+  if (filenames.size() < 2u)
+    return;
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, filenames.size(), 1),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        for (size_t i = _r.begin(); i != _r.end(); ++i)
+        {
+          // Errors are reported again when the entity loads the mesh.
+          try
+          {
+            meshManager->Load(filenames[i]);
+          }
+          catch(common::Exception &)
+          {
+          }
+        }
+      });
+}
+
 //////////////////////////////////////////////////
 World::World(const std::string &_name)
   : dataPtr(new WorldPrivate)
@@ -132,6 +216,8 @@ World::World(const std::string &_name)
 
   this->dataPtr->currentStateBuffer = 0;
   this->dataPtr->stateToggle = 0;
+  this->dataPtr->logKeyframeNeeded = true;
+  this->dataPtr->logPlaySeeking = false;
 
   this->dataPtr->pluginsLoaded = false;
 
@@ -334,6 +420,9 @@ void World::Load(sdf::ElementPtr _sdf)
   // information. The joints must be created last, otherwise they get
   // initialized improperly.
   {
+    // Decode the meshes in parallel before the entities need them
+    prefetchMeshes(this->dataPtr->sdf);
+
     // Create all the entities
     this->LoadEntities(this->dataPtr->sdf, this->dataPtr->rootElement);
 
@@ -589,7 +678,47 @@ void World::LogStep()
         this->dataPtr->stepInc = 1;
 
       std::string data;
-      if (!util::LogPlay::Instance()->Step(this->dataPtr->stepInc, data))
+      double keyframePeriod = util::LogPlay::Instance()->KeyframePeriod();
+
+      // Between keyframes a log only holds the models that changed, so a
+      // state can't be played on its own when stepping backwards. Seek to
+      // it instead, which replays the states since the previous keyframe.
+      if (keyframePeriod > 0 && this->dataPtr->stepInc < 0 &&
+          util::LogPlay::Instance()->Step(this->dataPtr->stepInc, data))
+      {
+        this->dataPtr->logPlayStateSDF->Clear();
+        sdf::readString(data, this->dataPtr->logPlayStateSDF);
+        this->dataPtr->logPlayState.Load(this->dataPtr->logPlayStateSDF);
+
+        this->SeekLog(this->dataPtr->logPlayState.GetSimTime());
+        this->dataPtr->stepInc = 1;
+      }
+
+      bool stepped =
+        util::LogPlay::Instance()->Step(this->dataPtr->stepInc, data);
+
+      // Apply all the states before the seek target, since each may hold
+      // the latest value of some of the models.
+      while (stepped && this->dataPtr->logPlaySeeking)
+      {
+        this->dataPtr->logPlayStateSDF->Clear();
+        sdf::readString(data, this->dataPtr->logPlayStateSDF);
+        this->dataPtr->logPlayState.Load(this->dataPtr->logPlayStateSDF);
+
+        if (this->dataPtr->logPlayState.GetSimTime() >=
+            this->dataPtr->logPlaySeekTarget)
+        {
+          break;
+        }
+
+        // Intermediate states only update the entities, the time is set
+        // by the target state
+        this->SetEntityStates(this->dataPtr->logPlayState);
+        stepped = util::LogPlay::Instance()->Step(data);
+      }
+      this->dataPtr->logPlaySeeking = false;
+
+      if (!stepped)
       {
         // There are no more chunks, time to exit.
         this->SetPaused(true);
@@ -964,6 +1093,7 @@ void World::Fini()
   this->dataPtr->logPlayState.SetWorld(WorldPtr());
   this->dataPtr->states[0].clear();
   this->dataPtr->states[1].clear();
+  WorldState::ClearFilterCache(this->Name());
 
   this->dataPtr->presetManager.reset();
   this->dataPtr->userCmdManager.reset();
@@ -1542,7 +1672,7 @@ void World::ProcessPlaybackControlMsgs()
     if (msg.has_seek())
     {
       common::Time targetSimTime = msgs::Convert(msg.seek());
-      util::LogPlay::Instance()->Seek(targetSimTime);
+      this->SeekLog(targetSimTime);
       this->dataPtr->stepInc = 1;
     }
 
@@ -1571,6 +1701,25 @@ void World::ProcessPlaybackControlMsgs()
   this->dataPtr->playbackControlMsgs.clear();
 }
 
+//////////////////////////////////////////////////
+void World::SeekLog(const common::Time &_time)
+{
+  double keyframePeriod = util::LogPlay::Instance()->KeyframePeriod();
+  if (keyframePeriod <= 0)
+  {
+    util::LogPlay::Instance()->Seek(_time);
+    return;
+  }
+
+  // Keyframes are at most two keyframe periods apart, since the recorder
+  // raises the keyframe period to at least the recording period. Starting
+  // that far back guarantees that a keyframe is played before the target,
+  // which bounds the cost of reconstructing the state.
+  util::LogPlay::Instance()->Seek(_time - common::Time(2.0 * keyframePeriod));
+  this->dataPtr->logPlaySeekTarget = _time;
+  this->dataPtr->logPlaySeeking = true;
+}
+
 //////////////////////////////////////////////////
 void World::OnRequest(ConstRequestPtr &_msg)
 {
@@ -1642,6 +1791,26 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
 {
+  // Evaluate the actors' animations in parallel. They only move their links
+  // in Actor::Update below.
+  Actor_V actors;
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (child->HasType(Base::ACTOR))
+      actors.push_back(boost::static_pointer_cast<Actor>(child));
+  }
+
+  if (actors.size() > 1)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, actors.size(), 1),
+        [&](const tbb::blocked_range<size_t> &_r)
+        {
+          for (size_t i = _r.begin(); i != _r.end(); ++i)
+            actors[i]->EvaluateFrame();
+        });
+  }
+
   // Update all the models
   for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
     this->dataPtr->rootElement->GetChild(i)->Update();
@@ -2286,6 +2455,12 @@ void World::SetState(const WorldState &_state)
   this->dataPtr->logRealTime = _state.GetRealTime();
   this->dataPtr->iterations = _state.GetIterations();
 
+  this->SetEntityStates(_state);
+}
+
+//////////////////////////////////////////////////
+void World::SetEntityStates(const WorldState &_state)
+{
   // Insertions (adapted from ProcessFactoryMsgs)
   auto insertions = _state.Insertions();
   for (auto const &insertion : insertions)
@@ -2337,6 +2512,15 @@ void World::SetState(const WorldState &_state)
       continue;
     }
 
+    // Seeking in a log applies the states before the target again, so the
+    // entity may already exist
+    const std::string name = elem->Get<std::string>("name");
+    if ((isModel && this->ModelByName(name)) ||
+        (isLight && this->LightByName(name)))
+    {
+      continue;
+    }
+
     elem->SetParent(this->dataPtr->sdf);
     elem->GetParent()->InsertElement(elem);
 
@@ -2406,9 +2590,72 @@ void World::SetState(const WorldState &_state)
   auto deletions = _state.Deletions();
   for (auto const &deletion : deletions)
   {
-    // This works for models and lights
-    this->RemoveModel(deletion);
+    // This works for models and lights. Skip entities that were already
+    // deleted, when a state is applied again.
+    if (this->ModelByName(deletion) || this->LightByName(deletion))
+      this->RemoveModel(deletion);
+  }
+}
+
+//////////////////////////////////////////////////
+bool World::SaveCheckpoint(std::vector<uint8_t> &_data)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+
+  std::vector<uint8_t> physicsData;
+  if (!this->dataPtr->physicsEngine ||
+      !this->dataPtr->physicsEngine->SaveCheckpoint(physicsData))
+  {
+    gzerr << "Physics engine does not support checkpoints\n";
+    return false;
+  }
+
+  _data.clear();
+  _data.reserve(physicsData.size() + 2 * sizeof(int32_t) + sizeof(uint64_t));
+  WriteCheckpoint(_data, this->dataPtr->simTime.sec);
+  WriteCheckpoint(_data, this->dataPtr->simTime.nsec);
+  WriteCheckpoint(_data, this->dataPtr->iterations);
+  _data.insert(_data.end(), physicsData.begin(), physicsData.end());
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool World::RestoreCheckpoint(const std::vector<uint8_t> &_data)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+
+  size_t offset = 0;
+  common::Time simTime;
+  uint64_t iterations = 0;
+  if (!this->dataPtr->physicsEngine ||
+      !ReadCheckpoint(_data, offset, simTime.sec) ||
+      !ReadCheckpoint(_data, offset, simTime.nsec) ||
+      !ReadCheckpoint(_data, offset, iterations))
+  {
+    gzerr << "Invalid world checkpoint\n";
+    return false;
+  }
+
+  const std::vector<uint8_t> physicsData(_data.begin() + offset, _data.end());
+  if (!this->dataPtr->physicsEngine->RestoreCheckpoint(physicsData))
+    return false;
+
+  // Propagate the restored poses, same as after a physics update.
+  {
+    boost::recursive_mutex::scoped_lock plock(
+        *this->Physics()->GetPhysicsUpdateMutex());
+
+    for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+      dirtyEntity->SetWorldPose(dirtyEntity->DirtyPose(), false);
+
+    this->dataPtr->dirtyPoses.clear();
   }
+
+  this->SetSimTime(simTime);
+  this->dataPtr->iterations = iterations;
+
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -2636,6 +2883,7 @@ bool World::OnLog(std::ostringstream &_stream)
     this->dataPtr->stateToggle = 0;
     this->dataPtr->prevStates[0] = WorldState();
     this->dataPtr->prevStates[1] = WorldState();
+    this->dataPtr->logKeyframeNeeded = true;
   }
 
   this->LogModelResources();
@@ -2934,18 +3182,52 @@ void World::LogWorker()
           this->dataPtr->prevStates[this->dataPtr->stateToggle];
       this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
-      if (!diffState.IsZero() || insertDelete)
+      // With keyframes enabled, a full state is stored once per keyframe
+      // period, even if nothing changed, so that playback can reconstruct
+      // any state from a bounded number of stored states.
+      double keyframePeriod = util::LogRecord::Instance()->KeyframePeriod();
+      bool keyframe = keyframePeriod <= 0 ||
+          this->dataPtr->logKeyframeNeeded ||
+          (simTime - this->dataPtr->logLastKeyframeTime).Double() >=
+          keyframePeriod;
+
+      if (!diffState.IsZero() || insertDelete ||
+          (keyframePeriod > 0 && keyframe))
       {
         this->dataPtr->stateToggle = currState;
+
+        // Store the entire current state (instead of the diffState). A slow
+        // moving link may never be captured if only diff state is recorded.
+        // Between keyframes, store only the models that have drifted from
+        // the value last stored for them. Drift accumulates, so slow moving
+        // links are still captured.
+        WorldState deltaState;
+        if (!keyframe)
+        {
+          deltaState = this->dataPtr->prevStates[currState].Delta(
+              this->dataPtr->logKeyframeRefState,
+              util::LogRecord::Instance()->DriftThreshold());
+        }
+        else if (keyframePeriod > 0)
+        {
+          this->dataPtr->logKeyframeRefState =
+            this->dataPtr->prevStates[currState];
+          this->dataPtr->logLastKeyframeTime = simTime;
+          this->dataPtr->logKeyframeNeeded = false;
+        }
+
+        WorldState &logState =
+          keyframe ? this->dataPtr->prevStates[currState] : deltaState;
+
+        if (keyframe || insertDelete || deltaState.GetModelStateCount() > 0 ||
+            deltaState.LightStateCount() > 0)
         {
-          // Store the entire current state (instead of the diffState). A slow
-          // moving link may never be captured if only diff state is recorded.
           std::lock_guard<std::mutex> bLock(this->dataPtr->logBufferMutex);
 
-          this->dataPtr->prevStates[currState].SetInsertions(insertions);
-          this->dataPtr->prevStates[currState].SetDeletions(deletions);
+          logState.SetInsertions(insertions);
+          logState.SetDeletions(deletions);
           this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(
-              this->dataPtr->prevStates[currState]);
+              logState);
 
           // Tell the logger to update, once the number of states exceeds 1000
           if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() >
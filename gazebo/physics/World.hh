@@ -297,6 +297,23 @@ namespace gazebo
       /// \param _state The state to set the World to.
       public: void SetState(const WorldState &_state);
 
+      /// \brief Save the dynamic state of the world to memory. The
+      /// checkpoint holds the simulation time, the iteration count and the
+      /// native state of the physics engine, including solver warm start
+      /// data, see PhysicsEngine::SaveCheckpoint. Plugin state is not
+      /// included.
+      /// \param[out] _data Checkpoint buffer.
+      /// \return False if the physics engine does not support checkpoints.
+      public: bool SaveCheckpoint(std::vector<uint8_t> &_data);
+
+      /// \brief Restore a checkpoint written by SaveCheckpoint. Unlike
+      /// SetState, stepping from a restored checkpoint reproduces the
+      /// original simulation exactly. Models must not have been inserted
+      /// or removed since the checkpoint was saved.
+      /// \param[in] _data Checkpoint buffer.
+      /// \return True if the checkpoint was restored.
+      public: bool RestoreCheckpoint(const std::vector<uint8_t> &_data);
+
       /// \brief Insert a model from an SDF file.
       /// Spawns a model into the world base on and SDF file.
       /// \param[in] _sdfFilename The name of the SDF file (including path).
@@ -596,6 +613,20 @@ namespace gazebo
       /// Must only be called from the World::ProcessMessages function.
       private: void ProcessPlaybackControlMsgs();
 
+      /// \brief Seek to a time in the log being played. If the log has
+      /// keyframes, the states between the previous keyframe and the target
+      /// are applied on the next World::LogStep.
+      /// \param[in] _time Target simulation time.
+      private: void SeekLog(const common::Time &_time);
+
+      /// \brief Apply the insertions, deletions, model states and light
+      /// states of a world state, without changing the simulation time.
+      /// Insertions of entities that already exist and deletions of
+      /// entities that don't are skipped, so a state can be applied again
+      /// when seeking in a log.
+      /// \param[in] _state The world state.
+      private: void SetEntityStates(const WorldState &_state);
+
       /// \brief Log callback. This is where we write out state info.
       private: bool OnLog(std::ostringstream &_stream);
 
@@ -275,6 +275,23 @@ namespace gazebo
       /// \brief Int used to toggle between prevStates
       public: int stateToggle;
 
+      /// \brief Last recorded value of every model and light, used to
+      /// compute the partial states recorded between keyframes.
+      public: WorldState logKeyframeRefState;
+
+      /// \brief Simulation time of the last keyframe recorded.
+      public: common::Time logLastKeyframeTime;
+
+      /// \brief True if the next recorded state must be a keyframe.
+      public: std::atomic_bool logKeyframeNeeded;
+
+      /// \brief True while catching up to logPlaySeekTarget during log
+      /// playback.
+      public: bool logPlaySeeking;
+
+      /// \brief Seek target when playing a log with keyframes.
+      public: common::Time logPlaySeekTarget;
+
       /// \brief State from from log file.
       public: sdf::ElementPtr logPlayStateSDF;
 
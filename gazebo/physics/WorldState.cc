@@ -17,6 +17,13 @@
 /* Desc: A world state
  * Author: Nate Koenig
  */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/common/Console.hh"
@@ -29,15 +36,184 @@
 using namespace gazebo;
 using namespace physics;
 
-// TODO added here for ABI compatibility
-// move to class when merging forward
-static std::string worldStateFilter;
+/// \brief World state filter of a world, and the compiled form of its
+/// model portion. The filter is compiled only when the filter string
+/// changes, and the match result for each model is cached by model id.
+/// Models are tested against the regex once, when they first appear, so
+/// per-tick filtering is a lookup instead of a regex match.
+struct ModelFilterCache
+{
+  /// \brief Protects the cache, several worlds may log at once.
+  std::mutex mutex;
+
+  /// \brief Filter set by the last WorldState::LoadWithFilter call.
+  std::string worldFilter;
+
+  /// \brief True once the cache has been built.
+  bool valid = false;
+
+  /// \brief Filter string the cache was built from.
+  std::string filter;
+
+  /// \brief True if the filter accepts every model.
+  bool matchAll = true;
+
+  /// \brief Compiled model name regex, valid when matchAll is false.
+  boost::regex regex;
+
+  /// \brief Match result of each model, indexed by model id.
+  std::unordered_map<uint32_t, bool> matches;
+};
+
+// Kept out of WorldState for ABI compatibility
+/// \brief Protects modelFilterCaches.
+static std::mutex modelFilterCachesMutex;
+
+/// \brief Filter cache of each world, by world name. Entries are shared so
+/// a world can be finalized while one of its states is still loading.
+static std::unordered_map<std::string, std::shared_ptr<ModelFilterCache>>
+    modelFilterCaches;
+
+/////////////////////////////////////////////////
+/// \brief Get the filter cache of a world, created on first use.
+/// \param[in] _worldName Name of the world.
+/// \return The world's filter cache. Lock its mutex before use.
+static std::shared_ptr<ModelFilterCache> WorldFilterCache(
+    const std::string &_worldName)
+{
+  std::lock_guard<std::mutex> lock(modelFilterCachesMutex);
+  auto &cache = modelFilterCaches[_worldName];
+  if (!cache)
+    cache = std::make_shared<ModelFilterCache>();
+  return cache;
+}
+
+/////////////////////////////////////////////////
+/// \brief Rebuild a model filter cache if the filter has changed.
+/// Must be called with the cache's mutex locked.
+/// \param[in,out] _cache Cache to update.
+static void UpdateModelFilterCache(ModelFilterCache &_cache)
+{
+  if (_cache.valid && _cache.worldFilter == _cache.filter)
+    return;
+
+  _cache.valid = true;
+  _cache.filter = _cache.worldFilter;
+  _cache.matches.clear();
+  _cache.matchAll = true;
+
+  std::list<std::string> mainParts, parts;
+  boost::split(mainParts, _cache.filter, boost::is_any_of("/"));
+
+  // Create the model filter
+  if (!mainParts.empty())
+  {
+    boost::split(parts, mainParts.front(), boost::is_any_of("."));
+    if (parts.empty() && !mainParts.front().empty())
+      parts.push_back(mainParts.front());
+  }
+
+  // The first element in the filter must be a model name or a star.
+  if (!parts.empty() && !parts.front().empty() && parts.front() != "*")
+  {
+    std::string regexStr = parts.front();
+    boost::replace_all(regexStr, "*", ".*");
+    _cache.regex = boost::regex(regexStr);
+    _cache.matchAll = false;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Largest change in position or orientation between two poses.
+/// \param[in] _a First pose.
+/// \param[in] _b Second pose.
+/// \return Max of the distance (meters) and the angle (radians)
+/// between the poses.
+static double PoseDrift(const ignition::math::Pose3d &_a,
+    const ignition::math::Pose3d &_b)
+{
+  double dot = _a.Rot().W() * _b.Rot().W() + _a.Rot().X() * _b.Rot().X() +
+    _a.Rot().Y() * _b.Rot().Y() + _a.Rot().Z() * _b.Rot().Z();
+  double angle = 2.0 * std::acos(std::min(std::abs(dot), 1.0));
+
+  return std::max(_a.Pos().Distance(_b.Pos()), angle);
+}
+
+/////////////////////////////////////////////////
+/// \brief Largest change between two states of the same model.
+/// \param[in] _a First model state.
+/// \param[in] _b Second model state.
+/// \return Max change of the model pose, and of the poses and positions
+/// of its links, joints and nested models. Structural changes, such as a
+/// new link or a different scale, return infinity.
+static double ModelDrift(const ModelState &_a, const ModelState &_b)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+
+  if (_a.Scale() != _b.Scale() ||
+      _a.GetLinkStateCount() != _b.GetLinkStateCount() ||
+      _a.GetJointStateCount() != _b.GetJointStateCount() ||
+      _a.NestedModelStateCount() != _b.NestedModelStateCount())
+  {
+    return inf;
+  }
+
+  double drift = PoseDrift(_a.Pose(), _b.Pose());
+
+  for (auto const &link : _a.GetLinkStates())
+  {
+    auto other = _b.GetLinkStates().find(link.first);
+    if (other == _b.GetLinkStates().end())
+      return inf;
+    drift = std::max(drift,
+        PoseDrift(link.second.Pose(), other->second.Pose()));
+  }
+
+  for (auto const &joint : _a.GetJointStates())
+  {
+    auto other = _b.GetJointStates().find(joint.first);
+    if (other == _b.GetJointStates().end() ||
+        joint.second.GetAngleCount() != other->second.GetAngleCount())
+    {
+      return inf;
+    }
+
+    for (unsigned int i = 0; i < joint.second.GetAngleCount(); ++i)
+    {
+      drift = std::max(drift,
+          std::abs(joint.second.Position(i) - other->second.Position(i)));
+    }
+  }
+
+  for (auto const &nested : _a.NestedModelStates())
+  {
+    auto other = _b.NestedModelStates().find(nested.first);
+    if (other == _b.NestedModelStates().end())
+      return inf;
+    drift = std::max(drift, ModelDrift(nested.second, other->second));
+  }
+
+  return drift;
+}
+
+/////////////////////////////////////////////////
+void WorldState::ClearFilterCache(const std::string &_worldName)
+{
+  std::lock_guard<std::mutex> lock(modelFilterCachesMutex);
+  modelFilterCaches.erase(_worldName);
+}
 
 /////////////////////////////////////////////////
 WorldState::WorldState()
   : State()
 {
-  worldStateFilter = "";
+  // A new state clears the filters, see LoadWithFilter
+  std::lock_guard<std::mutex> lock(modelFilterCachesMutex);
+  for (auto &cache : modelFilterCaches)
+  {
+    std::lock_guard<std::mutex> cacheLock(cache.second->mutex);
+    cache.second->worldFilter.clear();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -83,7 +259,11 @@ WorldState::~WorldState()
 void WorldState::LoadWithFilter(const WorldPtr _world,
                                 const std::string &_filter)
 {
-  worldStateFilter = _filter;
+  {
+    auto cache = WorldFilterCache(_world->Name());
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    cache->worldFilter = _filter;
+  }
   this->Load(_world);
 }
 
@@ -99,34 +279,31 @@ void WorldState::Load(const WorldPtr _world)
   this->insertions.clear();
   this->deletions.clear();
 
-  std::string filter = worldStateFilter;
-  std::list<std::string> mainParts, parts;
-  boost::split(mainParts, filter, boost::is_any_of("/"));
+  Model_V models = _world->Models();
 
-  // Create the model filter
-  if (!mainParts.empty())
-  {
-    boost::split(parts, mainParts.front(), boost::is_any_of("."));
-    if (parts.empty() && !mainParts.front().empty())
-      parts.push_back(mainParts.front());
-  }
-  std::list<std::string>::iterator partIter = parts.begin();
+  auto modelFilterCachePtr = WorldFilterCache(this->name);
+  ModelFilterCache &modelFilterCache = *modelFilterCachePtr;
+  std::lock_guard<std::mutex> lock(modelFilterCache.mutex);
+  UpdateModelFilterCache(modelFilterCache);
 
   // Add a state for all the models that match the filter
-  Model_V models = _world->Models();
   for (Model_V::const_iterator iter = models.begin();
        iter != models.end(); ++iter)
   {
-    bool add = true;
+    bool add = modelFilterCache.matchAll;
 
-    // The first element in the filter must be a model name or a star.
-    if (partIter != parts.end() && !parts.empty() &&
-        !(*partIter).empty() && (*partIter) != "*")
+    if (!add)
     {
-      std::string regexStr = *partIter;
-      boost::replace_all(regexStr, "*", ".*");
-      boost::regex regex(regexStr);
-      add = boost::regex_match((*iter)->GetName(), regex);
+      auto match = modelFilterCache.matches.find((*iter)->GetId());
+      if (match == modelFilterCache.matches.end())
+      {
+        add = boost::regex_match((*iter)->GetName(), modelFilterCache.regex);
+        modelFilterCache.matches[(*iter)->GetId()] = add;
+      }
+      else
+      {
+        add = match->second;
+      }
     }
 
     if (add)
@@ -136,6 +313,20 @@ void WorldState::Load(const WorldPtr _world)
     }
   }
 
+  // Drop cached results for deleted models. Ids are never reused, so this
+  // only bounds the size of the cache.
+  if (modelFilterCache.matches.size() > models.size())
+  {
+    std::unordered_map<uint32_t, bool> matches;
+    for (auto const &model : models)
+    {
+      auto match = modelFilterCache.matches.find(model->GetId());
+      if (match != modelFilterCache.matches.end())
+        matches.insert(*match);
+    }
+    modelFilterCache.matches.swap(matches);
+  }
+
   // Remove models that no longer exist. We determine this by check the time
   // stamp on each model.
   for (ModelState_M::iterator iter = this->modelStates.begin();
@@ -461,12 +652,10 @@ WorldState &WorldState::operator=(const WorldState &_state)
   }
 
   // Copy the insertions
-  std::copy(_state.insertions.begin(),
-            _state.insertions.end(), this->insertions.begin());
+  this->insertions = _state.insertions;
 
   // Copy the deletions
-  std::copy(_state.deletions.begin(),
-            _state.deletions.end(), this->deletions.begin());
+  this->deletions = _state.deletions;
 
   return *this;
 }
@@ -576,6 +765,70 @@ WorldState WorldState::operator+(const WorldState &_state) const
   return result;
 }
 
+/////////////////////////////////////////////////
+WorldState WorldState::Delta(WorldState &_reference,
+    const double _threshold) const
+{
+  WorldState result;
+
+  result.name = this->name;
+  result.simTime = this->simTime;
+  result.realTime = this->realTime;
+  result.wallTime = this->wallTime;
+  result.iterations = this->iterations;
+
+  double threshold = std::max(_threshold, 0.0);
+
+  for (auto const &modelState : this->modelStates)
+  {
+    auto ref = _reference.modelStates.find(modelState.first);
+    if (ref == _reference.modelStates.end() ||
+        ModelDrift(modelState.second, ref->second) > threshold)
+    {
+      result.modelStates[modelState.first] = modelState.second;
+      _reference.modelStates[modelState.first] = modelState.second;
+    }
+  }
+
+  for (auto const &lightState : this->lightStates)
+  {
+    auto ref = _reference.lightStates.find(lightState.first);
+    if (ref == _reference.lightStates.end() ||
+        PoseDrift(lightState.second.Pose(), ref->second.Pose()) > threshold)
+    {
+      result.lightStates[lightState.first] = lightState.second;
+      _reference.lightStates[lightState.first] = lightState.second;
+    }
+  }
+
+  // Forget entities that no longer exist.
+  for (auto iter = _reference.modelStates.begin();
+       iter != _reference.modelStates.end();)
+  {
+    if (!this->HasModelState(iter->first))
+      _reference.modelStates.erase(iter++);
+    else
+      ++iter;
+  }
+
+  for (auto iter = _reference.lightStates.begin();
+       iter != _reference.lightStates.end();)
+  {
+    if (!this->HasLightState(iter->first))
+      _reference.lightStates.erase(iter++);
+    else
+      ++iter;
+  }
+
+  _reference.name = this->name;
+  _reference.simTime = this->simTime;
+  _reference.realTime = this->realTime;
+  _reference.wallTime = this->wallTime;
+  _reference.iterations = this->iterations;
+
+  return result;
+}
+
 /////////////////////////////////////////////////
 void WorldState::FillSDF(sdf::ElementPtr _sdf)
 {
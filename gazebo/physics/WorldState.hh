@@ -78,6 +78,11 @@ namespace gazebo
       public: void LoadWithFilter(const WorldPtr _world,
           const std::string &_filter);
 
+      /// \brief Drop the cached state filter of a world. Called when the
+      /// world is finalized.
+      /// \param[in] _worldName Name of the world.
+      public: static void ClearFilterCache(const std::string &_worldName);
+
       /// \brief Load state from SDF element.
       ///
       /// Set a WorldState from an SDF element containing WorldState info.
@@ -204,6 +209,23 @@ namespace gazebo
       /// \return The resulting state.
       public: WorldState operator+(const WorldState &_state) const;
 
+      /// \brief Get the model and light states that have changed with
+      /// respect to a reference state.
+      ///
+      /// Unlike operator-, the returned states hold absolute values, so
+      /// the result can be applied on top of the reference with
+      /// World::SetState. The returned states are also copied into the
+      /// reference, so that small changes accumulate until they exceed
+      /// the threshold instead of being lost.
+      /// \param[in,out] _reference The reference state.
+      /// \param[in] _threshold Minimum change in position (meters), in
+      /// orientation (radians) or in joint position of a model, or of any of
+      /// its links, joints or nested models, for the model to be included.
+      /// A value <= 0 includes every model that changed.
+      /// \return The changed states, with the times of this state.
+      public: WorldState Delta(WorldState &_reference,
+                  const double _threshold) const;
+
       /// \brief Stream insertion operator
       /// \param[in] _out output stream
       /// \param[in] _state World state to output
@@ -113,6 +113,131 @@ TEST_F(WorldStateTest, WorldConstructor)
       ignition::math::Pose3d(0, 0, 10, 0, 0, 0));
 }
 
+//////////////////////////////////////////////////
+TEST_F(WorldStateTest, LoadWithFilter)
+{
+  // Load a world
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box_1");
+  this->SpawnBox("box_2");
+  this->SpawnSphere("sphere_1", ignition::math::Vector3d(0, 5, 0),
+      ignition::math::Vector3d::Zero);
+
+  physics::WorldState worldState;
+
+  // Only models matching the filter are loaded
+  worldState.LoadWithFilter(world, "box_*");
+  EXPECT_EQ(worldState.GetModelStateCount(), 2u);
+  EXPECT_TRUE(worldState.HasModelState("box_1"));
+  EXPECT_TRUE(worldState.HasModelState("box_2"));
+  EXPECT_FALSE(worldState.HasModelState("sphere_1"));
+
+  // Loading again with the same filter gives the same result
+  worldState.LoadWithFilter(world, "box_*");
+  EXPECT_EQ(worldState.GetModelStateCount(), 2u);
+
+  // Models inserted after the filter was set are matched too
+  this->SpawnBox("box_3");
+  worldState.LoadWithFilter(world, "box_*");
+  EXPECT_EQ(worldState.GetModelStateCount(), 3u);
+  EXPECT_TRUE(worldState.HasModelState("box_3"));
+
+  // Deleted models are removed
+  world->RemoveModel("box_2");
+  worldState.LoadWithFilter(world, "box_*");
+  EXPECT_EQ(worldState.GetModelStateCount(), 2u);
+  EXPECT_FALSE(worldState.HasModelState("box_2"));
+
+  // Changing the filter recompiles it
+  worldState.LoadWithFilter(world, "sphere_1");
+  EXPECT_EQ(worldState.GetModelStateCount(), 1u);
+  EXPECT_TRUE(worldState.HasModelState("sphere_1"));
+
+  // A star matches every model
+  worldState.LoadWithFilter(world, "*");
+  EXPECT_EQ(worldState.GetModelStateCount(), 4u);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldStateTest, Delta)
+{
+  // Load a world
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box_1", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5));
+  this->SpawnBox("box_2", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 5, 0.5));
+
+  physics::ModelPtr box1 = world->ModelByName("box_1");
+  ASSERT_TRUE(box1 != nullptr);
+
+  physics::WorldState reference(world);
+
+  // Nothing changed
+  physics::WorldState worldState(world);
+  physics::WorldState delta = worldState.Delta(reference, 0.1);
+  EXPECT_EQ(delta.GetModelStateCount(), 0u);
+  EXPECT_EQ(delta.LightStateCount(), 0u);
+  EXPECT_EQ(delta.GetSimTime(), worldState.GetSimTime());
+
+  // A change below the threshold is not included
+  box1->SetWorldPose(ignition::math::Pose3d(0.05, 0, 0.5, 0, 0, 0));
+  worldState.Load(world);
+  delta = worldState.Delta(reference, 0.1);
+  EXPECT_EQ(delta.GetModelStateCount(), 0u);
+
+  // Changes accumulate until they exceed the threshold
+  box1->SetWorldPose(ignition::math::Pose3d(0.15, 0, 0.5, 0, 0, 0));
+  worldState.Load(world);
+  delta = worldState.Delta(reference, 0.1);
+  EXPECT_EQ(delta.GetModelStateCount(), 1u);
+  ASSERT_TRUE(delta.HasModelState("box_1"));
+
+  // The delta holds absolute values, not differences
+  EXPECT_EQ(delta.GetModelState("box_1").Pose(),
+      ignition::math::Pose3d(0.15, 0, 0.5, 0, 0, 0));
+
+  // The reference was updated
+  EXPECT_EQ(reference.GetModelState("box_1").Pose(),
+      ignition::math::Pose3d(0.15, 0, 0.5, 0, 0, 0));
+  delta = worldState.Delta(reference, 0.1);
+  EXPECT_EQ(delta.GetModelStateCount(), 0u);
+
+  // Rotations are thresholded too
+  box1->SetWorldPose(ignition::math::Pose3d(0.15, 0, 0.5, 0, 0, 0.2));
+  worldState.Load(world);
+  delta = worldState.Delta(reference, 0.1);
+  EXPECT_TRUE(delta.HasModelState("box_1"));
+
+  // Any change is included with a zero threshold
+  box1->SetWorldPose(ignition::math::Pose3d(0.151, 0, 0.5, 0, 0, 0.2));
+  worldState.Load(world);
+  delta = worldState.Delta(reference, 0);
+  EXPECT_TRUE(delta.HasModelState("box_1"));
+  EXPECT_FALSE(delta.HasModelState("box_2"));
+
+  // New models are always included
+  this->SpawnBox("box_3", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, -5, 0.5));
+  worldState.Load(world);
+  delta = worldState.Delta(reference, 0.1);
+  EXPECT_EQ(delta.GetModelStateCount(), 1u);
+  EXPECT_TRUE(delta.HasModelState("box_3"));
+
+  // Deleted models are removed from the reference
+  world->RemoveModel("box_2");
+  worldState.Load(world);
+  delta = worldState.Delta(reference, 0.1);
+  EXPECT_EQ(delta.GetModelStateCount(), 0u);
+  EXPECT_FALSE(reference.HasModelState("box_2"));
+}
+
 //////////////////////////////////////////////////
 TEST_F(WorldStateTest, FillSDF)
 {
@@ -15,6 +15,10 @@
  *
 */
 
+#include <cstring>
+#include <sstream>
+#include <vector>
+
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -216,6 +220,257 @@ TEST_F(WorldTest, Stop)
   EXPECT_TRUE(world->Running());
 }
 
+//////////////////////////////////////////////////
+/// \brief Get the pose and velocities of all links in the world.
+/// \param[in] _world Pointer to the world.
+/// \return Link states, in a stable order.
+static std::vector<double> linkStates(physics::WorldPtr _world)
+{
+  std::vector<double> states;
+  for (auto const &model : _world->Models())
+  {
+    for (auto const &link : model->GetLinks())
+    {
+      auto pose = link->WorldPose();
+      auto linVel = link->WorldLinearVel();
+      auto angVel = link->WorldAngularVel();
+      states.insert(states.end(), {
+          pose.Pos().X(), pose.Pos().Y(), pose.Pos().Z(),
+          pose.Rot().W(), pose.Rot().X(), pose.Rot().Y(), pose.Rot().Z(),
+          linVel.X(), linVel.Y(), linVel.Z(),
+          angVel.X(), angVel.Y(), angVel.Z()});
+    }
+  }
+  return states;
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, Checkpoint)
+{
+  // Double pendulum, chaotic so any difference grows quickly
+  this->Load("test/worlds/inertia_ratio_pendulum.world", true);
+
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Sphere bouncing on a static box, to have contacts
+  SpawnBox("floor", ignition::math::Vector3d(4, 4, 1),
+      ignition::math::Vector3d(10, 0, 0), ignition::math::Vector3d::Zero,
+      true);
+  SpawnSphere("ball", ignition::math::Vector3d(10, 0, 1.6),
+      ignition::math::Vector3d::Zero);
+
+  world->Step(300);
+
+  std::vector<uint8_t> checkpoint;
+  ASSERT_TRUE(world->SaveCheckpoint(checkpoint));
+  EXPECT_FALSE(checkpoint.empty());
+
+  auto simTime = world->SimTime();
+  auto iterations = world->Iterations();
+  auto initial = linkStates(world);
+
+  world->Step(500);
+  auto expected = linkStates(world);
+  ASSERT_EQ(initial.size(), expected.size());
+  EXPECT_NE(initial, expected);
+
+  // Replaying from the checkpoint is bitwise identical, every time
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    ASSERT_TRUE(world->RestoreCheckpoint(checkpoint));
+    EXPECT_EQ(simTime, world->SimTime());
+    EXPECT_EQ(iterations, world->Iterations());
+
+    auto restored = linkStates(world);
+    ASSERT_EQ(initial.size(), restored.size());
+    EXPECT_EQ(0, std::memcmp(initial.data(), restored.data(),
+        initial.size() * sizeof(double)));
+
+    world->Step(500);
+
+    auto actual = linkStates(world);
+    ASSERT_EQ(expected.size(), actual.size());
+    EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(),
+        expected.size() * sizeof(double)));
+  }
+
+  // A truncated checkpoint is rejected, and leaves the world unchanged
+  simTime = world->SimTime();
+  iterations = world->Iterations();
+  auto current = linkStates(world);
+  for (size_t size : {checkpoint.size() / 2, checkpoint.size() - 1})
+  {
+    std::vector<uint8_t> truncated(checkpoint.begin(),
+        checkpoint.begin() + size);
+    EXPECT_FALSE(world->RestoreCheckpoint(truncated));
+    EXPECT_EQ(simTime, world->SimTime());
+    EXPECT_EQ(iterations, world->Iterations());
+
+    auto unchanged = linkStates(world);
+    ASSERT_EQ(current.size(), unchanged.size());
+    EXPECT_EQ(0, std::memcmp(current.data(), unchanged.data(),
+        current.size() * sizeof(double)));
+  }
+
+  // So is a checkpoint of a world with other models
+  SpawnSphere("ball2", ignition::math::Vector3d(-10, 0, 1.6),
+      ignition::math::Vector3d::Zero);
+  current = linkStates(world);
+  EXPECT_FALSE(world->RestoreCheckpoint(checkpoint));
+  EXPECT_EQ(simTime, world->SimTime());
+  auto unchanged = linkStates(world);
+  ASSERT_EQ(current.size(), unchanged.size());
+  EXPECT_EQ(0, std::memcmp(current.data(), unchanged.data(),
+      current.size() * sizeof(double)));
+}
+
+//////////////////////////////////////////////////
+/// \brief Step the world until a link is disabled by ODE auto disable.
+/// \param[in] _world Pointer to the world.
+/// \param[in] _link Link to watch.
+/// \param[in] _maxSteps Maximum number of steps.
+/// \return Iteration count when the link was disabled, 0 if it was not.
+static uint64_t stepUntilAsleep(physics::WorldPtr _world,
+    physics::LinkPtr _link, unsigned int _maxSteps)
+{
+  for (unsigned int i = 0; i < _maxSteps; ++i)
+  {
+    _world->Step(1);
+    if (!_link->GetEnabled())
+      return _world->Iterations();
+  }
+  return 0;
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, CheckpointAutoDisable)
+{
+  this->Load("worlds/empty.world", true);
+
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  SpawnSphere("ball", ignition::math::Vector3d(0, 0, 1),
+      ignition::math::Vector3d::Zero);
+  auto model = world->ModelByName("ball");
+  ASSERT_NE(nullptr, model);
+  auto link = model->GetLink();
+  ASSERT_NE(nullptr, link);
+
+  std::vector<uint8_t> start;
+  ASSERT_TRUE(world->SaveCheckpoint(start));
+
+  // Find when the ball falls asleep after landing
+  const uint64_t asleep = stepUntilAsleep(world, link, 5000);
+  ASSERT_GT(asleep, 200u);
+
+  // Checkpoint while the idle countdown is running
+  ASSERT_TRUE(world->RestoreCheckpoint(start));
+  EXPECT_TRUE(link->GetEnabled());
+  world->Step(asleep - world->Iterations() - 100);
+  EXPECT_TRUE(link->GetEnabled());
+  std::vector<uint8_t> idle;
+  ASSERT_TRUE(world->SaveCheckpoint(idle));
+
+  // Restoring it, from an asleep or awake ball, falls asleep on the
+  // same step
+  world->Step(500);
+  EXPECT_FALSE(link->GetEnabled());
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    ASSERT_TRUE(world->RestoreCheckpoint(idle));
+    EXPECT_TRUE(link->GetEnabled());
+    EXPECT_EQ(asleep, stepUntilAsleep(world, link, 500));
+  }
+
+  // A checkpoint of the asleep ball stays asleep
+  std::vector<uint8_t> sleeping;
+  ASSERT_TRUE(world->SaveCheckpoint(sleeping));
+  auto expected = linkStates(world);
+  ASSERT_TRUE(world->RestoreCheckpoint(idle));
+  ASSERT_TRUE(world->RestoreCheckpoint(sleeping));
+  EXPECT_FALSE(link->GetEnabled());
+  world->Step(100);
+  EXPECT_FALSE(link->GetEnabled());
+  auto actual = linkStates(world);
+  ASSERT_EQ(expected.size(), actual.size());
+  EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(),
+      expected.size() * sizeof(double)));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, CheckpointJointWrap)
+{
+  this->Load("worlds/empty.world", true);
+
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Wheel spinning on a revolute joint with limits beyond +/-pi, so the
+  // limit check depends on the unwrapped joint angle
+  std::ostringstream modelStr;
+  modelStr << "<sdf version ='" << SDF_VERSION << "'>"
+    << "<model name='wheel'>"
+    << "<pose>0 0 2 0 0 0</pose>"
+    << "<link name ='link'>"
+    <<   "<collision name ='collision'>"
+    <<     "<geometry><box><size>1 0.2 0.2</size></box></geometry>"
+    <<   "</collision>"
+    << "</link>"
+    << "<joint name='joint' type='revolute'>"
+    <<   "<parent>world</parent>"
+    <<   "<child>link</child>"
+    <<   "<axis>"
+    <<     "<xyz>0 0 1</xyz>"
+    <<     "<limit><lower>-10</lower><upper>8</upper></limit>"
+    <<   "</axis>"
+    << "</joint>"
+    << "</model>"
+    << "</sdf>";
+  SpawnSDF(modelStr.str());
+
+  auto model = world->ModelByName("wheel");
+  ASSERT_NE(nullptr, model);
+  auto joint = model->GetJoint("joint");
+  ASSERT_NE(nullptr, joint);
+
+  joint->SetVelocity(0, 3.0);
+  world->Step(1500);
+
+  // Past pi, the ODE angle has wrapped
+  std::vector<uint8_t> checkpoint;
+  ASSERT_TRUE(world->SaveCheckpoint(checkpoint));
+  const double position = joint->Position(0);
+  EXPECT_GT(position, IGN_PI);
+  auto initial = linkStates(world);
+
+  // Run into the upper limit
+  world->Step(2000);
+  const double expectedPosition = joint->Position(0);
+  EXPECT_LT(expectedPosition, 8.1);
+  auto expected = linkStates(world);
+
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    ASSERT_TRUE(world->RestoreCheckpoint(checkpoint));
+    EXPECT_DOUBLE_EQ(position, joint->Position(0));
+
+    auto restored = linkStates(world);
+    ASSERT_EQ(initial.size(), restored.size());
+    EXPECT_EQ(0, std::memcmp(initial.data(), restored.data(),
+        initial.size() * sizeof(double)));
+
+    world->Step(2000);
+    EXPECT_DOUBLE_EQ(expectedPosition, joint->Position(0));
+
+    auto actual = linkStates(world);
+    ASSERT_EQ(expected.size(), actual.size());
+    EXPECT_EQ(0, std::memcmp(expected.data(), actual.data(),
+        expected.size() * sizeof(double)));
+  }
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
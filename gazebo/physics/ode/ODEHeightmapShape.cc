@@ -26,6 +26,7 @@ ODEHeightmapShape::ODEHeightmapShape(CollisionPtr _parent)
     : HeightmapShape(_parent)
 {
   this->flipY = false;
+  this->SetTileable(true);
 }
 
 //////////////////////////////////////////////////
@@ -40,6 +41,13 @@ dReal ODEHeightmapShape::GetHeightCallback(void *_data, int _x, int _y)
   return static_cast<ODEHeightmapShape*>(_data)->GetHeight(_x, _y);
 }
 
+//////////////////////////////////////////////////
+// reads the heights of a tiled height field straight from its tiles. ODE
+// clamps the indices to the samples.
+static dReal GetTileHeightCallback(void *_data, int _x, int _y)
+{
+  return static_cast<HeightmapTiles *>(_data)->Height(_x, _y);
+}
 
 //////////////////////////////////////////////////
 // creates the ODE height field. Only enabled if the height data type is float.
@@ -110,19 +118,39 @@ void ODEHeightmapShape::Init()
 
 
   // Step 3: Setup a callback method for ODE
-  setOdeHeightfieldDetails(
-      this->odeData,
-      this->heights.data(),
-      // in meters
-      this->Size().X(),
-      // in meters
-      this->Size().Y(),
-      // number of vertices
-      this->vertSize,
-      // vertical (z-axis) offset
-      this->Pos().Z(),
-      // vertical thickness for closing the height map mesh
-      1.0);
+  if (this->Tiles())
+  {
+    // The heights are read from the tiles, so ODE only fills the tiles
+    // around the geoms it collides with the heightfield
+    dGeomHeightfieldDataBuildCallback(
+        this->odeData,
+        this->Tiles(),
+        &GetTileHeightCallback,
+        this->Size().X(),  // width (in meters)
+        this->Size().Y(),  // height (in meters)
+        this->vertSize,    // width (sampling size)
+        this->vertSize,    // height (sampling size)
+        1.0,               // vertical (z-axis) scaling
+        this->Pos().Z(),   // vertical (z-axis) offset
+        1.0,               // vertical thickness for closing the height map
+        0);                // wrap mode
+  }
+  else
+  {
+    setOdeHeightfieldDetails(
+        this->odeData,
+        this->heights.data(),
+        // in meters
+        this->Size().X(),
+        // in meters
+        this->Size().Y(),
+        // number of vertices
+        this->vertSize,
+        // vertical (z-axis) offset
+        this->Pos().Z(),
+        // vertical thickness for closing the height map mesh
+        1.0);
+  }
 
   // Step 4: Restrict the bounds of the AABB to improve efficiency
   dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
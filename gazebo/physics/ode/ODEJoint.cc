@@ -19,6 +19,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Assert.hh"
 
+#include "gazebo/physics/CheckpointHelpers.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
@@ -284,6 +285,64 @@ dJointFeedback *ODEJoint::GetFeedback()
   return nullptr;
 }
 
+//////////////////////////////////////////////////
+void ODEJoint::SaveCheckpoint(std::vector<uint8_t> &_data) const
+{
+  WriteCheckpoint(_data, this->GetId());
+
+  dReal lambda[6] = {0, 0, 0, 0, 0, 0};
+  dReal lambdaErp[6] = {0, 0, 0, 0, 0, 0};
+  if (this->jointId)
+    dJointGetWarmStart(this->jointId, lambda, lambdaErp);
+  WriteCheckpoint(_data, lambda);
+  WriteCheckpoint(_data, lambdaErp);
+
+  WriteCheckpoint(_data, this->forceApplied);
+  WriteCheckpoint(_data, this->forceAppliedTime.sec);
+  WriteCheckpoint(_data, this->forceAppliedTime.nsec);
+
+  dReal angles[2] = {0, 0};
+  int32_t angleCount = 0;
+  if (this->jointId)
+    angleCount = dJointGetCumulativeAngles(this->jointId, angles);
+  WriteCheckpoint(_data, angleCount);
+  WriteCheckpoint(_data, angles);
+}
+
+//////////////////////////////////////////////////
+bool ODEJoint::ParseCheckpoint(const std::vector<uint8_t> &_data,
+    size_t &_offset, Checkpoint &_state) const
+{
+  uint32_t id = 0;
+  int32_t angleCount = 0;
+  dReal angles[2] = {0, 0};
+  const int32_t expectedCount = this->jointId ?
+      dJointGetCumulativeAngles(this->jointId, angles) : 0;
+  return ReadCheckpoint(_data, _offset, id) && id == this->GetId() &&
+      ReadCheckpoint(_data, _offset, _state.lambda) &&
+      ReadCheckpoint(_data, _offset, _state.lambdaErp) &&
+      ReadCheckpoint(_data, _offset, _state.force) &&
+      ReadCheckpoint(_data, _offset, _state.forceTime.sec) &&
+      ReadCheckpoint(_data, _offset, _state.forceTime.nsec) &&
+      ReadCheckpoint(_data, _offset, angleCount) &&
+      angleCount == expectedCount &&
+      ReadCheckpoint(_data, _offset, _state.cumulativeAngles);
+}
+
+//////////////////////////////////////////////////
+void ODEJoint::RestoreCheckpoint(const Checkpoint &_state)
+{
+  if (this->jointId)
+  {
+    dJointSetWarmStart(this->jointId, _state.lambda, _state.lambdaErp);
+    dJointSetCumulativeAngles(this->jointId, _state.cumulativeAngles);
+  }
+
+  for (unsigned int i = 0; i < MAX_JOINT_AXIS; ++i)
+    this->forceApplied[i] = _state.force[i];
+  this->forceAppliedTime = _state.forceTime;
+}
+
 //////////////////////////////////////////////////
 void ODEJoint::SetUpperLimit(const unsigned int _index, const double _limit)
 {
@@ -19,6 +19,7 @@
 
 #include <boost/any.hpp>
 #include <string>
+#include <vector>
 
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/Joint.hh"
@@ -132,6 +133,46 @@ namespace gazebo
       /// \return Pointer to the joint feedback.
       public: dJointFeedback *GetFeedback();
 
+      /// \brief Append the solver warm start, commanded forces and
+      /// cumulative angles of the joint to a checkpoint buffer.
+      /// \param[in,out] _data Checkpoint buffer.
+      public: void SaveCheckpoint(std::vector<uint8_t> &_data) const;
+
+      /// \brief Solver warm start, commanded forces and cumulative angles
+      /// of the joint, read from a checkpoint.
+      public: struct Checkpoint
+              {
+                /// \brief Constraint impulses of the last step.
+                dReal lambda[6];
+
+                /// \brief Constraint impulses with ERP of the last step.
+                dReal lambdaErp[6];
+
+                /// \brief Commanded forces.
+                double force[MAX_JOINT_AXIS];
+
+                /// \brief Time the forces were commanded.
+                common::Time forceTime;
+
+                /// \brief Unwrapped angles ODE uses for limits beyond
+                /// +/-pi.
+                dReal cumulativeAngles[2];
+              };
+
+      /// \brief Read the state written by SaveCheckpoint, without changing
+      /// the joint.
+      /// \param[in] _data Checkpoint buffer.
+      /// \param[in,out] _offset Read position, advanced past the joint
+      /// state.
+      /// \param[out] _state State of the joint.
+      /// \return False if the buffer does not match this joint.
+      public: bool ParseCheckpoint(const std::vector<uint8_t> &_data,
+                  size_t &_offset, Checkpoint &_state) const;
+
+      /// \brief Restore a state read by ParseCheckpoint.
+      /// \param[in] _state State of the joint.
+      public: void RestoreCheckpoint(const Checkpoint &_state);
+
       /// \brief Get flag indicating whether implicit spring damper is enabled.
       /// \return True if implicit spring damper is used.
       public: bool UsesImplicitSpringDamper();
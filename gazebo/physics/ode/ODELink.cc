@@ -15,12 +15,14 @@
  *
 */
 #include <math.h>
+#include <cstring>
 #include <sstream>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 
+#include "gazebo/physics/CheckpointHelpers.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldPrivate.hh"
@@ -174,6 +176,137 @@ void ODELink::MoveCallback(dBodyID _id)
   }
 }
 
+//////////////////////////////////////////////////
+void ODELink::SaveCheckpoint(std::vector<uint8_t> &_data) const
+{
+  WriteCheckpoint(_data, this->GetId());
+  WriteCheckpoint(_data, static_cast<uint8_t>(this->linkId != nullptr));
+  if (!this->linkId)
+    return;
+
+  dReal pos[3], rot[4], linVel[3], angVel[3], force[3], torque[3];
+  std::memcpy(pos, dBodyGetPosition(this->linkId), sizeof(pos));
+  std::memcpy(rot, dBodyGetQuaternion(this->linkId), sizeof(rot));
+  std::memcpy(linVel, dBodyGetLinearVel(this->linkId), sizeof(linVel));
+  std::memcpy(angVel, dBodyGetAngularVel(this->linkId), sizeof(angVel));
+  std::memcpy(force, dBodyGetForce(this->linkId), sizeof(force));
+  std::memcpy(torque, dBodyGetTorque(this->linkId), sizeof(torque));
+
+  WriteCheckpoint(_data, pos);
+  WriteCheckpoint(_data, rot);
+  WriteCheckpoint(_data, linVel);
+  WriteCheckpoint(_data, angVel);
+  WriteCheckpoint(_data, force);
+  WriteCheckpoint(_data, torque);
+  WriteCheckpoint(_data,
+      static_cast<uint8_t>(dBodyIsEnabled(this->linkId) != 0));
+
+  // Auto disable progress, so a body falls asleep on the same step
+  const uint32_t samples = static_cast<uint32_t>(
+      dBodyGetAutoDisableAverageSamplesCount(this->linkId));
+  std::vector<dReal> linHistory(samples * 4);
+  std::vector<dReal> angHistory(samples * 4);
+  dReal idleTime = 0;
+  int idleSteps = 0;
+  unsigned int averageCounter = 0;
+  int averageReady = 0;
+  dBodyGetAutoDisableState(this->linkId, &idleTime, &idleSteps,
+      &averageCounter, &averageReady, linHistory.data(), angHistory.data());
+
+  WriteCheckpoint(_data, idleTime);
+  WriteCheckpoint(_data, static_cast<int32_t>(idleSteps));
+  WriteCheckpoint(_data, static_cast<uint32_t>(averageCounter));
+  WriteCheckpoint(_data, static_cast<int32_t>(averageReady));
+  WriteCheckpoint(_data, samples);
+  for (size_t i = 0; i < linHistory.size(); ++i)
+    WriteCheckpoint(_data, linHistory[i]);
+  for (size_t i = 0; i < angHistory.size(); ++i)
+    WriteCheckpoint(_data, angHistory[i]);
+}
+
+//////////////////////////////////////////////////
+bool ODELink::ParseCheckpoint(const std::vector<uint8_t> &_data,
+    size_t &_offset, Checkpoint &_state) const
+{
+  uint32_t id = 0;
+  uint8_t hasBody = 0;
+  if (!ReadCheckpoint(_data, _offset, id) || id != this->GetId() ||
+      !ReadCheckpoint(_data, _offset, hasBody) ||
+      hasBody != static_cast<uint8_t>(this->linkId != nullptr))
+  {
+    return false;
+  }
+
+  if (!this->linkId)
+    return true;
+
+  uint32_t samples = 0;
+  if (!ReadCheckpoint(_data, _offset, _state.pos) ||
+      !ReadCheckpoint(_data, _offset, _state.rot) ||
+      !ReadCheckpoint(_data, _offset, _state.linVel) ||
+      !ReadCheckpoint(_data, _offset, _state.angVel) ||
+      !ReadCheckpoint(_data, _offset, _state.force) ||
+      !ReadCheckpoint(_data, _offset, _state.torque) ||
+      !ReadCheckpoint(_data, _offset, _state.enabled) ||
+      !ReadCheckpoint(_data, _offset, _state.idleTime) ||
+      !ReadCheckpoint(_data, _offset, _state.idleSteps) ||
+      !ReadCheckpoint(_data, _offset, _state.averageCounter) ||
+      !ReadCheckpoint(_data, _offset, _state.averageReady) ||
+      !ReadCheckpoint(_data, _offset, samples) ||
+      samples != static_cast<uint32_t>(
+        dBodyGetAutoDisableAverageSamplesCount(this->linkId)))
+  {
+    return false;
+  }
+
+  _state.averageLinVel.resize(samples * 4);
+  _state.averageAngVel.resize(samples * 4);
+  for (auto &value : _state.averageLinVel)
+  {
+    if (!ReadCheckpoint(_data, _offset, value))
+      return false;
+  }
+  for (auto &value : _state.averageAngVel)
+  {
+    if (!ReadCheckpoint(_data, _offset, value))
+      return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ODELink::RestoreCheckpoint(const Checkpoint &_state)
+{
+  if (!this->linkId)
+    return;
+
+  dBodySetPosition(this->linkId, _state.pos[0], _state.pos[1],
+      _state.pos[2]);
+  dBodySetExactQuaternion(this->linkId, _state.rot);
+  dBodySetLinearVel(this->linkId, _state.linVel[0], _state.linVel[1],
+      _state.linVel[2]);
+  dBodySetAngularVel(this->linkId, _state.angVel[0], _state.angVel[1],
+      _state.angVel[2]);
+  dBodySetForce(this->linkId, _state.force[0], _state.force[1],
+      _state.force[2]);
+  dBodySetTorque(this->linkId, _state.torque[0], _state.torque[1],
+      _state.torque[2]);
+  if (_state.enabled && !dBodyIsEnabled(this->linkId))
+    dBodyEnable(this->linkId);
+  else if (!_state.enabled && dBodyIsEnabled(this->linkId))
+    dBodyDisable(this->linkId);
+
+  // After dBodyEnable, which resets the idle counters
+  dBodySetAutoDisableState(this->linkId, _state.idleTime, _state.idleSteps,
+      _state.averageCounter, _state.averageReady,
+      _state.averageLinVel.data(), _state.averageAngVel.data());
+
+  // Same as after a physics step, the world propagates the new pose to
+  // this link and its model.
+  MoveCallback(this->linkId);
+}
+
 //////////////////////////////////////////////////
 void ODELink::Fini()
 {
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODELINK_HH_
 #define GAZEBO_PHYSICS_ODE_ODELINK_HH_
 
+#include <vector>
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/ode/ode_inc.h"
@@ -179,6 +180,71 @@ namespace gazebo
       /// \param[in] _id Id of the body.
       public: static void MoveCallback(dBodyID _id);
 
+      /// \brief Append the dynamic state of the ODE body (pose, velocities,
+      /// force accumulators, enabled flag and auto disable progress) to a
+      /// checkpoint buffer.
+      /// \param[in,out] _data Checkpoint buffer.
+      public: void SaveCheckpoint(std::vector<uint8_t> &_data) const;
+
+      /// \brief Dynamic state of the ODE body, read from a checkpoint.
+      public: struct Checkpoint
+              {
+                /// \brief Body position.
+                dReal pos[3];
+
+                /// \brief Body orientation quaternion.
+                dReal rot[4];
+
+                /// \brief Linear velocity.
+                dReal linVel[3];
+
+                /// \brief Angular velocity.
+                dReal angVel[3];
+
+                /// \brief Force accumulator.
+                dReal force[3];
+
+                /// \brief Torque accumulator.
+                dReal torque[3];
+
+                /// \brief True if the body is enabled.
+                uint8_t enabled;
+
+                /// \brief Idle time left before auto disable.
+                dReal idleTime;
+
+                /// \brief Idle steps left before auto disable.
+                int32_t idleSteps;
+
+                /// \brief Next index in the velocity history.
+                uint32_t averageCounter;
+
+                /// \brief True once the velocity history is full.
+                int32_t averageReady;
+
+                /// \brief Linear velocity history used for auto disable,
+                /// 4 values per sample.
+                std::vector<dReal> averageLinVel;
+
+                /// \brief Angular velocity history used for auto disable,
+                /// 4 values per sample.
+                std::vector<dReal> averageAngVel;
+              };
+
+      /// \brief Read the state written by SaveCheckpoint, without changing
+      /// the link.
+      /// \param[in] _data Checkpoint buffer.
+      /// \param[in,out] _offset Read position, advanced past the link state.
+      /// \param[out] _state State of the link.
+      /// \return False if the buffer does not match this link.
+      public: bool ParseCheckpoint(const std::vector<uint8_t> &_data,
+                  size_t &_offset, Checkpoint &_state) const;
+
+      /// \brief Restore a state read by ParseCheckpoint, and queue the
+      /// link pose to be propagated back to Gazebo.
+      /// \param[in] _state State of the link.
+      public: void RestoreCheckpoint(const Checkpoint &_state);
+
       // Documentation inherited
       public: virtual void SetLinkStatic(bool _static);
 
@@ -14,6 +14,11 @@
  * limitations under the License.
  *
 */
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -25,6 +30,27 @@
 using namespace gazebo;
 using namespace physics;
 
+namespace
+{
+  /// \brief Compact sub-mesh buffers an ODE trimesh is built on, see
+  /// common::SubMesh::Compact.
+  struct SharedBuffers
+  {
+    /// \brief Vertex buffer of the sub-mesh.
+    std::shared_ptr<const std::vector<float>> vertices;
+
+    /// \brief Index buffer of the sub-mesh.
+    std::shared_ptr<const std::vector<int>> indices;
+  };
+
+  /// \brief Buffers referenced by each ODEMesh, kept out of ODEMesh to
+  /// preserve its layout. Only meshes that share buffers have an entry.
+  std::unordered_map<const ODEMesh *, SharedBuffers> g_sharedBuffers;
+
+  /// \brief Protects g_sharedBuffers.
+  std::mutex g_sharedBuffersMutex;
+}
+
 //////////////////////////////////////////////////
 ODEMesh::ODEMesh()
 {
@@ -39,6 +65,10 @@ ODEMesh::~ODEMesh()
   delete [] this->vertices;
   delete [] this->indices;
   dGeomTriMeshDataDestroy(this->odeData);
+
+  // The trimesh data is gone, the shared buffers can be released
+  std::lock_guard<std::mutex> lock(g_sharedBuffersMutex);
+  g_sharedBuffers.erase(this);
 }
 
 //////////////////////////////////////////////////
@@ -93,7 +123,8 @@ void ODEMesh::Init(const common::SubMesh *_subMesh, ODECollisionPtr _collision,
   this->indices = nullptr;
 
   // Get all the vertex and index data
-  _subMesh->FillArrays(&this->vertices, &this->indices);
+  if (!this->ShareBuffers(_subMesh, _scale))
+    _subMesh->FillArrays(&this->vertices, &this->indices);
 
   this->collisionId = _collision->GetCollisionId();
 
@@ -113,8 +144,13 @@ void ODEMesh::Init(const common::Mesh *_mesh, ODECollisionPtr _collision,
   this->vertices = nullptr;
   this->indices = nullptr;
 
-  // Get all the vertex and index data
-  _mesh->FillArrays(&this->vertices, &this->indices);
+  // Get all the vertex and index data. A mesh with a single sub-mesh has
+  // the same arrays as the sub-mesh.
+  if (_mesh->GetSubMeshCount() != 1u ||
+      !this->ShareBuffers(_mesh->GetSubMesh(0), _scale))
+  {
+    _mesh->FillArrays(&this->vertices, &this->indices);
+  }
 
   this->collisionId = _collision->GetCollisionId();
   this->CreateMesh(numVertices, numIndices, _collision, _scale);
@@ -128,18 +164,42 @@ void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
   if (this->odeData == nullptr)
     this->odeData = dGeomTriMeshDataCreate();
 
-  // Scale the vertex data
-  for (unsigned int j = 0;  j < _numVertices; j++)
+  const float *vertexData = this->vertices;
+  const int *indexData = this->indices;
+
+  std::shared_ptr<const std::vector<float>> vertexBuffer;
+  std::shared_ptr<const std::vector<int>> indexBuffer;
+  {
+    std::lock_guard<std::mutex> lock(g_sharedBuffersMutex);
+    auto iter = g_sharedBuffers.find(this);
+    if (iter != g_sharedBuffers.end())
+    {
+      vertexBuffer = iter->second.vertices;
+      indexBuffer = iter->second.indices;
+    }
+  }
+
+  if (vertexBuffer)
   {
-    this->vertices[j*3+0] = this->vertices[j*3+0] * _scale.X();
-    this->vertices[j*3+1] = this->vertices[j*3+1] * _scale.Y();
-    this->vertices[j*3+2] = this->vertices[j*3+2] * _scale.Z();
+    // Shared buffers are not scaled, ShareBuffers checked the scale is one
+    vertexData = vertexBuffer->data();
+    indexData = indexBuffer->data();
+  }
+  else
+  {
+    // Scale the vertex data
+    for (unsigned int j = 0;  j < _numVertices; j++)
+    {
+      this->vertices[j*3+0] = this->vertices[j*3+0] * _scale.X();
+      this->vertices[j*3+1] = this->vertices[j*3+1] * _scale.Y();
+      this->vertices[j*3+2] = this->vertices[j*3+2] * _scale.Z();
+    }
   }
 
   // Build the ODE triangle mesh
   dGeomTriMeshDataBuildSingle(this->odeData,
-      this->vertices, 3*sizeof(this->vertices[0]), _numVertices,
-      this->indices, _numIndices, 3*sizeof(this->indices[0]));
+      vertexData, 3*sizeof(vertexData[0]), _numVertices,
+      indexData, _numIndices, 3*sizeof(indexData[0]));
 
   if (_collision->GetCollisionId() == nullptr)
   {
@@ -155,3 +215,22 @@ void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
   memset(this->transform, 0, 32*sizeof(dReal));
   this->transformIndex = 0;
 }
+
+//////////////////////////////////////////////////
+bool ODEMesh::ShareBuffers(const common::SubMesh *_subMesh,
+    const ignition::math::Vector3d &_scale)
+{
+  std::lock_guard<std::mutex> lock(g_sharedBuffersMutex);
+  g_sharedBuffers.erase(this);
+
+  if (!_subMesh || !_subMesh->IsCompact() ||
+      _scale != ignition::math::Vector3d::One)
+  {
+    return false;
+  }
+
+  SharedBuffers &buffers = g_sharedBuffers[this];
+  buffers.vertices = _subMesh->VertexBuffer();
+  buffers.indices = _subMesh->IndexBuffer();
+  return true;
+}
@@ -68,6 +68,15 @@ namespace gazebo
                    unsigned int _numIndices, ODECollisionPtr _collision,
                    const ignition::math::Vector3d &_scale);
 
+      /// \brief Reference the compact buffers of a sub-mesh instead of
+      /// copying the vertices and indices, see common::SubMesh::Compact.
+      /// \param[in] _subMesh Pointer to the submesh.
+      /// \param[in] _scale Scaling factor.
+      /// \return True if the buffers are referenced. False if the
+      /// sub-mesh is not compact, or is scaled.
+      private: bool ShareBuffers(const common::SubMesh *_subMesh,
+                   const ignition::math::Vector3d &_scale);
+
       /// \brief Transform matrix.
       private: dReal transform[16*2];
 
@@ -14,6 +14,11 @@
  * limitations under the License.
  *
  */
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <algorithm>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
 
@@ -23,6 +28,7 @@
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODERayShape.hh"
+#include "gazebo/physics/ode/ODEMultiRayShapePrivate.hh"
 #include "gazebo/physics/ode/ODEMultiRayShape.hh"
 
 using namespace gazebo;
@@ -31,7 +37,8 @@ using namespace physics;
 
 //////////////////////////////////////////////////
 ODEMultiRayShape::ODEMultiRayShape(CollisionPtr _parent)
-: MultiRayShape(_parent)
+: MultiRayShape(_parent),
+  dataPtr(new ODEMultiRayShapePrivate)
 {
   this->SetName("ODE Multiray Shape");
 
@@ -48,7 +55,8 @@ ODEMultiRayShape::ODEMultiRayShape(CollisionPtr _parent)
 
 //////////////////////////////////////////////////
 ODEMultiRayShape::ODEMultiRayShape(PhysicsEnginePtr _physicsEngine)
-: MultiRayShape(_physicsEngine)
+: MultiRayShape(_physicsEngine),
+  dataPtr(new ODEMultiRayShapePrivate)
 {
   this->defaultUpdate = false;
 
@@ -76,6 +84,9 @@ ODEMultiRayShape::~ODEMultiRayShape()
   dSpaceSetCleanup(this->superSpaceId, 0);
   dSpaceDestroy(this->superSpaceId);
 
+  if (this->dataPtr->packetGeom)
+    dGeomDestroy(this->dataPtr->packetGeom);
+
   this->Fini();
 }
 
@@ -93,6 +104,14 @@ void ODEMultiRayShape::UpdateRays()
   {
     boost::recursive_mutex::scoped_lock lock(*ode->GetPhysicsUpdateMutex());
 
+    // Rays attached to a collision are queried in batches, stand alone
+    // rays keep going through the space collision callback.
+    if (this->defaultUpdate)
+    {
+      this->UpdateRaysBatched(ode);
+      return;
+    }
+
     // Do collision detection
     dSpaceCollide2((dGeomID) (this->superSpaceId),
         (dGeomID) (ode->GetSpaceId()),
@@ -100,6 +119,247 @@ void ODEMultiRayShape::UpdateRays()
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Check whether two bounding boxes in ODE layout overlap.
+/// \param[in] _a First bounding box.
+/// \param[in] _b Second bounding box.
+/// \return True if the boxes overlap.
+static bool aabbOverlap(const std::array<dReal, 6> &_a,
+    const std::array<dReal, 6> &_b)
+{
+  return _a[0] <= _b[1] && _a[1] >= _b[0] &&
+         _a[2] <= _b[3] && _a[3] >= _b[2] &&
+         _a[4] <= _b[5] && _a[5] >= _b[4];
+}
+
+//////////////////////////////////////////////////
+void ODEMultiRayShape::UpdateRaysBatched(ODEPhysicsPtr _ode)
+{
+  const size_t rayCount = this->rays.size();
+  this->dataPtr->rayGeoms.resize(rayCount);
+  this->dataPtr->rayBoxes.resize(rayCount);
+  this->dataPtr->depths.resize(rayCount);
+  this->dataPtr->hits.assign(rayCount, -1);
+  this->dataPtr->lastHitIds.resize(rayCount, 0);
+  this->dataPtr->hitIds.assign(rayCount, 0);
+
+  for (size_t i = 0; i < rayCount; ++i)
+  {
+    dGeomID rayId =
+      boost::static_pointer_cast<ODERayShape>(this->rays[i])->ODEGeomId();
+    dGeomRaySetParams(rayId, 0, 0);
+    dGeomRaySetClosestHit(rayId, 1);
+
+    dVector3 start, dir;
+    dGeomRayGet(rayId, start, dir);
+    dReal length = dGeomRayGetLength(rayId);
+
+    auto &box = this->dataPtr->rayBoxes[i];
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      dReal end = start[j] + dir[j] * length;
+      box[2*j] = std::min(start[j], end);
+      box[2*j+1] = std::max(start[j], end);
+    }
+
+    this->dataPtr->rayGeoms[i] = rayId;
+    this->dataPtr->depths[i] = this->rays[i]->GetLength();
+  }
+
+  const size_t packetCount =
+    (rayCount + ODEMultiRayShapePrivate::kPacketSize - 1) /
+    ODEMultiRayShapePrivate::kPacketSize;
+
+  // The broadphase updates the geoms' bounding boxes, so it runs serially.
+  // Only the collisions whose bounding box overlaps a packet are gathered,
+  // and the spaces of the links not overlapping it are skipped as a whole.
+  this->dataPtr->targets.clear();
+  this->dataPtr->targetIndex.clear();
+  this->dataPtr->packetTargets.resize(packetCount);
+  for (size_t p = 0; p < packetCount; ++p)
+    this->dataPtr->FindPacketTargets(p, _ode->GetSpaceId());
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, packetCount),
+      [&](const tbb::blocked_range<size_t> &_r)
+      {
+        // Trimesh collisions need collider caches for this thread
+        dAllocateODEDataForThread(dAllocateMaskAll);
+        for (size_t p = _r.begin(); p != _r.end(); ++p)
+          this->dataPtr->CollidePacket(p, true);
+      });
+
+  bool serialTargets = std::any_of(this->dataPtr->targets.begin(),
+      this->dataPtr->targets.end(),
+      [](const ODEMultiRayShapePrivate::Target &_target)
+      {
+        return !_target.threadSafe;
+      });
+  if (serialTargets)
+  {
+    for (size_t p = 0; p < packetCount; ++p)
+      this->dataPtr->CollidePacket(p, false);
+  }
+
+  // Store the closest hits in the ray shapes
+  for (size_t i = 0; i < rayCount; ++i)
+  {
+    int hit = this->dataPtr->hits[i];
+    if (hit < 0)
+      continue;
+
+    ODECollision *collision = this->dataPtr->targets[hit].collision;
+    RayShapePtr ray = this->rays[i];
+    ray->SetLength(this->dataPtr->depths[i]);
+    ray->SetRetro(collision->GetLaserRetro());
+
+    uint32_t id = collision->GetId();
+    this->dataPtr->hitIds[i] = id;
+    if (this->dataPtr->lastHitIds[i] != id)
+    {
+      ray->SetCollisionName(collision->GetScopedName());
+      this->dataPtr->lastHitIds[i] = id;
+    }
+  }
+  this->SetHitIds(this->dataPtr->hitIds);
+}
+
+//////////////////////////////////////////////////
+void ODEMultiRayShapePrivate::FindPacketTargets(const size_t _packet,
+    dSpaceID _spaceId)
+{
+  const size_t begin = _packet * kPacketSize;
+  const size_t end = std::min(begin + kPacketSize, this->rayGeoms.size());
+
+  // Bounding box of the whole packet
+  std::array<dReal, 6> packetBox = this->rayBoxes[begin];
+  for (size_t i = begin + 1; i < end; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      packetBox[2*j] = std::min(packetBox[2*j], this->rayBoxes[i][2*j]);
+      packetBox[2*j+1] =
+        std::max(packetBox[2*j+1], this->rayBoxes[i][2*j+1]);
+    }
+  }
+
+  // Query the broadphase with a box geom covering the packet, which has
+  // the collide bits of the rays
+  if (!this->packetGeom)
+  {
+    this->packetGeom = dCreateBox(0, 1, 1, 1);
+    dGeomSetCategoryBits(this->packetGeom, GZ_SENSOR_COLLIDE);
+    dGeomSetCollideBits(this->packetGeom, ~GZ_SENSOR_COLLIDE);
+  }
+  dGeomSetPosition(this->packetGeom,
+      (packetBox[0] + packetBox[1]) * 0.5,
+      (packetBox[2] + packetBox[3]) * 0.5,
+      (packetBox[4] + packetBox[5]) * 0.5);
+  dGeomBoxSetLengths(this->packetGeom,
+      packetBox[1] - packetBox[0],
+      packetBox[3] - packetBox[2],
+      packetBox[5] - packetBox[4]);
+
+  this->packetTargets[_packet].clear();
+  this->currentPacket = _packet;
+  dSpaceCollide2(this->packetGeom, reinterpret_cast<dGeomID>(_spaceId), this,
+      &ODEMultiRayShapePrivate::PacketCallback);
+}
+
+//////////////////////////////////////////////////
+void ODEMultiRayShapePrivate::PacketCallback(void *_data, dGeomID _o1,
+    dGeomID _o2)
+{
+  ODEMultiRayShapePrivate *self =
+    static_cast<ODEMultiRayShapePrivate *>(_data);
+  dGeomID geomId = _o1 == self->packetGeom ? _o2 : _o1;
+
+  // Descend into the spaces overlapping the packet
+  if (dGeomIsSpace(geomId))
+  {
+    dSpaceCollide2(self->packetGeom, geomId, self,
+        &ODEMultiRayShapePrivate::PacketCallback);
+    return;
+  }
+
+  self->AddPacketTarget(geomId);
+}
+
+//////////////////////////////////////////////////
+void ODEMultiRayShapePrivate::AddPacketTarget(dGeomID _geomId)
+{
+  auto iter = this->targetIndex.find(_geomId);
+  if (iter == this->targetIndex.end())
+  {
+    int geomClass = dGeomGetClass(_geomId);
+    ODECollision *collision = nullptr;
+    if (geomClass != dRayClass)
+    {
+      collision = static_cast<ODECollision*>(dGeomGetData(
+          geomClass == dGeomTransformClass ?
+          dGeomTransformGetGeom(_geomId) : _geomId));
+    }
+
+    // Geoms that cannot be hit are remembered, so they are only checked
+    // once per scan
+    int index = -1;
+    if (collision)
+    {
+      Target target;
+      target.geomId = _geomId;
+      target.collision = collision;
+
+      // The broadphase brought the geom pose and bounding box up to date,
+      // so the collision threads only read the geom.
+      dGeomGetAABB(_geomId, target.aabb.data());
+
+      // Heightfields and transforms use scratch data stored in the geom.
+      // Trimeshes use per thread collider caches.
+      target.threadSafe =
+        geomClass == dSphereClass || geomClass == dBoxClass ||
+        geomClass == dCapsuleClass || geomClass == dCylinderClass ||
+        geomClass == dPlaneClass || geomClass == dConvexClass ||
+        geomClass == dTriMeshClass;
+
+      index = static_cast<int>(this->targets.size());
+      this->targets.push_back(target);
+    }
+    iter = this->targetIndex.emplace(_geomId, index).first;
+  }
+
+  if (iter->second >= 0)
+    this->packetTargets[this->currentPacket].push_back(iter->second);
+}
+
+//////////////////////////////////////////////////
+void ODEMultiRayShapePrivate::CollidePacket(const size_t _packet,
+    const bool _threadSafe)
+{
+  const size_t begin = _packet * kPacketSize;
+  const size_t end = std::min(begin + kPacketSize, this->rayGeoms.size());
+
+  dContactGeom contact;
+  for (int t : this->packetTargets[_packet])
+  {
+    const Target &target = this->targets[t];
+    if (target.threadSafe != _threadSafe)
+      continue;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (!aabbOverlap(this->rayBoxes[i], target.aabb))
+        continue;
+
+      int n = dCollide(this->rayGeoms[i], target.geomId, 1, &contact,
+          sizeof(contact));
+      if (n > 0 && contact.depth < this->depths[i])
+      {
+        this->depths[i] = contact.depth;
+        this->hits[i] = t;
+      }
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
 {
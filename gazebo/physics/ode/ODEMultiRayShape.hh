@@ -17,6 +17,10 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_HH_
 
+#include <memory>
+
+#include "gazebo/physics/ode/ode_inc.h"
+#include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/physics/MultiRayShape.hh"
 #include "gazebo/util/system.hh"
 
@@ -24,6 +28,9 @@ namespace gazebo
 {
   namespace physics
   {
+    // Forward declare private data class
+    class ODEMultiRayShapePrivate;
+
     /// \addtogroup gazebo_physics_ode
     /// \{
 
@@ -44,6 +51,13 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void UpdateRays();
 
+      /// \brief Collide the rays with the world in packets of neighbouring
+      /// rays. The collisions overlapping each packet are found through the
+      /// broadphase of the world's space, and packets are split across
+      /// threads.
+      /// \param[in] _ode Pointer to the ODE physics engine.
+      private: void UpdateRaysBatched(ODEPhysicsPtr _ode);
+
       /// \brief Ray-intersection callback.
       /// \param[in] _data Pointer to user data.
       /// \param[in] _o1 First geom to check for collisions.
@@ -66,6 +80,10 @@ namespace gazebo
       /// \brief Helper to get the correct ray shape in the UpdateCallback
       /// function.
       private: bool defaultUpdate = true;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ODEMultiRayShapePrivate> dataPtr;
     };
     /// \}
   }
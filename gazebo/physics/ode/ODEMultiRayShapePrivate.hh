@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_PRIVATE_HH_
+#define GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_PRIVATE_HH_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "gazebo/physics/ode/ode_inc.h"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    class ODECollision;
+
+    /// \internal
+    /// \brief Private data class for ODEMultiRayShape. Holds the buffers
+    /// of the batched ray query, reused from one scan to the next.
+    class ODEMultiRayShapePrivate
+    {
+      /// \brief A collision in the world that rays can hit.
+      public: class Target
+      {
+        /// \brief ODE geom to collide the rays with.
+        public: dGeomID geomId;
+
+        /// \brief Axis aligned bounding box of the geom, in ODE layout
+        /// (min x, max x, min y, max y, min z, max z).
+        public: std::array<dReal, 6> aabb;
+
+        /// \brief Collision owning the geom.
+        public: ODECollision *collision;
+
+        /// \brief True if rays can be collided with the geom from several
+        /// threads at once.
+        public: bool threadSafe;
+      };
+
+      /// \brief Gather the targets whose bounding box overlaps a packet,
+      /// through the broadphase of the world's space.
+      /// \param[in] _packet Index of the packet.
+      /// \param[in] _spaceId Space of the world.
+      public: void FindPacketTargets(const size_t _packet,
+                  dSpaceID _spaceId);
+
+      /// \brief Broadphase callback of FindPacketTargets.
+      /// \param[in] _data Pointer to this object.
+      /// \param[in] _o1 First geom overlapping.
+      /// \param[in] _o2 Second geom overlapping.
+      public: static void PacketCallback(void *_data, dGeomID _o1,
+                  dGeomID _o2);
+
+      /// \brief Add a geom overlapping the current packet to its targets.
+      /// \param[in] _geomId Geom overlapping the packet.
+      public: void AddPacketTarget(dGeomID _geomId);
+
+      /// \brief Collide a packet of neighbouring rays with its targets.
+      /// \param[in] _packet Index of the packet.
+      /// \param[in] _threadSafe Only collide with targets whose threadSafe
+      /// flag has this value.
+      public: void CollidePacket(const size_t _packet, const bool _threadSafe);
+
+      /// \brief Number of neighbouring rays tested together against the
+      /// bounding box of each target.
+      public: static constexpr size_t kPacketSize = 64;
+
+      /// \brief Collisions the rays can hit, gathered for each scan.
+      public: std::vector<Target> targets;
+
+      /// \brief Index in targets of each gathered geom.
+      public: std::unordered_map<dGeomID, int> targetIndex;
+
+      /// \brief Indices in targets of the targets of each packet.
+      public: std::vector<std::vector<int>> packetTargets;
+
+      /// \brief Packet whose targets are being gathered.
+      public: size_t currentPacket = 0;
+
+      /// \brief Box geom, outside of any space, set to the bounding box of
+      /// a packet to query the broadphase.
+      public: dGeomID packetGeom = nullptr;
+
+      /// \brief ODE geom of each ray.
+      public: std::vector<dGeomID> rayGeoms;
+
+      /// \brief Bounding box of each ray, in ODE layout.
+      public: std::vector<std::array<dReal, 6>> rayBoxes;
+
+      /// \brief Distance to the closest hit of each ray.
+      public: std::vector<double> depths;
+
+      /// \brief Index of the target hit by each ray, -1 for no hit.
+      public: std::vector<int> hits;
+
+      /// \brief Id of the collision hit by each ray in the previous scan,
+      /// so that collision names are only updated when they change.
+      public: std::vector<uint32_t> lastHitIds;
+
+      /// \brief Id of the collision hit by each ray in this scan.
+      public: std::vector<uint32_t> hitIds;
+    };
+  }
+}
+#endif
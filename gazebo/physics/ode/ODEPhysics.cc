@@ -38,6 +38,7 @@
 
 #include "gazebo/transport/Publisher.hh"
 
+#include "gazebo/physics/CheckpointHelpers.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/PhysicsFactory.hh"
 #include "gazebo/physics/World.hh"
@@ -50,6 +51,7 @@
 
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODELink.hh"
+#include "gazebo/physics/ode/ODEJoint.hh"
 #include "gazebo/physics/ode/ODEScrewJoint.hh"
 #include "gazebo/physics/ode/ODEHingeJoint.hh"
 #include "gazebo/physics/ode/ODEGearboxJoint.hh"
@@ -485,6 +487,132 @@ void ODEPhysics::Reset()
   dJointGroupEmpty(this->dataPtr->contactGroup);
 }
 
+//////////////////////////////////////////////////
+/// \brief Collect the links and joints of a model and its nested models in
+/// a stable order, used to save and restore checkpoints.
+/// \param[in] _model Model to collect from.
+/// \param[out] _links Links of the model.
+/// \param[out] _joints Joints of the model.
+static void collectCheckpointEntities(const ModelPtr &_model,
+    std::vector<ODELinkPtr> &_links, std::vector<ODEJointPtr> &_joints)
+{
+  for (auto const &link : _model->GetLinks())
+  {
+    auto odeLink = boost::dynamic_pointer_cast<ODELink>(link);
+    if (odeLink)
+      _links.push_back(odeLink);
+  }
+
+  for (auto const &joint : _model->GetJoints())
+  {
+    auto odeJoint = boost::dynamic_pointer_cast<ODEJoint>(joint);
+    if (odeJoint)
+      _joints.push_back(odeJoint);
+  }
+
+  for (auto const &nested : _model->NestedModels())
+    collectCheckpointEntities(nested, _links, _joints);
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::SaveCheckpoint(std::vector<uint8_t> &_data) const
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  std::vector<ODELinkPtr> links;
+  std::vector<ODEJointPtr> joints;
+  for (auto const &model : this->world->Models())
+    collectCheckpointEntities(model, links, joints);
+
+  _data.clear();
+
+  // The random seed drives the constraint reordering in quick step.
+  WriteCheckpoint(_data, static_cast<uint64_t>(dRandGetSeed()));
+
+  WriteCheckpoint(_data, static_cast<uint32_t>(links.size()));
+  for (auto const &link : links)
+    link->SaveCheckpoint(_data);
+
+  WriteCheckpoint(_data, static_cast<uint32_t>(joints.size()));
+  for (auto const &joint : joints)
+    joint->SaveCheckpoint(_data);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::RestoreCheckpoint(const std::vector<uint8_t> &_data)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  std::vector<ODELinkPtr> links;
+  std::vector<ODEJointPtr> joints;
+  for (auto const &model : this->world->Models())
+    collectCheckpointEntities(model, links, joints);
+
+  // Read and check the whole buffer before changing anything, so a
+  // mismatched or truncated checkpoint leaves the world as it was.
+  size_t offset = 0;
+  uint64_t seed = 0;
+  uint32_t linkCount = 0;
+  if (!ReadCheckpoint(_data, offset, seed) ||
+      !ReadCheckpoint(_data, offset, linkCount) ||
+      linkCount != links.size())
+  {
+    gzerr << "Checkpoint does not match the links in the world\n";
+    return false;
+  }
+
+  std::vector<ODELink::Checkpoint> linkStates(links.size());
+  for (size_t i = 0; i < links.size(); ++i)
+  {
+    if (!links[i]->ParseCheckpoint(_data, offset, linkStates[i]))
+    {
+      gzerr << "Unable to restore link [" << links[i]->GetScopedName()
+            << "] from checkpoint\n";
+      return false;
+    }
+  }
+
+  uint32_t jointCount = 0;
+  if (!ReadCheckpoint(_data, offset, jointCount) ||
+      jointCount != joints.size())
+  {
+    gzerr << "Checkpoint does not match the joints in the world\n";
+    return false;
+  }
+
+  std::vector<ODEJoint::Checkpoint> jointStates(joints.size());
+  for (size_t i = 0; i < joints.size(); ++i)
+  {
+    if (!joints[i]->ParseCheckpoint(_data, offset, jointStates[i]))
+    {
+      gzerr << "Unable to restore joint [" << joints[i]->GetScopedName()
+            << "] from checkpoint\n";
+      return false;
+    }
+  }
+
+  if (offset != _data.size())
+  {
+    gzerr << "Checkpoint has unexpected trailing data\n";
+    return false;
+  }
+
+  for (size_t i = 0; i < links.size(); ++i)
+    links[i]->RestoreCheckpoint(linkStates[i]);
+
+  for (size_t i = 0; i < joints.size(); ++i)
+    joints[i]->RestoreCheckpoint(jointStates[i]);
+
+  dRandSetSeed(static_cast<unsigned long>(seed));
+
+  // Contact joints are recreated by the next collision update.
+  dJointGroupEmpty(this->dataPtr->contactGroup);
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 LinkPtr ODEPhysics::CreateLink(ModelPtr _parent)
 {
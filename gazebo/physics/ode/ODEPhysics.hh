@@ -21,6 +21,7 @@
 #include <tbb/concurrent_vector.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 
@@ -291,6 +292,18 @@ namespace gazebo
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
 
+      /// \brief Save the ODE state of all links and joints, see
+      /// PhysicsEngine::SaveCheckpoint.
+      /// \param[out] _data Buffer receiving the state.
+      /// \return True on success.
+      public: bool SaveCheckpoint(std::vector<uint8_t> &_data) const;
+
+      /// \brief Restore a state written by SaveCheckpoint, see
+      /// PhysicsEngine::RestoreCheckpoint.
+      /// \param[in] _data Buffer written by SaveCheckpoint.
+      /// \return False if the buffer does not match the world.
+      public: bool RestoreCheckpoint(const std::vector<uint8_t> &_data);
+
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
       protected: virtual void OnPhysicsMsg(ConstPhysicsPtr &_msg);
@@ -15,7 +15,9 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <memory>
 #include <sstream>
+#include <vector>
 
 #include "gazebo/common/Exception.hh"
 
@@ -109,16 +111,25 @@ void ContactSensor::Load(const std::string &_worldName)
 
   if (!this->dataPtr->collisions.empty())
   {
-    // request the contact manager to publish messages to a custom topic for
-    // this sensor
+    // request the contact manager to hand the contacts of our collisions
+    // directly to this sensor after each physics update. The contacts are
+    // only published on the filter topic if someone else subscribes to it.
+    std::weak_ptr<Sensor> self = this->weak_from_this();
     physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->dataPtr->filterName,
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
-    {
-      this->dataPtr->contactSub = this->node->Subscribe(topic,
-          &ContactSensor::OnContacts, this);
-    }
+    mgr->CreateFilter(this->dataPtr->filterName, this->dataPtr->collisions,
+        [self](const std::vector<physics::Contact *> &_contacts)
+        {
+          std::shared_ptr<ContactSensor> sensor =
+            std::static_pointer_cast<ContactSensor>(self.lock());
+          if (!sensor || !sensor->IsActive())
+            return;
+
+          boost::shared_ptr<msgs::Contacts> msg(new msgs::Contacts);
+          for (auto const contact : _contacts)
+            contact->FillMsg(*msg->add_contact());
+          msgs::Set(msg->mutable_time(), sensor->world->SimTime());
+          sensor->OnContacts(msg);
+        });
   }
 }
 
@@ -213,7 +224,6 @@ void ContactSensor::Fini()
     mgr->RemoveFilter(this->dataPtr->filterName);
   }
 
-  this->dataPtr->contactSub.reset();
   this->dataPtr->contactsPub.reset();
   Sensor::Fini();
 }
@@ -39,9 +39,6 @@ namespace gazebo
       /// \brief Output contact information.
       public: transport::PublisherPtr contactsPub;
 
-      /// \brief Subscription to contact messages from the physics engine
-      public: transport::SubscriberPtr contactSub;
-
       /// \brief Mutex to protect reads and writes.
       public: mutable std::mutex mutex;
 
@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <cmath>
+#include <limits>
+
+#include <boost/algorithm/string.hpp>
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/Image.hh"
+
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/MultiRayShape.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+
+#include "gazebo/transport/Node.hh"
+#include "gazebo/transport/Publisher.hh"
+
+#include "gazebo/sensors/SensorFactory.hh"
+#include "gazebo/sensors/CpuDepthCameraSensorPrivate.hh"
+#include "gazebo/sensors/CpuDepthCameraSensor.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+GZ_REGISTER_STATIC_SENSOR("cpu_depth", CpuDepthCameraSensor)
+
+//////////////////////////////////////////////////
+CpuDepthCameraSensor::CpuDepthCameraSensor()
+: Sensor(sensors::RAY),
+  dataPtr(new CpuDepthCameraSensorPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+CpuDepthCameraSensor::~CpuDepthCameraSensor()
+{
+}
+
+//////////////////////////////////////////////////
+std::string CpuDepthCameraSensor::Topic() const
+{
+  std::string topicName = "~/";
+  topicName += this->ParentName() + "/" + this->Name() + "/image";
+  boost::replace_all(topicName, "::", "/");
+
+  return topicName;
+}
+
+//////////////////////////////////////////////////
+std::string CpuDepthCameraSensor::PointCloudTopic() const
+{
+  std::string topicName = "~/";
+  topicName += this->ParentName() + "/" + this->Name() + "/points";
+  boost::replace_all(topicName, "::", "/");
+
+  return topicName;
+}
+
+//////////////////////////////////////////////////
+void CpuDepthCameraSensor::Load(const std::string &_worldName)
+{
+  Sensor::Load(_worldName);
+
+  sdf::ElementPtr cameraElem = this->sdf->GetElement("camera");
+  sdf::ElementPtr imageElem = cameraElem->GetElement("image");
+  sdf::ElementPtr clipElem = cameraElem->GetElement("clip");
+
+  this->dataPtr->hfov = cameraElem->Get<double>("horizontal_fov");
+  this->dataPtr->width = imageElem->Get<unsigned int>("width");
+  this->dataPtr->height = imageElem->Get<unsigned int>("height");
+  this->dataPtr->nearClip = clipElem->Get<double>("near");
+  this->dataPtr->farClip = clipElem->Get<double>("far");
+
+  if (this->dataPtr->width == 0 || this->dataPtr->height == 0 ||
+      this->dataPtr->hfov.Radian() <= 0 ||
+      this->dataPtr->hfov.Radian() >= IGN_PI ||
+      this->dataPtr->nearClip < 0 ||
+      this->dataPtr->nearClip >= this->dataPtr->farClip)
+  {
+    gzerr << "Invalid <camera> parameters for cpu depth camera sensor["
+          << this->Name() << "]\n";
+    return;
+  }
+
+  this->dataPtr->imagePub =
+    this->node->Advertise<msgs::ImageStamped>(this->Topic(), 50);
+  this->dataPtr->pointCloudPub =
+    this->node->Advertise<msgs::PointCloud>(this->PointCloudTopic(), 50);
+
+  GZ_ASSERT(this->world != nullptr,
+      "CpuDepthCameraSensor did not get a valid World pointer");
+
+  physics::PhysicsEnginePtr physicsEngine = this->world->Physics();
+
+  GZ_ASSERT(physicsEngine != nullptr,
+      "Unable to get a pointer to the physics engine");
+
+  this->dataPtr->rayCollision = physicsEngine->CreateCollision("multiray",
+      this->ParentName());
+
+  GZ_ASSERT(this->dataPtr->rayCollision != nullptr,
+      "Unable to create a multiray collision using the physics engine.");
+
+  this->dataPtr->rayCollision->SetName("cpu_depth_camera_collision");
+  this->dataPtr->rayCollision->SetRelativePose(this->pose);
+  this->dataPtr->rayCollision->SetInitialRelativePose(this->pose);
+
+  this->dataPtr->rayShape =
+    boost::dynamic_pointer_cast<physics::MultiRayShape>(
+        this->dataPtr->rayCollision->GetShape());
+
+  GZ_ASSERT(this->dataPtr->rayShape != nullptr,
+      "Unable to get the multiray shape from the multi-ray collision.");
+
+  const unsigned int width = this->dataPtr->width;
+  const unsigned int height = this->dataPtr->height;
+  const double hfov = this->dataPtr->hfov.Radian();
+  const double vfov = 2.0 * atan(tan(hfov / 2.0) * height / width);
+
+  // Create one ray per pixel with a scan that covers the image, and the
+  // range of the clip planes.
+  sdf::ElementPtr shapeSdf = this->sdf->Clone();
+  sdf::ElementPtr scanElem = shapeSdf->GetElement("ray")->GetElement("scan");
+  sdf::ElementPtr horzElem = scanElem->GetElement("horizontal");
+  horzElem->GetElement("samples")->Set(width);
+  horzElem->GetElement("resolution")->Set(1.0);
+  horzElem->GetElement("min_angle")->Set(-hfov / 2.0);
+  horzElem->GetElement("max_angle")->Set(hfov / 2.0);
+  sdf::ElementPtr vertElem = scanElem->GetElement("vertical");
+  vertElem->GetElement("samples")->Set(height);
+  vertElem->GetElement("resolution")->Set(1.0);
+  vertElem->GetElement("min_angle")->Set(-vfov / 2.0);
+  vertElem->GetElement("max_angle")->Set(vfov / 2.0);
+  sdf::ElementPtr rangeElem = shapeSdf->GetElement("ray")->GetElement("range");
+  rangeElem->GetElement("min")->Set(this->dataPtr->nearClip);
+  rangeElem->GetElement("max")->Set(this->dataPtr->farClip);
+
+  this->dataPtr->rayShape->Load(shapeSdf);
+  this->dataPtr->rayShape->Init();
+
+  GZ_ASSERT(this->dataPtr->rayShape->RayCount() == width * height,
+      "Unexpected number of rays in the cpu depth camera");
+
+  // The scan spaces the rays evenly in angle. Aim each ray through the
+  // center of its pixel instead, following a pinhole model.
+  const double focal = (width / 2.0) / tan(hfov / 2.0);
+  const double cx = (width - 1) / 2.0;
+  const double cy = (height - 1) / 2.0;
+  this->dataPtr->directions.resize(width * height);
+  for (unsigned int r = 0; r < height; ++r)
+  {
+    for (unsigned int c = 0; c < width; ++c)
+    {
+      ignition::math::Vector3d dir(focal, cx - c, cy - r);
+      dir.Normalize();
+
+      unsigned int index = r * width + c;
+      this->dataPtr->directions[index] = dir;
+
+      ignition::math::Vector3d axis = this->pose.Rot() * dir;
+      this->dataPtr->rayShape->SetRay(index,
+          this->pose.Pos() + axis * this->dataPtr->nearClip,
+          this->pose.Pos() + axis * this->dataPtr->farClip);
+    }
+  }
+
+  this->dataPtr->depths.assign(width * height,
+      std::numeric_limits<float>::infinity());
+  this->dataPtr->points.assign(width * height, ignition::math::Vector3d(
+      ignition::math::NAN_D, ignition::math::NAN_D, ignition::math::NAN_D));
+
+  msgs::Image *image = this->dataPtr->imageMsg.mutable_image();
+  image->set_width(width);
+  image->set_height(height);
+  image->set_pixel_format(common::Image::R_FLOAT32);
+  image->set_step(width * sizeof(float));
+
+  this->dataPtr->parentEntity = this->world->EntityByName(this->ParentName());
+
+  GZ_ASSERT(this->dataPtr->parentEntity != nullptr,
+      "Unable to get the parent entity.");
+}
+
+//////////////////////////////////////////////////
+void CpuDepthCameraSensor::Init()
+{
+  Sensor::Init();
+}
+
+//////////////////////////////////////////////////
+void CpuDepthCameraSensor::Fini()
+{
+  this->dataPtr->imagePub.reset();
+  this->dataPtr->pointCloudPub.reset();
+
+  if (this->dataPtr->rayCollision)
+  {
+    this->dataPtr->rayCollision->Fini();
+    this->dataPtr->rayCollision.reset();
+  }
+  this->dataPtr->rayShape.reset();
+  this->dataPtr->parentEntity.reset();
+
+  Sensor::Fini();
+}
+
+//////////////////////////////////////////////////
+unsigned int CpuDepthCameraSensor::ImageWidth() const
+{
+  return this->dataPtr->width;
+}
+
+//////////////////////////////////////////////////
+unsigned int CpuDepthCameraSensor::ImageHeight() const
+{
+  return this->dataPtr->height;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Angle CpuDepthCameraSensor::HFOV() const
+{
+  return this->dataPtr->hfov;
+}
+
+//////////////////////////////////////////////////
+double CpuDepthCameraSensor::NearClip() const
+{
+  return this->dataPtr->nearClip;
+}
+
+//////////////////////////////////////////////////
+double CpuDepthCameraSensor::FarClip() const
+{
+  return this->dataPtr->farClip;
+}
+
+//////////////////////////////////////////////////
+void CpuDepthCameraSensor::DepthData(std::vector<float> &_depths) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  _depths = this->dataPtr->depths;
+}
+
+//////////////////////////////////////////////////
+void CpuDepthCameraSensor::PointCloud(msgs::PointCloud &_cloud) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  _cloud.clear_points();
+  for (auto const &point : this->dataPtr->points)
+  {
+    if (!std::isnan(point.X()))
+      msgs::Set(_cloud.add_points(), point);
+  }
+}
+
+//////////////////////////////////////////////////
+bool CpuDepthCameraSensor::IsActive() const
+{
+  return Sensor::IsActive() ||
+    (this->dataPtr->imagePub && this->dataPtr->imagePub->HasConnections()) ||
+    (this->dataPtr->pointCloudPub &&
+     this->dataPtr->pointCloudPub->HasConnections());
+}
+
+//////////////////////////////////////////////////
+bool CpuDepthCameraSensor::UpdateImpl(const bool /*_force*/)
+{
+  if (!this->dataPtr->rayShape)
+    return false;
+
+  // Cast all the rays, in parallel
+  this->dataPtr->rayShape->Update();
+  this->lastMeasurementTime = this->world->SimTime();
+
+  const std::vector<double> &ranges = this->dataPtr->rayShape->Ranges();
+  const unsigned int width = this->dataPtr->width;
+  const double farClip = this->dataPtr->farClip;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Convert ranges along the rays to depths and points, row by row
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, this->dataPtr->height),
+      [&](const tbb::blocked_range<unsigned int> &_rows)
+      {
+        for (unsigned int r = _rows.begin(); r != _rows.end(); ++r)
+        {
+          for (unsigned int i = r * width; i < (r + 1) * width; ++i)
+          {
+            double range = ranges[i];
+            if (range >= farClip)
+            {
+              this->dataPtr->depths[i] =
+                std::numeric_limits<float>::infinity();
+              this->dataPtr->points[i].Set(ignition::math::NAN_D,
+                  ignition::math::NAN_D, ignition::math::NAN_D);
+            }
+            else
+            {
+              this->dataPtr->points[i] =
+                this->dataPtr->directions[i] * range;
+              this->dataPtr->depths[i] =
+                static_cast<float>(this->dataPtr->points[i].X());
+            }
+          }
+        }
+      });
+
+  if (this->dataPtr->imagePub && this->dataPtr->imagePub->HasConnections())
+  {
+    msgs::Set(this->dataPtr->imageMsg.mutable_time(),
+        this->lastMeasurementTime);
+    this->dataPtr->imageMsg.mutable_image()->set_data(
+        this->dataPtr->depths.data(),
+        this->dataPtr->depths.size() * sizeof(float));
+    this->dataPtr->imagePub->Publish(this->dataPtr->imageMsg);
+  }
+
+  if (this->dataPtr->pointCloudPub &&
+      this->dataPtr->pointCloudPub->HasConnections())
+  {
+    msgs::PointCloud &cloud = this->dataPtr->pointCloudMsg;
+    cloud.clear_points();
+    for (auto const &point : this->dataPtr->points)
+    {
+      if (!std::isnan(point.X()))
+        msgs::Set(cloud.add_points(), point);
+    }
+    this->dataPtr->pointCloudPub->Publish(cloud);
+  }
+
+  return true;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_CPUDEPTHCAMERASENSOR_HH_
+#define GAZEBO_SENSORS_CPUDEPTHCAMERASENSOR_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Angle.hh>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/sensors/Sensor.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declare private data class.
+    class CpuDepthCameraSensorPrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class CpuDepthCameraSensor CpuDepthCameraSensor.hh sensors/sensors.hh
+    /// \brief Depth camera computed by ray casting against the physics
+    /// collisions, without a rendering engine.
+    ///
+    /// The sensor reads the <camera> element of its SDF (horizontal field
+    /// of view, image size and clip planes) and casts one ray per pixel
+    /// through a pinhole model. It publishes a depth image in the R_FLOAT32
+    /// format used by DepthCameraSensor, and a point cloud in the camera
+    /// frame (x forward, y left, z up). Depths beyond the far clip are
+    /// +inf. Since it does not need OGRE or a GL context, it runs on
+    /// headless machines without a GPU.
+    class GZ_SENSORS_VISIBLE CpuDepthCameraSensor : public Sensor
+    {
+      /// \brief Constructor
+      public: CpuDepthCameraSensor();
+
+      /// \brief Destructor
+      public: virtual ~CpuDepthCameraSensor();
+
+      // Documentation inherited
+      public: virtual void Load(const std::string &_worldName);
+
+      // Documentation inherited
+      public: virtual void Init();
+
+      /// \brief Get the topic of the depth images.
+      /// \return Depth image topic name.
+      public: virtual std::string Topic() const;
+
+      /// \brief Get the topic of the point clouds.
+      /// \return Point cloud topic name.
+      public: std::string PointCloudTopic() const;
+
+      /// \brief Get the image width.
+      /// \return Width in pixels.
+      public: unsigned int ImageWidth() const;
+
+      /// \brief Get the image height.
+      /// \return Height in pixels.
+      public: unsigned int ImageHeight() const;
+
+      /// \brief Get the horizontal field of view.
+      /// \return Horizontal field of view.
+      public: ignition::math::Angle HFOV() const;
+
+      /// \brief Get the near clip distance.
+      /// \return Near clip distance, in meters.
+      public: double NearClip() const;
+
+      /// \brief Get the far clip distance. Rays are cast up to this
+      /// distance from the camera.
+      /// \return Far clip distance, in meters.
+      public: double FarClip() const;
+
+      /// \brief Get the depth image of the last update, row by row from
+      /// the top left pixel.
+      /// \param[out] _depths Depth of each pixel along the optical axis,
+      /// +inf where nothing was hit.
+      public: void DepthData(std::vector<float> &_depths) const;
+
+      /// \brief Get the point cloud of the last update, one point per pixel
+      /// that hit a collision, in the camera frame.
+      /// \param[out] _cloud Point cloud.
+      public: void PointCloud(msgs::PointCloud &_cloud) const;
+
+      // Documentation inherited
+      public: virtual bool IsActive() const;
+
+      // Documentation inherited
+      protected: virtual bool UpdateImpl(const bool _force);
+
+      // Documentation inherited
+      protected: virtual void Fini();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<CpuDepthCameraSensorPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_CPUDEPTHCAMERASENSOR_PRIVATE_HH_
+#define GAZEBO_SENSORS_CPUDEPTHCAMERASENSOR_PRIVATE_HH_
+
+#include <mutex>
+#include <vector>
+
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/transport/TransportTypes.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Cpu depth camera sensor private data.
+    class CpuDepthCameraSensorPrivate
+    {
+      /// \brief Collision that holds the rays.
+      public: physics::CollisionPtr rayCollision;
+
+      /// \brief One ray per pixel.
+      public: physics::MultiRayShapePtr rayShape;
+
+      /// \brief Parent entity pointer.
+      public: physics::EntityPtr parentEntity;
+
+      /// \brief Publisher of the depth images.
+      public: transport::PublisherPtr imagePub;
+
+      /// \brief Publisher of the point clouds.
+      public: transport::PublisherPtr pointCloudPub;
+
+      /// \brief Image width in pixels.
+      public: unsigned int width = 0;
+
+      /// \brief Image height in pixels.
+      public: unsigned int height = 0;
+
+      /// \brief Horizontal field of view.
+      public: ignition::math::Angle hfov;
+
+      /// \brief Near clip distance.
+      public: double nearClip = 0;
+
+      /// \brief Far clip distance.
+      public: double farClip = 0;
+
+      /// \brief Unit direction of the ray of each pixel, in the camera
+      /// frame.
+      public: std::vector<ignition::math::Vector3d> directions;
+
+      /// \brief Mutex to protect the results of the last update.
+      public: mutable std::mutex mutex;
+
+      /// \brief Depth of each pixel in the last update.
+      public: std::vector<float> depths;
+
+      /// \brief Point of each pixel in the last update, in the camera frame.
+      /// NaN where nothing was hit.
+      public: std::vector<ignition::math::Vector3d> points;
+
+      /// \brief Depth image message.
+      public: msgs::ImageStamped imageMsg;
+
+      /// \brief Point cloud message.
+      public: msgs::PointCloud pointCloudMsg;
+    };
+  }
+}
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <sdf/sdf.hh>
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class CpuDepthCameraSensor_TEST : public ServerFixture
+{
+};
+
+static std::string cpuDepthSensorString =
+"<sdf version='1.6'>"
+"  <sensor name='depth' type='cpu_depth'>"
+"    <always_on>1</always_on>"
+"    <update_rate>10</update_rate>"
+"    <pose>0 0 0.5 0 0 0</pose>"
+"    <camera>"
+"      <horizontal_fov>1.047</horizontal_fov>"
+"      <image>"
+"        <width>65</width>"
+"        <height>49</height>"
+"      </image>"
+"      <clip>"
+"        <near>0.1</near>"
+"        <far>10</far>"
+"      </clip>"
+"    </camera>"
+"  </sensor>"
+"</sdf>";
+
+/////////////////////////////////////////////////
+/// \brief Test the depth image and point cloud of a box in front of the
+/// camera.
+TEST_F(CpuDepthCameraSensor_TEST, UnitBox)
+{
+  Load("worlds/empty.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  // Box whose front face is 1.5 m in front of the camera
+  SpawnBox("box", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(2, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+
+  sdf::ElementPtr sdf(new sdf::Element);
+  sdf::initFile("sensor.sdf", sdf);
+  sdf::readString(cpuDepthSensorString, sdf);
+
+  std::string sensorName = mgr->CreateSensor(sdf, "default",
+      "ground_plane::link", 0);
+  EXPECT_EQ(sensorName, std::string("default::ground_plane::link::depth"));
+  mgr->Update();
+
+  sensors::CpuDepthCameraSensorPtr sensor =
+    std::dynamic_pointer_cast<sensors::CpuDepthCameraSensor>(
+        mgr->GetSensor(sensorName));
+  ASSERT_TRUE(sensor != nullptr);
+
+  EXPECT_EQ(sensor->ImageWidth(), 65u);
+  EXPECT_EQ(sensor->ImageHeight(), 49u);
+  EXPECT_NEAR(sensor->HFOV().Radian(), 1.047, 1e-6);
+  EXPECT_DOUBLE_EQ(sensor->NearClip(), 0.1);
+  EXPECT_DOUBLE_EQ(sensor->FarClip(), 10.0);
+  EXPECT_EQ(sensor->Topic(), "~/ground_plane/link/depth/image");
+  EXPECT_EQ(sensor->PointCloudTopic(), "~/ground_plane/link/depth/points");
+
+  sensor->Update(true);
+
+  std::vector<float> depths;
+  sensor->DepthData(depths);
+  ASSERT_EQ(depths.size(), 65u * 49u);
+
+  // The center pixel looks straight at the front face of the box
+  unsigned int center = 24 * 65 + 32;
+  EXPECT_NEAR(depths[center], 1.5, 1e-3);
+
+  // Depth is measured along the optical axis, so the whole face of the box
+  // has the same depth
+  EXPECT_NEAR(depths[center - 5], 1.5, 1e-3);
+  EXPECT_NEAR(depths[center + 5 * 65], 1.5, 1e-3);
+
+  // The top corners look above the box, at the empty sky
+  EXPECT_TRUE(std::isinf(depths[0]));
+  EXPECT_TRUE(std::isinf(depths[64]));
+
+  // One point per pixel that hit something
+  unsigned int hits = 0;
+  for (auto const depth : depths)
+    hits += std::isinf(depth) ? 0 : 1;
+
+  msgs::PointCloud cloud;
+  sensor->PointCloud(cloud);
+  EXPECT_EQ(static_cast<unsigned int>(cloud.points_size()), hits);
+
+  bool found = false;
+  for (int i = 0; i < cloud.points_size(); ++i)
+  {
+    ignition::math::Vector3d point = msgs::ConvertIgn(cloud.points(i));
+    if (point.Distance(ignition::math::Vector3d(1.5, 0, 0)) < 1e-3)
+      found = true;
+  }
+  EXPECT_TRUE(found);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -40,6 +40,7 @@ ForceTorqueSensor::ForceTorqueSensor()
 : Sensor(sensors::OTHER),
   dataPtr(new ForceTorqueSensorPrivate)
 {
+  this->SetSupportsUpdateInStep(true);
 }
 
 //////////////////////////////////////////////////
@@ -14,6 +14,13 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 
@@ -79,6 +86,201 @@ namespace gazebo
 using namespace gazebo;
 using namespace sensors;
 
+namespace
+{
+  /// \brief Golden ratio increment used to spread stream indices.
+  constexpr uint64_t kGoldenGamma = 0x9E3779B97F4A7C15ULL;
+
+  /// \brief splitmix64 finalizer.
+  /// \param[in] _x Value to mix.
+  /// \return Mixed value.
+  inline uint64_t Mix64(uint64_t _x)
+  {
+    _x = (_x ^ (_x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    _x = (_x ^ (_x >> 27)) * 0x94D049BB133111EBULL;
+    return _x ^ (_x >> 31);
+  }
+
+  /// \brief Uniform value in (0, 1] at an index of a counter based stream.
+  /// \param[in] _seed Stream seed.
+  /// \param[in] _index Index in the stream.
+  /// \return Uniform value.
+  inline double StreamUniform(const uint64_t _seed, const uint64_t _index)
+  {
+    return static_cast<double>((Mix64(_seed + _index * kGoldenGamma) >> 11)
+        + 1) * (1.0 / 9007199254740992.0);
+  }
+
+  /// \brief Standard normal value at an index of a counter based stream.
+  /// Values come in Box-Muller pairs: the even index of a pair takes the
+  /// cosine term and the odd index the sine term.
+  /// \param[in] _seed Stream seed.
+  /// \param[in] _index Index in the stream.
+  /// \return Normal value.
+  inline double StreamNormal(const uint64_t _seed, const uint64_t _index)
+  {
+    const uint64_t first = _index & ~static_cast<uint64_t>(1);
+    const double r = std::sqrt(-2.0 * std::log(StreamUniform(_seed, first)));
+    const double theta = 2.0 * IGN_PI * StreamUniform(_seed, first + 1);
+    return (_index & 1) ? r * std::sin(theta) : r * std::cos(theta);
+  }
+
+  /// \brief Fill a buffer with consecutive standard normal values of a
+  /// counter based stream. The output matches StreamNormal for each index,
+  /// but each Box-Muller pair is evaluated only once.
+  /// \param[in] _seed Stream seed.
+  /// \param[in] _first Index of the first value.
+  /// \param[out] _out Output buffer.
+  /// \param[in] _count Number of values to generate.
+  void FillStreamNormals(const uint64_t _seed, const uint64_t _first,
+      double *_out, const size_t _count)
+  {
+    size_t i = 0;
+    uint64_t index = _first;
+    if ((index & 1) && _count > 0)
+      _out[i++] = StreamNormal(_seed, index++);
+
+    for (; i + 1 < _count; i += 2, index += 2)
+    {
+      const double r = std::sqrt(-2.0 * std::log(StreamUniform(_seed, index)));
+      const double theta = 2.0 * IGN_PI * StreamUniform(_seed, index + 1);
+      _out[i] = r * std::cos(theta);
+      _out[i + 1] = r * std::sin(theta);
+    }
+
+    if (i < _count)
+      _out[i] = StreamNormal(_seed, index);
+  }
+
+  /// \brief Random number stream and cached dynamic bias coefficients of a
+  /// Gaussian noise model. Kept outside of GaussianNoiseModel so that its
+  /// layout does not change.
+  struct NoiseStream
+  {
+    /// \brief Seed of the counter based random number stream.
+    uint64_t seed = 0;
+
+    /// \brief Index of the next value in the random number stream.
+    uint64_t counter = 0;
+
+    /// \brief Buffer of normal samples reused by batch calls.
+    std::vector<double> normals;
+
+    /// \brief Time step the dynamic bias coefficients were computed for.
+    double cachedDt = -1.0;
+
+    /// \brief Dynamic bias standard deviation the coefficients were
+    /// computed for.
+    double cachedBiasStdDev = -1.0;
+
+    /// \brief Dynamic bias correlation time the coefficients were
+    /// computed for.
+    double cachedBiasCorrTime = -1.0;
+
+    /// \brief Cached dynamic bias decay factor, exp(-dt / tau).
+    double phiD = 0.0;
+
+    /// \brief Cached standard deviation of the discrete dynamic bias
+    /// driving noise.
+    double sigmaBD = 0.0;
+
+    /// \brief Draw the next standard normal value from the stream.
+    /// \return Normally distributed value with zero mean and unit
+    /// standard deviation.
+    double NextNormal()
+    {
+      return StreamNormal(this->seed, this->counter++);
+    }
+
+    /// \brief Update the cached dynamic bias coefficients if the time step
+    /// or the dynamic bias parameters changed.
+    /// \param[in] _dt Time step.
+    /// \param[in] _sigmaB Dynamic bias standard deviation.
+    /// \param[in] _tau Dynamic bias correlation time.
+    void UpdateBiasCoefficients(const double _dt, const double _sigmaB,
+        const double _tau)
+    {
+      if (ignition::math::equal(_dt, this->cachedDt, 0.0) &&
+          ignition::math::equal(_sigmaB, this->cachedBiasStdDev, 0.0) &&
+          ignition::math::equal(_tau, this->cachedBiasCorrTime, 0.0))
+      {
+        return;
+      }
+
+      this->sigmaBD = sqrt(-_sigmaB * _sigmaB * _tau / 2 *
+          expm1(-2 * _dt / _tau));
+      this->phiD = exp(-_dt / _tau);
+
+      this->cachedDt = _dt;
+      this->cachedBiasStdDev = _sigmaB;
+      this->cachedBiasCorrTime = _tau;
+    }
+  };
+
+  /// \brief Streams of all Gaussian noise models.
+  std::unordered_map<const GaussianNoiseModel *,
+      std::unique_ptr<NoiseStream>> g_streams;
+
+  /// \brief Mutex that protects g_streams.
+  std::mutex g_streamsMutex;
+
+  /// \brief Get the stream of a noise model, creating it if needed.
+  /// \param[in] _model Noise model.
+  /// \return The stream, valid until the model is destroyed.
+  NoiseStream &StreamOf(const GaussianNoiseModel *_model)
+  {
+    std::lock_guard<std::mutex> lock(g_streamsMutex);
+    auto &stream = g_streams[_model];
+    if (!stream)
+      stream.reset(new NoiseStream);
+    return *stream;
+  }
+
+  /// \brief 64 bit FNV-1a hash of a string.
+  /// \param[in] _str String to hash.
+  /// \return Hash value.
+  uint64_t HashString(const std::string &_str)
+  {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (const char c : _str)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 0x100000001B3ULL;
+    }
+    return hash;
+  }
+
+  /// \brief Derive a stream seed from the ignition::math::Rand seed, so
+  /// that runs seeded through it stay reproducible, and from a key.
+  /// \param[in] _key Key that identifies the noise model.
+  /// \return Stream seed.
+  uint64_t StreamSeed(const std::string &_key)
+  {
+    return Mix64(
+        (static_cast<uint64_t>(ignition::math::Rand::Seed()) << 32) ^
+        HashString(_key));
+  }
+
+  /// \brief Get the names of an element and the elements enclosing it,
+  /// e.g. "sdf/world[default]/model[robot]/link[base]/sensor[imu]/...".
+  /// This identifies a noise element the same way in every run,
+  /// regardless of the order in which sensors are created.
+  /// \param[in] _elem SDF element.
+  /// \return Element path.
+  std::string ElementPath(sdf::ElementPtr _elem)
+  {
+    std::string path;
+    for (sdf::ElementPtr elem = _elem; elem; elem = elem->GetParent())
+    {
+      std::string part = elem->GetName();
+      if (elem->HasAttribute("name"))
+        part += "[" + elem->GetAttribute("name")->GetAsString() + "]";
+      path = path.empty() ? part : part + "/" + path;
+    }
+    return path;
+  }
+}
+
 //////////////////////////////////////////////////
 GaussianNoiseModel::GaussianNoiseModel()
   : Noise(Noise::GAUSSIAN),
@@ -92,11 +294,14 @@ GaussianNoiseModel::GaussianNoiseModel()
     dynamicBiasStdDev(0),
     dynamicBiasCorrTime(0)
 {
+  StreamOf(this).seed = StreamSeed(std::string());
 }
 
 //////////////////////////////////////////////////
 GaussianNoiseModel::~GaussianNoiseModel()
 {
+  std::lock_guard<std::mutex> lock(g_streamsMutex);
+  g_streams.erase(this);
 }
 
 //////////////////////////////////////////////////
@@ -104,6 +309,8 @@ void GaussianNoiseModel::Load(sdf::ElementPtr _sdf)
 {
   Noise::Load(_sdf);
 
+  this->SetSeed(StreamSeed(ElementPath(_sdf)));
+
   this->mean = _sdf->Get<double>("mean");
   this->stdDev = _sdf->Get<double>("stddev");
   if (_sdf->HasElement("bias_mean"))
@@ -147,8 +354,10 @@ void GaussianNoiseModel::Fini()
 //////////////////////////////////////////////////
 double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
 {
+  NoiseStream &stream = StreamOf(this);
+
   // Add independent (uncorrelated) Gaussian noise to each input value.
-  double whiteNoise = ignition::math::Rand::DblNormal(this->mean, this->stdDev);
+  double whiteNoise = this->mean + this->stdDev * stream.NextNormal();
 
   // Generate varying (correlated) bias for each input value.
   // This implementation is based on the one available in Rotors:
@@ -161,15 +370,10 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
   if (this->dynamicBiasStdDev > 0 &&
       this->dynamicBiasCorrTime > 0)
   {
-    const double sigmaB = this->dynamicBiasStdDev;
-    const double tau = this->dynamicBiasCorrTime;
-
-    const double sigmaBD = sqrt(-sigmaB * sigmaB *
-        tau / 2 * expm1(-2 * _dt / tau));
-
-    const double phiD = exp(-_dt / tau);
-    this->bias = phiD * this->bias +
-      ignition::math::Rand::DblNormal(0, sigmaBD);
+    stream.UpdateBiasCoefficients(_dt, this->dynamicBiasStdDev,
+        this->dynamicBiasCorrTime);
+    this->bias = stream.phiD * this->bias +
+        stream.sigmaBD * stream.NextNormal();
   }
 
   double output = _in + this->bias + whiteNoise;
@@ -184,6 +388,74 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
   return output;
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatch(double *_data, const size_t _count,
+    const double _dt)
+{
+  if (_count == 0)
+    return;
+
+  NoiseStream &stream = StreamOf(this);
+
+  // Each sample draws its white noise value first, followed by its dynamic
+  // bias value, in the same stream order as ApplyImpl.
+  const bool dynamicBias = this->dynamicBiasStdDev > 0 &&
+      this->dynamicBiasCorrTime > 0;
+  const size_t draws = dynamicBias ? 2 * _count : _count;
+
+  if (stream.normals.size() < draws)
+    stream.normals.resize(draws);
+  double *n = stream.normals.data();
+  FillStreamNormals(stream.seed, stream.counter, n, draws);
+  stream.counter += draws;
+
+  const double m = this->mean;
+  const double s = this->stdDev;
+  if (dynamicBias)
+  {
+    stream.UpdateBiasCoefficients(_dt, this->dynamicBiasStdDev,
+        this->dynamicBiasCorrTime);
+    const double phi = stream.phiD;
+    const double sigma = stream.sigmaBD;
+    double b = this->bias;
+    for (size_t i = 0; i < _count; ++i)
+    {
+      const double whiteNoise = m + s * n[2 * i];
+      b = phi * b + sigma * n[2 * i + 1];
+      _data[i] = _data[i] + b + whiteNoise;
+    }
+    this->bias = b;
+  }
+  else
+  {
+    const double b = this->bias;
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = _data[i] + b + (m + s * n[i]);
+  }
+
+  if (this->quantized &&
+      !ignition::math::equal(this->precision, 0.0, 1e-6))
+  {
+    const double p = this->precision;
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = std::round(_data[i] / p) * p;
+  }
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::SetSeed(const uint64_t _seed)
+{
+  NoiseStream &stream = StreamOf(this);
+  stream.seed = _seed;
+  stream.counter = 0;
+}
+
+//////////////////////////////////////////////////
+uint64_t GaussianNoiseModel::Seed() const
+{
+  return StreamOf(this).seed;
+}
+
 //////////////////////////////////////////////////
 double GaussianNoiseModel::GetMean() const
 {
@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_GAUSSIAN_NOISE_MODEL_HH_
 #define _GAZEBO_GAUSSIAN_NOISE_MODEL_HH_
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -57,6 +58,19 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in, double _dt);
 
+        /// \brief Set the seed of the random number stream used by this
+        /// noise model and restart the stream. Two models with the same seed
+        /// and parameters produce the same noise sequence. By default the
+        /// seed is derived from the ignition::math::Rand seed and, once
+        /// loaded, from the names of the elements enclosing the noise
+        /// element, such as the model, link and sensor names.
+        /// \param[in] _seed Seed of the random number stream.
+        public: void SetSeed(const uint64_t _seed);
+
+        /// \brief Get the seed of the random number stream.
+        /// \return Seed of the random number stream.
+        public: uint64_t Seed() const;
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -99,6 +113,15 @@ namespace gazebo
         /// \brief Sample the bias.
         private: void SampleBias();
 
+        /// \brief Apply noise in place to a block of data values, drawing
+        /// the whole block from the random number stream at once. Called by
+        /// Noise::Apply.
+        /// \param[in,out] _data Pointer to the first data value.
+        /// \param[in] _count Number of data values.
+        /// \param[in] _dt Time step associated with each data value.
+        private: void ApplyBatch(double *_data, const size_t _count,
+                     const double _dt);
+
         /// \brief If type starts with GAUSSIAN, the mean of the distribution
         /// from which we sample when adding noise.
         protected: double mean;
@@ -132,6 +155,9 @@ namespace gazebo
         /// \biref If type starts with GAUSSIAN, the correlation time of the
         /// process from which the dynamic bias will be driven.
         private: double dynamicBiasCorrTime;
+
+        /// \brief Noise::Apply calls ApplyBatch.
+        friend class Noise;
     };
 
     /// \class GaussianNoiseModel
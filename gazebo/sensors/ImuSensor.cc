@@ -43,6 +43,7 @@ ImuSensor::ImuSensor()
   this->dataPtr->dataDirty = false;
   this->dataPtr->incomingLinkData[0].reset();
   this->dataPtr->incomingLinkData[1].reset();
+  this->SetSupportsUpdateInStep(true);
 }
 
 //////////////////////////////////////////////////
@@ -250,6 +251,10 @@ msgs::IMU ImuSensor::ImuMessage() const
 //////////////////////////////////////////////////
 void ImuSensor::OnLinkData(ConstLinkDataPtr &_msg)
 {
+  // The link state is read directly when updating in step
+  if (this->UpdateInStep())
+    return;
+
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   // Store the contacts message for processing in UpdateImpl
   this->dataPtr->incomingLinkData[this->dataPtr->dataIndex] = _msg;
@@ -301,22 +306,36 @@ void ImuSensor::SetWorldToReferenceOrientation(
 bool ImuSensor::UpdateImpl(const bool /*_force*/)
 {
   msgs::LinkData msg;
-  int readIndex = 0;
 
+  if (this->UpdateInStep())
   {
-    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    // Called right after the physics step, so read the link state directly
+    // instead of waiting for the link data message.
+    msgs::Set(msg.mutable_time(), this->world->SimTime());
+    msgs::Set(msg.mutable_linear_velocity(),
+        this->dataPtr->parentEntity->WorldLinearVel());
+    msgs::Set(msg.mutable_angular_velocity(),
+        this->dataPtr->parentEntity->WorldAngularVel());
+  }
+  else
+  {
+    int readIndex = 0;
 
-    // Don't do anything if there is no new data to process.
-    if (!this->dataPtr->dataDirty)
-      return false;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-    readIndex = this->dataPtr->dataIndex;
-    this->dataPtr->dataIndex ^= 1;
-    this->dataPtr->dataDirty = false;
-  }
+      // Don't do anything if there is no new data to process.
+      if (!this->dataPtr->dataDirty)
+        return false;
 
-  // toggle the index
-  msg.CopyFrom(*this->dataPtr->incomingLinkData[readIndex].get());
+      readIndex = this->dataPtr->dataIndex;
+      this->dataPtr->dataIndex ^= 1;
+      this->dataPtr->dataDirty = false;
+    }
+
+    // toggle the index
+    msg.CopyFrom(*this->dataPtr->incomingLinkData[readIndex].get());
+  }
 
   common::Time timestamp = msgs::Convert(msg.time());
 
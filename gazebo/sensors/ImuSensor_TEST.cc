@@ -18,6 +18,8 @@
 #ifndef _WIN32
 #include <sys/time.h>
 #endif
+#include <atomic>
+
 #include <gtest/gtest.h>
 
 #include "gazebo/test/ServerFixture.hh"
@@ -32,6 +34,7 @@ class ImuSensor_TEST : public ServerFixture,
 {
   public: void BasicImuSensorCheck(const std::string &_physicsEngine);
   public: void LinearAccelerationTest(const std::string &_physicsEngine);
+  public: void UpdateInStepTest(const std::string &_physicsEngine);
 };
 
 static std::string imuSensorString =
@@ -146,6 +149,64 @@ void ImuSensor_TEST::LinearAccelerationTest(const std::string &_physicsEngine)
   EXPECT_NEAR(imuSensor->LinearAcceleration().Z(), -gravityZ, 0.4);
 }
 
+/////////////////////////////////////////////////
+// Update an imu from the physics thread and check it produces one
+// measurement per step
+void ImuSensor_TEST::UpdateInStepTest(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  SpawnUnitImuSensor("imuModel", "imuSensor", "box", "~/imu_in_step",
+      ignition::math::Vector3d(0, 0, 10), ignition::math::Vector3d::Zero);
+
+  sensors::ImuSensorPtr imuSensor =
+      std::dynamic_pointer_cast<sensors::ImuSensor>(
+      sensors::get_sensor("imuSensor"));
+  ASSERT_TRUE(imuSensor != nullptr);
+
+  sensors::SensorManager::Instance()->Init();
+  imuSensor->SetActive(true);
+  imuSensor->SetUpdateRate(0);
+
+  EXPECT_TRUE(imuSensor->SupportsUpdateInStep());
+  EXPECT_FALSE(imuSensor->UpdateInStep());
+  EXPECT_TRUE(imuSensor->SetUpdateInStep(true));
+  EXPECT_TRUE(imuSensor->UpdateInStep());
+
+  std::atomic<unsigned int> updates(0);
+  event::ConnectionPtr connection = imuSensor->ConnectUpdated(
+      [&updates]()
+      {
+        ++updates;
+      });
+
+  // The first update only sets the initial velocity
+  world->Step(1);
+  updates = 0;
+
+  // The sensor threads don't update it anymore
+  sensors::SensorUpdateStatistics stats;
+  sensors::SensorManager::Instance()->UpdateStatistics(
+      imuSensor->ScopedName(), stats);
+  const uint64_t threadUpdates = stats.updateCount;
+
+  const unsigned int steps = 100;
+  world->Step(steps);
+  EXPECT_EQ(steps, updates);
+  sensors::SensorManager::Instance()->UpdateStatistics(
+      imuSensor->ScopedName(), stats);
+  EXPECT_EQ(threadUpdates, stats.updateCount);
+  EXPECT_EQ(world->SimTime(), imuSensor->LastMeasurementTime());
+
+  // Free fall
+  EXPECT_NEAR(imuSensor->LinearAcceleration().Z(), 0, TOL);
+
+  EXPECT_TRUE(imuSensor->SetUpdateInStep(false));
+  EXPECT_FALSE(imuSensor->UpdateInStep());
+}
+
 /////////////////////////////////////////////////
 TEST_P(ImuSensor_TEST, BasicImuSensorCheck)
 {
@@ -158,6 +219,12 @@ TEST_P(ImuSensor_TEST, LinearAccelerationTest)
   LinearAccelerationTest(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(ImuSensor_TEST, UpdateInStepTest)
+{
+  UpdateInStepTest(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, ImuSensor_TEST,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
@@ -20,6 +20,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
 
+#include "gazebo/sensors/ModelSpatialIndex.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/LogicalCameraSensorPrivate.hh"
 #include "gazebo/sensors/LogicalCameraSensor.hh"
@@ -57,6 +58,8 @@ void LogicalCameraSensor::Load(const std::string &_worldName,
   // Store parent model's name for use in the UpdateImpl function.
   this->dataPtr->modelName =
     this->dataPtr->parentLink->GetModel()->GetScopedName();
+
+  this->dataPtr->modelIndex = ModelSpatialIndex::Get(this->world);
 }
 
 //////////////////////////////////////////////////
@@ -106,36 +109,10 @@ void LogicalCameraSensor::Init()
 //////////////////////////////////////////////////
 void LogicalCameraSensor::Fini()
 {
+  this->dataPtr->modelIndex.reset();
   Sensor::Fini();
 }
 
-//////////////////////////////////////////////////
-void LogicalCameraSensorPrivate::AddVisibleModels(
-    ignition::math::Pose3d &_myPose, const physics::Model_V &_models)
-{
-  for (auto const &model : _models)
-  {
-    auto const &scopedName = model->GetScopedName();
-    auto const aabb = model->BoundingBox();
-
-    if (this->modelName != scopedName && this->frustum.Contains(aabb))
-    {
-      // Add new model msg
-      msgs::LogicalCameraImage::Model *modelMsg = this->msg.add_model();
-
-      // Set the name and pose reported by the sensor.
-      modelMsg->set_name(scopedName);
-      msgs::Set(modelMsg->mutable_pose(),
-          model->WorldPose() - _myPose);
-    }
-    // Check nested models
-    // Note, the model AABB does not necessarily contain the nested model
-    // so nested models must be searched even if the frustum does not contain
-    // the parent model.
-    AddVisibleModels(_myPose, model->NestedModels());
-  }
-}
-
 //////////////////////////////////////////////////
 bool LogicalCameraSensor::UpdateImpl(const bool _force)
 {
@@ -155,8 +132,25 @@ bool LogicalCameraSensor::UpdateImpl(const bool _force)
     // Set the camera's pose in the message.
     msgs::Set(this->dataPtr->msg.mutable_pose(), myPose);
 
-    // Recursively check if models and nested models are in the frustum.
-    this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    // Query the models and nested models whose bounding box intersects the
+    // frustum. Note, the model AABB does not necessarily contain the nested
+    // models, which are indexed separately.
+    for (auto const &model :
+        this->dataPtr->modelIndex->ModelsInFrustum(
+          this->dataPtr->frustum, _force))
+    {
+      auto const &scopedName = model->GetScopedName();
+      if (this->dataPtr->modelName == scopedName)
+        continue;
+
+      // Add new model msg
+      msgs::LogicalCameraImage::Model *modelMsg =
+        this->dataPtr->msg.add_model();
+
+      // Set the name and pose reported by the sensor.
+      modelMsg->set_name(scopedName);
+      msgs::Set(modelMsg->mutable_pose(), model->WorldPose() - myPose);
+    }
 
     // Send the message.
     this->dataPtr->pub->Publish(this->dataPtr->msg);
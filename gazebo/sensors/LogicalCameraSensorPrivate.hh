@@ -23,6 +23,7 @@
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/Link.hh"
+#include "gazebo/sensors/SensorTypes.hh"
 
 namespace gazebo
 {
@@ -32,12 +33,6 @@ namespace gazebo
     /// \brief Logical camera sensor private data.
     class LogicalCameraSensorPrivate
     {
-      /// \brief Add models that are visible to the camera to a vector of models
-      /// \param[in] _myPose pose of the logical camera
-      /// \param[in] _models list of models to test against frustum
-      public: void AddVisibleModels(ignition::math::Pose3d &_myPose,
-        const physics::Model_V &_models);
-
       /// \brief Publisher of msgs::LogicalCameraImage messages.
       public: transport::PublisherPtr pub;
 
@@ -55,6 +50,10 @@ namespace gazebo
 
       /// \brief Name of the parent model.
       public: std::string modelName;
+
+      /// \brief Spatial index of the world's models, shared with the other
+      /// sensors of the world.
+      public: ModelSpatialIndexPtr modelIndex;
     };
   }
 }
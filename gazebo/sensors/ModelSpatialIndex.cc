@@ -0,0 +1,569 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+
+#include "gazebo/sensors/ModelSpatialIndexPrivate.hh"
+#include "gazebo/sensors/ModelSpatialIndex.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+constexpr double ModelSpatialIndexPrivate::kCellSize;
+constexpr int64_t ModelSpatialIndexPrivate::kMaxCellsPerEntry;
+
+/////////////////////////////////////////////////
+/// \brief Append a model and its nested models in depth first order.
+/// \param[in] _models Models to append.
+/// \param[out] _out Flattened list of models.
+static void flattenModels(const physics::Model_V &_models,
+    physics::Model_V &_out)
+{
+  for (auto const &model : _models)
+  {
+    _out.push_back(model);
+    flattenModels(model->NestedModels(), _out);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the grid cell index of a coordinate.
+/// \param[in] _v Coordinate in meters.
+/// \return Cell index.
+static int64_t cellIndex(const double _v)
+{
+  return static_cast<int64_t>(
+      std::floor(_v / ModelSpatialIndexPrivate::kCellSize));
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that a box is not empty and has finite bounds.
+/// \param[in] _box Box to check.
+/// \return True if the box can be stored in the grid.
+static bool finiteBox(const ignition::math::AxisAlignedBox &_box)
+{
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (!std::isfinite(_box.Min()[i]) || !std::isfinite(_box.Max()[i]) ||
+        _box.Min()[i] > _box.Max()[i] ||
+        std::fabs(_box.Min()[i]) > 1e6 || std::fabs(_box.Max()[i]) > 1e6)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether two boxes overlap.
+/// \param[in] _a First box.
+/// \param[in] _b Second box.
+/// \return True if the boxes overlap.
+static bool boxOverlap(const ignition::math::AxisAlignedBox &_a,
+    const ignition::math::AxisAlignedBox &_b)
+{
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (_a.Max()[i] < _b.Min()[i] || _b.Max()[i] < _a.Min()[i])
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t ModelSpatialIndexPrivate::CellKey(const int64_t _x, const int64_t _y,
+    const int64_t _z)
+{
+  const uint64_t mask = (1u << 21) - 1;
+  return ((static_cast<uint64_t>(_x) & mask) << 42) |
+         ((static_cast<uint64_t>(_y) & mask) << 21) |
+         (static_cast<uint64_t>(_z) & mask);
+}
+
+/////////////////////////////////////////////////
+void ModelSpatialIndexPrivate::CellCoords(const uint64_t _key,
+    int64_t _cell[3])
+{
+  const uint64_t mask = (1u << 21) - 1;
+  const int shifts[3] = {42, 21, 0};
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    // Sign extend the 21 bit cell index
+    int64_t v = static_cast<int64_t>((_key >> shifts[i]) & mask);
+    if (v & (int64_t(1) << 20))
+      v -= int64_t(1) << 21;
+    _cell[i] = v;
+  }
+}
+
+/////////////////////////////////////////////////
+void ModelSpatialIndexPrivate::Insert(const unsigned int _index)
+{
+  ModelSpatialIndexEntry &entry = this->entries[_index];
+  entry.gridded = false;
+
+  if (finiteBox(entry.box))
+  {
+    int64_t cells = 1;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      entry.cellMin[i] = cellIndex(entry.box.Min()[i]);
+      entry.cellMax[i] = cellIndex(entry.box.Max()[i]);
+      cells *= entry.cellMax[i] - entry.cellMin[i] + 1;
+    }
+    entry.gridded = cells <= kMaxCellsPerEntry;
+  }
+
+  if (!entry.gridded)
+  {
+    this->ungridded.push_back(_index);
+    return;
+  }
+
+  for (int64_t x = entry.cellMin[0]; x <= entry.cellMax[0]; ++x)
+  {
+    for (int64_t y = entry.cellMin[1]; y <= entry.cellMax[1]; ++y)
+    {
+      for (int64_t z = entry.cellMin[2]; z <= entry.cellMax[2]; ++z)
+        this->grid[CellKey(x, y, z)].push_back(_index);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ModelSpatialIndexPrivate::Remove(const unsigned int _index)
+{
+  ModelSpatialIndexEntry &entry = this->entries[_index];
+  if (!entry.gridded)
+  {
+    this->ungridded.erase(std::remove(this->ungridded.begin(),
+          this->ungridded.end(), _index), this->ungridded.end());
+    return;
+  }
+
+  for (int64_t x = entry.cellMin[0]; x <= entry.cellMax[0]; ++x)
+  {
+    for (int64_t y = entry.cellMin[1]; y <= entry.cellMax[1]; ++y)
+    {
+      for (int64_t z = entry.cellMin[2]; z <= entry.cellMax[2]; ++z)
+      {
+        auto iter = this->grid.find(CellKey(x, y, z));
+        if (iter == this->grid.end())
+          continue;
+        auto &cell = iter->second;
+        cell.erase(std::remove(cell.begin(), cell.end(), _index), cell.end());
+        if (cell.empty())
+          this->grid.erase(iter);
+      }
+    }
+  }
+  entry.gridded = false;
+}
+
+/////////////////////////////////////////////////
+void ModelSpatialIndexPrivate::Touch(const ModelSpatialIndexEntry &_entry)
+{
+  // The revision is incremented at the end of the refresh
+  const uint64_t next = this->revision + 1;
+  if (!_entry.gridded)
+  {
+    this->ungriddedRevision = next;
+    return;
+  }
+
+  for (int64_t x = _entry.cellMin[0]; x <= _entry.cellMax[0]; ++x)
+  {
+    for (int64_t y = _entry.cellMin[1]; y <= _entry.cellMax[1]; ++y)
+    {
+      for (int64_t z = _entry.cellMin[2]; z <= _entry.cellMax[2]; ++z)
+        this->cellRevisions[CellKey(x, y, z)] = next;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+uint64_t ModelSpatialIndexPrivate::RegionRevision(
+    const ignition::math::AxisAlignedBox &_box) const
+{
+  if (!finiteBox(_box))
+    return this->revision;
+
+  int64_t cellMin[3];
+  int64_t cellMax[3];
+  double cells = 1;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    cellMin[i] = cellIndex(_box.Min()[i]);
+    cellMax[i] = cellIndex(_box.Max()[i]);
+    cells *= static_cast<double>(cellMax[i] - cellMin[i] + 1);
+  }
+
+  uint64_t result = this->ungriddedRevision;
+
+  // Scan the changed cells directly when the region covers more cells
+  // than have changed.
+  if (cells > static_cast<double>(this->cellRevisions.size()))
+  {
+    for (auto const &cellRevision : this->cellRevisions)
+    {
+      int64_t cell[3];
+      CellCoords(cellRevision.first, cell);
+      if (cell[0] >= cellMin[0] && cell[0] <= cellMax[0] &&
+          cell[1] >= cellMin[1] && cell[1] <= cellMax[1] &&
+          cell[2] >= cellMin[2] && cell[2] <= cellMax[2])
+      {
+        result = std::max(result, cellRevision.second);
+      }
+    }
+    return result;
+  }
+
+  for (int64_t x = cellMin[0]; x <= cellMax[0]; ++x)
+  {
+    for (int64_t y = cellMin[1]; y <= cellMax[1]; ++y)
+    {
+      for (int64_t z = cellMin[2]; z <= cellMax[2]; ++z)
+      {
+        auto iter = this->cellRevisions.find(CellKey(x, y, z));
+        if (iter != this->cellRevisions.end())
+          result = std::max(result, iter->second);
+      }
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+void ModelSpatialIndexPrivate::UpdateEntry(const unsigned int _index)
+{
+  ModelSpatialIndexEntry &entry = this->entries[_index];
+  entry.box = entry.model->BoundingBox();
+  this->Insert(_index);
+  ++this->lastUpdates;
+}
+
+/////////////////////////////////////////////////
+void ModelSpatialIndexPrivate::Rebuild(const physics::Model_V &_models)
+{
+  std::vector<ModelSpatialIndexEntry> oldEntries;
+  oldEntries.swap(this->entries);
+  this->grid.clear();
+  this->ungridded.clear();
+
+  std::map<physics::Model *, const ModelSpatialIndexEntry *> oldByModel;
+  for (auto const &entry : oldEntries)
+    oldByModel[entry.model.get()] = &entry;
+
+  this->entries.resize(_models.size());
+  for (unsigned int i = 0; i < _models.size(); ++i)
+  {
+    ModelSpatialIndexEntry &entry = this->entries[i];
+    entry.model = _models[i];
+    for (auto const &link : entry.model->GetLinks())
+      entry.linkPoses.push_back(link->WorldPose());
+    this->UpdateEntry(i);
+
+    // Only the regions of added, removed or moved models change
+    auto old = oldByModel.find(entry.model.get());
+    if (old == oldByModel.end())
+    {
+      this->Touch(entry);
+      continue;
+    }
+    if (old->second->box.Min() != entry.box.Min() ||
+        old->second->box.Max() != entry.box.Max())
+    {
+      this->Touch(*old->second);
+      this->Touch(entry);
+    }
+    oldByModel.erase(old);
+  }
+
+  for (auto const &removed : oldByModel)
+    this->Touch(*removed.second);
+}
+
+/////////////////////////////////////////////////
+void ModelSpatialIndexPrivate::Refresh(const bool _force)
+{
+  const uint64_t iteration = this->world->Iterations();
+  if (!_force && this->refreshed && iteration == this->lastIteration)
+    return;
+  this->refreshed = true;
+  this->lastIteration = iteration;
+  this->lastUpdates = 0;
+
+  this->models.clear();
+  flattenModels(this->world->Models(), this->models);
+
+  bool sameModels = this->models.size() == this->entries.size();
+  for (unsigned int i = 0; sameModels && i < this->models.size(); ++i)
+    sameModels = this->models[i] == this->entries[i].model;
+
+  if (!sameModels)
+  {
+    this->Rebuild(this->models);
+    ++this->revision;
+    return;
+  }
+
+  // Only recompute the boxes of models with a link that moved.
+  for (unsigned int i = 0; i < this->entries.size(); ++i)
+  {
+    ModelSpatialIndexEntry &entry = this->entries[i];
+    auto const &links = entry.model->GetLinks();
+
+    bool moved = links.size() != entry.linkPoses.size();
+    if (moved)
+      entry.linkPoses.resize(links.size());
+    for (unsigned int l = 0; l < links.size(); ++l)
+    {
+      const ignition::math::Pose3d pose = links[l]->WorldPose();
+      if (pose != entry.linkPoses[l])
+      {
+        entry.linkPoses[l] = pose;
+        moved = true;
+      }
+    }
+
+    if (moved)
+    {
+      this->Touch(entry);
+      this->Remove(i);
+      this->UpdateEntry(i);
+      this->Touch(entry);
+    }
+  }
+
+  if (this->lastUpdates > 0)
+    ++this->revision;
+}
+
+/////////////////////////////////////////////////
+void ModelSpatialIndexPrivate::Candidates(
+    const ignition::math::AxisAlignedBox &_box,
+    std::vector<unsigned int> &_candidates) const
+{
+  _candidates = this->ungridded;
+
+  int64_t cellMin[3];
+  int64_t cellMax[3];
+  double cells = 1;
+  const bool finite = finiteBox(_box);
+  if (finite)
+  {
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      cellMin[i] = cellIndex(_box.Min()[i]);
+      cellMax[i] = cellIndex(_box.Max()[i]);
+      cells *= static_cast<double>(cellMax[i] - cellMin[i] + 1);
+    }
+  }
+
+  // Scan the entries directly when the query covers more cells than there
+  // are entries.
+  if (!finite || cells > static_cast<double>(this->entries.size()))
+  {
+    for (unsigned int i = 0; i < this->entries.size(); ++i)
+    {
+      if (this->entries[i].gridded && boxOverlap(this->entries[i].box, _box))
+        _candidates.push_back(i);
+    }
+  }
+  else
+  {
+    for (int64_t x = cellMin[0]; x <= cellMax[0]; ++x)
+    {
+      for (int64_t y = cellMin[1]; y <= cellMax[1]; ++y)
+      {
+        for (int64_t z = cellMin[2]; z <= cellMax[2]; ++z)
+        {
+          auto iter = this->grid.find(CellKey(x, y, z));
+          if (iter == this->grid.end())
+            continue;
+          for (const unsigned int index : iter->second)
+          {
+            if (boxOverlap(this->entries[index].box, _box))
+              _candidates.push_back(index);
+          }
+        }
+      }
+    }
+  }
+
+  std::sort(_candidates.begin(), _candidates.end());
+  _candidates.erase(std::unique(_candidates.begin(), _candidates.end()),
+      _candidates.end());
+}
+
+/////////////////////////////////////////////////
+ModelSpatialIndex::ModelSpatialIndex(physics::WorldPtr _world)
+  : dataPtr(new ModelSpatialIndexPrivate)
+{
+  GZ_ASSERT(_world, "World is null");
+  this->dataPtr->world = _world;
+}
+
+/////////////////////////////////////////////////
+ModelSpatialIndex::~ModelSpatialIndex()
+{
+}
+
+/////////////////////////////////////////////////
+ModelSpatialIndexPtr ModelSpatialIndex::Get(physics::WorldPtr _world)
+{
+  static std::mutex registryMutex;
+  static std::map<std::string, std::weak_ptr<ModelSpatialIndex>> registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  ModelSpatialIndexPtr index = registry[_world->Name()].lock();
+  if (!index || index->dataPtr->world != _world)
+  {
+    index.reset(new ModelSpatialIndex(_world));
+    registry[_world->Name()] = index;
+  }
+  return index;
+}
+
+/////////////////////////////////////////////////
+void ModelSpatialIndex::Refresh(const bool _force)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Refresh(_force);
+}
+
+/////////////////////////////////////////////////
+physics::Model_V ModelSpatialIndex::ModelsInFrustum(
+    const ignition::math::Frustum &_frustum, const bool _force)
+{
+  // Bounding box of the frustum corners. The frustum looks along +x.
+  const ignition::math::Pose3d &pose = _frustum.Pose();
+  const double tanHalfFov = std::tan(_frustum.FOV().Radian() * 0.5);
+  ignition::math::AxisAlignedBox query;
+  query.Min().Set(ignition::math::MAX_D, ignition::math::MAX_D,
+      ignition::math::MAX_D);
+  query.Max().Set(-ignition::math::MAX_D, -ignition::math::MAX_D,
+      -ignition::math::MAX_D);
+  for (const double dist : {_frustum.Near(), _frustum.Far()})
+  {
+    const double halfWidth = dist * tanHalfFov;
+    const double halfHeight = halfWidth / _frustum.AspectRatio();
+    for (const double y : {-halfWidth, halfWidth})
+    {
+      for (const double z : {-halfHeight, halfHeight})
+      {
+        const ignition::math::Vector3d corner =
+          pose.CoordPositionAdd(ignition::math::Vector3d(dist, y, z));
+        query.Min().Min(corner);
+        query.Max().Max(corner);
+      }
+    }
+  }
+
+  physics::Model_V result;
+  std::vector<unsigned int> candidates;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Refresh(_force);
+  this->dataPtr->Candidates(query, candidates);
+  for (const unsigned int index : candidates)
+  {
+    const ModelSpatialIndexEntry &entry = this->dataPtr->entries[index];
+    if (_frustum.Contains(entry.box))
+      result.push_back(entry.model);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+physics::Model_V ModelSpatialIndex::ModelsInRadius(
+    const ignition::math::Vector3d &_center, const double _radius,
+    const bool _force)
+{
+  const ignition::math::Vector3d extent(_radius, _radius, _radius);
+  const ignition::math::AxisAlignedBox query(
+      _center - extent, _center + extent);
+
+  physics::Model_V result;
+  std::vector<unsigned int> candidates;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Refresh(_force);
+  this->dataPtr->Candidates(query, candidates);
+  for (const unsigned int index : candidates)
+  {
+    const ModelSpatialIndexEntry &entry = this->dataPtr->entries[index];
+    const ignition::math::Vector3d &boxMin = entry.box.Min();
+    const ignition::math::Vector3d &boxMax = entry.box.Max();
+
+    // Models without collisions have an empty box.
+    if (boxMin.X() > boxMax.X() || boxMin.Y() > boxMax.Y() ||
+        boxMin.Z() > boxMax.Z())
+    {
+      continue;
+    }
+
+    // Distance from the center to the closest point of the box
+    ignition::math::Vector3d closest(
+        ignition::math::clamp(_center.X(), boxMin.X(), boxMax.X()),
+        ignition::math::clamp(_center.Y(), boxMin.Y(), boxMax.Y()),
+        ignition::math::clamp(_center.Z(), boxMin.Z(), boxMax.Z()));
+    if (closest.Distance(_center) <= _radius)
+      result.push_back(entry.model);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+uint64_t ModelSpatialIndex::Revision(const bool _force)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Refresh(_force);
+  return this->dataPtr->revision;
+}
+
+/////////////////////////////////////////////////
+uint64_t ModelSpatialIndex::Revision(
+    const ignition::math::AxisAlignedBox &_box, const bool _force)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Refresh(_force);
+  return this->dataPtr->RegionRevision(_box);
+}
+
+/////////////////////////////////////////////////
+size_t ModelSpatialIndex::ModelCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->entries.size();
+}
+
+/////////////////////////////////////////////////
+size_t ModelSpatialIndex::LastRefreshUpdates() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->lastUpdates;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_MODELSPATIALINDEX_HH_
+#define GAZEBO_SENSORS_MODELSPATIALINDEX_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Frustum.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/sensors/SensorTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declare private data class.
+    class ModelSpatialIndexPrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class ModelSpatialIndex ModelSpatialIndex.hh sensors/sensors.hh
+    /// \brief Spatial index of the bounding boxes of the models in a world,
+    /// shared by all the sensors of that world.
+    ///
+    /// Models, including nested models, are stored in a uniform grid of
+    /// axis aligned boxes. The index is refreshed at most once per world
+    /// iteration, and only the models whose links moved have their
+    /// bounding box recomputed. Query results are returned in depth first
+    /// order of the world's model tree, which is the order a linear walk
+    /// over World::Models and Model::NestedModels would produce.
+    /// All functions are thread safe.
+    class GZ_SENSORS_VISIBLE ModelSpatialIndex
+    {
+      /// \brief Constructor.
+      /// \param[in] _world World whose models are indexed.
+      public: explicit ModelSpatialIndex(physics::WorldPtr _world);
+
+      /// \brief Destructor.
+      public: virtual ~ModelSpatialIndex();
+
+      /// \brief Get the index shared by the sensors of a world. The index
+      /// is created on first use, and released once no sensor holds it.
+      /// \param[in] _world World whose models are indexed.
+      /// \return Shared index of the world.
+      public: static ModelSpatialIndexPtr Get(physics::WorldPtr _world);
+
+      /// \brief Refresh the index from the current model poses. This is
+      /// done automatically by the queries once per world iteration.
+      /// \param[in] _force True to refresh even if the world has not
+      /// stepped since the last refresh, e.g. after a model was moved while
+      /// paused.
+      public: void Refresh(const bool _force = false);
+
+      /// \brief Get the models whose bounding box intersects a frustum.
+      /// \param[in] _frustum Frustum to test against.
+      /// \param[in] _force True to refresh the index first even if the
+      /// world has not stepped.
+      /// \return Models intersecting the frustum.
+      public: physics::Model_V ModelsInFrustum(
+                  const ignition::math::Frustum &_frustum,
+                  const bool _force = false);
+
+      /// \brief Get the models whose bounding box intersects a sphere.
+      /// \param[in] _center Center of the sphere in the world frame.
+      /// \param[in] _radius Radius of the sphere.
+      /// \param[in] _force True to refresh the index first even if the
+      /// world has not stepped.
+      /// \return Models intersecting the sphere.
+      public: physics::Model_V ModelsInRadius(
+                  const ignition::math::Vector3d &_center,
+                  const double _radius, const bool _force = false);
+
+      /// \brief Get the revision of the index. The revision changes every
+      /// time a model is added, removed or moved, so users can cache results
+      /// that depend on the model poses while it stays the same.
+      /// \param[in] _force True to refresh the index first even if the
+      /// world has not stepped.
+      /// \return Revision of the index.
+      public: uint64_t Revision(const bool _force = false);
+
+      /// \brief Get the revision of a region. It changes when a model is
+      /// added to, removed from or moved within the grid cells covered by
+      /// the region, or when a model too large for the grid changes. Use it
+      /// to cache results that only depend on the models in the region.
+      /// \param[in] _box Region in the world frame.
+      /// \param[in] _force True to refresh the index first even if the
+      /// world has not stepped.
+      /// \return Revision of the region, never larger than Revision().
+      public: uint64_t Revision(const ignition::math::AxisAlignedBox &_box,
+                  const bool _force = false);
+
+      /// \brief Get the number of indexed models, including nested models.
+      /// \return Number of models.
+      public: size_t ModelCount() const;
+
+      /// \brief Get the number of bounding boxes recomputed by the last
+      /// refresh.
+      /// \return Number of models updated by the last refresh.
+      public: size_t LastRefreshUpdates() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ModelSpatialIndexPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_MODELSPATIALINDEX_PRIVATE_HH_
+#define GAZEBO_SENSORS_MODELSPATIALINDEX_PRIVATE_HH_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief An indexed model.
+    class ModelSpatialIndexEntry
+    {
+      /// \brief The model.
+      public: physics::ModelPtr model;
+
+      /// \brief World poses of the model's links when the box was computed.
+      public: std::vector<ignition::math::Pose3d> linkPoses;
+
+      /// \brief Bounding box of the model.
+      public: ignition::math::AxisAlignedBox box;
+
+      /// \brief True if the box is stored in the grid, false if it is
+      /// empty, unbounded or too large and is tested by every query.
+      public: bool gridded = false;
+
+      /// \brief Lowest grid cell covered by the box.
+      public: int64_t cellMin[3] = {0, 0, 0};
+
+      /// \brief Highest grid cell covered by the box.
+      public: int64_t cellMax[3] = {0, 0, 0};
+    };
+
+    /// \internal
+    /// \brief Model spatial index private data.
+    class ModelSpatialIndexPrivate
+    {
+      /// \brief Rebuild the whole index from a list of models.
+      /// \param[in] _models Models in depth first order.
+      public: void Rebuild(const physics::Model_V &_models);
+
+      /// \brief Recompute the box of an entry and move it in the grid.
+      /// \param[in] _index Index of the entry.
+      public: void UpdateEntry(const unsigned int _index);
+
+      /// \brief Add an entry to the grid cells its box covers, or to the
+      /// list of entries tested by every query.
+      /// \param[in] _index Index of the entry.
+      public: void Insert(const unsigned int _index);
+
+      /// \brief Remove an entry from the grid.
+      /// \param[in] _index Index of the entry.
+      public: void Remove(const unsigned int _index);
+
+      /// \brief Mark the cells covered by an entry as changed by the
+      /// current refresh, see RegionRevision.
+      /// \param[in] _entry Entry that was added, removed or moved.
+      public: void Touch(const ModelSpatialIndexEntry &_entry);
+
+      /// \brief Get the revision of the last refresh that changed an entry
+      /// in the cells covered by a box. The mutex must be held.
+      /// \param[in] _box Region in the world frame.
+      /// \return Revision of the region.
+      public: uint64_t RegionRevision(
+                  const ignition::math::AxisAlignedBox &_box) const;
+
+      /// \brief Refresh the index if needed. The mutex must be held.
+      /// \param[in] _force True to refresh even if the world did not step.
+      public: void Refresh(const bool _force);
+
+      /// \brief Get the entries that may intersect a box, sorted by index.
+      /// The mutex must be held.
+      /// \param[in] _box Query box in the world frame.
+      /// \param[out] _candidates Indices of the candidate entries.
+      public: void Candidates(const ignition::math::AxisAlignedBox &_box,
+                  std::vector<unsigned int> &_candidates) const;
+
+      /// \brief Get the key of a grid cell.
+      /// \param[in] _x Cell index along x.
+      /// \param[in] _y Cell index along y.
+      /// \param[in] _z Cell index along z.
+      /// \return Key of the cell in the grid map.
+      public: static uint64_t CellKey(const int64_t _x, const int64_t _y,
+                  const int64_t _z);
+
+      /// \brief Get the cell indices of a grid cell key.
+      /// \param[in] _key Key of the cell, see CellKey.
+      /// \param[out] _cell Cell indices along x, y and z.
+      public: static void CellCoords(const uint64_t _key, int64_t _cell[3]);
+
+      /// \brief Size of a grid cell in meters.
+      public: static constexpr double kCellSize = 4.0;
+
+      /// \brief Largest number of cells a box may cover before it is
+      /// tested by every query instead of being stored in the grid.
+      public: static constexpr int64_t kMaxCellsPerEntry = 64;
+
+      /// \brief World whose models are indexed.
+      public: physics::WorldPtr world;
+
+      /// \brief Indexed models, in depth first order.
+      public: std::vector<ModelSpatialIndexEntry> entries;
+
+      /// \brief Entries in each occupied grid cell.
+      public: std::unordered_map<uint64_t, std::vector<unsigned int>> grid;
+
+      /// \brief Entries tested by every query.
+      public: std::vector<unsigned int> ungridded;
+
+      /// \brief Scratch list of models used to detect added or removed
+      /// models.
+      public: physics::Model_V models;
+
+      /// \brief World iteration of the last refresh.
+      public: uint64_t lastIteration = 0;
+
+      /// \brief True once the index has been refreshed.
+      public: bool refreshed = false;
+
+      /// \brief Revision of the index, incremented when a refresh changes
+      /// any entry.
+      public: uint64_t revision = 0;
+
+      /// \brief Revision of the last refresh that changed an entry in each
+      /// grid cell. Cells that never changed have no revision.
+      public: std::unordered_map<uint64_t, uint64_t> cellRevisions;
+
+      /// \brief Revision of the last refresh that changed an entry which
+      /// is not stored in the grid. It applies to every region.
+      public: uint64_t ungriddedRevision = 0;
+
+      /// \brief Number of boxes recomputed by the last refresh.
+      public: size_t lastUpdates = 0;
+
+      /// \brief Mutex that protects the index.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+#endif
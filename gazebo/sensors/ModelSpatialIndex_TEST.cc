@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include "gazebo/sensors/ModelSpatialIndex.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class ModelSpatialIndex_TEST : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the names of a list of models.
+/// \param[in] _models Models.
+/// \return Scoped names of the models.
+static std::vector<std::string> modelNames(const physics::Model_V &_models)
+{
+  std::vector<std::string> names;
+  for (auto const &model : _models)
+    names.push_back(model->GetScopedName());
+  return names;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare frustum and radius queries against a linear scan.
+TEST_F(ModelSpatialIndex_TEST, Queries)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // A row of boxes along x, spaced further apart than the grid cells
+  const unsigned int boxCount = 8;
+  for (unsigned int i = 0; i < boxCount; ++i)
+  {
+    SpawnBox("box_" + std::to_string(i), ignition::math::Vector3d(1, 1, 1),
+        ignition::math::Vector3d(3.0 + 5.0 * i, 0, 0.5),
+        ignition::math::Vector3d::Zero, true);
+  }
+
+  sensors::ModelSpatialIndexPtr index = sensors::ModelSpatialIndex::Get(world);
+  ASSERT_TRUE(index != nullptr);
+  EXPECT_EQ(index, sensors::ModelSpatialIndex::Get(world));
+
+  index->Refresh(true);
+  EXPECT_EQ(boxCount + 1u, index->ModelCount());
+
+  // Frustum looking down +x that reaches the first three boxes
+  ignition::math::Frustum frustum;
+  frustum.SetNear(0.1);
+  frustum.SetFar(14.0);
+  frustum.SetFOV(IGN_DTOR(60));
+  frustum.SetAspectRatio(1.0);
+  frustum.SetPose(ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0));
+
+  physics::Model_V expected;
+  for (auto const &model : world->Models())
+  {
+    if (frustum.Contains(model->BoundingBox()))
+      expected.push_back(model);
+  }
+  auto visible = index->ModelsInFrustum(frustum);
+  EXPECT_EQ(modelNames(expected), modelNames(visible));
+
+  // The ground plane is always reported, followed by the boxes in order
+  ASSERT_EQ(4u, visible.size());
+  EXPECT_EQ("ground_plane", visible[0]->GetScopedName());
+  EXPECT_EQ("box_0", visible[1]->GetScopedName());
+  EXPECT_EQ("box_2", visible[3]->GetScopedName());
+
+  // Radius query around the fourth box
+  auto near = index->ModelsInRadius(ignition::math::Vector3d(18, 0, 0.5), 1.0);
+  ASSERT_EQ(2u, near.size());
+  EXPECT_EQ("ground_plane", near[0]->GetScopedName());
+  EXPECT_EQ("box_3", near[1]->GetScopedName());
+
+  // Nothing but the ground plane far away from the boxes
+  near = index->ModelsInRadius(ignition::math::Vector3d(0, 50, 0.5), 2.0);
+  ASSERT_EQ(1u, near.size());
+
+  // Regions far from the box and regions it moves to or from
+  const ignition::math::AxisAlignedBox farRegion(
+      ignition::math::Vector3d(27, -1, 0), ignition::math::Vector3d(29, 1, 1));
+  const ignition::math::AxisAlignedBox fromRegion(
+      ignition::math::Vector3d(2, -1, 0), ignition::math::Vector3d(4, 1, 1));
+  const ignition::math::AxisAlignedBox toRegion(
+      ignition::math::Vector3d(-1, 49, 0), ignition::math::Vector3d(1, 51, 1));
+  const uint64_t revision = index->Revision();
+  const uint64_t farRevision = index->Revision(farRegion);
+  const uint64_t fromRevision = index->Revision(fromRegion);
+  const uint64_t toRevision = index->Revision(toRegion);
+
+  // Move a box; only its bounding box is recomputed
+  world->ModelByName("box_0")->SetWorldPose(
+      ignition::math::Pose3d(0, 50, 0.5, 0, 0, 0));
+  index->Refresh(true);
+  EXPECT_EQ(1u, index->LastRefreshUpdates());
+
+  // Only the regions the box left or entered change revision
+  EXPECT_NE(revision, index->Revision());
+  EXPECT_EQ(farRevision, index->Revision(farRegion));
+  EXPECT_NE(fromRevision, index->Revision(fromRegion));
+  EXPECT_NE(toRevision, index->Revision(toRegion));
+
+  near = index->ModelsInRadius(ignition::math::Vector3d(0, 50, 0.5), 2.0);
+  ASSERT_EQ(2u, near.size());
+  EXPECT_EQ("box_0", near[1]->GetScopedName());
+
+  visible = index->ModelsInFrustum(frustum, true);
+  ASSERT_EQ(3u, visible.size());
+  EXPECT_EQ("box_1", visible[1]->GetScopedName());
+
+  // Removing a model rebuilds the index
+  world->RemoveModel("box_7");
+  while (world->ModelByName("box_7"))
+    common::Time::MSleep(10);
+  index->Refresh(true);
+  EXPECT_EQ(boxCount, index->ModelCount());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,6 +15,8 @@
  *
 */
 
+#include <typeinfo>
+
 #include <boost/function.hpp>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -124,6 +126,28 @@ double Noise::ApplyImpl(double _in, double /*_dt*/)
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::Apply(double *_data, const size_t _count, const double _dt)
+{
+  if (this->type == NONE || _count == 0)
+    return;
+  else if (this->type == CUSTOM)
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = this->Apply(_data[i], _dt);
+  }
+  else if (typeid(*this) == typeid(GaussianNoiseModel))
+  {
+    // Not for derived classes, which may override ApplyImpl
+    static_cast<GaussianNoiseModel *>(this)->ApplyBatch(_data, _count, _dt);
+  }
+  else
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = this->ApplyImpl(_data[i], _dt);
+  }
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
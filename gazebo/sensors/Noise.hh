@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_NOISE_HH_
 #define _GAZEBO_NOISE_HH_
 
+#include <cstddef>
 #include <vector>
 #include <string>
 
@@ -88,6 +89,16 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in, double _dt = 0.0);
 
+      /// \brief Apply noise in place to a contiguous block of data values.
+      /// The result is the same as calling Apply on each value in order,
+      /// but the Gaussian noise model generates the samples for the whole
+      /// block at once.
+      /// \param[in,out] _data Pointer to the first data value.
+      /// \param[in] _count Number of data values.
+      /// \param[in] _dt Time step associated with each data value.
+      public: void Apply(double *_data, const size_t _count,
+                  const double _dt = 0.0);
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
@@ -373,6 +375,143 @@ TEST_F(NoiseTest, OnApplyNoise)
   }
 }
 
+//////////////////////////////////////////////////
+// Batch noise must match scalar noise drawn from the same stream
+TEST_F(NoiseTest, ApplyBatch)
+{
+  const double dt = 0.01;
+  std::ostringstream noiseStream;
+  noiseStream << "<sdf version='1.6'>"
+              << "  <noise type='gaussian'>"
+              << "    <mean>0.5</mean>"
+              << "    <stddev>2.0</stddev>"
+              << "    <dynamic_bias_stddev>0.2</dynamic_bias_stddev>"
+              << "    <dynamic_bias_correlation_time>10"
+              << "</dynamic_bias_correlation_time>"
+              << "  </noise>"
+              << "</sdf>";
+  sdf::ElementPtr dynamicSdf(new sdf::Element);
+  sdf::initFile("noise.sdf", dynamicSdf);
+  sdf::readString(noiseStream.str(), dynamicSdf);
+
+  std::vector<sdf::ElementPtr> sdfs = {
+      NoiseSdf("gaussian", 10.0, 5.0, 0.0, 0.0, 0.0),
+      NoiseSdf("gaussian_quantized", 10.0, 5.0, 0.0, 0.0, 0.3),
+      dynamicSdf};
+
+  for (const auto &elem : sdfs)
+  {
+    sensors::GaussianNoiseModelPtr scalar =
+      std::dynamic_pointer_cast<sensors::GaussianNoiseModel>(
+          sensors::NoiseFactory::NewNoiseModel(elem));
+    sensors::GaussianNoiseModelPtr batch =
+      std::dynamic_pointer_cast<sensors::GaussianNoiseModel>(
+          sensors::NoiseFactory::NewNoiseModel(elem));
+    ASSERT_TRUE(scalar != nullptr);
+    ASSERT_TRUE(batch != nullptr);
+
+    // Models loaded from the same element get the same stream, whatever
+    // the order they are created in
+    EXPECT_EQ(scalar->Seed(), batch->Seed());
+
+    scalar->SetSeed(1234u);
+    batch->SetSeed(1234u);
+    EXPECT_EQ(scalar->Seed(), 1234u);
+
+    // Split into uneven blocks so that blocks start at odd stream indices
+    std::vector<double> data(257);
+    for (unsigned int i = 0; i < data.size(); ++i)
+      data[i] = i * 0.25;
+    std::vector<double> expected(data.size());
+    for (unsigned int i = 0; i < data.size(); ++i)
+      expected[i] = scalar->Apply(data[i], dt);
+
+    batch->Apply(data.data(), 3, dt);
+    batch->Apply(data.data() + 3, data.size() - 3, dt);
+
+    for (unsigned int i = 0; i < data.size(); ++i)
+      EXPECT_DOUBLE_EQ(data[i], expected[i]);
+    EXPECT_DOUBLE_EQ(batch->GetBias(), scalar->GetBias());
+  }
+}
+
+//////////////////////////////////////////////////
+// The random stream depends on the enclosing elements and the global seed,
+// not on the order in which models are created
+TEST_F(NoiseTest, StreamSeed)
+{
+  auto seedOf = [](const std::string &_sensorName)
+  {
+    sdf::ElementPtr sensor(new sdf::Element);
+    sensor->SetName("sensor");
+    sensor->AddAttribute("name", "string", "", true);
+    sensor->GetAttribute("name")->Set(_sensorName);
+
+    sdf::ElementPtr elem = NoiseSdf("gaussian", 10.0, 5.0, 0.0, 0.0, 0.0);
+    elem->SetParent(sensor);
+
+    auto noise = std::dynamic_pointer_cast<sensors::GaussianNoiseModel>(
+        sensors::NoiseFactory::NewNoiseModel(elem));
+    return noise ? noise->Seed() : 0u;
+  };
+
+  const unsigned int globalSeed = ignition::math::Rand::Seed();
+
+  const uint64_t first = seedOf("first");
+  const uint64_t second = seedOf("second");
+  EXPECT_NE(first, second);
+  EXPECT_EQ(second, seedOf("second"));
+  EXPECT_EQ(first, seedOf("first"));
+
+  ignition::math::Rand::Seed(globalSeed + 1);
+  EXPECT_NE(first, seedOf("first"));
+
+  ignition::math::Rand::Seed(globalSeed);
+  EXPECT_EQ(first, seedOf("first"));
+}
+
+//////////////////////////////////////////////////
+// Statistics of batch Gaussian noise
+TEST_F(NoiseTest, ApplyBatchGaussian)
+{
+  const double mean = 10.0;
+  const double stddev = 5.0;
+  const unsigned int count = 10000;
+
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0.0, 0.0, 0));
+
+  std::vector<double> data(count, 42.0);
+  noise->Apply(data.data(), data.size());
+
+  boost::accumulators::accumulator_set<double,
+    boost::accumulators::stats<boost::accumulators::tag::mean,
+                               boost::accumulators::tag::variance > > acc;
+  for (const double y : data)
+    acc(y);
+
+  // See comments in GaussianNoise function to explain these calculations.
+  double sampleStdDev = g_sigma*stddev / sqrt(count);
+  EXPECT_NEAR(boost::accumulators::mean(acc), 42.0 + mean, sampleStdDev);
+
+  double variance = stddev*stddev;
+  double sampleVariance2 = 2 * variance*variance / (count - 1);
+  EXPECT_NEAR(boost::accumulators::variance(acc),
+              variance, g_sigma*sqrt(sampleVariance2));
+
+  // NONE and CUSTOM go through the same batch entry point
+  sensors::NoisePtr none = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("none", 0, 0, 0, 0, 0));
+  std::vector<double> unchanged = {1.0, 2.0, 3.0};
+  none->Apply(unchanged.data(), unchanged.size());
+  EXPECT_DOUBLE_EQ(unchanged[2], 3.0);
+
+  none->SetCustomNoiseCallback(boost::bind(&OnApplyCustomNoise, _1));
+  none->Apply(unchanged.data(), unchanged.size());
+  EXPECT_DOUBLE_EQ(unchanged[0], 2.0);
+  EXPECT_DOUBLE_EQ(unchanged[2], 6.0);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
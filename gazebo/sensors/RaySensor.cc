@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <vector>
+
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/physics/World.hh"
@@ -272,9 +275,16 @@ void RaySensor::Ranges(std::vector<double> &_ranges) const
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  _ranges.resize(this->dataPtr->laserMsg.scan().ranges_size());
-  memcpy(&_ranges[0], this->dataPtr->laserMsg.scan().ranges().data(),
-         sizeof(_ranges[0]) * this->dataPtr->laserMsg.scan().ranges_size());
+  const msgs::LaserScan &scan = this->dataPtr->laserMsg.scan();
+  if (this->dataPtr->packedFloatPayload)
+  {
+    _ranges.assign(scan.packed_ranges().begin(), scan.packed_ranges().end());
+    return;
+  }
+
+  _ranges.resize(scan.ranges_size());
+  memcpy(&_ranges[0], scan.ranges().data(),
+         sizeof(_ranges[0]) * scan.ranges_size());
 }
 
 //////////////////////////////////////////////////
@@ -282,18 +292,24 @@ double RaySensor::Range(const unsigned int _index) const
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  if (this->dataPtr->laserMsg.scan().ranges_size() == 0)
+  const msgs::LaserScan &scan = this->dataPtr->laserMsg.scan();
+  int size = this->dataPtr->packedFloatPayload ?
+      scan.packed_ranges_size() : scan.ranges_size();
+
+  if (size == 0)
   {
     gzwarn << "ranges not constructed yet (zero sized)\n";
     return 0.0;
   }
-  if (static_cast<int>(_index) >= this->dataPtr->laserMsg.scan().ranges_size())
+  if (static_cast<int>(_index) >= size)
   {
     gzerr << "Invalid range index[" << _index << "]\n";
     return 0.0;
   }
 
-  return this->dataPtr->laserMsg.scan().ranges(_index);
+  if (this->dataPtr->packedFloatPayload)
+    return scan.packed_ranges(_index);
+  return scan.ranges(_index);
 }
 
 //////////////////////////////////////////////////
@@ -301,19 +317,49 @@ double RaySensor::Retro(const unsigned int _index) const
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  if (this->dataPtr->laserMsg.scan().intensities_size() == 0)
+  const msgs::LaserScan &scan = this->dataPtr->laserMsg.scan();
+  int size = this->dataPtr->packedFloatPayload ?
+      scan.packed_intensities_size() : scan.intensities_size();
+
+  if (size == 0)
   {
     gzwarn << "Intensities not constructed yet (zero size)\n";
     return 0.0;
   }
-  if (static_cast<int>(_index) >=
-      this->dataPtr->laserMsg.scan().intensities_size())
+  if (static_cast<int>(_index) >= size)
   {
     gzerr << "Invalid intensity index[" << _index << "]\n";
     return 0.0;
   }
 
-  return this->dataPtr->laserMsg.scan().intensities(_index);
+  if (this->dataPtr->packedFloatPayload)
+    return scan.packed_intensities(_index);
+  return scan.intensities(_index);
+}
+
+//////////////////////////////////////////////////
+void RaySensor::SetPackedFloatPayload(const bool _packed)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (this->dataPtr->packedFloatPayload == _packed)
+    return;
+
+  // Drop the results stored in the other format
+  msgs::LaserScan *scan = this->dataPtr->laserMsg.mutable_scan();
+  scan->clear_ranges();
+  scan->clear_intensities();
+  scan->clear_packed_ranges();
+  scan->clear_packed_intensities();
+
+  this->dataPtr->packedFloatPayload = _packed;
+}
+
+//////////////////////////////////////////////////
+bool RaySensor::PackedFloatPayload() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->packedFloatPayload;
 }
 
 //////////////////////////////////////////////////
@@ -340,106 +386,80 @@ int RaySensor::Fiducial(const unsigned int _index) const
 }
 
 //////////////////////////////////////////////////
-bool RaySensor::UpdateImpl(const bool /*_force*/)
+void RaySensor::UpdateInterpolationTable()
 {
-  // do the collision checks
-  // this eventually call OnNewScans, so move mutex lock behind it in case
-  // need to move mutex lock after this? or make the OnNewLaserScan connection
-  // call somewhere else?
-  this->dataPtr->laserShape->Update();
-  this->lastMeasurementTime = this->world->SimTime();
-
-  // moving this behind laserShape update
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  msgs::Set(this->dataPtr->laserMsg.mutable_time(),
-            this->lastMeasurementTime);
-
-  msgs::LaserScan *scan = this->dataPtr->laserMsg.mutable_scan();
-
-  // Store the latest laser scans into laserMsg
-  msgs::Set(scan->mutable_world_pose(),
-      this->pose + this->dataPtr->parentEntity->WorldPose());
-  scan->set_angle_min(this->AngleMin().Radian());
-  scan->set_angle_max(this->AngleMax().Radian());
-  scan->set_angle_step(this->AngleResolution());
-  scan->set_count(this->RangeCount());
-
-  scan->set_vertical_angle_min(this->VerticalAngleMin().Radian());
-  scan->set_vertical_angle_max(this->VerticalAngleMax().Radian());
-  scan->set_vertical_angle_step(this->VerticalAngleResolution());
-  scan->set_vertical_count(this->VerticalRangeCount());
-
-  scan->set_range_min(this->RangeMin());
-  scan->set_range_max(this->RangeMax());
-
-  scan->clear_ranges();
-  scan->clear_intensities();
-
   unsigned int rayCount = this->RayCount();
   unsigned int rangeCount = this->RangeCount();
   unsigned int verticalRayCount = this->VerticalRayCount();
   unsigned int verticalRangeCount = this->VerticalRangeCount();
 
-  // Interpolation: for every point in range count, compute interpolated value
-  // using four bounding ray samples.
-  // (vja, hja)   (vja, hjb)
-  //       x---------x
-  //       |         |
-  //       |    o    |
-  //       |         |
-  //       x---------x
-  // (vjb, hja)   (vjb, hjb)
-  // where o: is the range to be interpolated
-  //       x: ray sample
-  //       vja: is the previous index of ray in vertical direction
-  //       vjb: is the next index of ray in vertical direction
-  //       hja: is the previous index of ray in horizontal direction
-  //       hjb: is the next index of ray in horizontal direction
-  unsigned int hja, hjb;
-  unsigned int vja = 0, vjb = 0;
-  // percentage of interpolation between rays
-  double vb = 0, hb;
-  // indices of ray samples
-  int j1, j2, j3, j4;
-  // range values of ray samples
-  double r1, r2, r3, r4;
+  if (rayCount == this->dataPtr->tableRayCount &&
+      rangeCount == this->dataPtr->tableRangeCount &&
+      verticalRayCount == this->dataPtr->tableVerticalRayCount &&
+      verticalRangeCount == this->dataPtr->tableVerticalRangeCount)
+  {
+    return;
+  }
+
+  this->dataPtr->tableRayCount = rayCount;
+  this->dataPtr->tableRangeCount = rangeCount;
+  this->dataPtr->tableVerticalRayCount = verticalRayCount;
+  this->dataPtr->tableVerticalRangeCount = verticalRangeCount;
 
   // Check for the common case of vertical and horizontal resolution being 1,
   // which means that ray count == range count and we can do simple lookup
   // of ranges and intensity data, skipping interpolation.  We could do this
   // check independently for vertical and horizontal, but that's more
   // complexity for an unlikely use case.
-  bool interp =
+  this->dataPtr->interpolate =
     ((rayCount != rangeCount) || (verticalRayCount != verticalRangeCount));
 
-  // interpolate in vertical direction
-  for (unsigned int j = 0; j < verticalRangeCount; ++j)
+  this->dataPtr->interpIndices.clear();
+  this->dataPtr->interpHorizontal.clear();
+  this->dataPtr->interpVertical.clear();
+
+  if (this->dataPtr->interpolate)
   {
-    if (interp)
+    this->dataPtr->interpIndices.reserve(
+        4 * rangeCount * verticalRangeCount);
+    this->dataPtr->interpHorizontal.reserve(rangeCount * verticalRangeCount);
+    this->dataPtr->interpVertical.reserve(rangeCount * verticalRangeCount);
+
+    // Interpolation: for every point in range count, compute interpolated
+    // value using four bounding ray samples.
+    // (vja, hja)   (vja, hjb)
+    //       x---------x
+    //       |         |
+    //       |    o    |
+    //       |         |
+    //       x---------x
+    // (vjb, hja)   (vjb, hjb)
+    // where o: is the range to be interpolated
+    //       x: ray sample
+    //       vja: is the previous index of ray in vertical direction
+    //       vjb: is the next index of ray in vertical direction
+    //       hja: is the previous index of ray in horizontal direction
+    //       hjb: is the next index of ray in horizontal direction
+    for (unsigned int j = 0; j < verticalRangeCount; ++j)
     {
-      vb = (verticalRangeCount == 1) ? 0 :
+      double vb = (verticalRangeCount == 1) ? 0 :
           static_cast<double>(j * (verticalRayCount - 1))
           / (verticalRangeCount - 1);
-      vja = static_cast<int>(floor(vb));
-      vjb = std::min(vja + 1, verticalRayCount - 1);
+      unsigned int vja = static_cast<int>(floor(vb));
+      unsigned int vjb = std::min(vja + 1, verticalRayCount - 1);
       vb = vb - floor(vb);
 
       GZ_ASSERT(vja < verticalRayCount,
           "Invalid vertical ray index used for interpolation");
       GZ_ASSERT(vjb < verticalRayCount,
           "Invalid vertical ray index used for interpolation");
-    }
-    // interpolate in horizontal direction
-    for (unsigned int i = 0; i < rangeCount; ++i)
-    {
-      double range, intensity;
-      if (interp)
+
+      for (unsigned int i = 0; i < rangeCount; ++i)
       {
-        hb = (rangeCount == 1)? 0 : static_cast<double>(i * (rayCount - 1))
-            / (rangeCount - 1);
-        hja = static_cast<int>(floor(hb));
-        hjb = std::min(hja + 1, rayCount - 1);
+        double hb = (rangeCount == 1)? 0 :
+            static_cast<double>(i * (rayCount - 1)) / (rangeCount - 1);
+        unsigned int hja = static_cast<int>(floor(hb));
+        unsigned int hjb = std::min(hja + 1, rayCount - 1);
         hb = hb - floor(hb);
 
         GZ_ASSERT(hja < rayCount,
@@ -448,52 +468,165 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
             "Invalid horizontal ray index used for interpolation");
 
         // indices of 4 corners
-        j1 = hja + vja * rayCount;
-        j2 = hjb + vja * rayCount;
-        j3 = hja + vjb * rayCount;
-        j4 = hjb + vjb * rayCount;
-
-        // range readings of 4 corners
-        r1 = this->LaserShape()->GetRange(j1);
-        r2 = this->LaserShape()->GetRange(j2);
-        r3 = this->LaserShape()->GetRange(j3);
-        r4 = this->LaserShape()->GetRange(j4);
-        range = (1-vb)*((1 - hb) * r1 + hb * r2)
-            + vb *((1 - hb) * r3 + hb * r4);
-
-        // intensity is averaged
-        intensity = 0.25 * (this->LaserShape()->GetRetro(j1)
-            + this->LaserShape()->GetRetro(j2)
-            + this->LaserShape()->GetRetro(j3)
-            + this->LaserShape()->GetRetro(j4));
-      }
-      else
-      {
-        range = this->dataPtr->laserShape->GetRange(j * this->RayCount() + i);
-        intensity = this->dataPtr->laserShape->GetRetro(j *
-            this->RayCount() + i);
+        this->dataPtr->interpIndices.push_back(hja + vja * rayCount);
+        this->dataPtr->interpIndices.push_back(hjb + vja * rayCount);
+        this->dataPtr->interpIndices.push_back(hja + vjb * rayCount);
+        this->dataPtr->interpIndices.push_back(hjb + vjb * rayCount);
+        this->dataPtr->interpHorizontal.push_back(hb);
+        this->dataPtr->interpVertical.push_back(vb);
       }
+    }
+  }
 
-      // Mask ranges outside of min/max to +/- inf, as per REP 117
-      if (range >= this->RangeMax())
-      {
+  // The remaining fields of the scan only change with the resolution
+  msgs::LaserScan *scan = this->dataPtr->laserMsg.mutable_scan();
+  scan->set_angle_min(this->AngleMin().Radian());
+  scan->set_angle_max(this->AngleMax().Radian());
+  scan->set_angle_step(this->AngleResolution());
+  scan->set_count(rangeCount);
+
+  scan->set_vertical_angle_min(this->VerticalAngleMin().Radian());
+  scan->set_vertical_angle_max(this->VerticalAngleMax().Radian());
+  scan->set_vertical_angle_step(this->VerticalAngleResolution());
+  scan->set_vertical_count(verticalRangeCount);
+
+  scan->set_range_min(this->RangeMin());
+  scan->set_range_max(this->RangeMax());
+}
+
+//////////////////////////////////////////////////
+bool RaySensor::UpdateImpl(const bool /*_force*/)
+{
+  // do the collision checks
+  // this eventually call OnNewScans, so move mutex lock behind it in case
+  // need to move mutex lock after this? or make the OnNewLaserScan connection
+  // call somewhere else?
+  this->dataPtr->laserShape->Update();
+  this->lastMeasurementTime = this->world->SimTime();
+
+  // moving this behind laserShape update
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  msgs::Set(this->dataPtr->laserMsg.mutable_time(),
+            this->lastMeasurementTime);
+
+  msgs::LaserScan *scan = this->dataPtr->laserMsg.mutable_scan();
+
+  // Store the latest laser scans into laserMsg
+  msgs::Set(scan->mutable_world_pose(),
+      this->pose + this->dataPtr->parentEntity->WorldPose());
+
+  this->UpdateInterpolationTable();
+
+  const unsigned int count =
+    this->dataPtr->tableRangeCount * this->dataPtr->tableVerticalRangeCount;
+
+  // Results of all the rays, computed in one batch by the shape update
+  const std::vector<double> &ranges = this->dataPtr->laserShape->Ranges();
+  const std::vector<double> &retros = this->dataPtr->laserShape->Retros();
+  GZ_ASSERT(ranges.size() == static_cast<size_t>(
+        this->dataPtr->tableRayCount * this->dataPtr->tableVerticalRayCount),
+      "Laser shape has an unexpected number of rays");
+
+  // Write the results straight into the message, or into scratch buffers
+  // when they are converted to a packed float payload afterwards.
+  double *outRanges;
+  double *outIntensities;
+  if (this->dataPtr->packedFloatPayload)
+  {
+    this->dataPtr->rangeBuffer.resize(count);
+    this->dataPtr->intensityBuffer.resize(count);
+    outRanges = this->dataPtr->rangeBuffer.data();
+    outIntensities = this->dataPtr->intensityBuffer.data();
+  }
+  else
+  {
+    scan->mutable_ranges()->Resize(count, 0.0);
+    scan->mutable_intensities()->Resize(count, 0.0);
+    outRanges = scan->mutable_ranges()->mutable_data();
+    outIntensities = scan->mutable_intensities()->mutable_data();
+  }
+
+  if (this->dataPtr->interpolate)
+  {
+    const unsigned int *idx = this->dataPtr->interpIndices.data();
+    const double *hb = this->dataPtr->interpHorizontal.data();
+    const double *vb = this->dataPtr->interpVertical.data();
+    const double *r = ranges.data();
+    const double *retro = retros.data();
+
+    for (unsigned int k = 0; k < count; ++k, idx += 4)
+    {
+      outRanges[k] = (1 - vb[k]) * ((1 - hb[k]) * r[idx[0]] + hb[k] * r[idx[1]])
+          + vb[k] * ((1 - hb[k]) * r[idx[2]] + hb[k] * r[idx[3]]);
+
+      // intensity is averaged
+      outIntensities[k] = 0.25 *
+          (retro[idx[0]] + retro[idx[1]] + retro[idx[2]] + retro[idx[3]]);
+    }
+  }
+  else
+  {
+    std::copy(ranges.begin(), ranges.begin() + count, outRanges);
+    std::copy(retros.begin(), retros.begin() + count, outIntensities);
+  }
+
+  // Mask ranges outside of min/max to +/- inf, as per REP 117
+  const double rangeMin = this->RangeMin();
+  const double rangeMax = this->RangeMax();
+  auto noiseIter = this->noises.find(RAY_NOISE);
+  if (noiseIter == this->noises.end())
+  {
+    for (unsigned int k = 0; k < count; ++k)
+    {
+      double range = outRanges[k];
+      outRanges[k] = range >= rangeMax ? ignition::math::INF_D :
+          (range <= rangeMin ? -ignition::math::INF_D : range);
+    }
+  }
+  else
+  {
+    // currently supports only one noise model per laser sensor.
+    // Gather the in range values so that noise is applied to them in one
+    // batch, then scatter the clamped results back.
+    auto &values = this->dataPtr->noiseBuffer;
+    auto &indices = this->dataPtr->noiseIndices;
+    values.clear();
+    indices.clear();
+    for (unsigned int k = 0; k < count; ++k)
+    {
+      double &range = outRanges[k];
+      if (range >= rangeMax)
         range = ignition::math::INF_D;
-      }
-      else if (range <= this->RangeMin())
-      {
+      else if (range <= rangeMin)
         range = -ignition::math::INF_D;
-      }
-      else if (this->noises.find(RAY_NOISE) !=
-               this->noises.end())
+      else
       {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
+        values.push_back(range);
+        indices.push_back(k);
       }
+    }
+
+    noiseIter->second->Apply(values.data(), values.size());
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      outRanges[indices[i]] =
+          ignition::math::clamp(values[i], rangeMin, rangeMax);
+    }
+  }
 
-      scan->add_ranges(range);
-      scan->add_intensities(intensity);
+  if (this->dataPtr->packedFloatPayload)
+  {
+    scan->mutable_packed_ranges()->Resize(count, 0.0f);
+    scan->mutable_packed_intensities()->Resize(count, 0.0f);
+    float *packedRanges = scan->mutable_packed_ranges()->mutable_data();
+    float *packedIntensities =
+      scan->mutable_packed_intensities()->mutable_data();
+    for (unsigned int k = 0; k < count; ++k)
+    {
+      packedRanges[k] = static_cast<float>(outRanges[k]);
+      packedIntensities[k] = static_cast<float>(outIntensities[k]);
     }
   }
 
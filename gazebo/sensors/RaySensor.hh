@@ -160,6 +160,20 @@ namespace gazebo
       /// \return Fiducial value
       public: int Fiducial(const unsigned int _index) const;
 
+      /// \brief Fill the scan message with single precision floats, in the
+      /// packed_ranges and packed_intensities fields, instead of doubles in
+      /// the ranges and intensities fields. This halves the size of the
+      /// published scans. Subscribers must read the packed fields.
+      /// \param[in] _packed True to publish packed floats.
+      /// \sa PackedFloatPayload
+      public: void SetPackedFloatPayload(const bool _packed);
+
+      /// \brief Get whether the scan message is filled with single
+      /// precision floats.
+      /// \return True if packed floats are published.
+      /// \sa SetPackedFloatPayload
+      public: bool PackedFloatPayload() const;
+
       /// \brief Returns a pointer to the internal physics::MultiRayShape
       /// \return Pointer to ray shape
       public: physics::MultiRayShapePtr LaserShape() const;
@@ -167,6 +181,12 @@ namespace gazebo
       // Documentation inherited
       public: virtual bool IsActive() const;
 
+      /// \brief Rebuild the table of ray samples and weights used to
+      /// interpolate ranges, and the fixed fields of the scan message, if
+      /// the scan resolution changed since the last update. The caller must
+      /// hold the laser message mutex.
+      private: void UpdateInterpolationTable();
+
       /// \internal
       /// \brief Private data pointer.
       private: std::unique_ptr<RaySensorPrivate> dataPtr;
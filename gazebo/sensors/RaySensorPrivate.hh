@@ -18,6 +18,7 @@
 #define _GAZEBO_SENSORS_RAYSENSOR_PRIVATE_HH_
 
 #include <mutex>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -48,6 +49,47 @@ namespace gazebo
 
       /// \brief Laser message.
       public: msgs::LaserScanStamped laserMsg;
+
+      /// \brief True to fill the packed float fields of the scan message
+      /// instead of the double ones.
+      public: bool packedFloatPayload = false;
+
+      /// \brief Horizontal ray count the interpolation table was built for.
+      public: unsigned int tableRayCount = 0;
+
+      /// \brief Horizontal range count the interpolation table was built for.
+      public: unsigned int tableRangeCount = 0;
+
+      /// \brief Vertical ray count the interpolation table was built for.
+      public: unsigned int tableVerticalRayCount = 0;
+
+      /// \brief Vertical range count the interpolation table was built for.
+      public: unsigned int tableVerticalRangeCount = 0;
+
+      /// \brief True if ranges are interpolated from the ray samples,
+      /// false if there is one range per ray.
+      public: bool interpolate = false;
+
+      /// \brief Indices of the four ray samples bounding each range.
+      public: std::vector<unsigned int> interpIndices;
+
+      /// \brief Horizontal interpolation factor of each range.
+      public: std::vector<double> interpHorizontal;
+
+      /// \brief Vertical interpolation factor of each range.
+      public: std::vector<double> interpVertical;
+
+      /// \brief Ranges of the last scan, used to build packed payloads.
+      public: std::vector<double> rangeBuffer;
+
+      /// \brief Intensities of the last scan, used to build packed payloads.
+      public: std::vector<double> intensityBuffer;
+
+      /// \brief In range values of the last scan, gathered for batch noise.
+      public: std::vector<double> noiseBuffer;
+
+      /// \brief Scan index of each value in noiseBuffer.
+      public: std::vector<unsigned int> noiseIndices;
     };
   }
 }
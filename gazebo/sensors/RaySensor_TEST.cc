@@ -15,6 +15,8 @@
  *
 */
 
+#include <cmath>
+
 #include <gtest/gtest.h>
 #include <ignition/math/Helpers.hh>
 #include <sdf/sdf.hh>
@@ -198,6 +200,68 @@ TEST_F(RaySensor_TEST, LaserScanResolution)
   }
 }
 
+/////////////////////////////////////////////////
+/// \brief Test the packed float payload of an interpolated scan
+TEST_F(RaySensor_TEST, PackedFloatPayload)
+{
+  Load("worlds/empty.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  // Box in front of the sensor so that some of the ranges are finite
+  SpawnBox("box", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(2, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+
+  sdf::ElementPtr sdf(new sdf::Element);
+  sdf::initFile("sensor.sdf", sdf);
+  sdf::readString(raySensorScanResString, sdf);
+
+  std::string sensorName = mgr->CreateSensor(sdf, "default",
+      "ground_plane::link", 0);
+  mgr->Update();
+
+  sensors::RaySensorPtr sensor = std::dynamic_pointer_cast<sensors::RaySensor>
+    (mgr->GetSensor(sensorName));
+  ASSERT_TRUE(sensor != nullptr);
+  EXPECT_FALSE(sensor->PackedFloatPayload());
+
+  sensor->Update(true);
+  std::vector<double> ranges;
+  sensor->Ranges(ranges);
+  ASSERT_EQ(ranges.size(), static_cast<size_t>(240 * 6));
+
+  std::vector<double> retros;
+  for (unsigned int i = 0; i < ranges.size(); ++i)
+    retros.push_back(sensor->Retro(i));
+
+  sensor->SetPackedFloatPayload(true);
+  EXPECT_TRUE(sensor->PackedFloatPayload());
+  sensor->Update(true);
+
+  std::vector<double> packedRanges;
+  sensor->Ranges(packedRanges);
+  ASSERT_EQ(packedRanges.size(), ranges.size());
+
+  bool finite = false;
+  for (unsigned int i = 0; i < ranges.size(); ++i)
+  {
+    finite = finite || std::isfinite(ranges[i]);
+    EXPECT_FLOAT_EQ(packedRanges[i], static_cast<float>(ranges[i]));
+    EXPECT_DOUBLE_EQ(sensor->Range(i), packedRanges[i]);
+    EXPECT_FLOAT_EQ(sensor->Retro(i), static_cast<float>(retros[i]));
+  }
+  EXPECT_TRUE(finite);
+
+  // Switching back fills the double fields again
+  sensor->SetPackedFloatPayload(false);
+  sensor->Update(true);
+  std::vector<double> newRanges;
+  sensor->Ranges(newRanges);
+  ASSERT_EQ(newRanges.size(), ranges.size());
+  for (unsigned int i = 0; i < ranges.size(); ++i)
+    EXPECT_DOUBLE_EQ(newRanges[i], ranges[i]);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
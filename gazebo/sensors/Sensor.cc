@@ -336,7 +336,12 @@ void Sensor::LoadPlugin(sdf::ElementPtr _sdf)
 //////////////////////////////////////////////////
 void Sensor::SetActive(const bool _value)
 {
+  const bool activated = _value && !this->active;
   this->active = _value;
+
+  // The sensor threads only poll inactive sensors at their update rate
+  if (activated)
+    SensorManager::Instance()->WakeSensorThreads();
 }
 
 //////////////////////////////////////////////////
@@ -401,6 +406,48 @@ common::Time Sensor::LastMeasurementTime() const
   return this->lastMeasurementTime;
 }
 
+//////////////////////////////////////////////////
+common::Time Sensor::NextUpdateTime() const
+{
+  // Matches the elapsed time check in Sensor::Update
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  return this->lastUpdateTime + this->updatePeriod - this->dataPtr->updateDelay;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::SupportsUpdateInStep() const
+{
+  return this->dataPtr->supportsUpdateInStep;
+}
+
+//////////////////////////////////////////////////
+void Sensor::SetSupportsUpdateInStep(const bool _value)
+{
+  this->dataPtr->supportsUpdateInStep = _value;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::SetUpdateInStep(const bool _value)
+{
+  if (_value && !this->SupportsUpdateInStep())
+  {
+    gzerr << "Sensor [" << this->ScopedName() << "] of type ["
+          << this->Type() << "] can't be updated in step\n";
+    return false;
+  }
+
+  // The sensor threads schedule only the sensors not updated in step
+  if (this->dataPtr->updateInStep.exchange(_value) != _value)
+    SensorManager::Instance()->WakeSensorThreads();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::UpdateInStep() const
+{
+  return this->dataPtr->updateInStep;
+}
+
 //////////////////////////////////////////////////
 std::string Sensor::Type() const
 {
@@ -185,6 +185,31 @@ namespace gazebo
       /// \return the timestamp
       public: virtual double NextRequiredTimestamp() const;
 
+      /// \brief Get the simulation time from which the next call to
+      /// Update(false) will update the sensor, given its update rate and
+      /// the delay accumulated by previous updates.
+      /// \return Time of the next update.
+      public: common::Time NextUpdateTime() const;
+
+      /// \brief Get whether the sensor can be updated in step, see
+      /// SetUpdateInStep.
+      /// \return True if the sensor supports in step updates.
+      public: bool SupportsUpdateInStep() const;
+
+      /// \brief Set whether the sensor is updated by the physics thread
+      /// right after each physics step, instead of by the sensor manager's
+      /// threads. This only suits sensors that are cheap to update, and
+      /// gives them samples at the exact step times up to the physics rate.
+      /// The sensor's update rate still applies.
+      /// \param[in] _value True to update the sensor in step.
+      /// \return False if the sensor does not support in step updates.
+      /// \sa SupportsUpdateInStep
+      public: bool SetUpdateInStep(const bool _value);
+
+      /// \brief Get whether the sensor is updated in step.
+      /// \return True if the sensor is updated by the physics thread.
+      public: bool UpdateInStep() const;
+
       /// \brief This gets overwritten by derived sensor types.
       ///        This function is called during Sensor::Update.
       ///        And in turn, Sensor::Update is called by
@@ -197,6 +222,12 @@ namespace gazebo
       /// \return True when sensor should be updated.
       protected: virtual bool NeedsUpdate();
 
+      /// \brief Set whether the sensor can be updated in step. Called by
+      /// the constructors of the sensor types that support it.
+      /// \param[in] _value True if the sensor supports in step updates.
+      /// \sa SetUpdateInStep
+      protected: void SetSupportsUpdateInStep(const bool _value);
+
       /// \brief Load a plugin for this sensor.
       /// \param[in] _sdf SDF parameters.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
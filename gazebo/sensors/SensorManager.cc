@@ -14,7 +14,16 @@
  * limitations under the License.
  *
 */
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <boost/bind.hpp>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Time.hh"
@@ -26,6 +35,7 @@
 #include "gazebo/sensors/SensorsIface.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/SensorManager.hh"
+#include "gazebo/sensors/SensorManagerPrivate.hh"
 #include "gazebo/util/LogPlay.hh"
 
 using namespace gazebo;
@@ -35,6 +45,55 @@ using namespace sensors;
 /// for timing coordination.
 boost::mutex g_sensorTimingMutex;
 
+/// \brief Ordering of the sensor schedule heap, earliest due time first.
+/// \param[in] _a First schedule entry.
+/// \param[in] _b Second schedule entry.
+/// \return True if _a is due after _b.
+static bool dueLater(const std::pair<common::Time, SensorPtr> &_a,
+    const std::pair<common::Time, SensorPtr> &_b)
+{
+  return _a.first > _b.first;
+}
+
+/// \brief Private data of the SensorManager and of its sensor containers,
+/// indexed by object. Kept out of the classes to preserve their layout.
+static std::unordered_map<const void *, std::shared_ptr<void>> g_privateData;
+
+/// \brief Protects g_privateData.
+static std::mutex g_privateDataMutex;
+
+/// \brief Create the private data of an object.
+/// \param[in] _object The SensorManager or sensor container.
+template<typename T>
+static void CreatePrivateData(const void *_object)
+{
+  std::lock_guard<std::mutex> lock(g_privateDataMutex);
+  g_privateData[_object] = std::make_shared<T>();
+}
+
+/// \brief Get the private data of an object. The data lives until the
+/// object is destroyed.
+/// \param[in] _object The SensorManager or sensor container.
+/// \return The private data.
+template<typename T>
+static T &PrivateData(const void *_object)
+{
+  std::lock_guard<std::mutex> lock(g_privateDataMutex);
+  return *std::static_pointer_cast<T>(g_privateData.at(_object));
+}
+
+/// \brief Destroy the private data of an object.
+/// \param[in] _object The SensorManager or sensor container.
+static void DestroyPrivateData(const void *_object)
+{
+  std::lock_guard<std::mutex> lock(g_privateDataMutex);
+  g_privateData.erase(_object);
+}
+
+/// \brief Name of the world that the calling thread is updating. The world
+/// update events are global, and each world updates on its own thread.
+static thread_local std::string t_stepWorld;
+
 //////////////////////////////////////////////////
 SensorManager::SensorManager()
   : initialized(false), removeAllSensors(false)
@@ -47,12 +106,24 @@ SensorManager::SensorManager()
 
   // sensors::OTHER container
   this->sensorContainers.push_back(new SensorContainer());
+
+  CreatePrivateData<SensorManagerPrivate>(this);
+
+  const char *parallel = getenv("GAZEBO_SENSOR_PARALLEL_UPDATES");
+  this->SetParallelUpdates(parallel && std::string(parallel) == "1");
 }
 
 //////////////////////////////////////////////////
 SensorManager::~SensorManager()
 {
   sensors::disable();
+  {
+    SensorManagerPrivate &data = PrivateData<SensorManagerPrivate>(this);
+    data.worldUpdateBeginConnection.reset();
+    data.worldUpdateEndConnection.reset();
+    data.stepSensors.clear();
+  }
+
   // Clean up the sensors.
   for (SensorContainer_V::iterator iter = this->sensorContainers.begin();
        iter != this->sensorContainers.end(); ++iter)
@@ -65,6 +136,8 @@ SensorManager::~SensorManager()
   this->sensorContainers.clear();
 
   this->initSensors.clear();
+
+  DestroyPrivateData(this);
 }
 
 //////////////////////////////////////////////////
@@ -134,6 +207,7 @@ void SensorManager::Update(bool _force)
 
         sensor->Init();
         this->sensorContainers[sensor->Category()]->AddSensor(sensor);
+        this->AddStepSensor(sensor);
       }
       this->initSensors.clear();
       for (auto &worldName_worldPtr : this->worlds)
@@ -145,6 +219,18 @@ void SensorManager::Update(bool _force)
     {
       GZ_ASSERT(!(*iter).empty(), "Remove sensor name is empty.");
 
+      // Stop the in step updates before the sensor is finalized
+      {
+        SensorManagerPrivate &data = PrivateData<SensorManagerPrivate>(this);
+        std::lock_guard<std::mutex> stepLock(data.stepMutex);
+        const std::string &name = *iter;
+        data.stepSensors.erase(std::remove_if(data.stepSensors.begin(),
+            data.stepSensors.end(), [&name](const SensorPtr &_sensor)
+            {
+              return _sensor->ScopedName() == name;
+            }), data.stepSensors.end());
+      }
+
       bool removed = false;
       for (SensorContainer_V::iterator iter2 = this->sensorContainers.begin();
            iter2 != this->sensorContainers.end() && !removed; ++iter2)
@@ -165,6 +251,12 @@ void SensorManager::Update(bool _force)
 
     if (this->removeAllSensors)
     {
+      {
+        SensorManagerPrivate &data = PrivateData<SensorManagerPrivate>(this);
+        std::lock_guard<std::mutex> stepLock(data.stepMutex);
+        data.stepSensors.clear();
+      }
+
       for (SensorContainer_V::iterator iter2 = this->sensorContainers.begin();
           iter2 != this->sensorContainers.end(); ++iter2)
       {
@@ -185,6 +277,36 @@ void SensorManager::Update(bool _force)
     this->sensorContainers[sensors::IMAGE]->Update(_force);
 }
 
+//////////////////////////////////////////////////
+void SensorManager::OnWorldUpdateBegin(const common::UpdateInfo &_info)
+{
+  t_stepWorld = _info.worldName;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::UpdateInStep()
+{
+  SensorManagerPrivate &data = PrivateData<SensorManagerPrivate>(this);
+  std::lock_guard<std::mutex> lock(data.stepMutex);
+  for (auto &sensor : data.stepSensors)
+  {
+    // Only the sensors of the world that just stepped
+    if (sensor->UpdateInStep() && sensor->WorldName() == t_stepWorld)
+      sensor->Update(false);
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorManager::AddStepSensor(SensorPtr _sensor)
+{
+  if (!_sensor->SupportsUpdateInStep())
+    return;
+
+  SensorManagerPrivate &data = PrivateData<SensorManagerPrivate>(this);
+  std::lock_guard<std::mutex> lock(data.stepMutex);
+  data.stepSensors.push_back(_sensor);
+}
+
 //////////////////////////////////////////////////
 bool SensorManager::SensorsInitialized()
 {
@@ -205,6 +327,42 @@ void SensorManager::ResetLastUpdateTimes()
   }
 }
 
+//////////////////////////////////////////////////
+bool SensorManager::UpdateStatistics(const std::string &_name,
+    SensorUpdateStatistics &_stats) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  for (auto const &container : this->sensorContainers)
+  {
+    GZ_ASSERT(container != nullptr, "SensorContainer is null");
+    if (container->Statistics(_name, _stats))
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SetParallelUpdates(const bool _parallel)
+{
+  PrivateData<SensorManagerPrivate>(this).parallelUpdates = _parallel;
+}
+
+//////////////////////////////////////////////////
+bool SensorManager::ParallelUpdates() const
+{
+  return PrivateData<SensorManagerPrivate>(this).parallelUpdates;
+}
+
+//////////////////////////////////////////////////
+void SensorManager::WakeSensorThreads()
+{
+  for (auto &container : this->sensorContainers)
+  {
+    GZ_ASSERT(container != nullptr, "SensorContainer is null");
+    container->Wake();
+  }
+}
+
 //////////////////////////////////////////////////
 void SensorManager::Init()
 {
@@ -228,6 +386,14 @@ void SensorManager::Init()
   this->removeSensorConnection = event::Events::ConnectRemoveSensor(
       std::bind(&SensorManager::RemoveSensor, this, std::placeholders::_1));
 
+  // Connect to the world update for the in step sensors.
+  SensorManagerPrivate &data = PrivateData<SensorManagerPrivate>(this);
+  data.worldUpdateBeginConnection = event::Events::ConnectWorldUpdateBegin(
+      std::bind(&SensorManager::OnWorldUpdateBegin, this,
+        std::placeholders::_1));
+  data.worldUpdateEndConnection = event::Events::ConnectWorldUpdateEnd(
+      std::bind(&SensorManager::UpdateInStep, this));
+
   // Connect to the create sensor event.
   this->createSensorConnection = event::Events::ConnectCreateSensor(
       std::bind(&SensorManager::OnCreateSensor, this,
@@ -242,6 +408,14 @@ void SensorManager::Fini()
 {
   boost::recursive_mutex::scoped_lock lock(this->mutex);
 
+  SensorManagerPrivate &data = PrivateData<SensorManagerPrivate>(this);
+  data.worldUpdateBeginConnection.reset();
+  data.worldUpdateEndConnection.reset();
+  {
+    std::lock_guard<std::mutex> stepLock(data.stepMutex);
+    data.stepSensors.clear();
+  }
+
   // Finalize all the sensor containers.
   for (SensorContainer_V::iterator iter = this->sensorContainers.begin();
        iter != this->sensorContainers.end(); ++iter)
@@ -304,6 +478,7 @@ std::string SensorManager::CreateSensor(sdf::ElementPtr _elem,
   if (!this->initialized)
   {
     this->sensorContainers[sensor->Category()]->AddSensor(sensor);
+    this->AddStepSensor(sensor);
   }
   // Otherwise the SensorManager is already running, and the sensor will get
   // initialized during the next SensorManager::Update call.
@@ -419,12 +594,14 @@ SensorManager::SensorContainer::SensorContainer()
   this->stop = true;
   this->initialized = false;
   this->runThread = nullptr;
+  CreatePrivateData<SensorContainerPrivate>(this);
 }
 
 //////////////////////////////////////////////////
 SensorManager::SensorContainer::~SensorContainer()
 {
   this->sensors.clear();
+  DestroyPrivateData(this);
 }
 
 //////////////////////////////////////////////////
@@ -458,6 +635,11 @@ void SensorManager::SensorContainer::Fini()
   // Remove all the sensors from the current sensor vector.
   this->sensors.clear();
 
+  SensorContainerPrivate &data = PrivateData<SensorContainerPrivate>(this);
+  data.schedule.clear();
+  data.scheduleDirty = true;
+  data.statistics.clear();
+
   this->initialized = false;
 }
 
@@ -510,42 +692,19 @@ void SensorManager::SensorContainer::RunLoop()
   // large step size.
   double maxSensorUpdate = engine->GetMaxStepSize() * 1000;
 
+  SensorContainerPrivate &data = PrivateData<SensorContainerPrivate>(this);
+
+  // A sensor is never scheduled twice in the same physics step
+  data.minUpdatePeriod = engine->GetMaxStepSize();
+
   // Release engine pointer, we don't need it in the loop
   engine.reset();
 
-  common::Time sleepTime, startTime, eventTime, diffTime;
-  double maxUpdateRate = 0;
+  common::Time startTime, eventTime, diffTime, nextTime;
 
   boost::mutex tmpMutex;
   boost::mutex::scoped_lock lock2(tmpMutex);
 
-  // Wait for a sensor to be added.
-  // Use a while loop since world resets will notify the runCondition.
-  while (this->sensors.empty())
-  {
-    this->runCondition.wait(lock2);
-    if (this->stop)
-      return;
-  }
-
-  {
-    boost::recursive_mutex::scoped_lock lock(this->mutex);
-
-    // Get the minimum update rate from the sensors.
-    for (Sensor_V::iterator iter = this->sensors.begin();
-        iter != this->sensors.end() && !this->stop; ++iter)
-    {
-      GZ_ASSERT((*iter) != nullptr, "Sensor is null");
-      maxUpdateRate = std::max((*iter)->UpdateRate(), maxUpdateRate);
-    }
-  }
-
-  // Calculate an appropriate sleep time.
-  if (maxUpdateRate > 0)
-    sleepTime.Set(1.0 / (maxUpdateRate));
-  else
-    sleepTime.Set(0, 1e6);
-
   while (!this->stop)
   {
     // If all the sensors get deleted, wait here.
@@ -560,16 +719,14 @@ void SensorManager::SensorContainer::RunLoop()
     // Get the start time of the update.
     startTime = world->SimTime();
 
-    this->Update(false);
+    // Update the sensors that are due, and find when the next one is.
+    nextTime = this->UpdateDueSensors(startTime);
 
     // Compute the time it took to update the sensors.
     // It's possible that the world time was reset during the Update. This
     // would case a negative diffTime. Instead, just use a event time of zero
     diffTime = std::max(common::Time::Zero, world->SimTime() - startTime);
 
-    // Set the default sleep time
-    eventTime = std::max(common::Time::Zero, sleepTime - diffTime);
-
     // Make sure update time is reasonable.
     // During log playback, time can jump forward an arbitrary amount.
     if (diffTime.sec >= maxSensorUpdate && !util::LogPlay::Instance()->IsOpen())
@@ -580,12 +737,9 @@ void SensorManager::SensorContainer::RunLoop()
         << "This warning can be ignored during log playback" << std::endl;
     }
 
-    // Make sure eventTime is not negative.
-    if (eventTime < common::Time::Zero)
-    {
-      gzerr << "Time to next sensor update is negative." << std::endl;
-      continue;
-    }
+    // Sleep until the next sensor is due. An event time of zero wakes the
+    // loop up at the next world update.
+    eventTime = std::max(common::Time::Zero, nextTime - world->SimTime());
 
     boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
 
@@ -595,13 +749,151 @@ void SensorManager::SensorContainer::RunLoop()
         eventTime, &this->runCondition);
 
     // This if statement helps prevent deadlock on osx during teardown.
-    if (!this->stop)
+    // A sensor activated since the update is scheduled right away.
+    if (!this->stop && !data.wakeRequested)
     {
       this->runCondition.wait(timingLock);
     }
   }
 }
 
+//////////////////////////////////////////////////
+common::Time SensorManager::SensorContainer::DueTime(SensorPtr _sensor,
+    const common::Time &_simTime) const
+{
+  common::Time due;
+
+  // Sensors that need a specific timestamp take precedence over their
+  // update rate.
+  double required = _sensor->NextRequiredTimestamp();
+  if (!std::isnan(required))
+    due = required;
+  else
+    due = _sensor->NextUpdateTime();
+
+  // Inactive sensors are polled once per update period, in case they get
+  // activated.
+  if (!_sensor->IsActive())
+  {
+    due = _simTime + std::max(
+        PrivateData<SensorContainerPrivate>(this).minUpdatePeriod,
+        common::Time(1.0 / std::max(_sensor->UpdateRate(), 1.0)));
+  }
+
+  return due;
+}
+
+//////////////////////////////////////////////////
+common::Time SensorManager::SensorContainer::UpdateDueSensors(
+    const common::Time &_simTime)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  SensorContainerPrivate &data = PrivateData<SensorContainerPrivate>(this);
+
+  // Rebuild the schedule when sensors are added or removed, and when time
+  // goes backwards after a world reset or a log seek.
+  if (data.wakeRequested.exchange(false) || data.scheduleDirty ||
+      _simTime < data.scheduleTime)
+  {
+    data.schedule.clear();
+    for (auto &sensor : this->sensors)
+    {
+      GZ_ASSERT(sensor != nullptr, "Sensor is null");
+
+      // Updated by the physics thread instead
+      if (sensor->UpdateInStep())
+        continue;
+
+      data.schedule.push_back(
+          std::make_pair(this->DueTime(sensor, _simTime), sensor));
+    }
+    std::make_heap(data.schedule.begin(), data.schedule.end(), dueLater);
+    data.scheduleDirty = false;
+  }
+  data.scheduleTime = _simTime;
+
+  // Pop the sensors that are due
+  std::vector<std::pair<common::Time, SensorPtr>> due;
+  while (!data.schedule.empty() && data.schedule.front().first <= _simTime)
+  {
+    std::pop_heap(data.schedule.begin(), data.schedule.end(), dueLater);
+    // Drop the sensors switched to in step updates since the last rebuild
+    if (!data.schedule.back().second->UpdateInStep())
+      due.push_back(data.schedule.back());
+    data.schedule.pop_back();
+  }
+
+  // Create the statistics before the parallel updates, so that each update
+  // only writes to its own entry.
+  std::vector<SensorUpdateStatistics *> stats;
+  for (auto &entry : due)
+    stats.push_back(&data.statistics[entry.second->ScopedName()]);
+
+  // Physics engines keep per thread collision data, so each update
+  // initializes the engine of the sensor's world for its thread.
+  std::vector<physics::PhysicsEnginePtr> engines(due.size());
+  for (size_t i = 0; i < due.size(); ++i)
+  {
+    const std::string worldName = due[i].second->WorldName();
+    if (physics::has_world(worldName))
+      engines[i] = physics::get_world(worldName)->Physics();
+  }
+
+  auto update = [&](const size_t _i)
+      {
+        const SensorPtr &sensor = due[_i].second;
+
+        if (engines[_i])
+          engines[_i]->InitForThread();
+
+        common::Time lastUpdate = sensor->LastUpdateTime();
+        common::Time start = common::Time::GetWallTime();
+
+        sensor->Update(false);
+
+        // Only count the calls that produced a new measurement
+        if (sensor->LastUpdateTime() == lastUpdate)
+          return;
+
+        common::Time latency = common::Time::GetWallTime() - start;
+        SensorUpdateStatistics *stat = stats[_i];
+        stat->updateCount++;
+        stat->lastLatency = latency;
+        stat->maxLatency = std::max(stat->maxLatency, latency);
+        stat->totalLatency += latency;
+
+        double period = sensor->UpdateRate() > 0 ?
+            1.0 / sensor->UpdateRate() : 0.0;
+        if (period > 0 && (_simTime - due[_i].first).Double() >= period)
+          stat->missedDeadlines++;
+      };
+
+  // Sensors and their plugins are not all safe to update concurrently, so
+  // parallel updates are opt in.
+  if (SensorManager::Instance()->ParallelUpdates())
+  {
+    tbb::parallel_for(static_cast<size_t>(0), due.size(), update);
+  }
+  else
+  {
+    for (size_t i = 0; i < due.size(); ++i)
+      update(i);
+  }
+
+  // Reschedule the updated sensors, at least one step later
+  for (auto &entry : due)
+  {
+    entry.first = std::max(this->DueTime(entry.second, _simTime),
+        _simTime + data.minUpdatePeriod);
+    data.schedule.push_back(entry);
+    std::push_heap(data.schedule.begin(), data.schedule.end(), dueLater);
+  }
+
+  if (data.schedule.empty())
+    return _simTime + data.minUpdatePeriod;
+  return data.schedule.front().first;
+}
+
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::Update(bool _force)
 {
@@ -615,7 +907,8 @@ void SensorManager::SensorContainer::Update(bool _force)
        iter != this->sensors.end(); ++iter)
   {
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
-    (*iter)->Update(_force);
+    if (!(*iter)->UpdateInStep())
+      (*iter)->Update(_force);
   }
 }
 
@@ -654,6 +947,7 @@ void SensorManager::SensorContainer::AddSensor(SensorPtr _sensor)
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
     this->sensors.push_back(_sensor);
+    PrivateData<SensorContainerPrivate>(this).scheduleDirty = true;
   }
 
   // Tell the run loop that we have received a sensor
@@ -678,6 +972,11 @@ bool SensorManager::SensorContainer::RemoveSensor(const std::string &_name)
     {
       (*iter)->Fini();
       this->sensors.erase(iter);
+
+      SensorContainerPrivate &data =
+          PrivateData<SensorContainerPrivate>(this);
+      data.statistics.erase(_name);
+      data.scheduleDirty = true;
       removed = true;
       break;
     }
@@ -699,11 +998,23 @@ void SensorManager::SensorContainer::ResetLastUpdateTimes()
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
     (*iter)->ResetLastUpdateTime();
   }
+  PrivateData<SensorContainerPrivate>(this).scheduleDirty = true;
 
   // Tell the run loop that world time has been reset.
   this->runCondition.notify_one();
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::Wake()
+{
+  PrivateData<SensorContainerPrivate>(this).wakeRequested = true;
+
+  // The run loop holds the timing mutex from the time it schedules its
+  // wake up event until it waits, so the notification is not lost.
+  boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
+  this->runCondition.notify_all();
+}
+
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::RemoveSensors()
 {
@@ -719,6 +1030,27 @@ void SensorManager::SensorContainer::RemoveSensors()
   }
 
   this->sensors.clear();
+
+  SensorContainerPrivate &data = PrivateData<SensorContainerPrivate>(this);
+  data.schedule.clear();
+  data.scheduleDirty = true;
+  data.statistics.clear();
+}
+
+//////////////////////////////////////////////////
+bool SensorManager::SensorContainer::Statistics(const std::string &_name,
+    SensorUpdateStatistics &_stats) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  const SensorContainerPrivate &data =
+      PrivateData<SensorContainerPrivate>(this);
+  auto iter = data.statistics.find(_name);
+  if (iter == data.statistics.end())
+    return false;
+
+  _stats = iter->second;
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -18,6 +18,7 @@
 #define _GAZEBO_SENSORMANAGER_HH_
 
 #include <boost/thread.hpp>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <list>
@@ -28,6 +29,7 @@
 
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/common/SingletonT.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 #include "gazebo/util/system.hh"
@@ -87,6 +89,28 @@ namespace gazebo
 
     /// \addtogroup gazebo_sensors
     /// \{
+
+    /// \brief Update statistics of a sensor run by the sensor threads.
+    /// \sa SensorManager::UpdateStatistics
+    class GZ_SENSORS_VISIBLE SensorUpdateStatistics
+    {
+      /// \brief Number of updates of the sensor.
+      public: uint64_t updateCount = 0;
+
+      /// \brief Number of updates that started a full update period or
+      /// more after the simulation time they were due.
+      public: uint64_t missedDeadlines = 0;
+
+      /// \brief Wall clock duration of the last update.
+      public: common::Time lastLatency;
+
+      /// \brief Longest wall clock duration of an update.
+      public: common::Time maxLatency;
+
+      /// \brief Sum of the wall clock durations of all the updates.
+      public: common::Time totalLatency;
+    };
+
     /// \class SensorManager SensorManager.hh sensors/sensors.hh
     /// \brief Class to manage and update all sensors
     class GZ_SENSORS_VISIBLE SensorManager : public SingletonT<SensorManager>
@@ -173,10 +197,52 @@ namespace gazebo
       /// \brief Reset last update times in all sensors.
       public: void ResetLastUpdateTimes();
 
+      /// \brief Get the update statistics of a sensor. Statistics are
+      /// gathered for the sensors updated by the threads started with
+      /// RunThreads, not for image based sensors.
+      /// \param[in] _name Scoped name of the sensor.
+      /// \param[out] _stats Statistics of the sensor.
+      /// \return True if the sensor has been updated by a sensor thread.
+      public: bool UpdateStatistics(const std::string &_name,
+                  SensorUpdateStatistics &_stats) const;
+
+      /// \brief Set whether the sensor threads update the sensors that are
+      /// due at the same time in parallel. The default is serial updates,
+      /// unless the GAZEBO_SENSOR_PARALLEL_UPDATES environment variable is
+      /// set to 1. Only enable it when the sensors and their plugins are
+      /// safe to update concurrently.
+      /// \param[in] _parallel True to update the sensors in parallel.
+      public: void SetParallelUpdates(const bool _parallel);
+
+      /// \brief Get whether the sensor threads update the sensors in
+      /// parallel.
+      /// \return True if the sensors are updated in parallel.
+      /// \sa SetParallelUpdates
+      public: bool ParallelUpdates() const;
+
+      /// \brief Wake the sensor threads up so that they reschedule their
+      /// sensors. Called by Sensor::SetActive when a sensor is activated,
+      /// since inactive sensors are only polled at their update rate.
+      public: void WakeSensorThreads();
+
       /// \brief Add a new sensor to a sensor container.
       /// \param[in] _sensor Pointer to a sensor to add.
       private: void AddSensor(SensorPtr _sensor);
 
+      /// \brief Record which world the calling physics thread updates.
+      /// \param[in] _info World update information.
+      private: void OnWorldUpdateBegin(const common::UpdateInfo &_info);
+
+      /// \brief Update the sensors that are updated in step, see
+      /// Sensor::SetUpdateInStep. Called by the physics thread at the end of
+      /// every world update, only updates the sensors of that world.
+      private: void UpdateInStep();
+
+      /// \brief Add a sensor to the list of sensors that may be updated in
+      /// step, if it supports it.
+      /// \param[in] _sensor Sensor to add.
+      private: void AddStepSensor(SensorPtr _sensor);
+
       /// \cond
       /// \brief A container for sensors of a specific type. This is used to
       /// separate sensors which rely on the rendering engine from those
@@ -235,10 +301,39 @@ namespace gazebo
                  /// \brief Reset last update times in all sensors.
                  public: void ResetLastUpdateTimes();
 
+                 /// \brief Wake the run thread up and make it rebuild its
+                 /// schedule. Does not lock the sensors, so it may be
+                 /// called while they are updated.
+                 public: void Wake();
+
+                 /// \brief Get the update statistics of a sensor.
+                 /// \param[in] _name Scoped name of the sensor.
+                 /// \param[out] _stats Statistics of the sensor.
+                 /// \return True if statistics exist for the sensor.
+                 public: bool Statistics(const std::string &_name,
+                             SensorUpdateStatistics &_stats) const;
+
                  /// \brief A loop to update the sensor. Used by the
                  /// runThread.
                  private: void RunLoop();
 
+                 /// \brief Update the sensors that are due, in parallel,
+                 /// and reschedule them.
+                 /// \param[in] _simTime Current simulation time.
+                 /// \return Simulation time at which the next sensor is
+                 /// due.
+                 private: common::Time UpdateDueSensors(
+                              const common::Time &_simTime);
+
+                 /// \brief Get the simulation time at which a sensor is
+                 /// due for an update.
+                 /// \param[in] _sensor The sensor.
+                 /// \param[in] _simTime Current simulation time.
+                 /// \return Time of the next update, later than _simTime
+                 /// unless the sensor is due now.
+                 private: common::Time DueTime(SensorPtr _sensor,
+                              const common::Time &_simTime) const;
+
                  /// \brief The set of sensors to maintain.
                  public: Sensor_V sensors;
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_SENSORMANAGER_PRIVATE_HH_
+#define GAZEBO_SENSORS_SENSORMANAGER_PRIVATE_HH_
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/sensors/SensorManager.hh"
+#include "gazebo/sensors/SensorTypes.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief SensorManager private data.
+    class SensorManagerPrivate
+    {
+      /// \brief True to update the due sensors in parallel.
+      public: std::atomic<bool> parallelUpdates{false};
+
+      /// \brief Connect to the world update begin event.
+      public: event::ConnectionPtr worldUpdateBeginConnection;
+
+      /// \brief Connect to the world update end event.
+      public: event::ConnectionPtr worldUpdateEndConnection;
+
+      /// \brief Sensors that support in step updates.
+      public: Sensor_V stepSensors;
+
+      /// \brief Protects stepSensors. It is held while the sensors are
+      /// updated in step, so a sensor is never finalized during an update.
+      public: std::mutex stepMutex;
+    };
+
+    /// \internal
+    /// \brief Private data of a sensor container of the SensorManager.
+    class SensorContainerPrivate
+    {
+      /// \brief Sensors of the run thread, as a min heap keyed by the
+      /// simulation time at which they are due.
+      public: std::vector<std::pair<common::Time, SensorPtr>> schedule;
+
+      /// \brief True when the schedule must be rebuilt from the sensors
+      /// vector.
+      public: bool scheduleDirty = true;
+
+      /// \brief Set by Wake when the schedule must be rebuilt.
+      public: std::atomic<bool> wakeRequested{false};
+
+      /// \brief Simulation time of the last scheduler update, used to
+      /// detect time going backwards.
+      public: common::Time scheduleTime;
+
+      /// \brief Smallest delay between two updates of a sensor, the
+      /// maximum physics step size.
+      public: common::Time minUpdatePeriod;
+
+      /// \brief Update statistics, indexed by sensor scoped name.
+      public: std::map<std::string, SensorUpdateStatistics> statistics;
+    };
+  }
+}
+#endif
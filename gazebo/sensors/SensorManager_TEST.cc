@@ -96,6 +96,121 @@ TEST_F(SensorManager_TEST, Data)
   }
 }
 
+/////////////////////////////////////////////////
+/// \brief Test the update statistics of the sensor threads
+TEST_F(SensorManager_TEST, UpdateStatistics)
+{
+  Load("worlds/test_camera_laser.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  EXPECT_TRUE(mgr->SensorsInitialized());
+
+  std::string laserName = "default::laser_1::link::laser";
+  sensors::SensorPtr laser = mgr->GetSensor(laserName);
+  ASSERT_TRUE(laser != nullptr);
+
+  // Wait for the ray sensor thread to update the laser a few times
+  sensors::SensorUpdateStatistics stats;
+  int i = 0;
+  while ((!mgr->UpdateStatistics(laserName, stats) || stats.updateCount < 5)
+      && i < 100)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 100);
+
+  EXPECT_GE(stats.updateCount, 5u);
+  EXPECT_LE(stats.missedDeadlines, stats.updateCount);
+  EXPECT_GT(stats.maxLatency, common::Time::Zero);
+  EXPECT_GE(stats.maxLatency, stats.lastLatency);
+  EXPECT_GE(stats.totalLatency, stats.maxLatency);
+
+  // The laser is scheduled at its own rate
+  if (laser->UpdateRate() > 0)
+  {
+    common::Time elapsed = physics::get_world()->SimTime();
+    EXPECT_LE(stats.updateCount,
+        static_cast<uint64_t>(elapsed.Double() * laser->UpdateRate()) + 2u);
+  }
+
+  // Image based sensors are not run by the sensor threads
+  EXPECT_FALSE(mgr->UpdateStatistics("default::camera_1::link::camera",
+        stats));
+  EXPECT_FALSE(mgr->UpdateStatistics("no_such_sensor", stats));
+}
+
+/////////////////////////////////////////////////
+/// \brief Test the opt in parallel updates of the sensor threads
+TEST_F(SensorManager_TEST, ParallelUpdates)
+{
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  const bool parallel = mgr->ParallelUpdates();
+
+  mgr->SetParallelUpdates(true);
+  EXPECT_TRUE(mgr->ParallelUpdates());
+
+  Load("worlds/test_camera_laser.world");
+  EXPECT_TRUE(mgr->SensorsInitialized());
+
+  // Both lasers are updated by the ray sensor thread
+  for (auto const &name : {"default::laser_1::link::laser",
+                           "default::laser_2::link::laser"})
+  {
+    sensors::SensorUpdateStatistics stats;
+    int i = 0;
+    while ((!mgr->UpdateStatistics(name, stats) || stats.updateCount < 5)
+        && i < 100)
+    {
+      common::Time::MSleep(100);
+      ++i;
+    }
+    EXPECT_LT(i, 100) << name;
+  }
+
+  mgr->SetParallelUpdates(false);
+  EXPECT_FALSE(mgr->ParallelUpdates());
+  mgr->SetParallelUpdates(parallel);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that an activated sensor is updated without waiting for
+/// the next poll of the inactive sensors.
+TEST_F(SensorManager_TEST, Activate)
+{
+  Load("worlds/test_camera_laser.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  physics::WorldPtr world = physics::get_world();
+  ASSERT_TRUE(world != nullptr);
+
+  sensors::SensorPtr laser = mgr->GetSensor("default::laser_1::link::laser");
+  ASSERT_TRUE(laser != nullptr);
+
+  // Inactive sensors are polled once per second at this rate
+  laser->SetUpdateRate(1.0);
+  laser->SetActive(false);
+
+  common::Time start = world->SimTime();
+  int i = 0;
+  while (world->SimTime() - start < common::Time(1.5) && i < 300)
+  {
+    common::Time::MSleep(10);
+    ++i;
+  }
+  EXPECT_LT(i, 300);
+
+  const common::Time activated = world->SimTime();
+  laser->SetActive(true);
+
+  i = 0;
+  while (laser->LastUpdateTime() < activated && i < 300)
+  {
+    common::Time::MSleep(10);
+    ++i;
+  }
+  EXPECT_LT(i, 300);
+  EXPECT_LT((laser->LastUpdateTime() - activated).Double(), 0.5);
+}
+
 /////////////////////////////////////////////////
 /// \brief Test SensorManager init and removal of sensors
 TEST_F(SensorManager_TEST, InitRemove)
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 #define GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 
+#include <atomic>
 #include <mutex>
 #include <sdf/sdf.hh>
 
@@ -51,6 +52,13 @@ namespace gazebo
       /// \brief The sensors unique ID.
       public: uint32_t id;
 
+      /// \brief True if the sensor type can be updated in step.
+      public: bool supportsUpdateInStep = false;
+
+      /// \brief True if the sensor is updated by the physics thread after
+      /// each physics step.
+      public: std::atomic<bool> updateInStep{false};
+
       /// \brief An SDF pointer that allows us to only read the sensor.sdf
       /// file once, which in turns limits disk reads.
       public: static sdf::ElementPtr sdfSensor;
@@ -0,0 +1,461 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/sensors/AltimeterSensor.hh"
+#include "gazebo/sensors/ForceTorqueSensor.hh"
+#include "gazebo/sensors/ImuSensor.hh"
+#include "gazebo/sensors/MagnetometerSensor.hh"
+#include "gazebo/sensors/RaySensor.hh"
+#include "gazebo/sensors/Sensor.hh"
+
+#include "gazebo/sensors/SensorRecorderPrivate.hh"
+#include "gazebo/sensors/SensorRecorder.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+/// \brief Magic bytes at the start of a recording, including the version.
+static const char kMagic[8] = {'G', 'Z', 'S', 'R', 'E', 'C', 0, 1};
+
+/// \brief Record type of a stream description.
+static const uint32_t kStreamRecord = 1;
+
+/// \brief Record type of a block of samples.
+static const uint32_t kBlockRecord = 2;
+
+/////////////////////////////////////////////////
+/// \brief Append the names of the x, y and z components of a vector.
+/// \param[in] _prefix Name of the vector.
+/// \param[out] _columns Column names.
+static void vectorColumns(const std::string &_prefix,
+    std::vector<std::string> &_columns)
+{
+  _columns.push_back(_prefix + "_x");
+  _columns.push_back(_prefix + "_y");
+  _columns.push_back(_prefix + "_z");
+}
+
+/////////////////////////////////////////////////
+/// \brief Copy a vector into a row.
+/// \param[in] _v Vector to copy.
+/// \param[out] _row First of three values to set.
+static void copyVector(const ignition::math::Vector3d &_v, double *_row)
+{
+  _row[0] = _v.X();
+  _row[1] = _v.Y();
+  _row[2] = _v.Z();
+}
+
+/////////////////////////////////////////////////
+void SensorRecorderStream::Record()
+{
+  const common::Time time = this->sensor->LastUpdateTime();
+  this->sample(this->row.data());
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->stopped)
+    return;
+
+  SensorRecorderBuffer *buffer = &this->buffers[this->front];
+  if (buffer->count >= this->capacity)
+  {
+    // Keep memory bounded rather than wait for the writer
+    if (this->backPending)
+    {
+      ++this->dropped;
+      return;
+    }
+
+    this->front = 1 - this->front;
+    this->backPending = true;
+    buffer = &this->buffers[this->front];
+    buffer->count = 0;
+
+    // Under the lock, so that the recorder is never notified once Stop
+    // has marked the stream as stopped
+    this->notify();
+  }
+
+  const unsigned int n = buffer->count++;
+  buffer->times[n] = static_cast<int64_t>(time.sec) * 1000000000 +
+      time.nsec;
+  for (size_t c = 0; c < this->row.size(); ++c)
+    buffer->values[c * this->capacity + n] = this->row[c];
+}
+
+/////////////////////////////////////////////////
+SensorRecorder::SensorRecorder()
+  : dataPtr(new SensorRecorderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SensorRecorder::~SensorRecorder()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+bool SensorRecorder::Start(const std::string &_filename,
+    const unsigned int _samplesPerBuffer)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->running)
+  {
+    gzerr << "Sensor recorder is already started\n";
+    return false;
+  }
+
+  if (_samplesPerBuffer == 0)
+  {
+    gzerr << "Sensor recorder needs at least one sample per buffer\n";
+    return false;
+  }
+
+  this->dataPtr->file.open(_filename.c_str(),
+      std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!this->dataPtr->file.is_open())
+  {
+    gzerr << "Unable to open sensor recording [" << _filename << "]\n";
+    return false;
+  }
+  this->dataPtr->file.write(kMagic, sizeof(kMagic));
+
+  this->dataPtr->samplesPerBuffer = _samplesPerBuffer;
+  this->dataPtr->written = 0;
+  this->dataPtr->dropped = 0;
+  this->dataPtr->pending = false;
+  this->dataPtr->running = true;
+  this->dataPtr->writeThread.reset(new std::thread(
+      std::bind(&SensorRecorderPrivate::RunWrite, this->dataPtr.get())));
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SensorRecorder::AddSensor(SensorPtr _sensor)
+{
+  if (!_sensor)
+    return false;
+
+  auto stream = std::make_shared<SensorRecorderStream>();
+  stream->sensor = _sensor;
+
+  if (auto imu = std::dynamic_pointer_cast<ImuSensor>(_sensor))
+  {
+    vectorColumns("angular_velocity", stream->columns);
+    vectorColumns("linear_acceleration", stream->columns);
+    stream->columns.push_back("orientation_w");
+    vectorColumns("orientation", stream->columns);
+    stream->sample = [imu](double *_row)
+    {
+      copyVector(imu->AngularVelocity(), _row);
+      copyVector(imu->LinearAcceleration(), _row + 3);
+      const ignition::math::Quaterniond rot = imu->Orientation();
+      _row[6] = rot.W();
+      _row[7] = rot.X();
+      _row[8] = rot.Y();
+      _row[9] = rot.Z();
+    };
+  }
+  else if (auto ft = std::dynamic_pointer_cast<ForceTorqueSensor>(_sensor))
+  {
+    vectorColumns("force", stream->columns);
+    vectorColumns("torque", stream->columns);
+    stream->sample = [ft](double *_row)
+    {
+      copyVector(ft->Force(), _row);
+      copyVector(ft->Torque(), _row + 3);
+    };
+  }
+  else if (auto ray = std::dynamic_pointer_cast<RaySensor>(_sensor))
+  {
+    const int count = ray->RangeCount() * ray->VerticalRangeCount();
+    if (count <= 0)
+    {
+      gzerr << "Ray sensor [" << _sensor->ScopedName()
+            << "] must be initialized before it is recorded\n";
+      return false;
+    }
+
+    for (int i = 0; i < count; ++i)
+      stream->columns.push_back("range_" + std::to_string(i));
+
+    stream->sample = [ray, count, ranges = std::vector<double>()](
+        double *_row) mutable
+    {
+      ray->Ranges(ranges);
+      const size_t n = std::min(ranges.size(), static_cast<size_t>(count));
+      std::copy(ranges.begin(), ranges.begin() + n, _row);
+      std::fill(_row + n, _row + count,
+          std::numeric_limits<double>::quiet_NaN());
+    };
+  }
+  else if (auto alt = std::dynamic_pointer_cast<AltimeterSensor>(_sensor))
+  {
+    stream->columns.push_back("altitude");
+    stream->columns.push_back("vertical_velocity");
+    stream->sample = [alt](double *_row)
+    {
+      _row[0] = alt->Altitude();
+      _row[1] = alt->VerticalVelocity();
+    };
+  }
+  else if (auto mag = std::dynamic_pointer_cast<MagnetometerSensor>(_sensor))
+  {
+    vectorColumns("magnetic_field", stream->columns);
+    stream->sample = [mag](double *_row)
+    {
+      copyVector(mag->MagneticField(), _row);
+    };
+  }
+  else
+  {
+    gzerr << "Sensor [" << _sensor->ScopedName() << "] of type ["
+          << _sensor->Type() << "] can't be recorded\n";
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->running)
+  {
+    gzerr << "Sensor recorder must be started before adding sensors\n";
+    return false;
+  }
+
+  stream->id = static_cast<uint32_t>(this->dataPtr->streams.size());
+  stream->row.resize(stream->columns.size());
+  stream->capacity = this->dataPtr->samplesPerBuffer;
+  for (auto &buffer : stream->buffers)
+  {
+    buffer.times.resize(stream->capacity);
+    buffer.values.resize(stream->capacity * stream->columns.size());
+  }
+
+  SensorRecorderPrivate *recorder = this->dataPtr.get();
+  stream->notify = [recorder]()
+  {
+    // The writer also wakes up periodically, so the sensor thread does
+    // not need to take the recorder mutex here.
+    recorder->pending = true;
+    recorder->condition.notify_one();
+  };
+
+  this->dataPtr->streams.push_back(stream);
+  this->dataPtr->newStreams.push_back(stream);
+
+  // Disconnecting does not wait for a running callback, so the callback
+  // keeps the stream alive while it records
+  std::weak_ptr<SensorRecorderStream> weakStream = stream;
+  stream->connection = _sensor->ConnectUpdated([weakStream]()
+      {
+        auto recorded = weakStream.lock();
+        if (recorded)
+          recorded->Record();
+      });
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SensorRecorder::Flush()
+{
+  this->dataPtr->SwapPartial();
+  this->dataPtr->pending = true;
+  this->dataPtr->condition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void SensorRecorder::Stop()
+{
+  std::vector<std::shared_ptr<SensorRecorderStream>> streams;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->running)
+      return;
+    streams = this->dataPtr->streams;
+  }
+
+  // Stop recording new samples before the last write. Callbacks already
+  // running finish their sample before the stream is marked stopped.
+  for (auto &stream : streams)
+  {
+    stream->connection.reset();
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->stopped = true;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->running = false;
+  }
+  this->dataPtr->condition.notify_all();
+  if (this->dataPtr->writeThread)
+    this->dataPtr->writeThread->join();
+  this->dataPtr->writeThread.reset();
+
+  // Pending back buffers first, then whatever is left in the front buffers
+  this->dataPtr->WritePending();
+  this->dataPtr->SwapPartial();
+  this->dataPtr->WritePending();
+  this->dataPtr->file.close();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &stream : this->dataPtr->streams)
+    this->dataPtr->dropped += stream->dropped;
+  this->dataPtr->streams.clear();
+  this->dataPtr->newStreams.clear();
+}
+
+/////////////////////////////////////////////////
+bool SensorRecorder::Recording() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->running;
+}
+
+/////////////////////////////////////////////////
+uint64_t SensorRecorder::WrittenSamples() const
+{
+  return this->dataPtr->written;
+}
+
+/////////////////////////////////////////////////
+uint64_t SensorRecorder::DroppedSamples() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  uint64_t dropped = this->dataPtr->dropped;
+  for (auto const &stream : this->dataPtr->streams)
+  {
+    std::lock_guard<std::mutex> streamLock(stream->mutex);
+    dropped += stream->dropped;
+  }
+  return dropped;
+}
+
+/////////////////////////////////////////////////
+void SensorRecorderPrivate::RunWrite()
+{
+  auto lastFlush = std::chrono::steady_clock::now();
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (this->running)
+  {
+    this->condition.wait_for(lock, std::chrono::milliseconds(100),
+        [this]{return !this->running || this->pending;});
+    if (!this->running)
+      break;
+    this->pending = false;
+    lock.unlock();
+
+    // Bound the delay before samples of slow sensors reach the disk
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastFlush >= std::chrono::seconds(1))
+    {
+      this->SwapPartial();
+      lastFlush = now;
+    }
+
+    if (!this->WritePending())
+      gzerr << "Failed to write sensor recording\n";
+
+    lock.lock();
+  }
+}
+
+/////////////////////////////////////////////////
+void SensorRecorderPrivate::SwapPartial()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto &stream : this->streams)
+  {
+    std::lock_guard<std::mutex> streamLock(stream->mutex);
+    if (stream->backPending || stream->buffers[stream->front].count == 0)
+      continue;
+
+    stream->front = 1 - stream->front;
+    stream->backPending = true;
+    stream->buffers[stream->front].count = 0;
+  }
+}
+
+/////////////////////////////////////////////////
+bool SensorRecorderPrivate::WritePending()
+{
+  std::vector<std::shared_ptr<SensorRecorderStream>> added;
+  std::vector<std::shared_ptr<SensorRecorderStream>> all;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    added.swap(this->newStreams);
+    all = this->streams;
+  }
+
+  for (auto const &stream : added)
+  {
+    this->WriteValue(kStreamRecord);
+    this->WriteValue(stream->id);
+    this->WriteString(stream->sensor->ScopedName());
+    this->WriteString(stream->sensor->Type());
+    this->WriteValue(static_cast<uint32_t>(stream->columns.size()));
+    for (auto const &column : stream->columns)
+      this->WriteString(column);
+  }
+
+  for (auto const &stream : all)
+  {
+    const SensorRecorderBuffer *back;
+    {
+      std::lock_guard<std::mutex> lock(stream->mutex);
+      if (!stream->backPending)
+        continue;
+      back = &stream->buffers[1 - stream->front];
+    }
+
+    // The sensor thread does not touch the back buffer while it is pending
+    const unsigned int n = back->count;
+    this->WriteValue(kBlockRecord);
+    this->WriteValue(stream->id);
+    this->WriteValue(static_cast<uint32_t>(n));
+    this->file.write(reinterpret_cast<const char *>(back->times.data()),
+        n * sizeof(int64_t));
+    for (size_t c = 0; c < stream->columns.size(); ++c)
+    {
+      this->file.write(reinterpret_cast<const char *>(
+          back->values.data() + c * stream->capacity), n * sizeof(double));
+    }
+    this->written += n;
+
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    stream->backPending = false;
+  }
+
+  this->file.flush();
+  return this->file.good();
+}
+
+/////////////////////////////////////////////////
+void SensorRecorderPrivate::WriteString(const std::string &_str)
+{
+  this->WriteValue(static_cast<uint32_t>(_str.size()));
+  this->file.write(_str.data(), _str.size());
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_SENSORRECORDER_HH_
+#define GAZEBO_SENSORS_SENSORRECORDER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/sensors/SensorTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declare private data class.
+    class SensorRecorderPrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class SensorRecorder SensorRecorder.hh sensors/sensors.hh
+    /// \brief Records the output of sensors to a columnar binary file.
+    ///
+    /// Each recorded sensor is a stream of samples. A sample is the sim
+    /// time of a sensor update followed by a fixed number of values:
+    ///   - imu: angular velocity, linear acceleration, orientation (w, x, y,
+    ///     z), 10 values.
+    ///   - force_torque: force and torque, 6 values.
+    ///   - ray: one value per range.
+    ///   - altimeter: altitude and vertical velocity, 2 values.
+    ///   - magnetometer: magnetic field, 3 values.
+    ///
+    /// Samples are copied into a fixed size buffer from the sensor's update
+    /// signal. When the buffer is full it is swapped with a second buffer
+    /// and handed to a background thread that writes it to disk. If the
+    /// writer has not drained the second buffer yet, the sample is dropped
+    /// and counted, so memory use stays bounded and the sensor threads never
+    /// wait on disk.
+    ///
+    /// The file starts with the 8 byte magic "GZSREC\0\1", followed by
+    /// records in native byte order. Each record starts with a uint32 type:
+    ///   - 1, stream: uint32 stream id, string name, string sensor type,
+    ///     uint32 column count, then one string per column name.
+    ///   - 2, block: uint32 stream id, uint32 sample count N, N int64 sim
+    ///     times in nanoseconds, then N doubles per column, one column
+    ///     after the other.
+    ///
+    /// Strings are stored as a uint32 length followed by the characters.
+    /// A stream record is always written before the blocks of its stream.
+    class GZ_SENSORS_VISIBLE SensorRecorder
+    {
+      /// \brief Constructor.
+      public: SensorRecorder();
+
+      /// \brief Destructor. Stops the recording.
+      public: virtual ~SensorRecorder();
+
+      /// \brief Open a file and start the writer thread.
+      /// \param[in] _filename Path of the file to write.
+      /// \param[in] _samplesPerBuffer Number of samples per stream held in
+      /// each of the two buffers.
+      /// \return True if the file was opened.
+      public: bool Start(const std::string &_filename,
+                  const unsigned int _samplesPerBuffer = 1024);
+
+      /// \brief Record the updates of a sensor. The recorder keeps the
+      /// sensor alive until the recording stops.
+      /// \param[in] _sensor Initialized sensor to record.
+      /// \return True if the sensor type is supported and the recorder
+      /// is started.
+      public: bool AddSensor(SensorPtr _sensor);
+
+      /// \brief Hand the samples in partially filled buffers to the writer
+      /// thread. Samples are otherwise written once a buffer is full, or
+      /// about once per second.
+      public: void Flush();
+
+      /// \brief Stop recording, write the remaining samples and close the
+      /// file.
+      public: void Stop();
+
+      /// \brief Get whether the recorder is started.
+      /// \return True if recording.
+      public: bool Recording() const;
+
+      /// \brief Get the number of samples written to the file.
+      /// \return Number of samples written.
+      public: uint64_t WrittenSamples() const;
+
+      /// \brief Get the number of samples dropped because the writer was
+      /// too slow.
+      /// \return Number of samples dropped.
+      public: uint64_t DroppedSamples() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SensorRecorderPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
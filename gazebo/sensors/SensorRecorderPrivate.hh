@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_SENSORRECORDER_PRIVATE_HH_
+#define GAZEBO_SENSORS_SENSORRECORDER_PRIVATE_HH_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/Event.hh"
+#include "gazebo/sensors/SensorTypes.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Samples of a stream, stored column by column.
+    class SensorRecorderBuffer
+    {
+      /// \brief Sim time of each sample, in nanoseconds.
+      public: std::vector<int64_t> times;
+
+      /// \brief Values, capacity samples per column.
+      public: std::vector<double> values;
+
+      /// \brief Number of samples in the buffer.
+      public: unsigned int count = 0;
+    };
+
+    /// \internal
+    /// \brief A recorded sensor.
+    class SensorRecorderStream
+    {
+      /// \brief Copy the latest output of the sensor into the front
+      /// buffer. Called from the sensor's update signal.
+      public: void Record();
+
+      /// \brief Id of the stream in the file.
+      public: uint32_t id = 0;
+
+      /// \brief Recorded sensor.
+      public: SensorPtr sensor;
+
+      /// \brief Names of the columns.
+      public: std::vector<std::string> columns;
+
+      /// \brief Fills a row with the latest sensor output.
+      public: std::function<void (double *)> sample;
+
+      /// \brief Row filled by sample, used by the sensor thread only.
+      public: std::vector<double> row;
+
+      /// \brief Number of samples per buffer.
+      public: unsigned int capacity = 0;
+
+      /// \brief Front and back buffers.
+      public: SensorRecorderBuffer buffers[2];
+
+      /// \brief Index of the buffer filled by the sensor thread.
+      public: unsigned int front = 0;
+
+      /// \brief True while the back buffer waits to be written. The
+      /// writer thread owns the back buffer while this is true.
+      public: bool backPending = false;
+
+      /// \brief Number of dropped samples.
+      public: uint64_t dropped = 0;
+
+      /// \brief True once the recorder stopped. Record does nothing after
+      /// this, and no longer calls notify.
+      public: bool stopped = false;
+
+      /// \brief Protects the buffer indices, counts and the stopped flag.
+      public: std::mutex mutex;
+
+      /// \brief Signals the writer thread that a buffer is pending.
+      public: std::function<void ()> notify;
+
+      /// \brief Connection to the sensor's update signal.
+      public: event::ConnectionPtr connection;
+    };
+
+    /// \internal
+    /// \brief Sensor recorder private data.
+    class SensorRecorderPrivate
+    {
+      /// \brief Writer thread loop.
+      public: void RunWrite();
+
+      /// \brief Swap the partially filled front buffers of all streams so
+      /// the writer thread picks them up.
+      public: void SwapPartial();
+
+      /// \brief Write the pending stream records and buffers.
+      /// \return False if a write failed.
+      public: bool WritePending();
+
+      /// \brief Write a string record field.
+      /// \param[in] _str String to write.
+      public: void WriteString(const std::string &_str);
+
+      /// \brief Write a plain value record field.
+      /// \param[in] _value Value to write.
+      public: template<typename T> void WriteValue(const T &_value)
+              {
+                this->file.write(reinterpret_cast<const char *>(&_value),
+                    sizeof(T));
+              }
+
+      /// \brief Output file.
+      public: std::ofstream file;
+
+      /// \brief Number of samples per buffer.
+      public: unsigned int samplesPerBuffer = 1024;
+
+      /// \brief All recorded streams.
+      public: std::vector<std::shared_ptr<SensorRecorderStream>> streams;
+
+      /// \brief Streams whose stream record has not been written.
+      public: std::vector<std::shared_ptr<SensorRecorderStream>> newStreams;
+
+      /// \brief Protects streams, newStreams, running and dropped.
+      public: std::mutex mutex;
+
+      /// \brief Wakes up the writer thread.
+      public: std::condition_variable condition;
+
+      /// \brief True while recording.
+      public: bool running = false;
+
+      /// \brief True when a buffer is waiting to be written.
+      public: std::atomic<bool> pending{false};
+
+      /// \brief Writer thread.
+      public: std::unique_ptr<std::thread> writeThread;
+
+      /// \brief Number of samples written.
+      public: std::atomic<uint64_t> written{0};
+
+      /// \brief Number of samples dropped by the streams of a stopped
+      /// recording.
+      public: uint64_t dropped = 0;
+    };
+  }
+}
+#endif
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "gazebo/sensors/ImuSensor.hh"
+#include "gazebo/sensors/SensorRecorder.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class SensorRecorder_TEST : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Read a plain value from a recording.
+/// \param[in] _in Recording.
+/// \return Value read.
+template<typename T>
+static T readValue(std::ifstream &_in)
+{
+  T value{};
+  _in.read(reinterpret_cast<char *>(&value), sizeof(T));
+  return value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a string from a recording.
+/// \param[in] _in Recording.
+/// \return String read.
+static std::string readString(std::ifstream &_in)
+{
+  std::string str(readValue<uint32_t>(_in), '\0');
+  _in.read(&str[0], str.size());
+  return str;
+}
+
+/////////////////////////////////////////////////
+/// \brief Record an IMU and read the samples back from the file.
+TEST_F(SensorRecorder_TEST, Imu)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  SpawnUnitImuSensor("imu_model", "imu_sensor", "box", "~/imu",
+      ignition::math::Vector3d(0, 0, 2), ignition::math::Vector3d::Zero);
+
+  sensors::ImuSensorPtr imu = std::dynamic_pointer_cast<sensors::ImuSensor>(
+      sensors::get_sensor("imu_sensor"));
+  ASSERT_TRUE(imu != nullptr);
+  sensors::SensorManager::Instance()->Init();
+  imu->SetActive(true);
+
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_sensor_recorder-%%%%-%%%%.bin");
+
+  sensors::SensorRecorder recorder;
+  EXPECT_FALSE(recorder.AddSensor(imu));
+  ASSERT_TRUE(recorder.Start(path.string(), 4));
+  EXPECT_TRUE(recorder.Recording());
+  EXPECT_TRUE(recorder.AddSensor(imu));
+
+  // More samples than fit in the two buffers, written as several blocks
+  const unsigned int sampleCount = 10;
+  for (unsigned int i = 0; i < sampleCount; ++i)
+  {
+    world->Step(1);
+    imu->Update(true);
+  }
+
+  recorder.Stop();
+  EXPECT_FALSE(recorder.Recording());
+  EXPECT_EQ(sampleCount, recorder.WrittenSamples() +
+      recorder.DroppedSamples());
+
+  std::ifstream in(path.string(), std::ios::binary);
+  ASSERT_TRUE(in.is_open());
+
+  char magic[8];
+  in.read(magic, sizeof(magic));
+  EXPECT_EQ(0, std::memcmp(magic, "GZSREC\0\1", sizeof(magic)));
+
+  // Stream record
+  EXPECT_EQ(1u, readValue<uint32_t>(in));
+  EXPECT_EQ(0u, readValue<uint32_t>(in));
+  EXPECT_EQ(imu->ScopedName(), readString(in));
+  EXPECT_EQ("imu", readString(in));
+  const uint32_t columnCount = readValue<uint32_t>(in);
+  ASSERT_EQ(10u, columnCount);
+  std::vector<std::string> columns;
+  for (uint32_t c = 0; c < columnCount; ++c)
+    columns.push_back(readString(in));
+  EXPECT_EQ("angular_velocity_x", columns[0]);
+  EXPECT_EQ("orientation_w", columns[6]);
+
+  // Blocks
+  std::vector<int64_t> times;
+  std::vector<double> orientationW;
+  while (in.peek() != EOF)
+  {
+    EXPECT_EQ(2u, readValue<uint32_t>(in));
+    EXPECT_EQ(0u, readValue<uint32_t>(in));
+    const uint32_t n = readValue<uint32_t>(in);
+    EXPECT_LE(n, 4u);
+    for (uint32_t i = 0; i < n; ++i)
+      times.push_back(readValue<int64_t>(in));
+    for (uint32_t c = 0; c < columnCount; ++c)
+    {
+      for (uint32_t i = 0; i < n; ++i)
+      {
+        const double value = readValue<double>(in);
+        if (c == 6)
+          orientationW.push_back(value);
+      }
+    }
+    ASSERT_TRUE(in.good());
+  }
+
+  EXPECT_EQ(recorder.WrittenSamples(), times.size());
+  for (size_t i = 1; i < times.size(); ++i)
+    EXPECT_LT(times[i - 1], times[i]);
+  for (auto const w : orientationW)
+    EXPECT_NEAR(1.0, w, 1e-6);
+
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -37,9 +37,11 @@ namespace gazebo
     class CameraSensor;
     class LogicalCameraSensor;
     class MagnetometerSensor;
+    class ModelSpatialIndex;
     class MultiCameraSensor;
     class DepthCameraSensor;
     class ContactSensor;
+    class CpuDepthCameraSensor;
     class ImuSensor;
     class GpuRaySensor;
     class RFIDSensor;
@@ -75,6 +77,10 @@ namespace gazebo
     /// \brief Shared pointer to MagnetometerSensor
     typedef std::shared_ptr<MagnetometerSensor> MagnetometerSensorPtr;
 
+    /// \def ModelSpatialIndexPtr
+    /// \brief Shared pointer to ModelSpatialIndex
+    typedef std::shared_ptr<ModelSpatialIndex> ModelSpatialIndexPtr;
+
     /// \def MultiCameraSensorPtr
     /// \brief Shared pointer to MultiCameraSensor
     typedef std::shared_ptr<MultiCameraSensor> MultiCameraSensorPtr;
@@ -91,6 +97,10 @@ namespace gazebo
     /// \brief Shared pointer to ContactSensor
     typedef std::shared_ptr<ContactSensor> ContactSensorPtr;
 
+    /// \def CpuDepthCameraSensorPtr
+    /// \brief Shared pointer to CpuDepthCameraSensor
+    typedef std::shared_ptr<CpuDepthCameraSensor> CpuDepthCameraSensorPtr;
+
     /// \def ImuSensorPtr
     /// \brief Shared pointer to ImuSensor
     typedef std::shared_ptr<ImuSensor> ImuSensorPtr;
@@ -14,10 +14,14 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/ModelSpatialIndex.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
@@ -37,6 +41,37 @@ const double WirelessTransmitterPrivate::ModelStdDev = 6.0;
 const double WirelessTransmitterPrivate::Step = 1.0;
 const double WirelessTransmitterPrivate::MaxRadius = 10.0;
 
+/// \brief Largest number of receiver positions kept in the obstruction
+/// cache before it is cleared.
+static const size_t kMaxCachedReceivers = 4096;
+
+/////////////////////////////////////////////////
+/// \brief Hata-Okumara propagation model.
+/// \param[in] _txPower Transmitter power (dBm).
+/// \param[in] _txGain Transmitter antenna gain (dBi).
+/// \param[in] _rxGain Receiver antenna gain (dBi).
+/// \param[in] _freq Transmitter frequency (MHz).
+/// \param[in] _obstructed True if there are obstacles between the
+/// transmitter and the receiver.
+/// \param[in] _distance Distance between transmitter and receiver.
+/// \return Received power (dBm).
+static double propagationModel(const double _txPower, const double _txGain,
+    const double _rxGain, const double _freq, const bool _obstructed,
+    const double _distance)
+{
+  // Compute the value of n depending on the obstacles between Tx and Rx
+  double n = _obstructed ? WirelessTransmitterPrivate::NObstacle :
+      WirelessTransmitterPrivate::NEmpty;
+
+  double distance = std::max(1.0, _distance);
+  double x = std::abs(ignition::math::Rand::DblNormal(0.0,
+        WirelessTransmitterPrivate::ModelStdDev));
+  double wavelength = common::SpeedOfLight / (_freq * 1000000);
+
+  return _txPower + _txGain + _rxGain - x +
+      20 * log10(wavelength) - 20 * log10(4 * M_PI) - 10 * n * log10(distance);
+}
+
 /////////////////////////////////////////////////
 WirelessTransmitter::WirelessTransmitter()
 : WirelessTransceiver(),
@@ -83,6 +118,96 @@ void WirelessTransmitter::Init()
   // between the transmitter and a given point.
   this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
       this->world->Physics()->CreateShape("ray", CollisionPtr()));
+
+  this->dataPtr->modelIndex = ModelSpatialIndex::Get(this->world);
+
+  if (!this->dataPtr->visualize)
+    return;
+
+  // Iterate using a rectangular grid, but only choose the points within
+  // a circunference of radius MaxRadius
+  this->dataPtr->gridPoints.clear();
+  for (double x = -this->dataPtr->MaxRadius;
+       x <= this->dataPtr->MaxRadius; x += this->dataPtr->Step)
+  {
+    for (double y = -this->dataPtr->MaxRadius;
+         y <= this->dataPtr->MaxRadius; y += this->dataPtr->Step)
+    {
+      if (ignition::math::Vector2d(x, y).Length() <= this->dataPtr->MaxRadius)
+        this->dataPtr->gridPoints.push_back(ignition::math::Vector2d(x, y));
+    }
+  }
+
+  // One ray per grid point, cast together so that physics engines can
+  // batch them.
+  this->dataPtr->gridCollision = this->world->Physics()->CreateCollision(
+      "multiray", this->ParentName());
+  GZ_ASSERT(this->dataPtr->gridCollision != nullptr,
+      "Unable to create a multiray collision using the physics engine.");
+  this->dataPtr->gridCollision->SetName(
+      "wireless_transmitter_propagation_collision");
+  this->dataPtr->gridCollision->SetRelativePose(this->pose);
+  this->dataPtr->gridCollision->SetInitialRelativePose(this->pose);
+
+  this->dataPtr->gridShape = boost::dynamic_pointer_cast<MultiRayShape>(
+      this->dataPtr->gridCollision->GetShape());
+  GZ_ASSERT(this->dataPtr->gridShape != nullptr,
+      "Unable to get the multiray shape from the multi-ray collision.");
+
+  sdf::ElementPtr shapeSdf = this->sdf->Clone();
+  sdf::ElementPtr scanElem = shapeSdf->GetElement("ray")->GetElement("scan");
+  sdf::ElementPtr horzElem = scanElem->GetElement("horizontal");
+  horzElem->GetElement("samples")->Set(
+      static_cast<unsigned int>(this->dataPtr->gridPoints.size()));
+  horzElem->GetElement("resolution")->Set(1.0);
+  horzElem->GetElement("min_angle")->Set(0.0);
+  horzElem->GetElement("max_angle")->Set(0.0);
+  sdf::ElementPtr vertElem = scanElem->GetElement("vertical");
+  vertElem->GetElement("samples")->Set(1u);
+  vertElem->GetElement("resolution")->Set(1.0);
+  sdf::ElementPtr rangeElem = shapeSdf->GetElement("ray")->GetElement("range");
+  rangeElem->GetElement("min")->Set(0.0);
+  rangeElem->GetElement("max")->Set(
+      this->dataPtr->MaxRadius + this->dataPtr->Step);
+
+  this->dataPtr->gridShape->Load(shapeSdf);
+  this->dataPtr->gridShape->Init();
+
+  GZ_ASSERT(this->dataPtr->gridShape->RayCount() ==
+      this->dataPtr->gridPoints.size(),
+      "Unexpected number of rays in the propagation grid");
+
+  // Rays are expressed in the frame of the parent link.
+  for (unsigned int i = 0; i < this->dataPtr->gridPoints.size(); ++i)
+  {
+    const ignition::math::Vector2d &point = this->dataPtr->gridPoints[i];
+    ignition::math::Vector3d end = this->pose.CoordPositionAdd(
+        ignition::math::Vector3d(point.X(), point.Y(), 0.0));
+
+    // Avoid computing the intersection of coincident points
+    if (end == this->pose.Pos())
+      end.Z() += 0.00001;
+
+    this->dataPtr->gridShape->SetRay(i, this->pose.Pos(), end);
+  }
+
+  this->dataPtr->gridObstructed.assign(this->dataPtr->gridPoints.size(),
+      false);
+  this->dataPtr->gridValid = false;
+}
+
+//////////////////////////////////////////////////
+void WirelessTransmitter::Fini()
+{
+  if (this->dataPtr->gridCollision)
+  {
+    this->dataPtr->gridCollision->Fini();
+    this->dataPtr->gridCollision.reset();
+  }
+  this->dataPtr->gridShape.reset();
+  this->dataPtr->modelIndex.reset();
+
+  WirelessTransceiver::Fini();
 }
 
 //////////////////////////////////////////////////
@@ -90,40 +215,56 @@ bool WirelessTransmitter::UpdateImpl(const bool /*_force*/)
 {
   this->referencePose = this->pose + this->parentEntity.lock()->WorldPose();
 
-  if (this->dataPtr->visualize)
+  if (this->dataPtr->visualize && this->dataPtr->gridShape)
   {
-    msgs::PropagationGrid msg;
-    ignition::math::Pose3d pos;
-    ignition::math::Pose3d worldPose;
-    double strength;
-    msgs::PropagationParticle *p;
-
-    // Iterate using a rectangular grid, but only choose the points within
-    // a circunference of radius MaxRadius
-    for (double x = -this->dataPtr->MaxRadius;
-         x <= this->dataPtr->MaxRadius; x += this->dataPtr->Step)
+    // The obstruction of each grid point only changes when the transmitter
+    // or the models within reach of the grid move.
+    const double reach = this->dataPtr->MaxRadius + this->dataPtr->Step;
+    const ignition::math::Vector3d extent(reach, reach, reach);
+    const uint64_t revision = this->dataPtr->modelIndex->Revision(
+        ignition::math::AxisAlignedBox(this->referencePose.Pos() - extent,
+          this->referencePose.Pos() + extent));
+    if (!this->dataPtr->gridValid ||
+        this->dataPtr->gridPose != this->referencePose ||
+        this->dataPtr->gridRevision != revision)
     {
-      for (double y = -this->dataPtr->MaxRadius;
-           y <= this->dataPtr->MaxRadius; y += this->dataPtr->Step)
       {
-        pos.Set(x, y, 0.0, 0, 0, 0);
-
-        worldPose = pos + this->referencePose;
-
-        if (this->referencePose.Pos().Distance(worldPose.Pos()) <=
-            this->dataPtr->MaxRadius)
-        {
-          // For the propagation model assume the receiver antenna has the same
-          // gain as the transmitter
-          strength = this->SignalStrength(worldPose, this->Gain());
-
-          // Add a new particle to the grid
-          p = msg.add_particle();
-          p->set_x(x);
-          p->set_y(y);
-          p->set_signal_level(strength);
-        }
+        // Acquire the mutex for avoiding race condition with the physics
+        // engine
+        boost::recursive_mutex::scoped_lock lock(*(
+              this->world->Physics()->GetPhysicsUpdateMutex()));
+        this->dataPtr->gridShape->Update();
       }
+
+      for (unsigned int i = 0; i < this->dataPtr->gridPoints.size(); ++i)
+      {
+        const double dist = std::max(0.00001,
+            this->dataPtr->gridPoints[i].Length());
+        this->dataPtr->gridObstructed[i] =
+          this->dataPtr->gridShape->Ray(i)->GetLength() < dist - 1e-6;
+      }
+
+      this->dataPtr->gridValid = true;
+      this->dataPtr->gridPose = this->referencePose;
+      this->dataPtr->gridRevision = revision;
+    }
+
+    msgs::PropagationGrid msg;
+    for (unsigned int i = 0; i < this->dataPtr->gridPoints.size(); ++i)
+    {
+      const ignition::math::Vector2d &point = this->dataPtr->gridPoints[i];
+
+      // For the propagation model assume the receiver antenna has the same
+      // gain as the transmitter
+      double strength = propagationModel(this->Power(), this->Gain(),
+          this->Gain(), this->Freq(), this->dataPtr->gridObstructed[i],
+          point.Length());
+
+      // Add a new particle to the grid
+      msgs::PropagationParticle *p = msg.add_particle();
+      p->set_x(point.X());
+      p->set_y(point.Y());
+      p->set_signal_level(strength);
     }
     this->pub->Publish(msg);
   }
@@ -160,34 +301,65 @@ double WirelessTransmitter::SignalStrength(
     end.Z() += 0.00001;
   }
 
-  // Acquire the mutex for avoiding race condition with the physics engine
-  boost::recursive_mutex::scoped_lock lock(*(
-        this->world->Physics()->GetPhysicsUpdateMutex()));
-
-  // Compute the value of n depending on the obstacles between Tx and Rx
-  double n = WirelessTransmitterPrivate::NEmpty;
+  // The path to a receiver only changes when the transmitter, the receiver
+  // or the models around the path move.
+  ignition::math::Vector3d pathMin = start;
+  ignition::math::Vector3d pathMax = start;
+  pathMin.Min(end);
+  pathMax.Max(end);
+  const uint64_t revision = this->dataPtr->modelIndex ?
+    this->dataPtr->modelIndex->Revision(
+        ignition::math::AxisAlignedBox(pathMin, pathMax)) : 0;
+  const ignition::math::Pose3d txPose = this->referencePose;
+  const auto key = std::make_tuple(end.X(), end.Y(), end.Z());
+
+  bool obstructed = false;
+  bool cached = false;
+  {
+    std::lock_guard<std::mutex> cacheLock(this->dataPtr->cacheMutex);
+    if (this->dataPtr->cachePose != txPose)
+    {
+      this->dataPtr->obstructionCache.clear();
+      this->dataPtr->cachePose = txPose;
+    }
 
-  // Looking for obstacles between start and end points
-  this->dataPtr->testRay->SetPoints(start, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
+    auto iter = this->dataPtr->obstructionCache.find(key);
+    if (iter != this->dataPtr->obstructionCache.end() &&
+        iter->second.second == revision)
+    {
+      obstructed = iter->second.first;
+      cached = true;
+    }
+  }
 
-  // ToDo: The ray intersects with my own collision model. Fix it.
-  if (entityName != "")
+  if (!cached)
   {
-    n = WirelessTransmitterPrivate::NObstacle;
-  }
+    {
+      // Acquire the mutex for avoiding race condition with the physics
+      // engine
+      boost::recursive_mutex::scoped_lock lock(*(
+            this->world->Physics()->GetPhysicsUpdateMutex()));
+
+      // Looking for obstacles between start and end points
+      this->dataPtr->testRay->SetPoints(start, end);
+      this->dataPtr->testRay->GetIntersection(dist, entityName);
+    }
 
-  double distance = std::max(1.0,
-      this->referencePose.Pos().Distance(_receiver.Pos()));
-  double x = std::abs(ignition::math::Rand::DblNormal(0.0,
-        WirelessTransmitterPrivate::ModelStdDev));
-  double wavelength = common::SpeedOfLight / (this->Freq() * 1000000);
+    // ToDo: The ray intersects with my own collision model. Fix it.
+    obstructed = entityName != "";
 
-  // Hata-Okumara propagation model
-  double rxPower = this->Power() + this->Gain() + _rxGain - x +
-      20 * log10(wavelength) - 20 * log10(4 * M_PI) - 10 * n * log10(distance);
+    std::lock_guard<std::mutex> cacheLock(this->dataPtr->cacheMutex);
+    if (this->dataPtr->cachePose == txPose)
+    {
+      if (this->dataPtr->obstructionCache.size() >= kMaxCachedReceivers)
+        this->dataPtr->obstructionCache.clear();
+      this->dataPtr->obstructionCache[key] =
+          std::make_pair(obstructed, revision);
+    }
+  }
 
-  return rxPower;
+  return propagationModel(this->Power(), this->Gain(), _rxGain, this->Freq(),
+      obstructed, txPose.Pos().Distance(_receiver.Pos()));
 }
 
 /////////////////////////////////////////////////
@@ -17,8 +17,19 @@
 #ifndef _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 #define _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector2.hh>
+
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/sensors/SensorTypes.hh"
 
 namespace gazebo
 {
@@ -59,6 +70,46 @@ namespace gazebo
 
       // \brief Ray used to test for collisions when placing entities
       public: physics::RayShapePtr testRay;
+
+      /// \brief Collision holding one ray per propagation grid point.
+      public: physics::CollisionPtr gridCollision;
+
+      /// \brief Rays from the transmitter to each propagation grid point.
+      public: physics::MultiRayShapePtr gridShape;
+
+      /// \brief Offset of each propagation grid point from the transmitter.
+      public: std::vector<ignition::math::Vector2d> gridPoints;
+
+      /// \brief True if an obstacle lies between the transmitter and each
+      /// grid point.
+      public: std::vector<bool> gridObstructed;
+
+      /// \brief True if gridObstructed holds a valid result.
+      public: bool gridValid = false;
+
+      /// \brief Transmitter pose the grid was computed for.
+      public: ignition::math::Pose3d gridPose;
+
+      /// \brief Model index revision of the grid region the grid was
+      /// computed for.
+      public: uint64_t gridRevision = 0;
+
+      /// \brief Obstruction of the paths to the receivers that queried
+      /// SignalStrength, keyed by receiver position. Each entry holds the
+      /// model index revision of the region around the path it was
+      /// computed for.
+      public: std::map<std::tuple<double, double, double>,
+                       std::pair<bool, uint64_t>> obstructionCache;
+
+      /// \brief Transmitter pose the obstruction cache is valid for.
+      public: ignition::math::Pose3d cachePose;
+
+      /// \brief Spatial index of the world's models, used to detect when
+      /// obstacles moved.
+      public: ModelSpatialIndexPtr modelIndex;
+
+      /// \brief Mutex that protects the obstruction cache.
+      public: std::mutex cacheMutex;
     };
   }
 }
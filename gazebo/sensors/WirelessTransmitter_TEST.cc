@@ -15,6 +15,8 @@
  *
 */
 
+#include <cmath>
+
 #include <gtest/gtest.h>
 #include "gazebo/test/ServerFixture.hh"
 
@@ -26,6 +28,7 @@ class WirelessTransmitter_TEST : public ServerFixture
     public: void TestSignalStrength();
     public: void TestUpdateImpl();
     public: void TestUpdateImplNoVisual();
+    public: void TestPropagationGridObstacle();
     public: void TestInvalidFreq();
     private: void TxMsg(const ConstPropagationGridPtr &_msg);
 
@@ -236,6 +239,62 @@ void WirelessTransmitter_TEST::TestUpdateImplNoVisual()
   EXPECT_FALSE(this->receivedMsg);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that the propagation grid accounts for obstacles
+void WirelessTransmitter_TEST::TestPropagationGridObstacle()
+{
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+
+  std::string txTopic =
+      "/gazebo/default/tx/link/wirelessTransmitterConstructor/transceiver";
+  transport::SubscriberPtr sub = node->Subscribe(txTopic,
+      &WirelessTransmitter_TEST::TxMsg, this);
+
+  // A wall between the transmitter and the points along +x
+  SpawnBox("wall", ignition::math::Vector3d(0.5, 4, 1),
+      ignition::math::Vector3d(3, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->receivedMsg = false;
+  }
+  for (int i = 0; i < 10; ++i)
+  {
+    this->tx->Update(true);
+    common::Time::MSleep(100);
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ASSERT_TRUE(this->receivedMsg);
+
+  // Compare the signal behind the wall with the signal at the same
+  // distance on the other side.
+  double blocked = 0;
+  double clear = 0;
+  int found = 0;
+  for (int i = 0; i < this->gridMsg->particle_size(); ++i)
+  {
+    const msgs::PropagationParticle &p = this->gridMsg->particle(i);
+    EXPECT_LE(std::hypot(p.x(), p.y()), 10.0 + 1e-6);
+    if (std::abs(p.y()) < 1e-6 && std::abs(p.x() - 6.0) < 1e-6)
+    {
+      blocked = p.signal_level();
+      ++found;
+    }
+    else if (std::abs(p.y()) < 1e-6 && std::abs(p.x() + 6.0) < 1e-6)
+    {
+      clear = p.signal_level();
+      ++found;
+    }
+  }
+  ASSERT_EQ(2, found);
+
+  // The obstacle exponent adds about 47 dB of loss at 6 m
+  EXPECT_LT(blocked, clear - 10.0);
+}
+
 /////////////////////////////////////////////////
 TEST_F(WirelessTransmitter_TEST, TestSensorCreation)
 {
@@ -266,6 +325,12 @@ TEST_F(WirelessTransmitter_TEST, TestUpdateImplNoVisual)
   TestUpdateImplNoVisual();
 }
 
+/////////////////////////////////////////////////
+TEST_F(WirelessTransmitter_TEST, TestPropagationGridObstacle)
+{
+  TestPropagationGridObstacle();
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -184,8 +184,15 @@ std::string LogPlay::Header() const
          << "</gazebo_version>\n"
          << "<rand_seed>" << this->dataPtr->randSeed << "</rand_seed>\n"
          << "<log_start>" << this->dataPtr->logStartTime << "</log_start>\n"
-         << "<log_end>" << this->dataPtr->logEndTime << "</log_end>\n"
-         << "</header>\n";
+         << "<log_end>" << this->dataPtr->logEndTime << "</log_end>\n";
+
+  if (this->dataPtr->keyframePeriod > 0)
+  {
+    stream << "<keyframe_period>" << this->dataPtr->keyframePeriod
+           << "</keyframe_period>\n";
+  }
+
+  stream << "</header>\n";
 
   return stream.str();
 }
@@ -211,6 +218,7 @@ void LogPlay::ReadHeader()
 
   this->dataPtr->logVersion.clear();
   this->dataPtr->gazeboVersion.clear();
+  this->dataPtr->keyframePeriod = 0;
 
   // Get the header element
   headerXml = this->dataPtr->logStartXml->FirstChildElement("header");
@@ -253,6 +261,24 @@ void LogPlay::ReadHeader()
 
   // Set the random number seed for simulation
   ignition::math::Rand::Seed(this->dataPtr->randSeed);
+
+  // Get the keyframe period, which is only present in logs that contain
+  // partial states.
+  childXml = headerXml->FirstChildElement("keyframe_period");
+  if (childXml)
+  {
+    const char *text = childXml->GetText();
+    try
+    {
+      this->dataPtr->keyframePeriod = std::stod(text ? text : "");
+    }
+    catch(...)
+    {
+      gzerr << "Log file header has an invalid keyframe period["
+            << (text ? text : "") << "]. Playing it without keyframes.\n";
+      this->dataPtr->keyframePeriod = 0;
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -399,6 +425,12 @@ uint32_t LogPlay::RandSeed() const
   return this->dataPtr->randSeed;
 }
 
+/////////////////////////////////////////////////
+double LogPlay::KeyframePeriod() const
+{
+  return this->dataPtr->keyframePeriod;
+}
+
 /////////////////////////////////////////////////
 common::Time LogPlay::LogStartTime() const
 {
@@ -82,6 +82,15 @@ namespace gazebo
       /// random number seed, as defined in ignition::math::Rand::Seed.
       public: uint32_t RandSeed() const;
 
+      /// \brief Get the keyframe period of the open log file. Between
+      /// keyframes, a log only contains the states that have changed, so
+      /// reconstructing the state at a given time requires playing the
+      /// states since the previous keyframe.
+      /// \return Keyframe period in seconds, or zero if every state in the
+      /// log is a full state.
+      /// \sa LogRecord::SetKeyframePeriod
+      public: double KeyframePeriod() const;
+
       /// \brief Get the log start time of the open log file.
       /// \return Start time of the log.
       public: common::Time LogStartTime() const;
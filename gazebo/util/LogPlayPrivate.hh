@@ -84,6 +84,10 @@ namespace gazebo
       /// \brief The random number seed recorded in the open log file.
       public: uint32_t randSeed = 0;
 
+      /// \brief Keyframe period recorded in the open log file, zero if
+      /// every state in the log is a full state.
+      public: double keyframePeriod = 0;
+
       /// \brief Log start time (simulation time).
       public: common::Time logStartTime;
 
@@ -17,8 +17,12 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/LogPlay.hh"
@@ -457,6 +461,49 @@ TEST_F(LogPlay_TEST, NoEndTag)
 #endif
 }
 
+/////////////////////////////////////////////////
+/// \brief Test reading the keyframe period from the log header
+TEST_F(LogPlay_TEST, KeyframePeriod)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  std::ifstream srcFile(std::string(TEST_PATH) + "/logs/state3.log",
+      std::ios::binary);
+  ASSERT_TRUE(srcFile.good());
+  std::ostringstream src;
+  src << srcFile.rdbuf();
+  const std::string log = src.str();
+  const size_t headerEnd = log.find("</header>");
+  ASSERT_NE(std::string::npos, headerEnd);
+
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_keyframe_test" << std::this_thread::get_id();
+  const std::string tmpFilename = stream.str();
+
+  // A valid period, and malformed ones that are ignored
+  const std::vector<std::pair<std::string, double>> periods = {
+    {"<keyframe_period>0.5</keyframe_period>", 0.5},
+    {"<keyframe_period>half</keyframe_period>", 0},
+    {"<keyframe_period></keyframe_period>", 0},
+    {"<keyframe_period>1e999</keyframe_period>", 0}};
+  for (auto const &period : periods)
+  {
+    std::ofstream destFile(tmpFilename, std::ios::binary);
+    ASSERT_TRUE(destFile.good());
+    destFile << log.substr(0, headerEnd) << period.first
+             << log.substr(headerEnd);
+    destFile.close();
+
+    EXPECT_NO_THROW(player->Open(tmpFilename));
+    EXPECT_DOUBLE_EQ(period.second, player->KeyframePeriod()) << period.first;
+  }
+
+  std::remove(tmpFilename.c_str());
+#endif
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -25,7 +25,12 @@
   #define access _access
 #endif
 
+#include <algorithm>
+#include <ctime>
+#include <fstream>
 #include <functional>
+#include <sstream>
+#include <vector>
 
 #include <boost/archive/iterators/base64_from_binary.hpp>
 #include <boost/archive/iterators/insert_linebreaks.hpp>
@@ -58,6 +63,64 @@
 using namespace gazebo;
 using namespace util;
 
+namespace
+{
+  /// \brief Compute the SHA1 of a file, reading it in fixed size chunks.
+  /// \param[in] _path File to hash.
+  /// \return Hexadecimal SHA1 of the file, or an empty string if the
+  /// file could not be read.
+  std::string FileSha1(const boost::filesystem::path &_path)
+  {
+    std::ifstream in(_path.string(), std::ios::binary);
+    if (!in)
+      return "";
+
+    boost::uuids::detail::sha1 sha1;
+    std::vector<char> chunk(64 * 1024);
+    while (in)
+    {
+      in.read(chunk.data(), chunk.size());
+      if (in.gcount() > 0)
+        sha1.process_bytes(chunk.data(), static_cast<size_t>(in.gcount()));
+    }
+    if (in.bad())
+      return "";
+
+    // Same format as common::get_sha1
+    unsigned int hash[5];
+    sha1.get_digest(hash);
+    std::stringstream stream;
+    for (std::size_t i = 0; i < sizeof(hash) / sizeof(hash[0]); ++i)
+    {
+      stream << std::setfill('0')
+             << std::setw(sizeof(hash[0]) * 2)
+             << std::hex
+             << hash[i];
+    }
+    return stream.str();
+  }
+
+  /// \brief Check whether a path is equal to or inside a directory.
+  /// \param[in] _dir Directory.
+  /// \param[in] _path Path to check.
+  /// \return True if _path is _dir or lies inside it.
+  bool IsWithin(const boost::filesystem::path &_dir,
+      const boost::filesystem::path &_path)
+  {
+    auto dirIt = _dir.begin();
+    auto pathIt = _path.begin();
+    for (; dirIt != _dir.end(); ++dirIt, ++pathIt)
+    {
+      // Ignore a trailing separator on the directory
+      if (dirIt->string() == ".")
+        continue;
+      if (pathIt == _path.end() || *dirIt != *pathIt)
+        return false;
+    }
+    return true;
+  }
+}
+
 //////////////////////////////////////////////////
 LogRecord::LogRecord()
 : dataPtr(new LogRecordPrivate)
@@ -89,6 +152,11 @@ LogRecord::LogRecord()
     this->dataPtr->logBasePath = boost::filesystem::path(homePath);
   }
 
+  // Resources are shared across recordings through a content addressed
+  // cache next to the default log directory.
+  this->dataPtr->resourceCachePath =
+      this->dataPtr->logBasePath / ".gazebo" / "log_resources";
+
   this->dataPtr->logBasePath /= "/.gazebo/log/";
 
   this->dataPtr->logsEnd = this->dataPtr->logs.end();
@@ -163,6 +231,16 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
     return false;
   }
 
+  // Latch the keyframe period for this recording, since it is stored in
+  // the log header. Keyframes can't be closer together than the recorded
+  // states.
+  this->dataPtr->keyframePeriod = this->dataPtr->nextKeyframePeriod;
+  if (this->dataPtr->keyframePeriod > 0 && this->dataPtr->period > 0)
+  {
+    this->dataPtr->keyframePeriod =
+      std::max(this->dataPtr->keyframePeriod, this->dataPtr->period);
+  }
+
   // Get the current time as an ISO string.
   std::string logTimeDir = common::Time::GetWallTimeAsISOString();
 
@@ -262,6 +340,20 @@ void LogRecord::Fini()
     this->dataPtr->cleanupThread->join();
   this->dataPtr->cleanupThread.reset();
 
+  // Finish any pending resource copies and stop the resource thread.
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->resourceMutex);
+    this->dataPtr->stopResourceThread = true;
+    this->dataPtr->resourceCondition.notify_all();
+  }
+  if (this->dataPtr->resourceThread &&
+      this->dataPtr->resourceThread->joinable())
+  {
+    this->dataPtr->resourceThread->join();
+  }
+  this->dataPtr->resourceThread.reset();
+  this->dataPtr->stopResourceThread = false;
+
   std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
   this->dataPtr->connections.clear();
 
@@ -273,11 +365,21 @@ void LogRecord::Fini()
 void LogRecord::Stop()
 {
   this->dataPtr->running = false;
+  this->dataPtr->keyframePeriod = this->dataPtr->nextKeyframePeriod;
   this->dataPtr->cleanupCondition.notify_all();
 
   if (this->dataPtr->cleanupThread && this->dataPtr->cleanupThread->joinable())
     this->dataPtr->cleanupThread->join();
   this->dataPtr->cleanupThread.reset();
+
+  // The cleanup thread already waited for the resources of the recording,
+  // this also covers resources queued without one.
+  if (!this->WaitForResources())
+  {
+    gzerr << "Failed to copy some resources into the log ["
+          << this->dataPtr->logCompletePath.string() << "]" << std::endl;
+  }
+
   this->dataPtr->savedModels.clear();
   this->dataPtr->savedFiles.clear();
 }
@@ -319,6 +421,18 @@ double LogRecord::Period() const
 //////////////////////////////////////////////////
 void LogRecord::SetPeriod(const double _period)
 {
+  // Seeking a log with keyframes relies on keyframes being at most two
+  // keyframe periods apart
+  if (this->dataPtr->running && this->dataPtr->keyframePeriod > 0 &&
+      _period > this->dataPtr->keyframePeriod)
+  {
+    gzwarn << "Recording period [" << _period << "] is limited to the "
+           << "keyframe period [" << this->dataPtr->keyframePeriod
+           << "] of the recording in progress" << std::endl;
+    this->dataPtr->period = this->dataPtr->keyframePeriod;
+    return;
+  }
+
   this->dataPtr->period = _period;
 }
 
@@ -340,6 +454,32 @@ bool LogRecord::Running() const
   return this->dataPtr->running;
 }
 
+//////////////////////////////////////////////////
+double LogRecord::KeyframePeriod() const
+{
+  return this->dataPtr->keyframePeriod;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetKeyframePeriod(const double _period)
+{
+  this->dataPtr->nextKeyframePeriod = _period;
+  if (!this->dataPtr->running)
+    this->dataPtr->keyframePeriod = _period;
+}
+
+//////////////////////////////////////////////////
+double LogRecord::DriftThreshold() const
+{
+  return this->dataPtr->driftThreshold;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetDriftThreshold(const double _threshold)
+{
+  this->dataPtr->driftThreshold = _threshold;
+}
+
 //////////////////////////////////////////////////
 bool LogRecord::RecordResources() const
 {
@@ -549,11 +689,7 @@ bool LogRecord::SaveModels(const std::set<std::string> &_models)
         modelFound = true;
         boost::filesystem::path destModelPath =
           this->dataPtr->logCompletePath / model;
-        if (!gazebo::common::copyDir(srcModelPath, destModelPath))
-        {
-          gzerr << "Failed to copy model from '" << srcModelPath.string()
-                 << "' to '" << destModelPath.string() << "'" << std::endl;
-        }
+        this->dataPtr->QueueResource(srcModelPath, destModelPath);
         break;
       }
     }
@@ -631,15 +767,7 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
         srcPath = srcPath / modelPath;
         boost::filesystem::path destPath =
           this->dataPtr->logCompletePath / modelPath;
-        boost::system::error_code errorCode;
-        boost::filesystem::create_directories(destPath, errorCode);
-        if (errorCode != boost::system::errc::success ||
-            !gazebo::common::copyDir(srcPath, destPath))
-        {
-          gzerr << "Failed to copy model from '" << srcPath.string()
-                 << "' to '" << destPath.string() << "'" << std::endl;
-          saveError = true;
-        }
+        this->dataPtr->QueueResource(srcPath, destPath);
       }
       // else copy only the specified file
       else
@@ -647,17 +775,7 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
         srcPath = srcPath / fileName;
         boost::filesystem::path destPath =
           this->dataPtr->logCompletePath / fileName;
-        boost::system::error_code errorCode;
-        boost::filesystem::create_directories(
-            destPath.parent_path(), errorCode);
-        if (errorCode == boost::system::errc::success)
-          boost::filesystem::copy_file(srcPath, destPath, errorCode);
-        else
-        {
-          gzerr << "Failed to copy file from '" << srcPath.string()
-                 << "' to '" << destPath.string() << "'" << std::endl;
-          saveError = true;
-        }
+        this->dataPtr->QueueResource(srcPath, destPath);
       }
     }
     else
@@ -670,6 +788,328 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
   return !saveError;
 }
 
+//////////////////////////////////////////////////
+bool LogRecord::WaitForResources()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->resourceMutex);
+  this->dataPtr->resourceDoneCondition.wait(lock, [this]
+      {return this->dataPtr->resourcesPending == 0;});
+
+  bool result = !this->dataPtr->resourceError;
+  this->dataPtr->resourceError = false;
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::string LogRecord::ResourceCachePath() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->resourceMutex);
+  return this->dataPtr->resourceCachePath.string();
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetResourceCachePath(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->resourceMutex);
+  this->dataPtr->resourceCachePath = _path;
+}
+
+//////////////////////////////////////////////////
+uintmax_t LogRecord::ResourceCacheSize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->resourceMutex);
+  return this->dataPtr->resourceCacheSize;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetResourceCacheSize(const uintmax_t _size)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->resourceMutex);
+  this->dataPtr->resourceCacheSize = _size;
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::QueueResource(const boost::filesystem::path &_src,
+    const boost::filesystem::path &_dest)
+{
+  std::lock_guard<std::mutex> lock(this->resourceMutex);
+
+  // Meshes of the same model all queue the model directory.
+  ResourceJob job(_src, _dest);
+  if (std::find(this->resourceJobs.begin(), this->resourceJobs.end(), job) !=
+      this->resourceJobs.end())
+  {
+    return;
+  }
+
+  this->resourceJobs.push_back(job);
+  ++this->resourcesPending;
+
+  if (!this->resourceThread)
+  {
+    this->resourceThread.reset(new std::thread(
+        std::bind(&LogRecordPrivate::RunResourceThread, this)));
+  }
+  this->resourceCondition.notify_one();
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::RunResourceThread()
+{
+  std::unique_lock<std::mutex> lock(this->resourceMutex);
+  while (true)
+  {
+    this->resourceCondition.wait(lock, [this]
+        {return this->stopResourceThread || !this->resourceJobs.empty();});
+
+    // Only exit once all the queued resources have been copied.
+    if (this->resourceJobs.empty())
+      break;
+
+    ResourceJob job = this->resourceJobs.front();
+    this->resourceJobs.pop_front();
+    lock.unlock();
+
+    bool result = this->ArchiveResource(job);
+    if (!result)
+    {
+      gzerr << "Failed to copy resource from '" << job.first.string()
+             << "' to '" << job.second.string() << "'" << std::endl;
+    }
+
+    // Bound the cache once the queue is drained rather than after every
+    // file, trimming walks the whole cache.
+    lock.lock();
+    if (this->resourceJobs.empty())
+    {
+      lock.unlock();
+      this->TrimResourceCache();
+      lock.lock();
+    }
+
+    this->resourceError = this->resourceError || !result;
+    if (--this->resourcesPending == 0)
+      this->resourceDoneCondition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+bool LogRecordPrivate::ArchiveResource(const ResourceJob &_job)
+{
+  namespace fs = boost::filesystem;
+  boost::system::error_code errorCode;
+
+  if (!fs::is_directory(_job.first, errorCode))
+    return this->ArchiveFile(_job.first, _job.second);
+
+  // Same as common::copyDir, replace any previous copy of the directory.
+  // Queued copies into the directory would race with the removal, drop
+  // the ones this copy already covers. The rest run afterwards.
+  this->CancelResourceJobs(_job);
+  fs::remove_all(_job.second, errorCode);
+
+  bool result = true;
+  std::list<ResourceJob> dirs = {_job};
+  while (!dirs.empty())
+  {
+    ResourceJob dir = dirs.front();
+    dirs.pop_front();
+
+    fs::create_directories(dir.second, errorCode);
+    if (errorCode)
+      return false;
+
+    for (fs::directory_iterator file(dir.first, errorCode);
+         !errorCode && file != fs::directory_iterator();
+         file.increment(errorCode))
+    {
+      fs::path current(file->path());
+      boost::system::error_code statError;
+      if (fs::is_directory(current, statError))
+        dirs.push_back(ResourceJob(current, dir.second / current.filename()));
+      else if (!this->ArchiveFile(current, dir.second / current.filename()))
+        result = false;
+    }
+
+    if (errorCode)
+      result = false;
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool LogRecordPrivate::ArchiveFile(const boost::filesystem::path &_src,
+    const boost::filesystem::path &_dest)
+{
+  namespace fs = boost::filesystem;
+  boost::system::error_code errorCode;
+
+  fs::create_directories(_dest.parent_path(), errorCode);
+  if (errorCode)
+    return false;
+
+  // Never overwrite a resource that is already in the log.
+  if (fs::exists(_dest, errorCode))
+    return true;
+
+  fs::path cachePath;
+  {
+    std::lock_guard<std::mutex> lock(this->resourceMutex);
+    cachePath = this->resourceCachePath;
+  }
+
+  if (!cachePath.empty())
+  {
+    // Only hash files that changed since they were last archived.
+    boost::system::error_code sizeError, timeError;
+    auto stamp = std::make_pair(fs::file_size(_src, sizeError),
+        fs::last_write_time(_src, timeError));
+
+    std::string hash;
+    auto cached = this->resourceHashes.find(_src.string());
+    if (!sizeError && !timeError && cached != this->resourceHashes.end() &&
+        cached->second.first == stamp)
+    {
+      hash = cached->second.second;
+    }
+    else
+    {
+      hash = FileSha1(_src);
+      if (!hash.empty())
+        this->resourceHashes[_src.string()] = std::make_pair(stamp, hash);
+    }
+
+    if (!hash.empty())
+    {
+      fs::path cacheFile = cachePath / hash.substr(0, 2) / hash;
+      if (fs::exists(cacheFile, errorCode))
+      {
+        // Mark as recently used, see TrimResourceCache.
+        fs::last_write_time(cacheFile, std::time(nullptr), errorCode);
+      }
+      else
+      {
+        // Copy under a temporary name first so that other recordings
+        // sharing the cache never copy a partially written file.
+        fs::path tmpFile = cacheFile.parent_path() /
+            fs::unique_path(hash + "-%%%%-%%%%");
+        boost::system::error_code cacheError;
+        fs::create_directories(cacheFile.parent_path(), cacheError);
+        if (!cacheError)
+          fs::copy_file(_src, tmpFile, cacheError);
+        if (!cacheError)
+          fs::rename(tmpFile, cacheFile, cacheError);
+        if (cacheError)
+          fs::remove(tmpFile, errorCode);
+      }
+
+      // Link the cached file into the log. Evicting it from the cache
+      // later only removes the cache's link. Copy when linking fails, e.g.
+      // when the log and the cache are on different file systems.
+      fs::create_hard_link(cacheFile, _dest, errorCode);
+      if (!errorCode)
+        return true;
+      errorCode.clear();
+      fs::copy_file(cacheFile, _dest, errorCode);
+      if (!errorCode)
+        return true;
+      fs::remove(_dest, errorCode);
+    }
+  }
+
+  // No cache, or the cache is not writable.
+  fs::copy_file(_src, _dest, errorCode);
+  return !errorCode;
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::CancelResourceJobs(const ResourceJob &_job)
+{
+  std::lock_guard<std::mutex> lock(this->resourceMutex);
+  for (auto iter = this->resourceJobs.begin();
+       iter != this->resourceJobs.end();)
+  {
+    if (IsWithin(_job.first, iter->first) &&
+        IsWithin(_job.second, iter->second))
+    {
+      iter = this->resourceJobs.erase(iter);
+      --this->resourcesPending;
+    }
+    else
+      ++iter;
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecordPrivate::TrimResourceCache()
+{
+  namespace fs = boost::filesystem;
+
+  fs::path cachePath;
+  uintmax_t maxSize;
+  {
+    std::lock_guard<std::mutex> lock(this->resourceMutex);
+    cachePath = this->resourceCachePath;
+    maxSize = this->resourceCacheSize;
+  }
+
+  boost::system::error_code errorCode;
+  if (cachePath.empty() || !fs::is_directory(cachePath, errorCode))
+    return;
+
+  struct CacheEntry
+  {
+    std::time_t time;
+    uintmax_t size;
+    fs::path path;
+  };
+  std::vector<CacheEntry> entries;
+  uintmax_t totalSize = 0;
+
+  for (fs::recursive_directory_iterator it(cachePath, errorCode);
+       !errorCode && it != fs::recursive_directory_iterator();
+       it.increment(errorCode))
+  {
+    boost::system::error_code statError;
+    if (!fs::is_regular_file(it->path(), statError))
+      continue;
+
+    // Skip files that another recording is still writing.
+    if (it->path().filename().string().find('-') != std::string::npos)
+      continue;
+
+    CacheEntry entry;
+    entry.size = fs::file_size(it->path(), statError);
+    if (statError)
+      continue;
+    entry.time = fs::last_write_time(it->path(), statError);
+    if (statError)
+      continue;
+    entry.path = it->path();
+    totalSize += entry.size;
+    entries.push_back(entry);
+  }
+
+  if (totalSize <= maxSize)
+    return;
+
+  // Oldest first
+  std::sort(entries.begin(), entries.end(),
+      [](const CacheEntry &_a, const CacheEntry &_b)
+      {
+        return _a.time < _b.time;
+      });
+
+  for (const auto &entry : entries)
+  {
+    if (totalSize <= maxSize)
+      break;
+    if (fs::remove(entry.path, errorCode))
+      totalSize -= entry.size;
+  }
+}
+
 //////////////////////////////////////////////////
 void LogRecord::Notify()
 {
@@ -903,8 +1343,15 @@ void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
          << "<header>\n"
          << "<log_version>" << GZ_LOG_VERSION << "</log_version>\n"
          << "<gazebo_version>" << GAZEBO_VERSION_FULL << "</gazebo_version>\n"
-         << "<rand_seed>" << ignition::math::Rand::Seed() << "</rand_seed>\n"
-         << "</header>\n";
+         << "<rand_seed>" << ignition::math::Rand::Seed() << "</rand_seed>\n";
+
+  if (this->parent->KeyframePeriod() > 0)
+  {
+    stream << "<keyframe_period>" << this->parent->KeyframePeriod()
+           << "</keyframe_period>\n";
+  }
+
+  stream << "</header>\n";
 
   this->buffer.append(stream.str());
 }
@@ -1072,6 +1519,13 @@ void LogRecord::Cleanup()
 
   this->Write(true);
 
+  // Make sure all the resources have been copied into the log.
+  if (!this->WaitForResources())
+  {
+    gzerr << "Failed to copy some resources into the log ["
+          << this->dataPtr->logCompletePath.string() << "]" << std::endl;
+  }
+
   // Stop all the logs
   for (LogRecordPrivate::Log_M::iterator iter = this->dataPtr->logs.begin();
       iter != this->dataPtr->logsEnd; ++iter)
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_UTIL_LOGRECORD_HH_
 #define _GAZEBO_UTIL_LOGRECORD_HH_
 
+#include <cstdint>
 #include <fstream>
 #include <set>
 #include <string>
@@ -120,7 +121,9 @@ namespace gazebo
       /// entity was not registered with the logger.
       public: bool Remove(const std::string &_name);
 
-      /// \brief Stop the logger.
+      /// \brief Stop the logger. Waits until the resources queued by
+      /// SaveModels and SaveFiles are in the log, and prints an error if
+      /// some could not be copied.
       public: void Stop();
 
       /// \brief Tell the recorder that an update should occur.
@@ -141,7 +144,8 @@ namespace gazebo
       /// \return Log recording period in seconds.
       public: double Period() const;
 
-      /// \brief Set the log recording period.
+      /// \brief Set the log recording period. While recording with
+      /// keyframes, the period is limited to the keyframe period.
       /// \param[in] _period New log recording period in seconds.
       public: void SetPeriod(const double _period);
 
@@ -153,6 +157,37 @@ namespace gazebo
       /// \param[in] _filter New log record filter regex string
       public: void SetFilter(const std::string &_filter);
 
+      /// \brief Get the keyframe period.
+      /// \return Keyframe period in seconds. A value <= 0 means every
+      /// recorded state is a full state.
+      /// \sa SetKeyframePeriod
+      public: double KeyframePeriod() const;
+
+      /// \brief Set the keyframe period in seconds of sim time. When > 0,
+      /// the full state is recorded once per keyframe period, and only the
+      /// models that have changed are recorded in between. A value <= 0
+      /// records the full state every time. Start raises values smaller
+      /// than the recording period to the recording period.
+      ///
+      /// A recording in progress keeps the period it was started with,
+      /// since it is stored in the log header, so this takes effect on the
+      /// next recording.
+      /// \param[in] _period Keyframe period in seconds.
+      public: void SetKeyframePeriod(const double _period);
+
+      /// \brief Get the drift threshold used between keyframes.
+      /// \return The drift threshold.
+      /// \sa SetDriftThreshold
+      public: double DriftThreshold() const;
+
+      /// \brief Set the drift threshold used between keyframes. A model is
+      /// recorded once its position (meters), orientation (radians) or
+      /// joint positions have changed by more than this value since it was
+      /// last recorded. A value <= 0 records any change.
+      /// \param[in] _threshold The drift threshold.
+      /// \sa physics::WorldState::Delta
+      public: void SetDriftThreshold(const double _threshold);
+
       /// \brief Get whether the model meshes and materials are saved when
       /// recording.
       /// \return True if model meshes and materials are saved when recording.
@@ -215,15 +250,45 @@ namespace gazebo
       /// \return True if an Update has not yet been completed.
       public: bool FirstUpdate() const;
 
-      /// \brief Return true if all the models are saved successfully.
-      /// \return True if all the models are saved successfully.
+      /// \brief Queue the given models to be saved in the log directory.
+      /// The copies happen in the background. Failed copies are reported
+      /// by WaitForResources and by Stop.
+      /// \return True if all the models are queued successfully.
       public: bool SaveModels(const std::set<std::string> &models);
 
-      /// \brief Return true if all the files are saved successfully.
-      /// \return True if all the files are saved successfully, and false if
-      /// there are errors saving the files.
+      /// \brief Queue the given files to be saved in the log directory.
+      /// The copies happen in the background. Failed copies are reported
+      /// by WaitForResources and by Stop.
+      /// \return True if all the files are queued successfully, and false
+      /// if some files could not be found.
       public: bool SaveFiles(const std::set<std::string> &resources);
 
+      /// \brief Block until all resources queued by SaveModels and
+      /// SaveFiles have been copied into the log. Resources are copied in
+      /// the background, and stopping a recording also waits for them.
+      /// \return True if all the resources were copied successfully.
+      public: bool WaitForResources();
+
+      /// \brief Get the path of the resource cache. Recorded resources are
+      /// stored there once per content and hard linked into each log, or
+      /// copied when linking is not possible.
+      /// \return Path to the resource cache.
+      public: std::string ResourceCachePath() const;
+
+      /// \brief Set the path of the resource cache.
+      /// \param[in] _path Path to the resource cache. An empty path
+      /// disables the cache and resources are copied directly.
+      public: void SetResourceCachePath(const std::string &_path);
+
+      /// \brief Get the maximum size of the resource cache. The least
+      /// recently used resources are removed once the cache grows larger.
+      /// \return Maximum size of the resource cache in bytes.
+      public: uintmax_t ResourceCacheSize() const;
+
+      /// \brief Set the maximum size of the resource cache.
+      /// \param[in] _size Maximum size of the resource cache in bytes.
+      public: void SetResourceCacheSize(const uintmax_t _size);
+
       /// \brief Write all logs.
       /// \param[in] _force True to skip waiting on dataAvailableCondition.
       public: void Write(const bool _force = false);
@@ -22,8 +22,11 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <utility>
 #include <functional>
 #include <condition_variable>
+#include <cstdint>
+#include <ctime>
 #include <boost/filesystem.hpp>
 
 namespace gazebo
@@ -212,11 +215,97 @@ namespace gazebo
       /// \brief Record with model resources.
       public: bool recordResources = false;
 
+      /// \brief Keyframe period of the current recording, latched when it
+      /// starts.
+      public: double keyframePeriod = -1.0;
+
+      /// \brief Keyframe period of the next recording.
+      public: double nextKeyframePeriod = -1.0;
+
+      /// \brief Drift threshold used between keyframes.
+      public: double driftThreshold = 0.0;
+
       /// \brief List of saved models if record with resources is enabled.
       public: std::set<std::string> savedModels;
 
       /// \brief List of saved files if record with resources is enabled.
       public: std::set<std::string> savedFiles;
+
+      /// \brief A pending resource copy. The first element is the source
+      /// file or directory, the second is its destination in the log.
+      public: using ResourceJob =
+                  std::pair<boost::filesystem::path, boost::filesystem::path>;
+
+      /// \brief Queue a resource copy for the resource thread, starting
+      /// the thread if needed.
+      /// \param[in] _src Source file or directory.
+      /// \param[in] _dest Destination file or directory.
+      public: void QueueResource(const boost::filesystem::path &_src,
+                                 const boost::filesystem::path &_dest);
+
+      /// \brief Resource thread, copies queued resources until stopped.
+      public: void RunResourceThread();
+
+      /// \brief Copy a file or directory into the log through the
+      /// resource cache.
+      /// \param[in] _job Resource to copy.
+      /// \return True on success.
+      public: bool ArchiveResource(const ResourceJob &_job);
+
+      /// \brief Place a single file into the log. The file is stored once
+      /// in the resource cache under its SHA1, and copied from there into
+      /// the log directory. Falls back to copying the source file when the
+      /// cache can't be used.
+      /// \param[in] _src Source file.
+      /// \param[in] _dest Destination file.
+      /// \return True on success.
+      public: bool ArchiveFile(const boost::filesystem::path &_src,
+                               const boost::filesystem::path &_dest);
+
+      /// \brief Remove queued jobs that a directory copy supersedes, i.e.
+      /// jobs copying from within _job's source to within its destination.
+      /// \param[in] _job Directory copy about to run.
+      public: void CancelResourceJobs(const ResourceJob &_job);
+
+      /// \brief Remove the least recently used files from the resource
+      /// cache until it fits in resourceCacheSize.
+      public: void TrimResourceCache();
+
+      /// \brief Thread that copies resources in the background.
+      public: std::unique_ptr<std::thread> resourceThread;
+
+      /// \brief Protects the resource queue and counters.
+      public: mutable std::mutex resourceMutex;
+
+      /// \brief Signals the resource thread that work is available.
+      public: std::condition_variable resourceCondition;
+
+      /// \brief Signals waiters that the resource queue is drained.
+      public: std::condition_variable resourceDoneCondition;
+
+      /// \brief Resources waiting to be copied.
+      public: std::list<ResourceJob> resourceJobs;
+
+      /// \brief Number of resources queued or being copied.
+      public: unsigned int resourcesPending = 0;
+
+      /// \brief True if any resource failed to copy since the last wait.
+      public: bool resourceError = false;
+
+      /// \brief True to stop the resource thread.
+      public: bool stopResourceThread = false;
+
+      /// \brief Content addressed cache shared by all recordings.
+      public: boost::filesystem::path resourceCachePath;
+
+      /// \brief Maximum size of the resource cache in bytes.
+      public: uintmax_t resourceCacheSize = 1024 * 1024 * 1024;
+
+      /// \brief SHA1 of previously archived source files, keyed by path
+      /// and valid as long as the file size and modification time match.
+      public: std::map<std::string,
+                  std::pair<std::pair<uintmax_t, std::time_t>, std::string>>
+                  resourceHashes;
     };
     /// \}
   }
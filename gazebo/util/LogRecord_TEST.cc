@@ -15,6 +15,9 @@
  *
 */
 #include <gtest/gtest.h>
+#include <fstream>
+#include <set>
+#include <string>
 #include <boost/filesystem.hpp>
 
 #include "gazebo/common/CommonIface.hh"
@@ -226,6 +229,241 @@ TEST_F(LogRecord_TEST, RecordResources)
   EXPECT_FALSE(recorder->RecordResources());
 }
 
+/////////////////////////////////////////////////
+/// \brief Test LogRecord keyframe parameters
+TEST_F(LogRecord_TEST, Keyframes)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+
+  // check default values
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), -1);
+  EXPECT_DOUBLE_EQ(recorder->DriftThreshold(), 0);
+
+  recorder->SetKeyframePeriod(5);
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), 5);
+
+  recorder->SetDriftThreshold(0.01);
+  EXPECT_DOUBLE_EQ(recorder->DriftThreshold(), 0.01);
+
+  recorder->SetKeyframePeriod(-1);
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), -1);
+
+  recorder->SetDriftThreshold(0);
+  EXPECT_DOUBLE_EQ(recorder->DriftThreshold(), 0);
+
+  // A recording keeps the period it started with, which is in its header
+  EXPECT_TRUE(recorder->Init("test"));
+  recorder->SetKeyframePeriod(5);
+  EXPECT_TRUE(recorder->Start("txt"));
+  recorder->SetKeyframePeriod(2);
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), 5);
+
+  recorder->Stop();
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), 2);
+  recorder->SetKeyframePeriod(-1);
+
+  int i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that keyframes are never closer together than the recorded
+/// states, which seeking a log relies on
+TEST_F(LogRecord_TEST, KeyframePeriodClamp)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+  EXPECT_TRUE(recorder->Init("test"));
+
+  // A keyframe period smaller than the recording period is raised to it
+  gazebo::util::LogRecordParams params;
+  params.encoding = "txt";
+  params.period = 10;
+  recorder->SetKeyframePeriod(2);
+  EXPECT_TRUE(recorder->Start(params));
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), 10);
+
+  // The recording period can't grow past the keyframe period while
+  // recording
+  recorder->SetPeriod(20);
+  EXPECT_DOUBLE_EQ(recorder->Period(), 10);
+  recorder->SetPeriod(5);
+  EXPECT_DOUBLE_EQ(recorder->Period(), 5);
+
+  recorder->Stop();
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), 2);
+
+  // A larger keyframe period is kept
+  params.period = 1;
+  EXPECT_TRUE(recorder->Start(params));
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), 2);
+  recorder->Stop();
+
+  // Without keyframes the recording period is not limited
+  recorder->SetKeyframePeriod(-1);
+  EXPECT_TRUE(recorder->Start(params));
+  EXPECT_DOUBLE_EQ(recorder->KeyframePeriod(), -1);
+  recorder->SetPeriod(20);
+  EXPECT_DOUBLE_EQ(recorder->Period(), 20);
+  recorder->Stop();
+  recorder->SetPeriod(-1);
+
+  int i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that saved files are copied through the resource cache
+TEST_F(LogRecord_TEST, SaveFilesCache)
+{
+  namespace fs = boost::filesystem;
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+
+  fs::path tmpPath = fs::temp_directory_path() /
+      fs::unique_path("gz_log_resources-%%%%-%%%%");
+  fs::path srcPath = tmpPath / "src";
+  fs::create_directories(srcPath);
+
+  // Two files with the same content and one with different content
+  std::ofstream(fs::path(srcPath / "a.txt").string()) << "same";
+  std::ofstream(fs::path(srcPath / "b.txt").string()) << "same";
+  std::ofstream(fs::path(srcPath / "c.txt").string()) << "different";
+
+  std::string defaultCachePath = recorder->ResourceCachePath();
+  EXPECT_FALSE(defaultCachePath.empty());
+  recorder->SetResourceCachePath((tmpPath / "cache").string());
+  EXPECT_EQ(recorder->ResourceCachePath(), (tmpPath / "cache").string());
+
+  EXPECT_TRUE(recorder->Init("test"));
+  EXPECT_TRUE(recorder->Start("zlib", (tmpPath / "log").string()));
+
+  std::set<std::string> files = {
+      (srcPath / "a.txt").string(),
+      (srcPath / "b.txt").string(),
+      (srcPath / "c.txt").string()};
+  EXPECT_TRUE(recorder->SaveFiles(files));
+  EXPECT_TRUE(recorder->WaitForResources());
+
+  // All files are in the log with their original content
+  for (const auto &file : files)
+  {
+    fs::path dest = tmpPath / "log" / file;
+    EXPECT_TRUE(fs::exists(dest)) << dest.string();
+    std::ifstream srcStream(file);
+    std::ifstream destStream(dest.string());
+    std::string srcContent, destContent;
+    std::getline(srcStream, srcContent);
+    std::getline(destStream, destContent);
+    EXPECT_EQ(srcContent, destContent);
+  }
+
+  // Identical content is stored only once in the cache
+  unsigned int cached = 0;
+  for (fs::recursive_directory_iterator it(tmpPath / "cache");
+       it != fs::recursive_directory_iterator(); ++it)
+  {
+    if (fs::is_regular_file(it->path()))
+      ++cached;
+  }
+  EXPECT_EQ(cached, 2u);
+
+  // The log links its files to the cache, both are on the same file
+  // system here
+  for (const auto &file : files)
+    EXPECT_GE(fs::hard_link_count(tmpPath / "log" / file), 2u);
+
+  // Stop recording.
+  recorder->Stop();
+
+  int i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+
+  recorder->SetResourceCachePath(defaultCachePath);
+  fs::remove_all(tmpPath);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that the resource cache is bounded
+TEST_F(LogRecord_TEST, SaveFilesCacheSize)
+{
+  namespace fs = boost::filesystem;
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+
+  fs::path tmpPath = fs::temp_directory_path() /
+      fs::unique_path("gz_log_resources-%%%%-%%%%");
+  fs::path srcPath = tmpPath / "src";
+  fs::create_directories(srcPath);
+
+  // Three files of 100 bytes with different content
+  std::set<std::string> files;
+  for (char c : {'a', 'b', 'c'})
+  {
+    fs::path file = srcPath / (std::string(1, c) + ".txt");
+    std::ofstream(file.string()) << std::string(100, c);
+    files.insert(file.string());
+  }
+
+  std::string defaultCachePath = recorder->ResourceCachePath();
+  uintmax_t defaultCacheSize = recorder->ResourceCacheSize();
+  EXPECT_GT(defaultCacheSize, 0u);
+  recorder->SetResourceCachePath((tmpPath / "cache").string());
+  recorder->SetResourceCacheSize(250);
+  EXPECT_EQ(recorder->ResourceCacheSize(), 250u);
+
+  EXPECT_TRUE(recorder->Init("test"));
+  EXPECT_TRUE(recorder->Start("zlib", (tmpPath / "log").string()));
+
+  EXPECT_TRUE(recorder->SaveFiles(files));
+  EXPECT_TRUE(recorder->WaitForResources());
+
+  // All files are in the log even though the cache was trimmed
+  for (const auto &file : files)
+  {
+    fs::path dest = tmpPath / "log" / file;
+    EXPECT_TRUE(fs::exists(dest)) << dest.string();
+    EXPECT_EQ(fs::file_size(dest), 100u);
+  }
+
+  uintmax_t cacheSize = 0;
+  for (fs::recursive_directory_iterator it(tmpPath / "cache");
+       it != fs::recursive_directory_iterator(); ++it)
+  {
+    if (fs::is_regular_file(it->path()))
+      cacheSize += fs::file_size(it->path());
+  }
+  EXPECT_LE(cacheSize, 250u);
+  EXPECT_GT(cacheSize, 0u);
+
+  // Stop recording.
+  recorder->Stop();
+
+  int i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+
+  recorder->SetResourceCachePath(defaultCachePath);
+  recorder->SetResourceCacheSize(defaultCacheSize);
+  fs::remove_all(tmpPath);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -254,6 +254,26 @@ void LaserTest::LaserUnitBox(const std::string &_physicsEngine)
 
   EXPECT_DOUBLE_EQ(raySensor->Range(samples-1), ignition::math::INF_D);
 
+  // The batched results match the per ray accessors
+  physics::MultiRayShapePtr laserShape = raySensor->LaserShape();
+  ASSERT_EQ(laserShape->Ranges().size(), samples);
+  ASSERT_EQ(laserShape->Retros().size(), samples);
+  ASSERT_EQ(laserShape->HitIds().size(), samples);
+  for (unsigned int i = 0; i < samples; ++i)
+  {
+    EXPECT_DOUBLE_EQ(laserShape->Ranges()[i], laserShape->GetRange(i));
+    EXPECT_DOUBLE_EQ(laserShape->Retros()[i], laserShape->GetRetro(i));
+  }
+
+  if (_physicsEngine == "ode")
+  {
+    physics::Collision_V collisions =
+      world->ModelByName(box01)->GetLink()->GetCollisions();
+    ASSERT_EQ(collisions.size(), 1u);
+    EXPECT_EQ(laserShape->HitIds()[mid], collisions[0]->GetId());
+    EXPECT_EQ(laserShape->HitIds()[samples-1], 0u);
+  }
+
   // Move all boxes out of range
   world->ModelByName(box01)->SetWorldPose(
       ignition::math::Pose3d(
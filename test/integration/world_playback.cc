@@ -15,7 +15,9 @@
  *
 */
 #include <chrono>
+#include <fstream>
 #include <map>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <tuple>
@@ -303,6 +305,91 @@ INSTANTIATE_TEST_CASE_P(LogFiles,
                                           "state2.log",
                                           "state3.log"),);  // NOLINT
 
+/////////////////////////////////////////////////
+/// \brief Fixture that plays a log written by the test.
+class WorldPlaybackInsertionTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Get a state chunk of a log.
+/// \param[in] _time Simulation time in milliseconds.
+/// \param[in] _insertion True to insert the box in this state.
+/// \return The chunk.
+static std::string stateChunk(const int _time, const bool _insertion)
+{
+  std::ostringstream stream;
+  stream << "<chunk encoding='txt'><![CDATA[<sdf version='1.6'>"
+         << "<state world_name='default'>"
+         << "<sim_time>0 " << _time * 1000000 << "</sim_time>"
+         << "<wall_time>0 0</wall_time><real_time>0 " << _time * 1000000
+         << "</real_time><iterations>" << _time << "</iterations>";
+  if (_insertion)
+  {
+    stream << "<insertions><model name='box'><link name='link'>"
+           << "<collision name='collision'><geometry><box><size>1 1 1</size>"
+           << "</box></geometry></collision></link></model></insertions>";
+  }
+  if (_time >= 200)
+  {
+    stream << "<model name='box'><pose>0 0 " << _time / 1000.0
+           << " 0 0 0</pose><scale>1 1 1</scale><link name='link'><pose>0 0 "
+           << _time / 1000.0 << " 0 0 0</pose><velocity>0 0 0 0 0 0"
+           << "</velocity></link></model>";
+  }
+  stream << "</state></sdf>]]></chunk>\n";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Seek across the insertion of a model in a log with keyframes.
+/// The states before the target are applied again on every seek, and the
+/// model must only be inserted once.
+TEST_F(WorldPlaybackInsertionTest, SeekAcrossInsertion)
+{
+  boost::filesystem::path logPath =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_seek_insertion_%%%%%%.log");
+  {
+    std::ofstream logFile(logPath.string());
+    ASSERT_TRUE(logFile.good());
+    logFile << "<?xml version='1.0'?>\n<gazebo_log>\n<header>\n"
+            << "<log_version>1.0</log_version>\n"
+            << "<gazebo_version>11.0.0</gazebo_version>\n"
+            << "<rand_seed>1</rand_seed>\n"
+            << "<keyframe_period>1</keyframe_period>\n</header>\n"
+            << "<chunk encoding='txt'><![CDATA[<sdf version='1.6'>"
+            << "<world name='default'></world></sdf>]]></chunk>\n";
+    for (int time = 100; time <= 500; time += 100)
+      logFile << stateChunk(time, time == 200);
+    logFile << "</gazebo_log>\n";
+  }
+
+  this->LoadArgs("-u -p " + logPath.string());
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  auto pub = node->Advertise<msgs::LogPlaybackControl>("~/playback_control");
+
+  for (const double target : {0.4, 0.3, 0.5})
+  {
+    msgs::LogPlaybackControl msg;
+    msgs::Set(msg.mutable_seek(), common::Time(target));
+    pub->Publish(msg);
+    this->WaitUntilSimTime(common::Time(target), 50, 50);
+    EXPECT_EQ(common::Time(target), world->SimTime());
+
+    EXPECT_EQ(1u, world->ModelCount());
+    auto box = world->ModelByName("box");
+    ASSERT_TRUE(box != nullptr);
+    EXPECT_NEAR(target, box->WorldPose().Pos().Z(), 1e-6);
+  }
+
+  boost::filesystem::remove(logPath);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
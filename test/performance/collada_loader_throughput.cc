@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Mesh.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+/// \brief Get the COLLADA files in a directory.
+/// \param[in] _path Directory.
+/// \return Full paths of the .dae files.
+static std::vector<std::string> colladaFiles(const std::string &_path)
+{
+  std::vector<std::string> files;
+  boost::filesystem::recursive_directory_iterator iter(_path), end;
+  for (; iter != end; ++iter)
+  {
+    if (boost::filesystem::is_regular_file(*iter) &&
+        iter->path().extension() == ".dae")
+    {
+      files.push_back(iter->path().string());
+    }
+  }
+  return files;
+}
+
+/////////////////////////////////////////////////
+/// \brief Load the meshes of media/models and print the load rate.
+TEST(ColladaLoaderThroughput, MediaModels)
+{
+  std::vector<std::string> files =
+      colladaFiles(std::string(PROJECT_SOURCE_PATH) + "/media/models");
+  ASSERT_FALSE(files.empty());
+
+  const unsigned int iterations = 5;
+  uintmax_t bytes = 0;
+  std::chrono::steady_clock::duration elapsed{0};
+
+  for (auto const &file : files)
+  {
+    const uintmax_t size = boost::filesystem::file_size(file);
+    std::chrono::steady_clock::duration fileElapsed{0};
+
+    for (unsigned int i = 0; i < iterations; ++i)
+    {
+      common::ColladaLoader loader;
+      auto start = std::chrono::steady_clock::now();
+      std::unique_ptr<common::Mesh> mesh(loader.Load(file));
+      fileElapsed += std::chrono::steady_clock::now() - start;
+
+      ASSERT_TRUE(mesh != nullptr) << file;
+      EXPECT_GT(mesh->GetVertexCount(), 0u) << file;
+    }
+
+    std::cout << boost::filesystem::path(file).filename().string() << ": "
+      << size << " bytes, "
+      << std::chrono::duration<double, std::milli>(fileElapsed).count() /
+         iterations << " ms per load\n";
+
+    bytes += size * iterations;
+    elapsed += fileElapsed;
+  }
+
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  std::cout << "Loaded " << files.size() << " files " << iterations
+    << " times in " << seconds << " s, "
+    << bytes / seconds / 1e6 << " MB/s\n";
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
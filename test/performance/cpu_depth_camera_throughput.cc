@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <sdf/sdf.hh>
+#include "gazebo/common/Timer.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class CpuDepthCameraThroughput_TEST : public ServerFixture
+{
+};
+
+static std::string cpuDepthSensorString =
+"<sdf version='1.6'>"
+"  <sensor name='depth' type='cpu_depth'>"
+"    <always_on>1</always_on>"
+"    <update_rate>0</update_rate>"
+"    <pose>0 0 0.5 0 0 0</pose>"
+"    <camera>"
+"      <horizontal_fov>1.047</horizontal_fov>"
+"      <image>"
+"        <width>320</width>"
+"        <height>240</height>"
+"      </image>"
+"      <clip>"
+"        <near>0.1</near>"
+"        <far>20</far>"
+"      </clip>"
+"    </camera>"
+"  </sensor>"
+"</sdf>";
+
+/////////////////////////////////////////////////
+/// \brief Measure how many depth pixels per second the cpu depth camera
+/// produces, in front of a field of boxes and spheres.
+TEST_F(CpuDepthCameraThroughput_TEST, MegapixelsPerSecond)
+{
+  Load("worlds/empty.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  // Fill the field of view with shapes at various distances
+  for (int i = 0; i < 10; ++i)
+  {
+    for (int j = -2; j <= 2; ++j)
+    {
+      std::ostringstream name;
+      name << "shape_" << i << "_" << j + 2;
+      ignition::math::Vector3d pos(2 + i * 1.5, j * 1.5 + (i % 2) * 0.5, 0.5);
+      if ((i + j) % 2)
+      {
+        SpawnBox(name.str(), ignition::math::Vector3d(0.8, 0.8, 0.8), pos,
+            ignition::math::Vector3d(0, 0, 0.3 * i), true);
+      }
+      else
+      {
+        SpawnSphere(name.str(), pos, ignition::math::Vector3d::Zero,
+            true, true);
+      }
+    }
+  }
+
+  sdf::ElementPtr sdf(new sdf::Element);
+  sdf::initFile("sensor.sdf", sdf);
+  sdf::readString(cpuDepthSensorString, sdf);
+
+  std::string sensorName = mgr->CreateSensor(sdf, "default",
+      "ground_plane::link", 0);
+  mgr->Update();
+
+  sensors::CpuDepthCameraSensorPtr sensor =
+    std::dynamic_pointer_cast<sensors::CpuDepthCameraSensor>(
+        mgr->GetSensor(sensorName));
+  ASSERT_TRUE(sensor != nullptr);
+
+  // Stop the sensor thread from updating the sensor during the measurement
+  sensor->SetActive(false);
+
+  // Warm up
+  sensor->Update(true);
+
+  const unsigned int iterations = 20;
+  common::Timer timer;
+  timer.Start();
+  for (unsigned int i = 0; i < iterations; ++i)
+    sensor->Update(true);
+  double elapsed = timer.GetElapsed().Double();
+
+  double megapixels = iterations * sensor->ImageWidth() *
+      sensor->ImageHeight() / 1e6;
+  unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+
+  std::cout << "CPU depth camera " << sensor->ImageWidth() << "x"
+            << sensor->ImageHeight() << ": "
+            << megapixels / elapsed << " Mpixel/s, "
+            << megapixels / elapsed / cores << " Mpixel/s per core ("
+            << cores << " cores)" << std::endl;
+
+  EXPECT_GT(elapsed, 0.0);
+
+  std::vector<float> depths;
+  sensor->DepthData(depths);
+  EXPECT_EQ(depths.size(), sensor->ImageWidth() * sensor->ImageHeight());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,7 +14,11 @@
  * limitations under the License.
  *
 */
+#include <chrono>
 #include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 
 #include "gazebo/test/ServerFixture.hh"
@@ -62,6 +66,184 @@ TEST_F(ImageConvertStressTest, ManyConversions)
   EXPECT_LE(memAfter - memBefore, 2000);
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the rate of a number of items processed in a duration.
+/// \param[in] _count Number of items, such as bytes or pixels.
+/// \param[in] _elapsed Duration.
+/// \return Rate in millions per second.
+static double millionsPerSecond(const double _count,
+    const std::chrono::steady_clock::duration &_elapsed)
+{
+  return _count / std::chrono::duration<double>(_elapsed).count() / 1e6;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert camera frames between pixel formats and print the
+/// conversion rates.
+TEST_F(ImageConvertStressTest, ConvertThroughput)
+{
+  using Image = common::Image;
+  const unsigned int width = 1280;
+  const unsigned int height = 720;
+  const size_t pixels = width * height;
+  const unsigned int iterations = 200;
+
+  std::vector<unsigned char> src(pixels * 4);
+  for (size_t i = 0; i < src.size(); ++i)
+    src[i] = static_cast<unsigned char>(i * 7);
+  std::vector<unsigned char> dst(pixels * 4);
+
+  struct Conversion
+  {
+    Image::PixelFormat src;
+    Image::PixelFormat dst;
+  };
+  const std::vector<Conversion> conversions = {
+    {Image::RGB_INT8, Image::BGR_INT8},
+    {Image::RGB_INT8, Image::RGBA_INT8},
+    {Image::RGBA_INT8, Image::BGR_INT8},
+    {Image::BGRA_INT8, Image::RGBA_INT8},
+    {Image::RGB_INT8, Image::L_INT8},
+    {Image::L_INT8, Image::RGB_INT8}};
+
+  for (auto const &conversion : conversions)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; ++i)
+    {
+      ASSERT_TRUE(Image::ConvertPixels(src.data(), conversion.src,
+          dst.data(), conversion.dst, pixels));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << common::PixelFormatNames[conversion.src] << " to "
+      << common::PixelFormatNames[conversion.dst] << ": "
+      << millionsPerSecond(static_cast<double>(pixels) * iterations,
+         elapsed) << " Mpixel/s\n";
+  }
+
+  // Depth images in meters to millimeters, and back
+  std::vector<float> depths(pixels);
+  for (size_t i = 0; i < pixels; ++i)
+    depths[i] = 0.5f + (i % 1000) * 0.01f;
+  std::vector<uint16_t> millimeters(pixels);
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    Image::ConvertDepth(depths.data(), millimeters.data(), pixels);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "R_FLOAT32 to L_INT16 depth: "
+    << millionsPerSecond(static_cast<double>(pixels) * iterations, elapsed)
+    << " Mpixel/s\n";
+
+  start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    Image::ConvertDepth(millimeters.data(), depths.data(), pixels);
+  elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "L_INT16 to R_FLOAT32 depth: "
+    << millionsPerSecond(static_cast<double>(pixels) * iterations, elapsed)
+    << " Mpixel/s\n";
+  EXPECT_FLOAT_EQ(0.5f, depths[0]);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read camera frames out of images, allocating a buffer per frame
+/// and reusing a buffer, and print the rates.
+TEST_F(ImageConvertStressTest, DataThroughput)
+{
+  const unsigned int width = 1280;
+  const unsigned int height = 720;
+  const unsigned int iterations = 200;
+  std::vector<unsigned char> frame(width * height * 4, 128);
+
+  common::Image image;
+  image.SetFromData(frame.data(), width, height, common::Image::RGBA_INT8);
+  const double bytes = static_cast<double>(image.DataSize()) * iterations;
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    unsigned char *data = nullptr;
+    unsigned int size = 0;
+    image.GetData(&data, size);
+    delete [] data;
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "GetData: " << millionsPerSecond(bytes, elapsed)
+    << " MB/s\n";
+
+  std::vector<unsigned char> buffer(image.DataSize());
+  start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    ASSERT_TRUE(image.CopyData(buffer.data(), buffer.size()));
+  elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "CopyData: " << millionsPerSecond(bytes, elapsed)
+    << " MB/s\n";
+
+  std::vector<unsigned char> rgb(width * height * 3);
+  start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    ASSERT_TRUE(image.CopyRGBData(rgb.data(), rgb.size()));
+  elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "CopyRGBData: " << millionsPerSecond(bytes, elapsed)
+    << " MB/s\n";
+
+  start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    msgs::Image msg;
+    msgs::Set(&msg, image);
+  }
+  elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "msgs::Set: " << millionsPerSecond(bytes, elapsed)
+    << " MB/s\n";
+
+  start = std::chrono::steady_clock::now();
+  ignition::math::Color avg = image.AvgColor();
+  ignition::math::Color max = image.MaxColor();
+  elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "AvgColor and MaxColor: "
+    << std::chrono::duration<double, std::milli>(elapsed).count()
+    << " ms\n";
+  EXPECT_EQ(avg, max);
+}
+
+/////////////////////////////////////////////////
+/// \brief Rescale images down and up, and print the time per rescale.
+TEST_F(ImageConvertStressTest, RescaleThroughput)
+{
+  const unsigned int width = 1920;
+  const unsigned int height = 1080;
+  const unsigned int iterations = 10;
+  std::vector<unsigned char> frame(width * height * 3);
+  for (size_t i = 0; i < frame.size(); ++i)
+    frame[i] = static_cast<unsigned char>(i * 13);
+
+  const std::vector<std::pair<unsigned int, unsigned int>> sizes = {
+    {640, 360}, {3840, 2160}, {513, 513}};
+  for (auto const &size : sizes)
+  {
+    std::chrono::steady_clock::duration elapsed{0};
+    for (unsigned int i = 0; i < iterations; ++i)
+    {
+      common::Image image;
+      image.SetFromData(frame.data(), width, height, common::Image::RGB_INT8);
+
+      auto start = std::chrono::steady_clock::now();
+      image.Rescale(size.first, size.second);
+      elapsed += std::chrono::steady_clock::now() - start;
+
+      ASSERT_EQ(size.first, image.GetWidth());
+      ASSERT_EQ(size.second, image.GetHeight());
+    }
+
+    std::cout << width << "x" << height << " to " << size.first << "x"
+      << size.second << ": "
+      << std::chrono::duration<double, std::milli>(elapsed).count() /
+         iterations << " ms per rescale\n";
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
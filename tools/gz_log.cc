@@ -14,6 +14,14 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
@@ -591,6 +599,272 @@ std::string StateFilter::Filter(const std::string &_stateString)
   return result.str();
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the column names of a filtered pose.
+/// \param[in] _filter The pose elements filter string [x,y,z,r,p,a].
+/// \return Column names, in the order FilterBase::FilterPose outputs them.
+static std::vector<std::string> poseColumns(std::string _filter)
+{
+  static const std::vector<std::string> names =
+    {"x", "y", "z", "roll", "pitch", "yaw"};
+
+  boost::erase_all(_filter, "[");
+  boost::erase_all(_filter, "]");
+  if (_filter.empty())
+    return names;
+
+  std::vector<std::string> elements;
+  boost::split(elements, _filter, boost::is_any_of(","));
+
+  std::vector<std::string> result;
+  for (auto const &element : elements)
+  {
+    if (element.empty())
+      continue;
+    switch (element[0])
+    {
+      case 'X': case 'x': result.push_back(names[0]); break;
+      case 'Y': case 'y': result.push_back(names[1]); break;
+      case 'Z': case 'z': result.push_back(names[2]); break;
+      case 'R': case 'r': result.push_back(names[3]); break;
+      case 'P': case 'p': result.push_back(names[4]); break;
+      case 'A': case 'a': result.push_back(names[5]); break;
+      default: break;
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+BatchFilter::BatchFilter(const std::string &_stamp)
+: filter(false, ""), stamp(_stamp.empty() ? "sim" : _stamp)
+{
+  this->stateSdf.reset(new sdf::Element);
+  sdf::initFile("state.sdf", this->stateSdf);
+}
+
+/////////////////////////////////////////////////
+void BatchFilter::Init(const std::string &_filter)
+{
+  this->filter.Init(_filter);
+
+  // Name the value columns after the filtered components. When the rows of
+  // the model, link and joint filters have different columns, or output a
+  // whole state, the columns are only named "value".
+  std::vector<std::vector<std::string> > levels;
+  bool unnamed = false;
+
+  std::vector<std::string> parts(this->filter.parts.begin(),
+      this->filter.parts.end());
+  if (parts.size() >= 2)
+    levels.push_back(poseColumns(parts.size() > 2 ? parts[2] : ""));
+  else if (!this->filter.linkFilter && !this->filter.jointFilter)
+    unnamed = true;
+
+  if (this->filter.linkFilter)
+  {
+    parts.assign(this->filter.linkFilter->parts.begin(),
+        this->filter.linkFilter->parts.end());
+    if (parts.size() >= 2)
+      levels.push_back(poseColumns(parts.size() > 2 ? parts[2] : ""));
+    else
+      unnamed = true;
+  }
+
+  if (this->filter.jointFilter)
+  {
+    parts.assign(this->filter.jointFilter->parts.begin(),
+        this->filter.jointFilter->parts.end());
+    if (parts.size() >= 2)
+    {
+      std::string axes = parts[1];
+      boost::erase_all(axes, "[");
+      boost::erase_all(axes, "]");
+      std::vector<std::string> axisList;
+      boost::split(axisList, axes, boost::is_any_of(","));
+      levels.push_back(std::vector<std::string>());
+      for (auto const &axis : axisList)
+        levels.back().push_back("axis_" + axis);
+    }
+    else
+      unnamed = true;
+  }
+
+  this->columns.clear();
+  for (auto const &level : levels)
+  {
+    if (level != levels.front())
+      unnamed = true;
+  }
+  if (unnamed || levels.empty() || levels.front().empty())
+    this->columns.push_back("value");
+  else
+    this->columns = levels.front();
+}
+
+/////////////////////////////////////////////////
+std::string BatchFilter::Header() const
+{
+  std::string header = "log,";
+  if (this->stamp == "real")
+    header += "real_time";
+  else if (this->stamp == "wall")
+    header += "wall_time";
+  else if (this->stamp == "iterations")
+    header += "iterations";
+  else
+    header += "sim_time";
+
+  header += ",entity";
+  for (auto const &column : this->columns)
+    header += "," + column;
+  return header;
+}
+
+/////////////////////////////////////////////////
+void BatchFilter::AddRows(const std::string &_entity,
+    const std::string &_values, const std::string &_prefix,
+    std::vector<BatchRow> &_rows) const
+{
+  // The filters output one line per filtered element, with the values
+  // separated by spaces.
+  std::istringstream lines(_values);
+  std::string line;
+  while (std::getline(lines, line))
+  {
+    std::list<std::string> values;
+    boost::split(values, line, boost::is_any_of(" \t"),
+        boost::token_compress_on);
+
+    BatchRow row;
+    row.simTime = this->state.GetSimTime();
+    row.text = _prefix + "," + _entity;
+    bool empty = true;
+    for (auto const &value : values)
+    {
+      if (value.empty())
+        continue;
+      row.text += "," + value;
+      empty = false;
+    }
+
+    if (!empty)
+      _rows.push_back(row);
+  }
+}
+
+/////////////////////////////////////////////////
+void BatchFilter::Filter(const std::string &_stateString,
+    const std::string &_label, std::vector<BatchRow> &_rows)
+{
+  // Read and parse the state information
+  this->stateSdf->Clear();
+  sdf::readString(_stateString, this->stateSdf);
+  this->state.Load(this->stateSdf);
+
+  std::ostringstream prefix;
+  prefix.setf(std::ios::fixed);
+  prefix << _label << ",";
+  if (this->stamp == "real")
+    prefix << this->state.GetRealTime().Double();
+  else if (this->stamp == "wall")
+    prefix << this->state.GetWallTime().Double();
+  else if (this->stamp == "iterations")
+    prefix << this->state.GetIterations();
+  else
+    prefix << this->state.GetSimTime().Double();
+
+  // Walk the models, links and joints as ModelFilter::Filter does, so
+  // that each row names its entity.
+  std::list<std::string> &parts = this->filter.parts;
+  std::list<std::string>::iterator partIter = parts.begin();
+
+  gazebo::physics::ModelState_M models;
+  if (partIter != parts.end() && !(*partIter).empty() && *partIter != "*")
+  {
+    std::string regexStr = *partIter;
+    boost::replace_all(regexStr, "*", ".*");
+    models = this->state.GetModelStates(boost::regex(regexStr));
+  }
+  else
+    models = this->state.GetModelStates();
+
+  if (partIter != parts.end())
+    ++partIter;
+
+  LinkFilter *linkFilter = this->filter.linkFilter;
+  JointFilter *jointFilter = this->filter.jointFilter;
+  for (auto &model : models)
+  {
+    const std::string modelName = model.second.GetName();
+
+    // No parts, output the whole model state.
+    if (!linkFilter && !jointFilter && partIter == parts.end())
+    {
+      std::ostringstream whole;
+      whole << std::fixed << model.second;
+      this->AddRows(modelName, whole.str(), prefix.str(), _rows);
+      continue;
+    }
+
+    if (partIter != parts.end())
+    {
+      this->AddRows(modelName,
+          this->filter.FilterParts(model.second, partIter), prefix.str(),
+          _rows);
+    }
+
+    if (linkFilter && !linkFilter->parts.empty())
+    {
+      auto linkPartIter = linkFilter->parts.begin();
+      gazebo::physics::LinkState_M links;
+      if (*linkPartIter != "*")
+      {
+        std::string regexStr = *linkPartIter;
+        boost::replace_all(regexStr, "*", ".*");
+        links = model.second.GetLinkStates(boost::regex(regexStr));
+      }
+      else
+        links = model.second.GetLinkStates();
+      ++linkPartIter;
+
+      for (auto &link : links)
+      {
+        std::ostringstream values;
+        if (linkPartIter != linkFilter->parts.end())
+          values << linkFilter->FilterParts(link.second, linkPartIter);
+        else
+          values << std::fixed << link.second << std::endl;
+        this->AddRows(modelName + "::" + link.second.GetName(),
+            values.str(), prefix.str(), _rows);
+      }
+    }
+
+    if (jointFilter && !jointFilter->parts.empty())
+    {
+      auto jointPartIter = jointFilter->parts.begin();
+      std::string regexStr = *jointPartIter;
+      boost::replace_all(regexStr, "*", ".*");
+      gazebo::physics::JointState_M joints =
+        model.second.GetJointStates(boost::regex(regexStr));
+      ++jointPartIter;
+
+      for (auto &joint : joints)
+      {
+        std::ostringstream values;
+        if (jointPartIter != jointFilter->parts.end())
+          values << jointFilter->FilterParts(joint.second, jointPartIter);
+        else if (joint.second.GetAngleCount() == 1)
+          values << std::fixed << joint.second.Position(0);
+        else
+          values << std::fixed << joint.second;
+        this->AddRows(modelName + "::" + joint.first, values.str(),
+            prefix.str(), _rows);
+      }
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 LogCommand::LogCommand()
   : Command("log", "Introspects and manipulates Gazebo log files.")
@@ -622,7 +896,20 @@ LogCommand::LogCommand()
      "Valid in conjunction with the output command. See also the "
      "--output argument.")
     ("filter", po::value<std::string>(),
-     "Filter output. Valid only with the echo, step, and output commands");
+     "Filter output. Valid only with the echo, step, output, and batch "
+     "commands")
+    ("batch,b", po::value<std::vector<std::string> >()->multitoken(),
+     "Filter one or more log files into CSV rows of the form "
+     "'log,stamp,entity,value,...', after a header line naming the columns. "
+     "Rows are written to the --output file, or to screen. Valid in "
+     "conjunction with the filter, stamp, hz, start, end and jobs commands.")
+    ("start", po::value<double>(), "Only output states at or after this sim "
+     "time, in seconds. Only valid for the batch command.")
+    ("end", po::value<double>(), "Only output states at or before this sim "
+     "time, in seconds. Only valid for the batch command.")
+    ("jobs,j", po::value<unsigned int>(), "Number of threads used to filter "
+     "states. Defaults to the number of cores. Only valid for the batch "
+     "command.");
 }
 
 /////////////////////////////////////////////////
@@ -668,6 +955,21 @@ bool LogCommand::RunImpl()
 
   raw = this->vm.count("raw");
 
+  if (this->vm.count("batch"))
+  {
+    double start = this->vm.count("start") ?
+      this->vm["start"].as<double>() : 0;
+    double end = this->vm.count("end") ? this->vm["end"].as<double>() : 0;
+    unsigned int jobs = this->vm.count("jobs") ?
+      this->vm["jobs"].as<unsigned int>() : std::thread::hardware_concurrency();
+    std::string output = this->vm.count("output") ?
+      this->vm["output"].as<std::string>() : "";
+
+    this->Batch(this->vm["batch"].as<std::vector<std::string> >(), output,
+        filter, stamp, hz, start, end, jobs);
+    return true;
+  }
+
   if (!this->vm.count("record"))
   {
     // Load the log file
@@ -980,6 +1282,206 @@ void LogCommand::Step(const std::string &_filter, bool _raw,
     std::cout << "</gazebo_log>\n";
 }
 
+/////////////////////////////////////////////////
+void LogCommand::Batch(const std::vector<std::string> &_files,
+    const std::string &_outFilename, const std::string &_filter,
+    const std::string &_stamp, const double _hz, const double _start,
+    const double _end, const unsigned int _jobs)
+{
+  // Number of states handed to a worker at a time.
+  const size_t blockSize = 256;
+
+  /// \brief A block of consecutive states from one log file.
+  struct Block
+  {
+    std::string label;
+    std::vector<std::string> states;
+    std::promise<std::vector<BatchRow> > rows;
+  };
+
+  if (_filter.empty())
+  {
+    std::cerr << "A filter is required for batch processing. "
+      << "Use the --filter argument.\n";
+    return;
+  }
+
+  std::ofstream outFile;
+  if (!_outFilename.empty())
+  {
+    outFile.open(_outFilename, std::fstream::out);
+    if (!outFile.is_open())
+    {
+      std::cerr << "Unable to open file[" << _outFilename
+        << "] for writing.\n";
+      return;
+    }
+  }
+  std::ostream &out = _outFilename.empty() ?
+    static_cast<std::ostream &>(std::cout) : outFile;
+
+  unsigned int jobs = std::max(_jobs, 1u);
+
+  // Create one filter per worker up front, since constructing them is not
+  // thread safe.
+  std::vector<std::unique_ptr<BatchFilter> > filters;
+  for (unsigned int i = 0; i < jobs; ++i)
+  {
+    filters.emplace_back(new BatchFilter(_stamp));
+    filters.back()->Init(_filter);
+  }
+
+  out << filters.front()->Header() << "\n";
+
+  std::mutex queueMutex;
+  std::condition_variable queueCondition;
+  std::deque<std::shared_ptr<Block> > queue;
+  bool done = false;
+
+  std::vector<std::thread> workers;
+  for (unsigned int i = 0; i < jobs; ++i)
+  {
+    workers.push_back(std::thread([&, i]()
+    {
+      while (true)
+      {
+        std::shared_ptr<Block> block;
+        {
+          std::unique_lock<std::mutex> lock(queueMutex);
+          queueCondition.wait(lock, [&]{return done || !queue.empty();});
+          if (queue.empty())
+            return;
+          block = queue.front();
+          queue.pop_front();
+        }
+
+        try
+        {
+          std::vector<BatchRow> rows;
+          for (auto const &stateString : block->states)
+            filters[i]->Filter(stateString, block->label, rows);
+          block->rows.set_value(rows);
+        }
+        catch(...)
+        {
+          block->rows.set_exception(std::current_exception());
+        }
+      }
+    }));
+  }
+
+  // Rows are written in log order, applying the time range and rate
+  // filtering, which depend on the previous output.
+  size_t prevFile = _files.size();
+  gazebo::common::Time prevTime;
+  std::deque<std::pair<size_t, std::future<std::vector<BatchRow> > > >
+    pending;
+  auto writeFront = [&]()
+  {
+    if (pending.front().first != prevFile)
+    {
+      prevFile = pending.front().first;
+      prevTime = gazebo::common::Time::Zero;
+    }
+
+    std::vector<BatchRow> rows;
+    try
+    {
+      rows = pending.front().second.get();
+    }
+    catch(gazebo::common::Exception &_e)
+    {
+      std::cerr << "Unable to filter states from log file["
+        << _files[prevFile] << "]: " << _e.GetErrorStr() << "\n";
+    }
+    catch(std::exception &_e)
+    {
+      std::cerr << "Unable to filter states from log file["
+        << _files[prevFile] << "]: " << _e.what() << "\n";
+    }
+
+    for (auto const &row : rows)
+    {
+      if (row.simTime.Double() < _start ||
+          (_end > 0 && row.simTime.Double() > _end))
+      {
+        continue;
+      }
+
+      if (_hz > 0.0 && prevTime != gazebo::common::Time::Zero &&
+          row.simTime != prevTime &&
+          (row.simTime - prevTime).Double() < 1.0 / _hz)
+      {
+        continue;
+      }
+
+      prevTime = row.simTime;
+      out << row.text << "\n";
+    }
+    pending.pop_front();
+  };
+
+  auto submit = [&](const size_t _file, std::shared_ptr<Block> _block)
+  {
+    pending.push_back(std::make_pair(_file, _block->rows.get_future()));
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      queue.push_back(_block);
+    }
+    queueCondition.notify_one();
+
+    // Bound the memory used by decoded states that are waiting.
+    while (pending.size() > 2 * jobs)
+      writeFront();
+  };
+
+  // LogPlay is a singleton, so logs are decoded one at a time on this
+  // thread while the workers parse and filter the decoded states.
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+  for (size_t f = 0; f < _files.size(); ++f)
+  {
+    if (!this->LoadLogFromFile(_files[f]))
+      continue;
+
+    std::shared_ptr<Block> block(new Block);
+    block->label = _files[f];
+
+    std::string stateString;
+    unsigned int i = 0;
+    while (play->Step(stateString))
+    {
+      // The first frame holds the world description.
+      if (i++ == 0)
+        continue;
+
+      block->states.push_back(stateString);
+      if (block->states.size() >= blockSize)
+      {
+        submit(f, block);
+        block.reset(new Block);
+        block->label = _files[f];
+      }
+    }
+
+    if (!block->states.empty())
+      submit(f, block);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    done = true;
+  }
+  queueCondition.notify_all();
+
+  while (!pending.empty())
+    writeFront();
+
+  for (auto &worker : workers)
+    worker.join();
+
+  out.flush();
+}
+
 /////////////////////////////////////////////////
 void LogCommand::Record(bool _start)
 {
@@ -19,6 +19,7 @@
 
 #include <string>
 #include <list>
+#include <vector>
 
 #include <gazebo/physics/WorldState.hh>
 #include "gz.hh"
@@ -187,6 +188,68 @@ namespace gazebo
     private: gazebo::common::Time prevTime;
   };
 
+  /// \brief A single row of batch output.
+  struct BatchRow
+  {
+    /// \brief Sim time of the state the row was generated from.
+    gazebo::common::Time simTime;
+
+    /// \brief Comma separated row, without the trailing newline.
+    std::string text;
+  };
+
+  /// \brief Converts log states into CSV rows. Each instance owns its own
+  /// SDF parser state, so one instance can be used per thread.
+  class BatchFilter
+  {
+    /// \brief Constructor
+    /// \param[in] _stamp Type of time stamp written in the second column.
+    /// Valid values are (sim,real,wall,iterations)
+    public: explicit BatchFilter(const std::string &_stamp);
+
+    /// \brief Initialize the filter with a set of parameters.
+    /// \param[in] _filter The filter parameters
+    public: void Init(const std::string &_filter);
+
+    /// \brief Filter a state and append the resulting rows.
+    /// \param[in] _stateString The state string to filter.
+    /// \param[in] _label Label written in the first column of each row.
+    /// \param[out] _rows Vector that receives the rows.
+    public: void Filter(const std::string &_stateString,
+                const std::string &_label, std::vector<BatchRow> &_rows);
+
+    /// \brief Get the CSV header line, without the trailing newline.
+    /// \return Names of the columns of the rows.
+    public: std::string Header() const;
+
+    /// \brief Append one row per line of filtered values.
+    /// \param[in] _entity Scoped name of the entity the values belong to.
+    /// \param[in] _values Values separated by spaces, one row per line.
+    /// \param[in] _prefix Label and stamp columns.
+    /// \param[out] _rows Vector that receives the rows.
+    private: void AddRows(const std::string &_entity,
+                 const std::string &_values, const std::string &_prefix,
+                 std::vector<BatchRow> &_rows) const;
+
+    /// \brief Filter for a model. Time stamps are added by BatchFilter
+    /// rather than by the model filter, so there is one per row. Only its
+    /// parsed parts and sub-filters are used, BatchFilter walks the
+    /// entities itself to name them in each row.
+    private: ModelFilter filter;
+
+    /// \brief Names of the value columns.
+    private: std::vector<std::string> columns;
+
+    /// \brief Type of time stamp to output.
+    private: std::string stamp;
+
+    /// \brief SDF element used to parse states.
+    private: sdf::ElementPtr stateSdf;
+
+    /// \brief State that is reused for every parsed state string.
+    private: gazebo::physics::WorldState state;
+  };
+
   /// \brief Log command
   class LogCommand : public Command
   {
@@ -240,6 +303,25 @@ namespace gazebo
     private: void Step(const std::string &_filter, bool _raw,
                  const std::string &_stamp, double _hz);
 
+    /// \brief Filter many log files into CSV rows. Log files are decoded
+    /// in order on the calling thread, while parsing and filtering of the
+    /// states is spread over a pool of worker threads.
+    /// \param[in] _files Log files to process.
+    /// \param[in] _outFilename Output filename, empty for stdout.
+    /// \param[in] _filter Filter string
+    /// \param[in] _stamp Type of stamp to apply.
+    /// Valid values are (sim,real,wall,iterations)
+    /// \param[in] _hz Hertz rate.
+    /// \param[in] _start Only output states at or after this sim time.
+    /// \param[in] _end Only output states at or before this sim time,
+    /// ignored if not greater than zero.
+    /// \param[in] _jobs Number of worker threads.
+    private: void Batch(const std::vector<std::string> &_files,
+                 const std::string &_outFilename,
+                 const std::string &_filter, const std::string &_stamp,
+                 const double _hz, const double _start, const double _end,
+                 const unsigned int _jobs);
+
     /// \brief Start or stop logging
     /// \param[in] _start True to start logging
     private: void Record(bool _start);
@@ -331,6 +331,55 @@ TEST(gz_log, RawFilterStamp)
   EXPECT_EQ(validEcho, echo);
 }
 
+/////////////////////////////////////////////////
+/// Check batch filtering of several log files into CSV rows
+TEST(gz_log, Batch)
+{
+  std::string logPath = std::string(PROJECT_SOURCE_PATH) +
+    "/test/data/pr2_state.log";
+
+  // Rows from each log are output in order, whatever the number of jobs,
+  // after a header line.
+  std::string rows = "," + std::string("0.021344,pr2,0.000000\n") +
+    logPath + ",0.028958,pr2,0.000000";
+  std::string validBatch = "log,sim_time,entity,x\n" +
+    logPath + rows + "\n" + logPath + rows;
+
+  for (auto jobs : {"1", "4"})
+  {
+    std::string batch = custom_exec(GZ_LOG_PATH + " --filter pr2.pose.x -j " +
+        jobs + " -b " + logPath + " " + logPath);
+    boost::trim_right(batch);
+    EXPECT_EQ(validBatch, batch);
+  }
+
+  // Real time stamp
+  std::string batch = custom_exec(GZ_LOG_PATH +
+      " --stamp real --filter pr2.pose.x -b " + logPath);
+  boost::trim_right(batch);
+  EXPECT_EQ("log,real_time,entity,x\n" +
+      logPath + ",0.001000,pr2,0.000000\n" +
+      logPath + ",0.002000,pr2,0.000000", batch);
+
+  // Sim time range
+  batch = custom_exec(GZ_LOG_PATH +
+      " --start 0.025 --filter pr2.pose.x -b " + logPath);
+  boost::trim_right(batch);
+  EXPECT_EQ("log,sim_time,entity,x\n" + logPath + ",0.028958,pr2,0.000000",
+      batch);
+
+  // Link rows are named after the model and the link
+  batch = custom_exec(GZ_LOG_PATH +
+      " --start 0.025 --filter pr2/r_upper*.pose.x,y -b " + logPath);
+  boost::trim_right(batch);
+  EXPECT_EQ("log,sim_time,entity,x,y", batch.substr(0, batch.find('\n')));
+  EXPECT_NE(std::string::npos, batch.find(",pr2::r_upper"));
+
+  // A filter is required
+  batch = custom_exec(GZ_LOG_PATH + " -b " + logPath);
+  EXPECT_TRUE(batch.empty());
+}
+
 /////////////////////////////////////////////////
 /// Check to make sure that 'gz log -s' returns correct information
 TEST(gz_log, Step)